@@ -25,12 +25,170 @@
  */
 
 
+#include <chrono>
 #include <QMetaType>
+#include <QCoreApplication>
 #include "ContextSwitcher.h"
 
+#ifdef _LIN_
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <QMutex>
+#include <QWaitCondition>
+#endif
+
+namespace
+{
+
+/** Number of checks before calling thread goes to sleep */
+enum { CompletionSpinCount = 1000 };
+
+/** Queue time of the switched call executed on the thread or -1 */
+thread_local qint64 t_nCurrentCallQueueTime = -1;
+
+#ifdef _LIN_
+
+void FutexWait(std::atomic<int>* pWord, int nValue)
+{
+	syscall(SYS_futex, reinterpret_cast<int*>(pWord), FUTEX_WAIT_PRIVATE, nValue, NULL, NULL, 0);
+}
+
+void FutexWake(std::atomic<int>* pWord)
+{
+	syscall(SYS_futex, reinterpret_cast<int*>(pWord), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+#else
+
+/** Futex replacement for the platforms that do not have it */
+QMutex g_CompletionMutex;
+QWaitCondition g_CompletionCondition;
+
+void FutexWait(std::atomic<int>* pWord, int nValue)
+{
+	QMutexLocker _lock(&g_CompletionMutex);
+	if (pWord->load() == nValue)
+		g_CompletionCondition.wait(&g_CompletionMutex);
+}
+
+void FutexWake(std::atomic<int>*)
+{
+	QMutexLocker _lock(&g_CompletionMutex);
+	g_CompletionCondition.wakeAll();
+}
+
+#endif
+
+} // namespace
+
+const QEvent::Type ContextSwitcher::ProcessQueueEvent = (QEvent::Type)QEvent::registerEventType();
+
+void ContextSwitcher::Completion::Wait()
+{
+	for (int i = 0; i < CompletionSpinCount; ++i)
+	{
+		if (m_nState.load(std::memory_order_acquire) == Completed)
+			return;
+	}
+
+	int nState = Pending;
+	m_nState.compare_exchange_strong(nState, Sleeping, std::memory_order_acq_rel);
+	while (m_nState.load(std::memory_order_acquire) != Completed)
+		FutexWait(&m_nState, Sleeping);
+}
+
+void ContextSwitcher::Completion::Signal()
+{
+	// Waiting thread may destroy object right after state change so
+	// futex word address is the only thing used after it
+	std::atomic<int>* pState = &m_nState;
+	if (pState->exchange(Completed, std::memory_order_acq_rel) == Sleeping)
+		FutexWake(pState);
+}
+
 ContextSwitcher::ContextSwitcher()
+: m_nEnqueuePos(0), m_nDequeuePos(0), m_nProcessingScheduled(0)
 {
 	qRegisterMetaType<IInvoke*>("IInvoke*");
+
+	for (std::size_t i = 0; i < QueueSize; ++i)
+	{
+		m_queue[i].nSequence.store(i, std::memory_order_relaxed);
+		m_queue[i].pInvoke = NULL;
+	}
+}
+
+bool ContextSwitcher::Enqueue(IInvoke* pInvoke)
+{
+	Cell* pCell;
+	std::size_t nPos = m_nEnqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		pCell = &m_queue[nPos & QueueMask];
+		std::size_t nSeq = pCell->nSequence.load(std::memory_order_acquire);
+		std::ptrdiff_t nDiff = (std::ptrdiff_t)nSeq - (std::ptrdiff_t)nPos;
+		if (0 == nDiff)
+		{
+			if (m_nEnqueuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (nDiff < 0)
+			return false;
+		else
+			nPos = m_nEnqueuePos.load(std::memory_order_relaxed);
+	}
+
+	pCell->pInvoke = pInvoke;
+	pCell->nSequence.store(nPos + 1, std::memory_order_release);
+
+	// Only first call after queue processing start posts an event
+	if (0 == m_nProcessingScheduled.exchange(1, std::memory_order_seq_cst))
+		QCoreApplication::postEvent(this, new QEvent(ProcessQueueEvent));
+	return true;
+}
+
+ContextSwitcher::IInvoke* ContextSwitcher::Dequeue()
+{
+	Cell* pCell = &m_queue[m_nDequeuePos & QueueMask];
+	std::size_t nSeq = pCell->nSequence.load(std::memory_order_acquire);
+	if ((std::ptrdiff_t)nSeq - (std::ptrdiff_t)(m_nDequeuePos + 1) < 0)
+		return NULL;
+
+	IInvoke* pInvoke = pCell->pInvoke;
+	pCell->nSequence.store(m_nDequeuePos + QueueSize, std::memory_order_release);
+	++m_nDequeuePos;
+	return pInvoke;
+}
+
+void ContextSwitcher::ProcessQueue()
+{
+	// Calls enqueued after this point schedule new processing pass
+	m_nProcessingScheduled.exchange(0, std::memory_order_seq_cst);
+
+	for (int i = 0; i < MaxCallsPerPass; ++i)
+	{
+		IInvoke* pInvoke = Dequeue();
+		if (!pInvoke)
+			return;
+		Execute(pInvoke);
+	}
+
+	// Let other events to be processed and continue later
+	if (0 == m_nProcessingScheduled.exchange(1, std::memory_order_seq_cst))
+		QCoreApplication::postEvent(this, new QEvent(ProcessQueueEvent));
+}
+
+bool ContextSwitcher::event(QEvent* evt)
+{
+	if (evt->type() == ProcessQueueEvent)
+	{
+		ProcessQueue();
+		return true;
+	}
+	return QObject::event(evt);
 }
 
 void ContextSwitcher::MakeCtxCall(IInvoke* pInvoke)
@@ -38,5 +196,25 @@ void ContextSwitcher::MakeCtxCall(IInvoke* pInvoke)
 	Q_ASSERT(pInvoke);
 
 	if (pInvoke)
-		pInvoke->Call();
+		Execute(pInvoke);
+}
+
+qint64 ContextSwitcher::GetCurrentCallQueueTime()
+{
+	return t_nCurrentCallQueueTime;
+}
+
+qint64 ContextSwitcher::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ContextSwitcher::Execute(IInvoke* pInvoke)
+{
+	// Switched call may switch to another context and so be nested
+	qint64 nPrevQueueTime = t_nCurrentCallQueueTime;
+	t_nCurrentCallQueueTime = qMax(Now() - pInvoke->m_nEnqueuedAt, qint64(0));
+	pInvoke->Call();
+	t_nCurrentCallQueueTime = nPrevQueueTime;
 }
@@ -28,11 +28,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+
 #include <QThread>
 #include <QObject>
 #include <QMetaObject>
-
-#include "PP.h"
+#include <QEvent>
 
 /**
 * Allows to execute function(s) in main thread context (context switch)
@@ -48,30 +50,67 @@ class ContextSwitcher : public QObject
 	class IInvoke
 	{
 	public:
+		IInvoke() : m_nEnqueuedAt(0) {}
 		virtual ~IInvoke() {}
 		virtual void Call() = 0;
+
+		/** Time the call was put to the queue at, in nanoseconds */
+		qint64 m_nEnqueuedAt;
+	};
+
+	/**
+	* Completion of the call that is waited by the calling thread.
+	* Caller spins for a while and then sleeps on the futex (on Linux)
+	* until main thread marks call as completed.
+	*/
+	class Completion
+	{
+	public:
+		Completion() : m_nState(Pending) {}
+
+		/** Blocks calling thread until Signal() is called */
+		void Wait();
+		/** Marks call as completed and wakes up waiting thread */
+		void Signal();
+
+	private:
+		enum { Pending = 0, Completed = 1, Sleeping = 2 };
+		std::atomic<int> m_nState;
 	};
 
 	/**
-	* IInvoker template interface.
+	* Invoker of the function call bound to its arguments.
 	*
 	* Provides actual context switch (see Invoke(...) function),
-	*
-	* Inherit this interface, reimplement Call(), that must
-	* save result in m_res member.
+	* call result is saved in m_res member.
 	*/
-	template<class Tret>
-	class IInvoker : public IInvoke
+	template<class Tret, class Tcall>
+	class Invoker : public IInvoke
 	{
-	protected:
+		Tcall& m_call;
 		Tret m_res;
+		Completion m_completion;
+
+		virtual void Call()
+		{
+			m_res = m_call();
+			m_completion.Signal();
+		}
 	public:
+		explicit Invoker(Tcall& call) : m_call(call), m_res() {}
+
 		Tret Invoke(ContextSwitcher* pCtx)
 		{
-			bool bRes = QMetaObject::invokeMethod(pCtx, "MakeCtxCall", Qt::BlockingQueuedConnection,
-				Q_ARG(IInvoke*, this));
-			Q_ASSERT(bRes); Q_UNUSED(bRes);
-
+			m_nEnqueuedAt = ContextSwitcher::Now();
+			if (pCtx->Enqueue(this))
+				m_completion.Wait();
+			else
+			{
+				// Queue is overflowed - fallback to Qt queued call
+				bool bRes = QMetaObject::invokeMethod(pCtx, "MakeCtxCall", Qt::BlockingQueuedConnection,
+					Q_ARG(IInvoke*, this));
+				Q_ASSERT(bRes); Q_UNUSED(bRes);
+			}
 			return m_res;
 		}
 	};
@@ -83,85 +122,56 @@ public:
 	ContextSwitcher();
 
 	/**
-	 * EXAMPLE : Here we define template functions this like
-	 */
-
-	/*
-	template<class Tret ,class Targ0 ,class Targ1 >
-	Tret Invoke(Tret(*func)(Targ0, Targ1) ,Targ0 arg0 ,Targ1 arg1)
+	* Calls function in main thread context and returns its result.
+	* Arguments are passed to the function by reference, calling thread
+	* is blocked until function is completed.
+	*/
+	template<class Tret, class... Targs>
+	Tret Invoke(Tret(*func)(Targs...), Targs&... args)
 	{
 		if (QThread::currentThread() != this->thread())
 		{
-			class Invoker : public IInvoker<Tret>
-			{
-				 Tret(*func)(Targ0, Targ1);
-				 Targ0& arg0; Targ1& arg1;
-				 virtual void Call()	{ IInvoker<Tret>::m_res = (*func)(arg0, arg1); }
-			public:
-				Invoker(Tret(*func)(Targ0, Targ1) ,Targ0& arg0 ,Targ1& arg1)
-					: func(func) ,arg0(arg0), arg1(arg1) {}
-			};
-
-			return Invoker(func ,arg0, arg1).Invoke(this);
+			auto call = [&]() { return (*func)(args...); };
+			return Invoker<Tret, decltype(call)>(call).Invoke(this);
 		}
 		else
 		{
-			return (*func)(arg0, arg1);
+			return (*func)(args...);
 		}
 	}
-	*/
 
-#define CLASS_ARG_TYPE(N, d) ,class T##arg##N
-#define TYPE_VAL_REF_MEMB(N, d) T##arg##N & arg##N ;
-#define TYPE_VAL_REF_PARAM(N, d) ,T##arg##N & arg##N
-#define MEMB_VAL_INIT(N, d) ,arg##N(arg##N)
-#define PARAM_VAL_PASS(N, d) ,arg##N
-#define NAME_COMMA_SEP(N, name) NAME_COMMA_SEP_I(N, name)
-#define NAME_COMMA_SEP_I(N, name) PT_PP_COMMA_IF(N) name##N
-
-/**
-* Defines macro that defines template function Invoke().
-* Invoke() crates temp object, that saves passed params,
-* this object passed and called in MakeCtxCall(IInvoke*) via IInvoke* interface.
-*/
-#define DECL_INVOKE_FUNC_N_PARAMS(N, d) \
-	template<class Tret PP_MAKE_##N (CLASS_ARG_TYPE, _) > \
-	Tret Invoke(Tret(*func)(PP_MAKE_##N (NAME_COMMA_SEP, Targ)) PP_MAKE_##N (TYPE_VAL_REF_PARAM, _)) \
-	{ \
-		if (QThread::currentThread() != this->thread()) \
-		{ \
-			class Invoker : public IInvoker<Tret> \
-			{ \
-				Tret(*func)(PP_MAKE_##N (NAME_COMMA_SEP, Targ)); \
-				PP_MAKE_##N (TYPE_VAL_REF_MEMB, _); \
-				virtual void Call()	{ IInvoker<Tret>::m_res = (*func)(PP_MAKE_##N (NAME_COMMA_SEP, arg)); } \
-				public: \
-				Invoker(Tret(*func)(PP_MAKE_##N (NAME_COMMA_SEP, Targ)) PP_MAKE_##N (TYPE_VAL_REF_PARAM, _)) \
-					: func(func) PP_MAKE_##N (MEMB_VAL_INIT, _) {} \
-			}; \
-			\
-			return Invoker(func PP_MAKE_##N (PARAM_VAL_PASS, _)).Invoke(this); \
-		} \
-		else \
-		{ \
-			return (*func)(PP_MAKE_##N (NAME_COMMA_SEP, arg)); \
-		} \
-	}
+	/** Event handler */
+	bool event(QEvent* evt);
 
 	/**
-	* Declare template Invoke(...) functions,
-	* those accept up to 12 arguments.
+	* Returns time the call being executed on the calling thread spent in
+	* the calls queue before main thread took it, in nanoseconds.
+	* @return -1 if calling thread does not execute a switched call
 	*/
-	PP_MAKE_13(DECL_INVOKE_FUNC_N_PARAMS, _)
+	static qint64 GetCurrentCallQueueTime();
 
-#undef DECL_INVOKE_FUNC_N_PARAMS
-#undef NAME_COMMA_SEP_I
-#undef NAME_COMMA_SEP
-#undef PARAM_VAL_PASS
-#undef MEMB_VAL_INIT
-#undef TYPE_VAL_REF_PARAM
-#undef TYPE_VAL_REF_MEMB
-#undef CLASS_ARG_TYPE
+private:
+	/** Returns monotonic time in nanoseconds calls are timestamped with */
+	static qint64 Now();
+	/**
+	* Executes dequeued call (in main thread context) and accounts
+	* its time spent in the queue
+	*/
+	static void Execute(IInvoke* pInvoke);
+	/**
+	* Puts call to the calls queue and schedules queue processing in main thread
+	* @return false if queue is full
+	*/
+	bool Enqueue(IInvoke* pInvoke);
+	/**
+	* Takes next call from the calls queue. Must be called from main thread only.
+	* @return NULL if there are no published calls
+	*/
+	IInvoke* Dequeue();
+	/**
+	* Processes queued calls (in main thread context)
+	*/
+	void ProcessQueue();
 
 private slots:
 	/**
@@ -169,4 +179,36 @@ private slots:
 	* This function calls passed IInvoke::Call();
 	*/
 	Q_SLOT void MakeCtxCall(IInvoke*);
+
+private:
+	enum
+	{
+		/** Calls queue capacity (must be power of 2) */
+		QueueSize = 256,
+		QueueMask = QueueSize - 1,
+		/** Maximum calls processed at once to not starve main event loop */
+		MaxCallsPerPass = QueueSize,
+	};
+
+	/** Event type that schedules calls queue processing */
+	static const QEvent::Type ProcessQueueEvent;
+
+	/**
+	* Bounded multi producer single consumer calls queue cell.
+	* Cell sequence tells whether cell is free for the producer with the same
+	* position or published for the consumer with previous position.
+	*/
+	struct Cell
+	{
+		std::atomic<std::size_t> nSequence;
+		IInvoke* pInvoke;
+	};
+
+	Cell m_queue[QueueSize];
+	/** Next position to enqueue (shared by producers) */
+	std::atomic<std::size_t> m_nEnqueuePos;
+	/** Next position to dequeue (main thread only) */
+	std::size_t m_nDequeuePos;
+	/** Sign whether queue processing event was posted and not processed yet */
+	std::atomic<int> m_nProcessingScheduled;
 };
@@ -29,8 +29,7 @@ CONFIG += staticlib
 include(ContextSwitcher.pri)
 
 HEADERS += 				\
-	ContextSwitcher.h		\
-	PP.h
+	ContextSwitcher.h
 
 SOURCES += 				\
 	ContextSwitcher.cpp
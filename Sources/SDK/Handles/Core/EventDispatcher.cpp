@@ -25,15 +25,19 @@
  */
 
 
-#include <QList>
+#include <atomic>
 #include <QMutex>
-#include <QRecursiveMutex>
+#include <QThread>
+#include <QVector>
 #include "PrlHandleBase.h"
 #include "EventDispatcher.h"
 
 class EventDispatcher::Handler
 {
 public:
+	Handler():
+		m_owner(0), m_callback(0), m_data(0)
+	{}
 	Handler(void *const owner,
 			const PRL_EVENT_HANDLER_PTR callback,
 			void *const data):
@@ -63,10 +67,23 @@ bool EventDispatcher::Handler::operator==(const Handler &other) const
 			m_data == other.m_data);
 }
 
+/**
+ * Handlers are kept in immutable reference counted snapshots. Dispatching
+ * never locks: it takes a reference to the current snapshot and calls
+ * handlers from it. Registration publishes a new snapshot and then waits
+ * for dispatches started before (grace period), so handler is never called
+ * after its unregistration has returned - unless it is unregistered from
+ * a handler running on the same thread.
+ *
+ * Dispatches are counted per epoch. Writer flips the epoch after publishing
+ * and waits for dispatches of the previous one only, so constant stream of
+ * events can't starve it.
+ */
 class EventDispatcher::Private
 {
 public:
 	Private();
+	~Private();
 	void regHandler(void *const onwer,
 					const PRL_EVENT_HANDLER_PTR handler,
 					void *const data);
@@ -78,49 +95,149 @@ public:
 private:
 	Private(const Private &);
 	const Private &operator=(const Private &);
-	QRecursiveMutex m_handlersLock;
-	QList<Handler> m_handlers;
+
+	struct Snapshot
+	{
+		Snapshot(): refs(1) {}
+		std::atomic<int> refs;
+		QVector<Handler> handlers;
+	};
+
+	/** Dispatch in progress on the current thread */
+	struct Frame
+	{
+		const Private *dispatcher;
+		int epoch;
+		Frame *prev;
+	};
+
+	static void release(Snapshot *const snapshot);
+	void publish(Snapshot *const snapshot);
+
+	static thread_local Frame *s_frames;
+
+	/** Serializes writers */
+	QMutex m_writeLock;
+	std::atomic<Snapshot *> m_current;
+	std::atomic<int> m_epoch;
+	std::atomic<int> m_dispatches[2];
 };
 
-EventDispatcher::Private::Private()
-{}
+thread_local EventDispatcher::Private::Frame *EventDispatcher::Private::s_frames = 0;
+
+EventDispatcher::Private::Private():
+	m_current(new Snapshot), m_epoch(0)
+{
+	m_dispatches[0] = 0;
+	m_dispatches[1] = 0;
+}
+
+EventDispatcher::Private::~Private()
+{
+	release(m_current.load());
+}
+
+void EventDispatcher::Private::release(Snapshot *const snapshot)
+{
+	if (1 == snapshot->refs.fetch_sub(1))
+		delete snapshot;
+}
+
+void EventDispatcher::Private::publish(Snapshot *const snapshot)
+{
+	Snapshot *const old = m_current.exchange(snapshot);
+	const int epoch = m_epoch.load();
+	m_epoch.store(1 - epoch);
+
+	// Dispatches of the current thread can't complete while we are waiting
+	int own = 0;
+	for (const Frame *f = s_frames; f; f = f->prev)
+		if (f->dispatcher == this && f->epoch == epoch)
+			++own;
+
+	while (m_dispatches[epoch].load() > own)
+		QThread::yieldCurrentThread();
+
+	release(old);
+}
 
 void EventDispatcher::Private::regHandler(void *const owner,
 										  const PRL_EVENT_HANDLER_PTR handler,
 										  void *const data)
 {
-	QMutexLocker handlersLocker(&m_handlersLock);
-	m_handlers.append(Handler(owner, handler, data));
+	QMutexLocker writeLocker(&m_writeLock);
+	Snapshot *const snapshot = new Snapshot;
+	snapshot->handlers = m_current.load()->handlers;
+	snapshot->handlers.append(Handler(owner, handler, data));
+	publish(snapshot);
 }
 
 void EventDispatcher::Private::unregHandler(void *const owner,
 											const PRL_EVENT_HANDLER_PTR handler,
 											void *const data)
 {
-	QMutexLocker handlersLocker(&m_handlersLock);
-	m_handlers.removeOne(Handler(owner, handler, data));
+	QMutexLocker writeLocker(&m_writeLock);
+	const QVector<Handler> &handlers = m_current.load()->handlers;
+	const int i = handlers.indexOf(Handler(owner, handler, data));
+	if (0 > i)
+		return;
+
+	Snapshot *const snapshot = new Snapshot;
+	snapshot->handlers = handlers;
+	snapshot->handlers.remove(i);
+	publish(snapshot);
 }
 
 void EventDispatcher::Private::unregHandlers(void *const owner)
 {
-	QMutexLocker handlersLocker(&m_handlersLock);
-	for (int i = m_handlers.size(); 0 < i--;)
+	QMutexLocker writeLocker(&m_writeLock);
+	const QVector<Handler> &handlers = m_current.load()->handlers;
+	Snapshot *const snapshot = new Snapshot;
+	for (int i = 0, c = handlers.size(); c > i; ++i)
 	{
-		if (m_handlers[i].owner() == owner)
+		if (handlers[i].owner() != owner)
 		{
-			m_handlers.removeAt(i);
+			snapshot->handlers.append(handlers[i]);
 		}
 	}
+	if (snapshot->handlers.size() == handlers.size())
+	{
+		delete snapshot;
+		return;
+	}
+	publish(snapshot);
 }
 
 void EventDispatcher::Private::callHandlers(PrlHandleBase *const event)
 {
-	QMutexLocker handlersLocker(&m_handlersLock);
-	const QList<Handler> handlers = m_handlers;
+	Frame frame;
+	frame.dispatcher = this;
+	frame.prev = s_frames;
+	// Dispatch is counted in the epoch which is still current after counting,
+	// so the writer flipping this epoch is guaranteed to wait for it
+	for (;;)
+	{
+		frame.epoch = m_epoch.load();
+		m_dispatches[frame.epoch].fetch_add(1);
+		if (m_epoch.load() == frame.epoch)
+			break;
+		m_dispatches[frame.epoch].fetch_sub(1);
+	}
+	s_frames = &frame;
+
+	// Writer releases snapshot only after dispatches of the epoch are done
+	Snapshot *const snapshot = m_current.load();
+	snapshot->refs.fetch_add(1);
+
+	const QVector<Handler> &handlers = snapshot->handlers;
 	for (int i = 0, c = handlers.size(); c > i; ++i)
 	{
 		handlers[i].call(event);
 	}
+
+	release(snapshot);
+	s_frames = frame.prev;
+	m_dispatches[frame.epoch].fetch_sub(1);
 }
 
 EventDispatcher::EventDispatcher():
@@ -54,6 +54,7 @@
 #include "Build/Current.ver"
 
 #include "PrlContextSwitcher.h"
+#include "PrlRequestsPerf.h"
 #include "PrlNew.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -282,6 +283,39 @@ PRL_METHOD( PrlApi_GetAppMode ) (
 	return PRL_ERR_SUCCESS;
 }
 
+PRL_METHOD( PrlApi_GetPerfCounters ) (
+		PRL_REQUEST_PERF_COUNTER_PTR pCounters,
+		PRL_UINT32_PTR pnCount
+		)
+{
+	SYNC_CHECK_API_INITIALIZED
+	// Logging API calls for the possibility of debug trace
+	LOG_MESSAGE( DBG_DEBUG, "%s (pCounters=%p, pnCount=%p)",
+		__FUNCTION__,
+		pCounters,
+		pnCount
+		);
+
+	if ( PRL_WRONG_PTR(pnCount) )
+		return PRL_ERR_INVALID_ARG;
+
+	QList<PRL_REQUEST_PERF_COUNTER> lstCounters = PrlRequestsPerf::GetCounters();
+	PRL_UINT32 nCount = PRL_UINT32(lstCounters.size());
+	if ( !pCounters )
+	{
+		*pnCount = nCount;
+		return PRL_ERR_SUCCESS;
+	}
+
+	PRL_UINT32 nCopied = qMin(*pnCount, nCount);
+	for ( PRL_UINT32 i = 0; i < nCopied; ++i )
+		pCounters[i] = lstCounters.at(i);
+
+	PRL_RESULT nResult = (*pnCount < nCount) ? PRL_ERR_BUFFER_OVERRUN : PRL_ERR_SUCCESS;
+	*pnCount = nCount;
+	return nResult;
+}
+
 PRL_METHOD( PrlApi_GetResultDescription ) (
 	PRL_RESULT nErrCode,
 	PRL_BOOL bIsBriefMessage,
@@ -419,11 +453,10 @@ PRL_METHOD( PrlHandle_GetType ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// Handles should be valid pointers
-	if ( PRL_WRONG_HANDLE(handle) || PRL_WRONG_PTR(type) )
+	PrlHandleBasePtr pHandle = PRL_OBJECT_BY_HANDLE<PrlHandleBase>( handle );
+	if ( !pHandle || PRL_WRONG_PTR(type) )
 		return PRL_ERR_INVALID_ARG;
 
-	// Casting handle to the valid object and continuing
-	PrlHandleBasePtr pHandle = PRL_OBJECT_BY_HANDLE<PrlHandleBase>( handle );
 	*type = pHandle->GetType();
 
 	// We have done what we were asked for
@@ -480,10 +513,10 @@ PRL_METHOD( PrlHandle_FromString ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hHandle) || PRL_WRONG_PTR( sXml ) )
+	PrlHandleBasePtr pObj = PRL_OBJECT_BY_HANDLE<PrlHandleBase>( hHandle );
+	if ( !pObj || PRL_WRONG_PTR( sXml ) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleBasePtr pObj = PRL_OBJECT_BY_HANDLE<PrlHandleBase>(hHandle);
 	return pObj->fromString(sXml);
 }
 
@@ -501,11 +534,10 @@ PRL_METHOD( PrlHandle_ToString ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hHandle) ||	PRL_WRONG_PTR( ppXml ) )
+	PrlHandleBasePtr pObj = PRL_OBJECT_BY_HANDLE<PrlHandleBase>( hHandle );
+	if ( !pObj || PRL_WRONG_PTR( ppXml ) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleBasePtr pObj = PRL_OBJECT_BY_HANDLE<PrlHandleBase>(hHandle);
-
 	QString qsXml = pObj->toString();
 	if (qsXml.isEmpty())
 		return PRL_ERR_UNIMPLEMENTED;
@@ -549,10 +581,10 @@ PRL_METHOD( PrlStrList_GetItemsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hStringsList, PHT_STRINGS_LIST) || PRL_WRONG_PTR(pnItemsCount))
+	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hStringsList, PHT_STRINGS_LIST );
+	if (!pStringsList || PRL_WRONG_PTR(pnItemsCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hStringsList);
 	return (pStringsList->GetItemsCount(pnItemsCount));
 }
 
@@ -569,10 +601,10 @@ PRL_METHOD( PrlStrList_AddItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hStringsList, PHT_STRINGS_LIST) || PRL_WRONG_PTR(sItem))
+	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hStringsList, PHT_STRINGS_LIST );
+	if (!pStringsList || PRL_WRONG_PTR(sItem))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hStringsList);
 	return (pStringsList->AddItem(sItem));
 }
 
@@ -593,10 +625,10 @@ PRL_METHOD( PrlStrList_GetItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hStringsList, PHT_STRINGS_LIST) || PRL_WRONG_PTR(pnItemBufSize))
+	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hStringsList, PHT_STRINGS_LIST );
+	if (!pStringsList || PRL_WRONG_PTR(pnItemBufSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hStringsList);
 	return (pStringsList->GetItem(nItemIndex, sItemBuf, pnItemBufSize));
 }
 
@@ -613,10 +645,10 @@ PRL_METHOD( PrlStrList_RemoveItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hStringsList, PHT_STRINGS_LIST))
+	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hStringsList, PHT_STRINGS_LIST );
+	if (!pStringsList)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hStringsList);
 	return (pStringsList->RemoveItem(nItemIndex));
 }
 
@@ -655,10 +687,10 @@ PRL_METHOD( PrlHndlList_GetItemsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHandlesList, PHT_HANDLES_LIST) || PRL_WRONG_PTR(pnItemsCount))
+	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>( hHandlesList, PHT_HANDLES_LIST );
+	if (!pHandlesList || PRL_WRONG_PTR(pnItemsCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hHandlesList);
 	return (pHandlesList->GetItemsCount(pnItemsCount));
 }
 
@@ -675,12 +707,11 @@ PRL_METHOD( PrlHndlList_AddItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHandlesList, PHT_HANDLES_LIST) || PRL_WRONG_HANDLE(hItem, PHT_ERROR))
+	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>( hHandlesList, PHT_HANDLES_LIST );
+	PrlHandleBasePtr pItemHandle = PRL_OBJECT_BY_HANDLE<PrlHandleBase>( hItem );
+	if (!pHandlesList || !pItemHandle)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hHandlesList);
-	PrlHandleBasePtr pItemHandle = PRL_OBJECT_BY_HANDLE<PrlHandleBase>(hItem);
-
 	return (pHandlesList->AddItem(pItemHandle));
 }
 
@@ -699,10 +730,10 @@ PRL_METHOD( PrlHndlList_GetItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHandlesList, PHT_HANDLES_LIST) || PRL_WRONG_PTR(phItem))
+	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>( hHandlesList, PHT_HANDLES_LIST );
+	if (!pHandlesList || PRL_WRONG_PTR(phItem))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hHandlesList);
 	return (pHandlesList->GetItem(nItemIndex, phItem));
 }
 
@@ -719,10 +750,10 @@ PRL_METHOD( PrlHndlList_RemoveItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHandlesList, PHT_HANDLES_LIST))
+	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>( hHandlesList, PHT_HANDLES_LIST );
+	if (!pHandlesList)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHandlesListPtr pHandlesList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hHandlesList);
 	return (pHandlesList->RemoveItem(nItemIndex));
 }
 
@@ -772,10 +803,10 @@ PRL_METHOD( PrlOpTypeList_GetItemsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOpTypeList, PHT_OPAQUE_TYPE_LIST) || PRL_WRONG_PTR(pnItemsCount))
+	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hOpTypeList, PHT_OPAQUE_TYPE_LIST );
+	if (!pOpTypeList || PRL_WRONG_PTR(pnItemsCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>(hOpTypeList);
 	return (pOpTypeList->GetItemsCount(pnItemsCount));
 }
 
@@ -792,10 +823,10 @@ PRL_METHOD( PrlOpTypeList_AddItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOpTypeList, PHT_OPAQUE_TYPE_LIST) || PRL_WRONG_PTR(pnItem))
+	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hOpTypeList, PHT_OPAQUE_TYPE_LIST );
+	if (!pOpTypeList || PRL_WRONG_PTR(pnItem))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>(hOpTypeList);
 	return (pOpTypeList->AddItem(pnItem));
 }
 
@@ -814,10 +845,10 @@ PRL_METHOD( PrlOpTypeList_GetItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOpTypeList, PHT_OPAQUE_TYPE_LIST) || PRL_WRONG_PTR(pnItem))
+	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hOpTypeList, PHT_OPAQUE_TYPE_LIST );
+	if (!pOpTypeList || PRL_WRONG_PTR(pnItem))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>(hOpTypeList);
 	return (pOpTypeList->GetItem(nItemIndex, pnItem));
 }
 
@@ -834,10 +865,10 @@ PRL_METHOD( PrlOpTypeList_RemoveItem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOpTypeList, PHT_OPAQUE_TYPE_LIST))
+	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hOpTypeList, PHT_OPAQUE_TYPE_LIST );
+	if (!pOpTypeList)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>(hOpTypeList);
 	return (pOpTypeList->RemoveItem(nItemIndex));
 }
 
@@ -854,10 +885,10 @@ PRL_METHOD( PrlOpTypeList_GetTypeSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOpTypeList, PHT_OPAQUE_TYPE_LIST) || PRL_WRONG_PTR(pnTypeSize))
+	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hOpTypeList, PHT_OPAQUE_TYPE_LIST );
+	if (!pOpTypeList || PRL_WRONG_PTR(pnTypeSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleOpTypeListPtr pOpTypeList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>(hOpTypeList);
 	return (pOpTypeList->GetTypeSize(pnTypeSize));
 }
 
@@ -865,12 +896,10 @@ PRL_METHOD( PrlOpTypeList_GetTypeSize ) (
 PRL_RESULT PrlJob_Wait_Impl(PRL_HANDLE hJob, PRL_UINT32 msecs)
 {
 	// Handles should be valid pointers
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob )
 		RETURN_RES(PRL_ERR_INVALID_ARG)
 
-		// We need to be sure that this job was registered one day
-		PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	RETURN_RES(pJob->Wait(msecs))
 }
 */
@@ -888,24 +917,160 @@ PRL_METHOD( PrlJob_Wait ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob )
 		return (PRL_ERR_INVALID_ARG);
 
-	// We need to be sure that this job was registered one day
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	return (pJob->Wait(msecs));
 }
 
+namespace {
+/**
+ * Waits for completion of any or all jobs from the handles list
+ * @param handles list with jobs
+ * @param wait mode
+ * @param timeout in msecs
+ * @param pointer to buffer for storing index of the first completed job (may be NULL)
+ */
+PRL_RESULT WaitJobs(PRL_HANDLE hJobsList, PrlJobsWaiter::Mode nMode,
+					PRL_UINT32 msecs, PRL_UINT32_PTR pnIndex)
+{
+	PrlHandleHandlesListPtr pJobsList =
+		PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>( hJobsList, PHT_HANDLES_LIST );
+	if (!pJobsList)
+		return (PRL_ERR_INVALID_ARG);
+
+	QList<PrlHandleJobPtr> lstJobs;
+	foreach(const PrlHandleBasePtr &pItem, pJobsList->GetHandlesList())
+	{
+		PrlHandleJobPtr pJob = pItem
+			? PRL_OBJECT_BY_HANDLE<PrlHandleJob>( pItem->GetHandle(), PHT_JOB )
+			: PrlHandleJobPtr();
+		if (!pJob)
+			return (PRL_ERR_INVALID_ARG);
+		lstJobs.append(pJob);
+	}
+	if (lstJobs.isEmpty())
+		return (PRL_ERR_INVALID_ARG);
+
+	PrlJobsWaiter *pWaiterObj = new PrlJobsWaiter(nMode, lstJobs.size());
+	if (!pWaiterObj)
+		return (PRL_ERR_OUT_OF_MEMORY);
+	SmartPtr<PrlJobsWaiter> pWaiter(pWaiterObj);
+
+	PRL_RESULT nRetCode = PRL_ERR_SUCCESS;
+	bool bProcessEvents = false;
+	int nAttached = 0;
+	for (; nAttached < lstJobs.size(); ++nAttached)
+	{
+		nRetCode = lstJobs.at(nAttached)->AttachWaiter(pWaiter, nAttached);
+		if (PRL_FAILED(nRetCode))
+			break;
+		bProcessEvents = bProcessEvents || lstJobs.at(nAttached)->IsResultProcessedByCurrentThread();
+	}
+
+	if (PRL_SUCCEEDED(nRetCode))
+	{
+		if (!pWaiter->Wait(msecs, bProcessEvents))
+			nRetCode = PRL_ERR_TIMEOUT;
+		else if (pnIndex)
+			*pnIndex = PRL_UINT32(pWaiter->GetFirstCompleted());
+	}
+
+	for (int i = 0; i < nAttached; ++i)
+		lstJobs.at(i)->DetachWaiter(pWaiter);
+
+	return (nRetCode);
+}
+
+} // namespace
+
+PRL_METHOD( PrlJob_WaitAny ) (
+		PRL_HANDLE hJobsList,
+		PRL_UINT32 msecs,
+		PRL_UINT32_PTR pnIndex
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hJobsList=%p, msecs=%u, pnIndex=%p)",
+		__FUNCTION__,
+		hJobsList,
+		msecs,
+		pnIndex
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	if ( PRL_WRONG_PTR(pnIndex) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (WaitJobs(hJobsList, PrlJobsWaiter::WaitAny, msecs, pnIndex));
+}
+
+PRL_METHOD( PrlJob_WaitAll ) (
+		PRL_HANDLE hJobsList,
+		PRL_UINT32 msecs
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hJobsList=%p, msecs=%u)",
+		__FUNCTION__,
+		hJobsList,
+		msecs
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	return (WaitJobs(hJobsList, PrlJobsWaiter::WaitAll, msecs, NULL));
+}
+
+PRL_METHOD( PrlJob_GetCompletionFd ) (
+		PRL_HANDLE hJob,
+		PRL_INT32_PTR pnFd
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hJob=%p, pnFd=%p)",
+		__FUNCTION__,
+		hJob,
+		pnFd
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(pnFd) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pJob->GetCompletionFd(pnFd));
+}
+
+PRL_METHOD( PrlJob_SetCompletionCallback ) (
+		PRL_HANDLE hJob,
+		PRL_EVENT_HANDLER_PTR handler,
+		PRL_VOID_PTR userData
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hJob=%p, handler=%p, userData=%p)",
+		__FUNCTION__,
+		hJob,
+		handler,
+		userData
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pJob->SetCompletionCallback(handler, userData));
+}
+
 PRL_HANDLE PrlJob_Cancel_Impl(PRL_HANDLE hJob)
 {
 	// Handles should be valid pointers
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_JOB_CANCEL))
 
-		// We need to be sure that this job was registered one day
-		PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	RETURN_RES(pJob->Cancel())
 }
 
@@ -938,12 +1103,10 @@ PRL_METHOD( PrlJob_GetStatus ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) || PRL_WRONG_PTR(status) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(status) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	return pJob->GetStatus( status );
 }
 
@@ -962,12 +1125,10 @@ PRL_METHOD( PrlJob_GetProgress ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) || PRL_WRONG_PTR(percentage) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(percentage) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	return pJob->GetProgress( percentage );
 }
 
@@ -985,12 +1146,10 @@ PRL_METHOD( PrlJob_GetRetCode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) || PRL_WRONG_PTR(retcode) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(retcode) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	return pJob->GetRetCode( retcode );
 }
 
@@ -1010,12 +1169,10 @@ PRL_METHOD( PrlJob_GetDataPtr) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	return pJob->GetDataPtr( data_ptr, data_size );
 
 }
@@ -1035,12 +1192,10 @@ PRL_METHOD ( PrlJob_GetResult ) (
 		);
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) || PRL_WRONG_PTR(handle) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(handle) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
-
 	return pJob->GetResult( handle );
 }
 
@@ -1057,10 +1212,10 @@ PRL_METHOD( PrlJob_GetError ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) || PRL_WRONG_PTR(phError) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(phError) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
 
 	return pJob->GetError( phError );
 }
@@ -1078,10 +1233,10 @@ PRL_METHOD( PrlJob_GetOpCode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) || PRL_WRONG_PTR(pnJobOpCode) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(pnJobOpCode) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
 
 	return pJob->GetOpCode( pnJobOpCode );
 }
@@ -1099,10 +1254,10 @@ PRL_METHOD( PrlJob_IsRequestWasSent ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hJob, PHT_JOB) || PRL_WRONG_PTR(pbIsRequestWasSent) )
+	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob, PHT_JOB );
+	if ( !pJob || PRL_WRONG_PTR(pbIsRequestWasSent) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleJobPtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleJob>( hJob );
 
 	return pJob->IsRequestWasSent( pbIsRequestWasSent );
 }
@@ -1122,12 +1277,10 @@ PRL_METHOD( PrlResult_GetParamsCount ) (
 		);
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(pCount) )
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(pCount) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
-
 	return pResult->GetParamsCount( pCount );
 }
 
@@ -1146,10 +1299,10 @@ PRL_METHOD( PrlResult_GetParamByIndex ) (
 		phParam
 		);
 
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(phParam) )
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(phParam) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
 
 	return pResult->GetParamByIndex( nIndex, phParam );
 }
@@ -1167,10 +1320,10 @@ PRL_METHOD( PrlResult_GetParam ) (
 		pHandle
 		);
 
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(pHandle))
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(pHandle))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
 
 	return pResult->GetResultAsHandle( pHandle );
 }
@@ -1192,10 +1345,10 @@ PRL_METHOD(PrlResult_GetParamByIndexAsString) (
 		pnParamBufSize
 		);
 
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(pnParamBufSize) )
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(pnParamBufSize) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
 
 	return pResult->GetParamByIndexAsString( nIndex, sParamBuf, pnParamBufSize );
 }
@@ -1215,10 +1368,10 @@ PRL_METHOD(PrlResult_GetParamAsString) (
 		pnParamBufSize
 		);
 
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(pnParamBufSize) )
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(pnParamBufSize) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
 
 	return pResult->GetParamByIndexAsString( 0, sParamBuf, pnParamBufSize );
 }
@@ -1238,12 +1391,10 @@ PRL_METHOD( PrlEvent_GetType ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(type) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(type) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this event was registered one day
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
-
 	return pEvent->GetEventType( type );
 }
 
@@ -1262,12 +1413,10 @@ PRL_METHOD( PrlEvent_GetDataPtr ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(data_ptr) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(data_ptr) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this event was registered one day
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
-
 	return pEvent->GetDataPtr( data_ptr );
 }
 
@@ -1286,12 +1435,10 @@ PRL_METHOD( PrlEvent_GetServer) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(server) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(server) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this event was registered one day
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
-
 	return pEvent->GetServer( server );
 }
 
@@ -1310,12 +1457,10 @@ PRL_METHOD( PrlEvent_GetVm) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pVm) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pVm) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this event was registered one day
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
-
 	return pEvent->GetVm( pVm );
 }
 
@@ -1334,11 +1479,10 @@ PRL_METHOD( PrlEvent_GetJob) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pJob) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pJob) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this event was registered one day
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 #ifdef _WIN_
 #ifdef GetJob
 #undef GetJob
@@ -1360,10 +1504,10 @@ PRL_METHOD( PrlEvent_GetParamsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pnParamsCount) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pnParamsCount) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->GetParamsCount( pnParamsCount );
 }
@@ -1382,10 +1526,10 @@ PRL_METHOD( PrlEvent_GetParam ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(phEventParam) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(phEventParam) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->GetParam( nIndex, phEventParam );
 }
@@ -1405,10 +1549,10 @@ PRL_METHOD( PrlEvent_GetParamByName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(sParamName) || PRL_WRONG_PTR(phEventParam) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(sParamName) || PRL_WRONG_PTR(phEventParam) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->GetParamByName( sParamName, phEventParam );
 }
@@ -1426,10 +1570,10 @@ PRL_METHOD( PrlEvent_GetErrCode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pnErrCode) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pnErrCode) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->GetErrCode( pnErrCode );
 }
@@ -1451,10 +1595,10 @@ PRL_METHOD( PrlEvent_GetErrString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pnErrStringBufLength) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pnErrStringBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->GetErrString( bIsBriefMessage, bFormated, sErrString, pnErrStringBufLength );
 }
@@ -1472,10 +1616,10 @@ PRL_METHOD( PrlEvent_CanBeIgnored ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pbCanBeIgnored) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pbCanBeIgnored) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->CanBeIgnored( pbCanBeIgnored );
 }
@@ -1493,10 +1637,10 @@ PRL_METHOD( PrlEvent_IsAnswerRequired ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pbIsAnswerRequired) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pbIsAnswerRequired) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->IsAnswerRequired( pbIsAnswerRequired );
 }
@@ -1514,10 +1658,10 @@ PRL_METHOD( PrlEvent_GetIssuerType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(pnIssuerType) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(pnIssuerType) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->GetIssuerType( pnIssuerType );
 }
@@ -1537,10 +1681,10 @@ PRL_METHOD( PrlEvent_GetIssuerId ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) ||	PRL_WRONG_PTR(pnIssuerIdBufLength) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent ||	PRL_WRONG_PTR(pnIssuerIdBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->GetIssuerId( sIssuerId, pnIssuerIdBufLength );
 }
@@ -1560,10 +1704,10 @@ PRL_METHOD( PrlEvent_CreateAnswerEvent ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(phEvent))
+	PrlHandleVmEventPtr pVmEvent = PRL_OBJECT_BY_HANDLE<PrlHandleVmEvent>( hEvent, PHT_EVENT );
+	if (!pVmEvent || PRL_WRONG_PTR(phEvent))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmEventPtr pVmEvent = PRL_OBJECT_BY_HANDLE<PrlHandleVmEvent>( hEvent );
 
 	return (pVmEvent->CreateAnswerEvent(phEvent, nAnswer));
 }
@@ -1581,10 +1725,10 @@ PRL_METHOD( PrlEvent_FromString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEvent, PHT_EVENT) || PRL_WRONG_PTR(sEvent) )
+	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent, PHT_EVENT );
+	if ( !pEvent || PRL_WRONG_PTR(sEvent) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventPtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleEvent>( hEvent );
 
 	return pEvent->FromString( sEvent );
 }
@@ -1604,10 +1748,10 @@ PRL_METHOD( PrlEvtPrm_GetName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamNameBufLength) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pnParamNameBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->GetName( sParamName, pnParamNameBufLength );
 }
@@ -1625,10 +1769,10 @@ PRL_METHOD( PrlEvtPrm_GetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamType) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pnParamType) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->GetParamType( pnParamType );
 }
@@ -1648,10 +1792,10 @@ PRL_METHOD( PrlEvtPrm_ToString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamValueBufLength) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pnParamValueBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToString( sParamValue, pnParamValueBufLength );
 }
@@ -1671,11 +1815,11 @@ PRL_METHOD( PrlEvtPrm_ToCData ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) ||
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam ||
 		PRL_WRONG_PTR(pnParamValueBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToCData( sParamValue, pnParamValueBufLength );
 }
@@ -1693,10 +1837,10 @@ PRL_METHOD( PrlEvtPrm_ToUint32 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamValue) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pnParamValue) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToUint32( pnParamValue );
 }
@@ -1714,10 +1858,10 @@ PRL_METHOD( PrlEvtPrm_ToInt32 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamValue) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pnParamValue) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToInt32( pnParamValue );
 }
@@ -1735,10 +1879,10 @@ PRL_METHOD( PrlEvtPrm_ToUint64 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamValue) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pnParamValue) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToUint64( pnParamValue );
 }
@@ -1756,10 +1900,10 @@ PRL_METHOD( PrlEvtPrm_ToInt64 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamValue) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pnParamValue) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToInt64( pnParamValue );
 }
@@ -1777,10 +1921,10 @@ PRL_METHOD( PrlEvtPrm_ToBoolean ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pbParamValue) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(pbParamValue) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToBoolean( pbParamValue );
 }
@@ -1798,10 +1942,10 @@ PRL_METHOD( PrlEvtPrm_ToHandle ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (	PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(phParamValue) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if (	!pEventParam || PRL_WRONG_PTR(phParamValue) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->ToHandle( phParamValue );
 }
@@ -1821,10 +1965,10 @@ PRL_METHOD( PrlEvtPrm_GetBuffer ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hEventParam, PHT_EVENT_PARAMETER) || PRL_WRONG_PTR(pnParamValueBufLength) )
+	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam, PHT_EVENT_PARAMETER );
+	if ( !pEventParam || PRL_WRONG_PTR(pnParamValueBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleEventParamPtr pEventParam = PRL_OBJECT_BY_HANDLE<PrlHandleEventParam>( hEventParam );
 
 	return pEventParam->GetBuffer( pParamValue, pnParamValueBufLength );
 }
@@ -1876,7 +2020,8 @@ PRL_HANDLE PrlApi_SendPackedProblemReport_Impl(
 )
 {
 	PRL_UNUSED_PARAM(nReserved);
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_API_SEND_PACKED_PROBLEM_REPORT))
 
 	PrlHandleLocalJobPtr pSendReportJob(new PrlHandleLocalJob(Uuid::createUuid().toString(),
@@ -1884,8 +2029,6 @@ PRL_HANDLE PrlApi_SendPackedProblemReport_Impl(
 	if (!pSendReportJob.getHandle())
 		RETURN_RES(PRL_INVALID_HANDLE);
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>(hProblemReport);
-
 	PrlProblemReportSender *pReportSender = new PrlProblemReportSender(pSendReportJob, pProblemReport, bUseProxy, sProxyHost,
 			nProxyPort, sProxyUserLogin, sProxyUserPasswd, nProblemSendTimeout, handler, pUserData);
 	if (!pReportSender)
@@ -1950,10 +2093,10 @@ PRL_METHOD( PrlReport_SetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->SetType(nReportType));
 }
@@ -1971,10 +2114,10 @@ PRL_METHOD( PrlReport_GetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) || PRL_WRONG_PTR(pnReportType) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport || PRL_WRONG_PTR(pnReportType) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->GetPRType(pnReportType));
 }
@@ -1992,10 +2135,10 @@ PRL_METHOD( PrlReport_SetReason ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->SetReason(nReportReason));
 }
@@ -2013,10 +2156,10 @@ PRL_METHOD( PrlReport_GetReason ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) || PRL_WRONG_PTR(pnReportReason) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport || PRL_WRONG_PTR(pnReportReason) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->GetReason(pnReportReason));
 }
@@ -2036,10 +2179,10 @@ PRL_METHOD( PrlReport_GetUserEmail ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->GetUserEmail(sUserEmail, pnUserEmailBufLength));
 }
@@ -2057,10 +2200,10 @@ PRL_METHOD( PrlReport_SetUserEmail ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->SetUserEmail(sNewUserEmail));
 }
@@ -2080,10 +2223,10 @@ PRL_METHOD( PrlReport_GetDescription ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->GetDescription(sDescription, pnDescriptionBufLength));
 }
@@ -2101,10 +2244,10 @@ PRL_METHOD( PrlReport_SetDescription ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->SetDescription(sNewDescription));
 }
@@ -2114,10 +2257,10 @@ PRL_HANDLE PrlReport_Assembly_Impl(
                                    PRL_UINT32 nFlags
                                    )
 {
-	if ( PRL_WRONG_HANDLE( hProblemReport, PHT_PROBLEM_REPORT ) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_REPORT_ASSEMBLY))
 
-        PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 	RETURN_RES(pProblemReport->Assembly(nFlags))
 }
 
@@ -2168,15 +2311,13 @@ PRL_METHOD( PrlDbg_GetHandlesNum) (
 	if (PRL_WRONG_PTR(handles_num))
 		return PRL_ERR_INVALID_ARG;
 
-	QMutexLocker _lock(PrlHandleBase::s_pHandlesMapMutex);
 	if (PHT_ERROR == type)
-		*handles_num = PrlHandleBase::s_pHandlesMap->size();
+		*handles_num = PrlHandleBase::s_pHandlesTable->Count();
 	else
 	{
 		PRL_UINT32 nHandlesNum = 0;
-		HandlesMap::iterator _handle = PrlHandleBase::s_pHandlesMap->begin();
-		for (; _handle != PrlHandleBase::s_pHandlesMap->end(); ++_handle)
-			if (_handle.value()->GetType() == type)
+		foreach(const SmartPtr<PrlHandleBase> &pHandle, PrlHandleBase::s_pHandlesTable->Snapshot())
+			if (pHandle->GetType() == type)
 				nHandlesNum++;
 		*handles_num = nHandlesNum;
 	}
@@ -2227,13 +2368,12 @@ PRL_METHOD( PrlHandle_GetPackageId ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( ( PRL_WRONG_HANDLE(hObj, PHT_EVENT) && PRL_WRONG_HANDLE(hObj, PHT_JOB) )
+	PrlHandleBasePtr pObj = PRL_OBJECT_BY_HANDLE<PrlHandleBase>( hObj );
+	if ( !pObj
+		|| ( pObj->GetType() != PHT_EVENT && pObj->GetType() != PHT_JOB )
 		|| PRL_WRONG_PTR(id) )
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this event was registered one day
-	PrlHandleBasePtr pObj = PRL_OBJECT_BY_HANDLE<PrlHandleBase>( hObj );
-
 	return pObj->GetPackageId( id );
 }
 
@@ -2348,10 +2488,10 @@ PRL_METHOD( PrlReport_GetScheme ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) || PRL_WRONG_PTR(pnReportScheme) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport || PRL_WRONG_PTR(pnReportScheme) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->GetScheme(pnReportScheme));
 }
@@ -2371,10 +2511,10 @@ PRL_METHOD( PrlReport_GetArchiveFileName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->GetArchiveFileName(sArchiveFileName, pnBufLength));
 }
@@ -2394,10 +2534,10 @@ PRL_METHOD( PrlReport_GetUserName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 #ifdef _WIN_
 #ifdef GetUserName
 #undef GetUserName
@@ -2419,10 +2559,10 @@ PRL_METHOD( PrlReport_SetUserName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->SetUserName(sNewUserName));
 }
@@ -2442,10 +2582,10 @@ PRL_METHOD( PrlReport_GetData ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->GetData(pBuffer, pnBufLength));
 }
@@ -2465,10 +2605,10 @@ PRL_METHOD( PrlReport_AsString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	return (pProblemReport->AsString(sBuffer, pnBufLength));
 }
@@ -2504,10 +2644,10 @@ PRL_ASYNC_METHOD( PrlReport_Send ) (
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_API_SEND_PACKED_PROBLEM_REPORT)
 
-	if ( PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport, PHT_PROBLEM_REPORT );
+	if ( !pProblemReport )
 		return (GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_API_SEND_PROBLEM_REPORT));
 
-	PrlHandleProblemReportPtr pProblemReport = PRL_OBJECT_BY_HANDLE<PrlHandleProblemReport>( hProblemReport );
 
 	if (PRS_OLD_XML_BASED == pProblemReport->GetScheme())
 	{
@@ -43,6 +43,7 @@
 #include "PrlHandleOpTypeList.h"
 #include "PrlContextSwitcher.h"
 #include "PrlHandleServer.h"
+#include "PrlHandleVm.h"
 
 #include <prlcommon/HostUtils/PrlMiscellaneous.h>
 #include <prlcommon/PrlCommonUtilsBase/CGuestOsesHelper.h>
@@ -154,6 +155,74 @@ void PrlContextSwitcher::DeinitInstance ()
 PrlContextSwitcher::PrlContextSwitcher()
 {}
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/** Direct call in progress on the thread or NULL */
+thread_local PrlDirectCall *t_pCurrentDirectCall = 0;
+
+} // namespace
+
+PrlDirectCall::PrlDirectCall(PRL_HANDLE handle)
+: m_pObject(PRL_OBJECT_BY_HANDLE<PrlHandleBase>(handle)), m_pLock(NULL),
+  m_pOuterCall(t_pCurrentDirectCall)
+{
+	t_pCurrentDirectCall = this;
+
+	PrlHandleServerPtr pServer;
+	if (m_pObject && m_pObject->GetType() == PHT_VIRTUAL_MACHINE)
+		pServer = static_cast<PrlHandleVm *>(m_pObject.getHandle())->GetServer();
+
+	if (!pServer)
+		return;
+
+	m_pOwner = PrlHandleBasePtr(pServer.getHandle());
+	m_pLock = pServer->GetDirectCallsLock();
+	m_pLock->lockForRead();
+}
+
+PrlDirectCall::~PrlDirectCall()
+{
+	t_pCurrentDirectCall = m_pOuterCall;
+
+	if (m_pLock)
+		m_pLock->unlock();
+	// Jobs of the sent requests are registered by now
+	if (!m_lstPendingRequests.isEmpty())
+		static_cast<PrlHandleServer *>(m_pOwner.getHandle())->RemovePendingRequests(m_lstPendingRequests);
+}
+
+void PrlDirectCall::AddPendingRequest(const PrlUuidKey &requestUuid)
+{
+	PrlDirectCall *pCall = t_pCurrentDirectCall;
+	if (!pCall || !pCall->m_pOwner || requestUuid.isNull())
+		return;
+
+	static_cast<PrlHandleServer *>(pCall->m_pOwner.getHandle())->AddPendingRequest(requestUuid);
+	pCall->m_lstPendingRequests.append(requestUuid);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+PrlOwnerContext::PrlOwnerContext(PRL_HANDLE handle)
+: m_pContextSwitcher(PrlContextSwitcher::Instance())
+{
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>(handle, PHT_SERVER);
+	if (!pServer)
+	{
+		PrlHandleVmPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVm>(handle, PHT_VIRTUAL_MACHINE);
+		if (pVm)
+			pServer = pVm->GetServer();
+	}
+
+	if (!pServer)
+		return;
+
+	m_pOwner = PrlHandleBasePtr(pServer.getHandle());
+	m_pContextSwitcher = pServer->GetContextSwitcher();
+}
+
 void PrlSdkThreadsDestructor::RegisterThreadForDeletion(Heappy *thread_)
 {
 	QMutexLocker g(&m_ThreadsListMutex);
@@ -344,20 +413,16 @@ void QMainThread::DeinitSdkParts()
 	m_MainThreadCondition.wakeAll();
 	PrlContextSwitcher::DeinitInstance();
 
-	//Copy Handle map under mutex to temporary list to prevent dead-locks ( Task #PM-1642 )
+	//Move handles table content to temporary list to prevent dead-locks ( Task #PM-1642 )
 	//Loop until all handle spawning activities would be stopped.
 	QList<SmartPtr<PrlHandleBase> > _lockFreeHandleList;
 	while(true)
 	{
-		{
-			QMutexLocker lock(PrlHandleBase::s_pHandlesMapMutex);
-			if (PrlHandleBase::s_pHandlesMap->isEmpty())
-				break;
+		_lockFreeHandleList = PrlHandleBase::s_pHandlesTable->TakeAll();
+		if (_lockFreeHandleList.isEmpty())
+			break;
 
-			_lockFreeHandleList = PrlHandleBase::s_pHandlesMap->values();
-			PrlHandleBase::s_pHandlesMap->clear();
-		}
-		//Destroy handles without mutex lock
+		//Destroy handles without table locks
 		_lockFreeHandleList.clear();
 	}
 }
@@ -441,7 +506,7 @@ bool PrlContextSwitcher::event ( QEvent* evt )
 		return true;
 	}
 	else
-		return QObject::event(evt);
+		return ContextSwitcher::event(evt);
 }
 
 void PrlContextSwitcher::NotifyWorkFinalization()
@@ -70,122 +70,123 @@ extern PRL_BOOL PRL_WRONG_VM_DEVICE_TYPE(PRL_DEVICE_TYPE typo);
 class PrlHandleJob;
 extern PRL_HANDLE store_result(PrlHandleJob *job_obj, PRL_HANDLE hVm = PRL_INVALID_HANDLE);
 
-#define PRL_CntxSw_CHECK_HANDLE_ASYNC(h_value, h_expected_type, job_code)   \
-    if ( PRL_WRONG_HANDLE(h_value, h_expected_type) )                   \
+#define PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(obj_type, obj_name, h_value, h_expected_type, job_code)   \
+	PrlHandleSmartPtr<obj_type> obj_name = PRL_OBJECT_BY_HANDLE<obj_type>(h_value, h_expected_type); \
+	if ( !obj_name )                                                    \
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_code)) ;
 
 #define ONE_HANDLE_AND_ONE_PTR_PARAM_METH_IMPLEMENTATION(methodname, param, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(param) )\
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );\
+	if ( !pServer || PRL_WRONG_PTR(param) )\
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname(param);\
 	if (!pJob)\
 		RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define DISP_ONE_HANDLE_AND_ONE_PTR_PARAM_METH_IMPLEMENTATION(methodname, param, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(param) )\
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );\
+	if ( !pServer || PRL_WRONG_PTR(param) )\
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname(param);\
 	if (!pJob)\
 		RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_METH_IMPLEMENTATION(methodname, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname();\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_DISP_METH_IMPLEMENTATION(methodname, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname();\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_STAT_METH_IMPLEMENTATION(methodname, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerStatPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerStat>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerStatPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerStat>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname();\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_NET_METH_IMPLEMENTATION(methodname, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname();\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_DEPRECATED_METH_IMPLEMENTATION(methodname, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname();\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_METH_IMPLEMENTATION_WITH_FLAGS(methodname, flags, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname(flags);\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_VM_METH_IMPLEMENTATION_WITH_FLAGS(methodname, flags, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname(flags);\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_DISP_METH_IMPLEMENTATION_WITH_FLAGS(methodname, flags, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname(flags);\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_NET_METH_IMPLEMENTATION_WITH_FLAGS(methodname, flags, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname(flags);\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_SRV_DEPRECATED_METH_IMPLEMENTATION_WITH_FLAGS(methodname, flags, job_type)\
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )\
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );\
+	if ( !pServer )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );\
 	PrlHandleJobPtr pJob = pServer->methodname(flags);\
 	if ( !pJob )\
 	RETURN_RES(PRL_INVALID_HANDLE)\
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_VM_METH_IMPLEMENTATION(methodname, job_type)\
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )\
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );\
+	if ( !pVm )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);\
 	PrlHandleJobPtr pJob = pVm->methodname();\
 	if (!pJob)\
 	RETURN_RES(PRL_INVALID_HANDLE)\
@@ -193,9 +194,9 @@ extern PRL_HANDLE store_result(PrlHandleJob *job_obj, PRL_HANDLE hVm = PRL_INVAL
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_AND_ONE_PTR_PARAM_VM_METH_IMPLEMENTATION(methodname, param,  job_type)\
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(param) )\
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );\
+	if ( !pVm || PRL_WRONG_PTR(param) )\
 	RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);\
 	PrlHandleJobPtr pJob = pVm->methodname( param );\
 	if (!pJob)\
 	RETURN_RES(PRL_INVALID_HANDLE)\
@@ -203,9 +204,9 @@ extern PRL_HANDLE store_result(PrlHandleJob *job_obj, PRL_HANDLE hVm = PRL_INVAL
 	RETURN_RES(pJob->GetHandle())
 
 #define ONE_HANDLE_AND_FLAGS_VM_METH_IMPLEMENTATION(methodname, flags, job_type)\
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )\
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );\
+	if ( !pVm )\
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, job_type))\
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);\
 	PrlHandleJobPtr pJob = pVm->methodname(flags);\
 	if (!pJob)\
 		RETURN_RES(PRL_INVALID_HANDLE)\
@@ -30,12 +30,15 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QList>
 
 #include "Libraries/ContextSwitcher/ContextSwitcher.h"
 #include "SDK/Include/PrlTypes.h"
 #include "SDK/Include/PrlErrors.h"
 #include "SDK/Include/PrlEnums.h"
 #include "PrlHandleJob.h"
+#include "PrlUuidKey.h"
 
 
 #define ARGS_APPLY_I(macro, args) macro args
@@ -46,6 +49,22 @@
 #define CALL_THROUGH_CTXT_SWITCHER(ctxt_switcher, methodname, values)\
 	return ctxt_switcher->Invoke(methodname##_Impl, ARGS_STRIP_PARENS(values));
 
+/**
+ * Executes method implementation in the execution context of the server owning
+ * specified handle (see PrlOwnerContext for details). Context is held until
+ * the call is completed.
+ */
+#define CALL_THROUGH_OWNER_CTXT(handle, methodname, values)\
+	return PrlOwnerContext(handle).GetContextSwitcher()->Invoke(methodname##_Impl, ARGS_STRIP_PARENS(values));
+
+/**
+ * Executes method implementation right on the caller thread. Suitable only for
+ * implementations which just build protocol command and send it to the server
+ * under the handles own locks (see PrlDirectCall for details).
+ */
+#define CALL_DIRECT(handle, methodname, values)\
+	return PrlDirectCall(handle).Invoke(methodname##_Impl, ARGS_STRIP_PARENS(values));
+
 typedef PRL_METHOD_PTR( PRL_EVENT_HANDLER_PTR ) (
 		PRL_HANDLE hEvent,
 		PRL_VOID_PTR data
@@ -99,4 +118,85 @@ private:
 	static QMutex s_pContextSwitcherMutex;
 };
 
+/**
+ * Scope of the API call executed directly on the caller thread without switching
+ * to the SDK event loop.
+ *
+ * Direct calls are running concurrently with the server event loop, so:
+ *  - the target object is held for the whole call, thus the last reference to it
+ *    (and so to its server object which finalization requires the server event loop)
+ *    is never dropped inside the call;
+ *  - the call is registered at the direct calls lock of the target object server
+ *    for reading. Server event loop takes this lock for writing to replace the
+ *    connection object. Calls to other servers are not affected;
+ *  - requests sent by the call are marked pending at the server until the call
+ *    is completed. Response of a pending request which has arrived before its
+ *    job was registered waits for the call. Other responses are not delayed.
+ */
+class PrlDirectCall
+{
+public:
+	/**
+	 * Class constructor
+	 * @param handle of the call target object
+	 */
+	explicit PrlDirectCall(PRL_HANDLE handle);
+	/** Class destructor */
+	~PrlDirectCall();
+
+	/** Calls function on the caller thread within the call scope */
+	template<class Tret, class... Targs>
+	Tret Invoke(Tret(*func)(Targs...), Targs&... args)
+	{
+		return (*func)(args...);
+	}
+
+	/**
+	 * Marks request as pending till the direct call of the current thread is
+	 * completed. Must be called before the request is sent. Does nothing if
+	 * the current thread is not in a direct call.
+	 * @param request UUID
+	 */
+	static void AddPendingRequest(const PrlUuidKey &requestUuid);
+
+private:
+	Q_DISABLE_COPY(PrlDirectCall)
+
+	/** Target object held during the call */
+	PrlHandleBasePtr m_pObject;
+	/** Server object owning direct calls lock */
+	PrlHandleBasePtr m_pOwner;
+	/** Direct calls lock of the server held for reading or NULL */
+	QReadWriteLock *m_pLock;
+	/** Direct call of the thread this call is nested into or NULL */
+	PrlDirectCall *m_pOuterCall;
+	/** Requests sent by the call marked pending at the server */
+	QList<PrlUuidKey> m_lstPendingRequests;
+};
+
+/**
+ * Execution context of the API call target object. Server objects and objects
+ * belonging to them (VMs) are served by the own event loop of the server, so calls
+ * to different servers do not wait each other. All other objects are served by
+ * SDK event loop.
+ */
+class PrlOwnerContext
+{
+public:
+	/**
+	 * Class constructor
+	 * @param handle of the call target object
+	 */
+	explicit PrlOwnerContext(PRL_HANDLE handle);
+
+	/** Returns context switcher to pass call through */
+	ContextSwitcher *GetContextSwitcher() const { return m_pContextSwitcher; }
+
+private:
+	/** Server object owning context held during the call */
+	PrlHandleBasePtr m_pOwner;
+	/** Context switcher of the owner */
+	ContextSwitcher *m_pContextSwitcher;
+};
+
 #endif	// __PRL_CONTEXT_SWITCHER_H__
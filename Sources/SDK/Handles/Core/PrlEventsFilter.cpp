@@ -0,0 +1,116 @@
+/*
+ * PrlEventsFilter.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+
+
+#include "PrlEventsFilter.h"
+#include "PrlHandleOpTypeList.h"
+#include "PrlHandleStringsList.h"
+
+#include <prlcommon/PrlUuid/Uuid.h>
+
+PrlEventsFilter::PrlEventsFilter()
+: m_nDelivered(0), m_nFiltered(0)
+{}
+
+PRL_RESULT PrlEventsFilter::SetFilter(PrlHandleOpTypeList *pEventTypes, PrlHandleStringsList *pVmUuids)
+{
+	QSet<PRL_UINT32> setEventTypes;
+	if (pEventTypes)
+	{
+		PRL_SIZE nTypeSize = 0;
+		PRL_UINT32 nCount = 0;
+		PRL_RESULT nErr = pEventTypes->GetTypeSize(&nTypeSize);
+		if (PRL_SUCCEEDED(nErr))
+			nErr = pEventTypes->GetItemsCount(&nCount);
+		if (PRL_FAILED(nErr))
+			return (nErr);
+		if (nTypeSize == 0 || nTypeSize > sizeof(PRL_UINT64))
+			return (PRL_ERR_INVALID_ARG);
+
+		for (PRL_UINT32 i = 0; i < nCount; ++i)
+		{
+			PRL_UINT64 nItem = 0;
+			nErr = pEventTypes->GetItem(i, &nItem);
+			if (PRL_FAILED(nErr))
+				return (nErr);
+
+			switch (nTypeSize)
+			{
+			case sizeof(PRL_UINT8):
+				setEventTypes.insert(*reinterpret_cast<PRL_UINT8 *>(&nItem));
+				break;
+			case sizeof(PRL_UINT16):
+				setEventTypes.insert(*reinterpret_cast<PRL_UINT16 *>(&nItem));
+				break;
+			case sizeof(PRL_UINT32):
+				setEventTypes.insert(*reinterpret_cast<PRL_UINT32 *>(&nItem));
+				break;
+			default:
+				setEventTypes.insert(PRL_UINT32(nItem));
+				break;
+			}
+		}
+	}
+
+	QSet<QString> setVmUuids;
+	if (pVmUuids)
+	{
+		foreach(const QString &sUuid, pVmUuids->GetStringsList())
+			setVmUuids.insert(Uuid(sUuid).toString());
+	}
+
+	QWriteLocker _lock(&m_Lock);
+	m_setEventTypes = setEventTypes;
+	m_setVmUuids = setVmUuids;
+	return (PRL_ERR_SUCCESS);
+}
+
+bool PrlEventsFilter::Accept(PRL_EVENT_TYPE nEventType, const QString &sVmUuid) const
+{
+	QReadLocker _lock(&m_Lock);
+	if (!m_setEventTypes.isEmpty() && !m_setEventTypes.contains(PRL_UINT32(nEventType)))
+		return (false);
+	if (!m_setVmUuids.isEmpty() && !sVmUuid.isEmpty()
+		&& !m_setVmUuids.contains(sVmUuid))
+		return (false);
+	return (true);
+}
+
+void PrlEventsFilter::CountEvent(bool bDelivered)
+{
+	if (bDelivered)
+		m_nDelivered.fetchAndAddRelaxed(1);
+	else
+		m_nFiltered.fetchAndAddRelaxed(1);
+}
+
+void PrlEventsFilter::GetStat(PRL_UINT64_PTR pnDelivered, PRL_UINT64_PTR pnFiltered) const
+{
+	*pnDelivered = m_nDelivered.loadAcquire();
+	*pnFiltered = m_nFiltered.loadAcquire();
+}
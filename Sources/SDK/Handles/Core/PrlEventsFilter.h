@@ -0,0 +1,99 @@
+/*
+ * PrlEventsFilter.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+
+
+#ifndef __VIRTUOZZO_EVENTS_FILTER_H__
+#define __VIRTUOZZO_EVENTS_FILTER_H__
+
+#include "SDK/Include/PrlTypes.h"
+#include "SDK/Include/PrlEnums.h"
+
+#include <QAtomicInteger>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+
+class PrlHandleOpTypeList;
+class PrlHandleStringsList;
+
+/**
+ * Client side filter of the events received from server.
+ *
+ * Events which do not pass the filter are dropped right after receiving
+ * before any event handle is created and before they are queued to the
+ * notification thread. Empty set of event types or VM UUIDs means no
+ * restriction by that criterion.
+ */
+class PrlEventsFilter
+{
+public:
+	PrlEventsFilter();
+
+	/**
+	 * Sets filter criteria
+	 * @param list of accepted event types (PHT_OPAQUE_TYPE_LIST) or NULL
+	 * @param list of accepted VM UUIDs (PHT_STRINGS_LIST) or NULL
+	 * @return PRL_RESULT. Possible values:
+	 * * PRL_ERR_INVALID_ARG	- wrong list item type size
+	 * * PRL_ERR_SUCCESS		- operation completed successfully
+	 */
+	PRL_RESULT SetFilter(PrlHandleOpTypeList *pEventTypes, PrlHandleStringsList *pVmUuids);
+
+	/**
+	 * Returns sign whether event passes the filter
+	 * @param event type
+	 * @param normalized UUID of the VM event relates to (see Uuid::toString())
+	 *        or empty string for server events
+	 */
+	bool Accept(PRL_EVENT_TYPE nEventType, const QString &sVmUuid) const;
+
+	/**
+	 * Counts received event
+	 * @param sign whether event was delivered or filtered
+	 */
+	void CountEvent(bool bDelivered);
+
+	/**
+	 * Returns numbers of delivered and filtered events
+	 */
+	void GetStat(PRL_UINT64_PTR pnDelivered, PRL_UINT64_PTR pnFiltered) const;
+
+private:
+	/** Filter criteria access synchronization object */
+	mutable QReadWriteLock m_Lock;
+	/** Accepted event types */
+	QSet<PRL_UINT32> m_setEventTypes;
+	/** Accepted VM UUIDs in normalized form */
+	QSet<QString> m_setVmUuids;
+	/** Number of delivered events */
+	QAtomicInteger<quint64> m_nDelivered;
+	/** Number of filtered events */
+	QAtomicInteger<quint64> m_nFiltered;
+};
+
+#endif // __VIRTUOZZO_EVENTS_FILTER_H__
@@ -37,40 +37,28 @@
 
 #include "Build/Current.ver"
 
-static PRL_UINT32 s_UniqueHandle = 0x0000FACE;
 extern PRL_UINT32 g_SdkSequenceNum;
 
-HandlesMap *PrlHandleBase::s_pHandlesMap = new HandlesMap;
-QRecursiveMutex *PrlHandleBase::s_pHandlesMapMutex = new QRecursiveMutex{};
+PrlHandlesTable *PrlHandleBase::s_pHandlesTable = new PrlHandlesTable;
 
 /**
  * Object's constructor is protected to prevent direct
  * object creation in non-inherited blocks of code.
  */
 PrlHandleBase::PrlHandleBase( PRL_HANDLE_TYPE type )
-:	m_HandleType( type )
+:	m_RefCount( 1 ),
+	m_Handle( PRL_INVALID_HANDLE ),
+	m_HandleType( type )
 {
-	QMutexLocker _lock(s_pHandlesMapMutex);
-
 	// Object is always being created with reference count = 1
-	m_RefCount = 1;
-	forever
-	{
-		ULONG_PTR id = (s_UniqueHandle++ | (g_SdkSequenceNum << 29));
-		PRL_HANDLE h = (PRL_HANDLE)id;
-		if (PRL_INVALID_HANDLE != h && !s_pHandlesMap->contains(h))
-		{
-			m_Handle = h;
-			break;
-		}
-	}
 	PrlSdkStatusReader r;
 	if (r.IsSdkInitialized())
 	{
-		// Registering handle in the map of handles
-		(*s_pHandlesMap)[ m_Handle ] = SmartPtr<PrlHandleBase>(this);
+		// Registering handle in the table of handles
+		m_Handle = s_pHandlesTable->Register(SmartPtr<PrlHandleBase>(this), g_SdkSequenceNum);
 	}
-	else
+	// Not registered objects are deleted on the last Release() call
+	if (PRL_INVALID_HANDLE == m_Handle)
 		m_HandleType = (PRL_HANDLE_TYPE)-m_HandleType;
 
 	LOG_MESSAGE( DBG_DEBUG, "OBJ_CREATED: type=%s(%.8X) handle=%.8X this=%.8X",
@@ -114,9 +102,11 @@ PRL_UINT32 PrlHandleBase::Release()
 
 	if ( uOldVal == 1 )
 	{
-		QMutexLocker _lock(s_pHandlesMapMutex);
-		// Removing object from the handles list
-		if (0 == s_pHandlesMap->remove(m_Handle) && m_HandleType < 0)
+		// Removing object from the handles table. Object is destroyed
+		// outside of the table locks as its destructor may release
+		// other handles.
+		SmartPtr<PrlHandleBase> pRegistered = s_pHandlesTable->Take(m_Handle);
+		if (!pRegistered.isValid() && m_HandleType < 0)
 			SmartPtr<PrlHandleBase>(this);
 
 		return 0;
@@ -30,6 +30,7 @@
 
 
 #include "SDK/Include/Virtuozzo.h"
+#include "PrlHandlesTable.h"
 #include <prlcommon/PrlCommonUtilsBase/PrlStringifyConsts.h>
 #include <prlcommon/IOService/IOCommunication/IOProtocol.h>
 
@@ -125,19 +126,13 @@ protected:
 	PRL_HANDLE		m_Handle;
 
 public:
-	/** Statical map holding all handles by their identifiers. */
-	typedef QHash< PRL_HANDLE, SmartPtr<PrlHandleBase> > HandleObjMap;
-	static HandleObjMap *s_pHandlesMap;
-
-	/** Object for synchronizing access to handles list */
-	static QRecursiveMutex *s_pHandlesMapMutex;
+	/** Statical table holding all handles by their identifiers. */
+	static PrlHandlesTable *s_pHandlesTable;
 
 private:
 	PRL_HANDLE_TYPE m_HandleType;
 };
 
-typedef PrlHandleBase::HandleObjMap HandlesMap;
-
 /**
  * Temporary class that can be using in debug cases
  * Must be eliminated at Release stage
@@ -173,10 +168,9 @@ public:
 	{
 		if (pHandle)
 		{
-			QMutexLocker _lock(PrlHandleBase::s_pHandlesMapMutex);
-			HandlesMap::const_iterator it = PrlHandleBase::s_pHandlesMap->find( pHandle->GetHandle() );
-			if (it != PrlHandleBase::s_pHandlesMap->end() && it.value().get() == pHandle)
-				m_pHandle = it.value();
+			SmartPtr<PrlHandleBase> pRegistered = PrlHandleBase::s_pHandlesTable->Find( pHandle->GetHandle() );
+			if (pRegistered.get() == pHandle)
+				m_pHandle = pRegistered;
 		}
 		if (m_pHandle) m_pHandle->AddRef();
 	}
@@ -239,10 +233,9 @@ public:
 		SmartPtr<PrlHandleBase> pWrappedHandle;
 		if (pHandle)
 		{
-			QMutexLocker _lock(PrlHandleBase::s_pHandlesMapMutex);
-			HandlesMap::const_iterator it = PrlHandleBase::s_pHandlesMap->find( pHandle->GetHandle() );
-			if (it != PrlHandleBase::s_pHandlesMap->end() && it.value().get() == pHandle)
-				pWrappedHandle = it.value();
+			SmartPtr<PrlHandleBase> pRegistered = PrlHandleBase::s_pHandlesTable->Find( pHandle->GetHandle() );
+			if (pRegistered.get() == pHandle)
+				pWrappedHandle = pRegistered;
 		}
 		ASSIGN_POINTER(pWrappedHandle)
 		return (*this);
@@ -347,12 +340,25 @@ typedef PrlHandleSmartPtr<class PrlHandleVcmmdConfig> PrlHandleVcmmdConfigPtr;
 template <typename PrlHandleType>
 PrlHandleSmartPtr<PrlHandleType> PRL_OBJECT_BY_HANDLE( PRL_HANDLE handle )
 {
-	QMutexLocker _lock(PrlHandleBase::s_pHandlesMapMutex);
-	HandlesMap::iterator it = PrlHandleBase::s_pHandlesMap->find( handle );
-	if ( it == PrlHandleBase::s_pHandlesMap->end() )
-		return PrlHandleSmartPtr<PrlHandleType>(0);
+	return PrlHandleSmartPtr<PrlHandleType>(PrlHandleBase::s_pHandlesTable->Find( handle ));
+}
+
+/**
+ * Get pointer to the object by handle and verify its type within the same lookup.
+ * Replaces PRL_WRONG_HANDLE() check followed by PRL_OBJECT_BY_HANDLE() call
+ * which takes handles table lock and object reference twice.
+ * @param handle to identify
+ * @param expected type of the handle
+ * @return corresponding object or NULL on wrong handle or handle type
+ */
+template <typename PrlHandleType>
+PrlHandleSmartPtr<PrlHandleType> PRL_OBJECT_BY_HANDLE( PRL_HANDLE handle, PRL_HANDLE_TYPE type )
+{
+	SmartPtr<PrlHandleBase> pObject = PrlHandleBase::s_pHandlesTable->Find( handle );
+	if ( !pObject.isValid() || pObject->GetType() != type )
+		return PrlHandleSmartPtr<PrlHandleType>();
 
-	return PrlHandleSmartPtr<PrlHandleType>(it.value());
+	return PrlHandleSmartPtr<PrlHandleType>(pObject);
 }
 
 /**
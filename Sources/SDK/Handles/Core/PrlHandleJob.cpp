@@ -79,3 +79,34 @@ void PrlHandleJob::SetPackageId( PRL_UINT64 id )
 {
 	m_nRespPackageId = id;
 }
+
+PRL_RESULT PrlHandleJob::AttachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter, PRL_UINT32 nIndex )
+{
+	Q_UNUSED(pWaiter);
+	Q_UNUSED(nIndex);
+	// IO jobs are completed by their own Wait() only
+	return (PRL_ERR_INVALID_ARG);
+}
+
+void PrlHandleJob::DetachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter )
+{
+	Q_UNUSED(pWaiter);
+}
+
+bool PrlHandleJob::IsResultProcessedByCurrentThread()
+{
+	return (false);
+}
+
+PRL_RESULT PrlHandleJob::GetCompletionFd( PRL_INT32_PTR pnFd )
+{
+	Q_UNUSED(pnFd);
+	return (PRL_ERR_UNIMPLEMENTED);
+}
+
+PRL_RESULT PrlHandleJob::SetCompletionCallback( PRL_EVENT_HANDLER_PTR handler, PRL_VOID_PTR userData )
+{
+	Q_UNUSED(handler);
+	Q_UNUSED(userData);
+	return (PRL_ERR_UNIMPLEMENTED);
+}
@@ -30,6 +30,7 @@
 
 
 #include "PrlHandleBase.h"
+#include "PrlJobsWaiter.h"
 
 #define GENERATE_ERROR_HANDLE(error_code, job_type)\
 	craftError(error_code, __FUNCTION__, job_type)
@@ -153,6 +154,48 @@ public:
 	 */
 	virtual PRL_RESULT GetPackageId( PRL_UINT64_PTR id );
 
+	/**
+	 * Attaches waiter which should be signalled on job completion. Waiter
+	 * is signalled immediately if job is already completed.
+	 * @param waiter object
+	 * @param job index which waiter should be signalled with
+	 * @return PRL_RESULT. Possible values:
+	 * * PRL_ERR_INVALID_ARG - job can't be waited for together with other jobs (IO jobs)
+	 * * PRL_ERR_SUCCESS				- operation completed successfully
+	 */
+	virtual PRL_RESULT AttachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter, PRL_UINT32 nIndex );
+
+	/**
+	 * Detaches previously attached waiter
+	 * @param waiter object
+	 */
+	virtual void DetachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter );
+
+	/**
+	 * Returns sign whether job result is processed by event loop of the
+	 * calling thread so waiting thread should process its events
+	 */
+	virtual bool IsResultProcessedByCurrentThread();
+
+	/**
+	 * Returns descriptor which becomes readable on job completion
+	 * @param pointer to buffer for storing result
+	 * @return PRL_RESULT. Possible values:
+	 * * PRL_ERR_UNIMPLEMENTED - object doesn't support functionality
+	 * * PRL_ERR_SUCCESS				- operation completed successfully
+	 */
+	virtual PRL_RESULT GetCompletionFd( PRL_INT32_PTR pnFd );
+
+	/**
+	 * Sets callback which is invoked once on job completion
+	 * @param callback (NULL resets previously set one)
+	 * @param user data passed to the callback
+	 * @return PRL_RESULT. Possible values:
+	 * * PRL_ERR_UNIMPLEMENTED - object doesn't support functionality
+	 * * PRL_ERR_SUCCESS				- operation completed successfully
+	 */
+	virtual PRL_RESULT SetCompletionCallback( PRL_EVENT_HANDLER_PTR handler, PRL_VOID_PTR userData );
+
 	/**
 	 * Set numeric identifier of the response package
 	 * @param numeric identifier of the response package
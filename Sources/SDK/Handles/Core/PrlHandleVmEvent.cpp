@@ -26,6 +26,7 @@
 
 
 #include "PrlHandleVmEvent.h"
+#include "PrlLazyVmEvent.h"
 #include "PrlHandleVm.h"
 #include "PrlHandleServerJob.h"
 #include "PrlHandleEventParam.h"
@@ -76,6 +77,7 @@ QString toHtmlEscaped(const QString &s)
 PrlHandleVmEvent::PrlHandleVmEvent( const PrlHandleServerPtr &pServer, PRL_EVENT_TYPE eType, CVmEvent* pVmEvent )
 : PrlHandleEvent( pServer, eType, pVmEvent ? pVmEvent->getEventId() : 0 ), m_VmEvent(pVmEvent)
 {
+	TakePendingXml(pVmEvent);
 	if (pVmEvent && pServer)
 	{
 		if (pVmEvent->getEventIssuerType() == PIE_VIRTUAL_MACHINE)
@@ -94,17 +96,32 @@ PrlHandleVmEvent::PrlHandleVmEvent( const PrlHandleVmPtr &pVm, CVmEvent *pVmEven
 				  pVmEvent ? pVmEvent->getEventId() : 0),
 				  m_VmEvent(pVmEvent)
 {
+	TakePendingXml(pVmEvent);
 	m_pVm = pVm;
 }
 
 PrlHandleVmEvent::~PrlHandleVmEvent()
 {}
 
+void PrlHandleVmEvent::TakePendingXml(const CVmEvent *pVmEvent)
+{
+	const CLazyVmEvent *pLazyEvent = dynamic_cast<const CLazyVmEvent *>(pVmEvent);
+	if (pLazyEvent)
+		m_sPendingXml = pLazyEvent->GetPendingXml();
+}
+
+CVmEvent &PrlHandleVmEvent::GetEventObject()
+{
+	SYNCHRO_INTERNAL_DATA_ACCESS
+	CLazyVmEvent::Materialize(m_VmEvent, m_sPendingXml);
+	return (m_VmEvent);
+}
+
 
 PRL_RESULT PrlHandleVmEvent::GetDataPtr( PRL_VOID_PTR_PTR data_ptr )
 {
 	SYNCHRO_INTERNAL_DATA_ACCESS
-	char *sBuf = strdup(m_VmEvent.toString().toUtf8().data());
+	char *sBuf = strdup(GetEventObject().toString().toUtf8().data());
 	if (!sBuf) return (PRL_ERR_OUT_OF_MEMORY);
 	*data_ptr = (void *)sBuf;
 	return (PRL_ERR_SUCCESS);
@@ -130,17 +147,17 @@ PRL_RESULT PrlHandleVmEvent::GetJob(PRL_HANDLE_PTR phJob)
 PRL_RESULT PrlHandleVmEvent::GetParamsCount(PRL_UINT32_PTR pnParamsCount)
 {
 	SYNCHRO_INTERNAL_DATA_ACCESS
-	*pnParamsCount = PRL_UINT32(m_VmEvent.m_lstEventParameters.size());
+	*pnParamsCount = PRL_UINT32(GetEventObject().m_lstEventParameters.size());
 	return (PRL_ERR_SUCCESS);
 }
 
 PRL_RESULT PrlHandleVmEvent::GetParam(PRL_UINT32 nIndex, PRL_HANDLE_PTR phEventParam)
 {
 	SYNCHRO_INTERNAL_DATA_ACCESS
-	if (nIndex >= PRL_UINT32(m_VmEvent.m_lstEventParameters.size()))
+	if (nIndex >= PRL_UINT32(GetEventObject().m_lstEventParameters.size()))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleEventParam *pEventParam = new PrlHandleEventParam(PrlHandleVmEventPtr(this), m_VmEvent.m_lstEventParameters.value(nIndex));
+	PrlHandleEventParam *pEventParam = new PrlHandleEventParam(PrlHandleVmEventPtr(this), GetEventObject().m_lstEventParameters.value(nIndex));
 	if (!pEventParam)
 		return (PRL_ERR_OUT_OF_MEMORY);
 
@@ -152,7 +169,7 @@ PRL_RESULT PrlHandleVmEvent::GetParam(PRL_UINT32 nIndex, PRL_HANDLE_PTR phEventP
 PRL_RESULT PrlHandleVmEvent::GetParamByName(PRL_CONST_STR sParamName, PRL_HANDLE_PTR phEventParam)
 {
 	SYNCHRO_INTERNAL_DATA_ACCESS
-	CVmEventParameter *pParam = m_VmEvent.getEventParameter(UTF8_2QSTR(sParamName));
+	CVmEventParameter *pParam = GetEventObject().getEventParameter(UTF8_2QSTR(sParamName));
 	if (!pParam)
 		return (PRL_ERR_NO_DATA);
 
@@ -169,6 +186,7 @@ PRL_RESULT PrlHandleVmEvent::FromString(PRL_CONST_STR sXml)
 {
 	SYNCHRO_INTERNAL_DATA_ACCESS
 
+	m_sPendingXml.clear();
 	foreach(CVmEventParameter *pParam, m_VmEvent.m_lstEventParameters)
 		PrlControlValidity::MarkAsInvalid(pParam);
 
@@ -275,8 +293,9 @@ QString PrlHandleVmEvent::GetErrString(PRL_BOOL bIsBriefMessage, PRL_BOOL bForma
 	if ( !PrlErrStringsStorage::Contains(nErrCode) )
         return UTF8_2QSTR(PRL_RESULT_TO_STRING(nErrCode)) ;
 
-    QString result = PrlErrStringsStorage::GetErrString( nErrCode, bIsBriefMessage, bFormated==PRL_TRUE, &m_VmEvent );
-    ReplaceParams(result, m_VmEvent) ;
+	CVmEvent &_event = GetEventObject();
+    QString result = PrlErrStringsStorage::GetErrString( nErrCode, bIsBriefMessage, bFormated==PRL_TRUE, &_event );
+    ReplaceParams(result, _event) ;
 #ifdef _DEBUG
     static const QRegExp arg_param("[^%]?(%[0-9]+)[^0-9]?") ;
     if (result.indexOf(arg_param, 0)!=-1)
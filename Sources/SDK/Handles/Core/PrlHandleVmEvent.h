@@ -222,11 +222,18 @@ public:
 	 */
 	inline QRecursiveMutex *GetSynchroObject() {return (&m_HandleMutex);}
 	/**
-	 * Returns reference to internal VM event object for external usage
+	 * Returns reference to internal VM event object for external usage.
+	 * Event received from server is parsed in full on the first call.
 	 */
-	inline CVmEvent &GetEventObject() {return (m_VmEvent);}
+	CVmEvent &GetEventObject();
 
 private:
+	/**
+	 * Keeps not parsed yet XML representation of the lazy event
+	 * (see CLazyVmEvent for details)
+	 */
+	void TakePendingXml(const CVmEvent *pVmEvent);
+
 	QString GetErrString(PRL_BOOL bIsBriefMessage, PRL_BOOL bFormated) ;
 
 	QString& ReplaceParams(QString &result, CVmEvent &event);
@@ -239,6 +246,8 @@ private:
 private:
 	/// Storing VM event object
 	CVmEvent m_VmEvent;
+	/// Not parsed yet VM event UTF-8 XML representation (parameters are not filled)
+	QByteArray m_sPendingXml;
 	QString err_string ;
 };
 
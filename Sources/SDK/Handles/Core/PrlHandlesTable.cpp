@@ -0,0 +1,204 @@
+/*
+ * PrlHandlesTable.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "PrlHandlesTable.h"
+#include "PrlHandleBase.h"
+
+#include <prlcommon/Logging/Logging.h>
+
+PrlHandlesTable::PrlHandlesTable()
+: m_nNextShard(0)
+{}
+
+PRL_HANDLE PrlHandlesTable::Encode(PRL_UINT32 nSequenceNum, PRL_UINT32 nGeneration,
+								   PRL_UINT32 nShard, PRL_UINT32 nSlot)
+{
+	ULONG_PTR id = (nSequenceNum << SequenceShift)
+		| ((nGeneration & GenerationMask) << (SlotBits + ShardBits))
+		| ((nShard & ShardMask) << SlotBits)
+		| (nSlot & SlotMask);
+	return (PRL_HANDLE)id;
+}
+
+void PrlHandlesTable::ReleaseSlot(Shard &s, PRL_UINT32 nSlot)
+{
+	Slot &slot = s.vSlots[nSlot];
+	slot.pObject = SmartPtr<PrlHandleBase>();
+	if (slot.nGeneration < PRL_UINT32(GenerationMask))
+	{
+		++slot.nGeneration;
+		s.qFreeSlots.enqueue(nSlot);
+		return;
+	}
+	// Wrapped generation would make handles freed long ago valid again.
+	// Zero generation is reserved to keep handle values non null.
+	slot.nGeneration = 1;
+	s.qRetiredSlots.enqueue(nSlot);
+}
+
+PRL_HANDLE PrlHandlesTable::Register(const SmartPtr<PrlHandleBase> &pObject, PRL_UINT32 nSequenceNum)
+{
+	PRL_UINT32 nFirstShard = PRL_UINT32(m_nNextShard.fetchAndAddRelaxed(1)) & ShardMask;
+	// Retired slots are recycled as the last resort only
+	for (int nPass = 0; nPass < 2; ++nPass)
+	{
+		for (PRL_UINT32 i = 0; i < ShardsCount; ++i)
+		{
+			PRL_HANDLE h = RegisterInShard((nFirstShard + i) & ShardMask, pObject,
+										   nSequenceNum, nPass != 0);
+			if (PRL_INVALID_HANDLE != h)
+				return h;
+		}
+	}
+
+	WRITE_TRACE(DBG_FATAL, "Handles table is full: %u handles registered", Count());
+	return PRL_INVALID_HANDLE;
+}
+
+PRL_HANDLE PrlHandlesTable::RegisterInShard(PRL_UINT32 nShard,
+											const SmartPtr<PrlHandleBase> &pObject,
+											PRL_UINT32 nSequenceNum,
+											bool bRecycleRetired)
+{
+	Shard &s = m_Shards[nShard];
+	QWriteLocker _lock(&s.lock);
+
+	PRL_UINT32 nSlot;
+	if (!s.qFreeSlots.isEmpty())
+		nSlot = s.qFreeSlots.dequeue();
+	else if (PRL_UINT32(s.vSlots.size()) < PRL_UINT32(MaxSlotsPerShard))
+	{
+		nSlot = s.vSlots.size();
+		s.vSlots.append(Slot());
+	}
+	else if (bRecycleRetired && !s.qRetiredSlots.isEmpty())
+		nSlot = s.qRetiredSlots.dequeue();
+	else
+		return PRL_INVALID_HANDLE;
+
+	Slot &slot = s.vSlots[nSlot];
+	slot.pObject = pObject;
+	++s.nCount;
+
+	return Encode(nSequenceNum, slot.nGeneration, nShard, nSlot);
+}
+
+SmartPtr<PrlHandleBase> PrlHandlesTable::Find(PRL_HANDLE handle) const
+{
+	ULONG_PTR id = (ULONG_PTR)handle;
+	PRL_UINT32 nSlot = id & SlotMask;
+	const Shard &s = m_Shards[(id >> SlotBits) & ShardMask];
+
+	QReadLocker _lock(&s.lock);
+	if (nSlot >= PRL_UINT32(s.vSlots.size()))
+		return SmartPtr<PrlHandleBase>();
+
+	const Slot &slot = s.vSlots.at(nSlot);
+	if (!slot.pObject.isValid() || slot.pObject->GetHandle() != handle)
+		return SmartPtr<PrlHandleBase>();
+
+	return slot.pObject;
+}
+
+SmartPtr<PrlHandleBase> PrlHandlesTable::Take(PRL_HANDLE handle)
+{
+	SmartPtr<PrlHandleBase> pObject;
+	if (PRL_INVALID_HANDLE == handle)
+		return pObject;
+
+	ULONG_PTR id = (ULONG_PTR)handle;
+	PRL_UINT32 nSlot = id & SlotMask;
+	Shard &s = m_Shards[(id >> SlotBits) & ShardMask];
+
+	QWriteLocker _lock(&s.lock);
+	if (nSlot >= PRL_UINT32(s.vSlots.size()))
+		return pObject;
+
+	Slot &slot = s.vSlots[nSlot];
+	if (!slot.pObject.isValid() || slot.pObject->GetHandle() != handle)
+		return pObject;
+
+	pObject = slot.pObject;
+	ReleaseSlot(s, nSlot);
+	--s.nCount;
+
+	return pObject;
+}
+
+QList<SmartPtr<PrlHandleBase> > PrlHandlesTable::TakeAll()
+{
+	QList<SmartPtr<PrlHandleBase> > lstObjects;
+	for (PRL_UINT32 i = 0; i < ShardsCount; ++i)
+	{
+		Shard &s = m_Shards[i];
+		QWriteLocker _lock(&s.lock);
+		for (int nSlot = 0; nSlot < s.vSlots.size(); ++nSlot)
+		{
+			Slot &slot = s.vSlots[nSlot];
+			if (!slot.pObject.isValid())
+				continue;
+
+			lstObjects.append(slot.pObject);
+			ReleaseSlot(s, nSlot);
+		}
+		s.nCount = 0;
+	}
+	return lstObjects;
+}
+
+QList<SmartPtr<PrlHandleBase> > PrlHandlesTable::Snapshot() const
+{
+	QList<SmartPtr<PrlHandleBase> > lstObjects;
+	for (PRL_UINT32 i = 0; i < ShardsCount; ++i)
+	{
+		const Shard &s = m_Shards[i];
+		QReadLocker _lock(&s.lock);
+		foreach(const Slot &slot, s.vSlots)
+		{
+			if (slot.pObject.isValid())
+				lstObjects.append(slot.pObject);
+		}
+	}
+	return lstObjects;
+}
+
+PRL_UINT32 PrlHandlesTable::Count() const
+{
+	PRL_UINT32 nCount = 0;
+	for (PRL_UINT32 i = 0; i < ShardsCount; ++i)
+	{
+		const Shard &s = m_Shards[i];
+		QReadLocker _lock(&s.lock);
+		nCount += s.nCount;
+	}
+	return nCount;
+}
+
+bool PrlHandlesTable::IsEmpty() const
+{
+	return (0 == Count());
+}
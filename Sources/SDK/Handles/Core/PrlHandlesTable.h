@@ -0,0 +1,165 @@
+/*
+ * PrlHandlesTable.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_HANDLES_TABLE_H__
+#define __VIRTUOZZO_HANDLES_TABLE_H__
+
+#include "SDK/Include/Virtuozzo.h"
+
+#include <QAtomicInt>
+#include <QList>
+#include <QQueue>
+#include <QReadWriteLock>
+#include <QVector>
+
+#include <prlcommon/Std/SmartPtr.h>
+
+class PrlHandleBase;
+
+/**
+ * Table of all registered handle objects.
+ *
+ * Handle value is not a key of hash anymore but a self describing slot
+ * reference:
+ *
+ *   31..29  SDK sequence number (see g_SdkSequenceNum)
+ *   28..18  slot generation (never 0, so the handle is never PRL_INVALID_HANDLE)
+ *   17..14  shard index
+ *   13..0   slot index inside the shard
+ *
+ * Lookup is an array index plus generation check under the shard read lock,
+ * so concurrent lookups never block each other and lookups of handles from
+ * different shards do not even touch the same lock. Generation is bumped each
+ * time slot is freed so stale handles are detected. Freed slots are reused in
+ * FIFO order. Slot which has used up its generations is retired instead of
+ * wrapping, and is recycled only when all shards are full otherwise.
+ *
+ * Table never destroys handle objects under its locks: removed objects are
+ * returned to the caller which drops them after all locks were released.
+ */
+class PrlHandlesTable
+{
+public:
+	enum
+	{
+		SlotBits = 14,
+		ShardBits = 4,
+		GenerationBits = 11,
+		SequenceShift = SlotBits + ShardBits + GenerationBits,
+
+		ShardsCount = 1 << ShardBits,
+		MaxSlotsPerShard = 1 << SlotBits,
+		SlotMask = MaxSlotsPerShard - 1,
+		ShardMask = ShardsCount - 1,
+		GenerationMask = (1 << GenerationBits) - 1,
+	};
+
+	PrlHandlesTable();
+
+	/**
+	 * Registers object in the table.
+	 * @param registering object
+	 * @param SDK sequence number to encode in the handle value
+	 * @return handle value or PRL_INVALID_HANDLE if table is full
+	 */
+	PRL_HANDLE Register(const SmartPtr<PrlHandleBase> &pObject, PRL_UINT32 nSequenceNum);
+
+	/**
+	 * Looks for the object by handle.
+	 * @param handle to identify
+	 * @return corresponding object or invalid pointer for wrong or stale handle
+	 */
+	SmartPtr<PrlHandleBase> Find(PRL_HANDLE handle) const;
+
+	/**
+	 * Removes object from the table.
+	 * @param handle of removing object
+	 * @return removed object or invalid pointer if handle was not registered.
+	 * Caller is responsible to drop it without holding any handles locks.
+	 */
+	SmartPtr<PrlHandleBase> Take(PRL_HANDLE handle);
+
+	/**
+	 * Removes all objects from the table.
+	 * @return list of all removed objects
+	 */
+	QList<SmartPtr<PrlHandleBase> > TakeAll();
+
+	/**
+	 * Returns consistent per shard copy of all registered objects.
+	 */
+	QList<SmartPtr<PrlHandleBase> > Snapshot() const;
+
+	/**
+	 * Returns number of registered objects.
+	 */
+	PRL_UINT32 Count() const;
+
+	/**
+	 * Returns whether there are no registered objects.
+	 */
+	bool IsEmpty() const;
+
+private:
+	struct Slot
+	{
+		Slot() : nGeneration(1) {}
+
+		SmartPtr<PrlHandleBase> pObject;
+		PRL_UINT32 nGeneration;
+	};
+
+	struct Shard
+	{
+		Shard() : nCount(0) {}
+
+		mutable QReadWriteLock lock;
+		QVector<Slot> vSlots;
+		QQueue<PRL_UINT32> qFreeSlots;
+		/** Slots with used up generations */
+		QQueue<PRL_UINT32> qRetiredSlots;
+		PRL_UINT32 nCount;
+	};
+
+	static PRL_HANDLE Encode(PRL_UINT32 nSequenceNum, PRL_UINT32 nGeneration,
+							 PRL_UINT32 nShard, PRL_UINT32 nSlot);
+
+	/** Bumps generation of the freed slot and puts it to the free or retired slots */
+	static void ReleaseSlot(Shard &s, PRL_UINT32 nSlot);
+
+	PRL_HANDLE RegisterInShard(PRL_UINT32 nShard,
+							   const SmartPtr<PrlHandleBase> &pObject,
+							   PRL_UINT32 nSequenceNum,
+							   bool bRecycleRetired);
+
+private:
+	Shard m_Shards[ShardsCount];
+	/** Round robin shard selector for new handles */
+	QAtomicInt m_nNextShard;
+};
+
+#endif // __VIRTUOZZO_HANDLES_TABLE_H__
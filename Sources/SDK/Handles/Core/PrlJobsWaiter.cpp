@@ -0,0 +1,93 @@
+/*
+ * PrlJobsWaiter.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "PrlJobsWaiter.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <climits>
+
+PrlJobsWaiter::PrlJobsWaiter(Mode nMode, PRL_UINT32 nJobsCount)
+: m_nMode(nMode), m_nFirstCompleted(-1), m_nPending(nJobsCount)
+{}
+
+void PrlJobsWaiter::Completed(PRL_UINT32 nIndex)
+{
+	QMutexLocker _lock(&m_Mutex);
+	bool bFirst = (m_nFirstCompleted < 0);
+	if (bFirst)
+		m_nFirstCompleted = int(nIndex);
+	if (m_nPending)
+		--m_nPending;
+
+	// Waiting thread is interested in the satisfying completion only
+	if ((WaitAny == m_nMode && bFirst) || (WaitAll == m_nMode && !m_nPending))
+		m_Condition.wakeAll();
+}
+
+bool PrlJobsWaiter::IsSatisfied() const
+{
+	return (WaitAny == m_nMode ? m_nFirstCompleted >= 0 : !m_nPending);
+}
+
+bool PrlJobsWaiter::Wait(PRL_UINT32 nTimeoutMs, bool bProcessEvents)
+{
+	QElapsedTimer _timer;
+	_timer.start();
+
+	QMutexLocker _lock(&m_Mutex);
+	while (!IsSatisfied())
+	{
+		unsigned long nWaitMs = ULONG_MAX;
+		if (nTimeoutMs != UINT_MAX)
+		{
+			qint64 nElapsed = _timer.elapsed();
+			if (nElapsed >= qint64(nTimeoutMs))
+				break;
+			nWaitMs = (unsigned long)(qint64(nTimeoutMs) - nElapsed);
+		}
+
+		if (bProcessEvents)
+		{
+			//Special case to prevent block of event loop owner thread which processes jobs results
+			_lock.unlock();
+			QCoreApplication::processEvents();
+			_lock.relock();
+			if (IsSatisfied())
+				break;
+			nWaitMs = qMin(nWaitMs, 50UL);
+		}
+		m_Condition.wait(&m_Mutex, nWaitMs);
+	}
+	return IsSatisfied();
+}
+
+int PrlJobsWaiter::GetFirstCompleted()
+{
+	QMutexLocker _lock(&m_Mutex);
+	return m_nFirstCompleted;
+}
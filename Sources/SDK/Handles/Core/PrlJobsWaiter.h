@@ -0,0 +1,91 @@
+/*
+ * PrlJobsWaiter.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_JOBS_WAITER_H__
+#define __VIRTUOZZO_JOBS_WAITER_H__
+
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "SDK/Include/PrlTypes.h"
+
+/**
+ * Waiter of completion of any or all jobs from a set. Each job signals
+ * the waiter on its completion with own index in the set, so waiter never
+ * rescans the jobs and waiting thread is woken up only once the wait
+ * condition is satisfied.
+ */
+class PrlJobsWaiter
+{
+public:
+	enum Mode
+	{
+		WaitAny,
+		WaitAll,
+	};
+
+	/**
+	 * Class constructor
+	 * @param wait mode
+	 * @param number of jobs in the set
+	 */
+	PrlJobsWaiter(Mode nMode, PRL_UINT32 nJobsCount);
+
+	/**
+	 * Signals completion of the job
+	 * @param index of the job in the set
+	 */
+	void Completed(PRL_UINT32 nIndex);
+
+	/**
+	 * Waits until condition is satisfied
+	 * @param timeout in msecs, UINT_MAX to wait forever
+	 * @param sign whether calling thread should process its events while
+	 * waiting as job results are processed by its event loop
+	 * @return sign whether condition was satisfied
+	 */
+	bool Wait(PRL_UINT32 nTimeoutMs, bool bProcessEvents);
+
+	/**
+	 * Returns index of the first completed job or -1
+	 */
+	int GetFirstCompleted();
+
+private:
+	bool IsSatisfied() const;
+
+private:
+	Mode m_nMode;
+	QMutex m_Mutex;
+	QWaitCondition m_Condition;
+	/** Index of the first completed job */
+	int m_nFirstCompleted;
+	/** Number of not completed jobs */
+	PRL_UINT32 m_nPending;
+};
+
+#endif // __VIRTUOZZO_JOBS_WAITER_H__
@@ -0,0 +1,102 @@
+/*
+ * PrlLazyVmEvent.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+
+
+#include "PrlLazyVmEvent.h"
+
+#include <QXmlStreamReader>
+
+#include <prlcommon/Interfaces/ParallelsDomModel.h>
+#include <prlcommon/Logging/Logging.h>
+
+CLazyVmEvent::CLazyVmEvent(const QByteArray &sXml)
+{
+	if (ParseHeader(sXml))
+		m_sPendingXml = sXml;
+	else if (PRL_FAILED(fromString(UTF8_2QSTR(sXml.constData()))))
+		WRITE_TRACE(DBG_FATAL, "Couldn't to parse VM event XML representation");
+}
+
+bool CLazyVmEvent::ParseHeader(const QByteArray &sXml)
+{
+	// Header fields are plain child elements of the root preceding the
+	// parameters list. Reading stops at the parameters list, so the rest
+	// of the document is neither decoded nor tokenized.
+	QXmlStreamReader _reader(sXml);
+	if (!_reader.readNextStartElement())
+		return (false);
+
+	bool bTypeFound = false;
+	while (_reader.readNextStartElement())
+	{
+		const QStringRef sName = _reader.name();
+		if (sName == XML_VM_EVENT_EL_PARAMETERS)
+			break;
+
+		bool bOk = true;
+		if (sName == XML_VM_EVENT_EL_TYPE)
+		{
+			setEventType((PRL_EVENT_TYPE)_reader.readElementText().toUInt(&bOk));
+			bTypeFound = bOk;
+		}
+		else if (sName == XML_VM_EVENT_EL_LEVEL)
+			setEventLevel((PVE::VmEventLevel)_reader.readElementText().toUInt(&bOk));
+		else if (sName == XML_VM_EVENT_EL_CODE)
+			setEventCode((PRL_RESULT)_reader.readElementText().toLongLong(&bOk));
+		else if (sName == XML_VM_EVENT_EL_NEED_RESPONSE)
+			setRespRequired((PVE::VmEventRespOption)_reader.readElementText().toUInt(&bOk));
+		else if (sName == XML_VM_EVENT_EL_ISSUER_TYPE)
+			setEventIssuerType((PRL_EVENT_ISSUER_TYPE)_reader.readElementText().toUInt(&bOk));
+		else if (sName == XML_VM_EVENT_EL_ISSUER_ID)
+			setEventIssuerId(_reader.readElementText());
+		else if (sName == XML_VM_EVENT_EL_INIT_REQUEST_ID)
+			setInitRequestId(_reader.readElementText());
+		else
+			_reader.skipCurrentElement();
+
+		// Unexpected representation is parsed in full
+		if (!bOk)
+			return (false);
+	}
+
+	return (bTypeFound && !_reader.hasError());
+}
+
+void CLazyVmEvent::Materialize(CVmEvent &event, QByteArray &sPendingXml)
+{
+	if (sPendingXml.isEmpty())
+		return;
+
+	QString sInitRequestId = event.getInitRequestId();
+	quint32 nEventId = event.getEventId();
+	if (PRL_FAILED(event.fromString(UTF8_2QSTR(sPendingXml.constData()))))
+		WRITE_TRACE(DBG_FATAL, "Couldn't to parse VM event XML representation");
+	event.setInitRequestId(sInitRequestId);
+	event.setEventId(nEventId);
+	sPendingXml.clear();
+}
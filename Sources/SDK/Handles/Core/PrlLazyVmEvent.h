@@ -0,0 +1,86 @@
+/*
+ * PrlLazyVmEvent.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+
+
+#ifndef __VIRTUOZZO_LAZY_VM_EVENT_H__
+#define __VIRTUOZZO_LAZY_VM_EVENT_H__
+
+#include <prlcommon/Messaging/CVmEvent.h>
+
+/**
+ * VM event received from server which parameters are not parsed yet.
+ *
+ * Only header fields of the event (type, code, issuer, request id and so on)
+ * preceding its parameters list are decoded at once. Received UTF-8 XML
+ * representation is kept as is and decoded and parsed on the first access to
+ * the event parameters, so events which are just routed by type never build
+ * parameters tree.
+ */
+class CLazyVmEvent : public CVmEvent
+{
+public:
+	/**
+	 * Class constructor. Decodes event header from XML representation.
+	 * If header couldn't be decoded event is parsed in full at once.
+	 * @param event UTF-8 XML representation
+	 */
+	explicit CLazyVmEvent(const QByteArray &sXml);
+
+	/**
+	 * Returns not parsed yet UTF-8 XML representation of the event or empty
+	 * array if event was parsed in full.
+	 */
+	const QByteArray &GetPendingXml() const { return m_sPendingXml; }
+
+	/**
+	 * Parses event in full if it was not parsed yet
+	 */
+	void Materialize() { Materialize(*this, m_sPendingXml); }
+
+	/**
+	 * Parses pending XML representation to the event object keeping its
+	 * header fields which were set after receiving (event and request ids).
+	 * @param event object with decoded header
+	 * @param pending UTF-8 XML representation. Cleared on return.
+	 */
+	static void Materialize(CVmEvent &event, QByteArray &sPendingXml);
+
+private:
+	/**
+	 * Decodes event header to this object
+	 * @param event UTF-8 XML representation
+	 * @return sign whether header was decoded
+	 */
+	bool ParseHeader(const QByteArray &sXml);
+
+private:
+	/** Not parsed yet event UTF-8 XML representation */
+	QByteArray m_sPendingXml;
+};
+
+#endif // __VIRTUOZZO_LAZY_VM_EVENT_H__
@@ -0,0 +1,280 @@
+/*
+ * PrlRequestsPerf.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "PrlRequestsPerf.h"
+#include "Libraries/ContextSwitcher/ContextSwitcher.h"
+
+#include <QtAlgorithms>
+#include <algorithm>
+#include <string.h>
+
+#ifdef ENABLE_MALLOC_DEBUG
+    // By adding this interface we enable allocations tracing in the module
+    #include "Interfaces/Debug.h"
+#else
+    // We're not allowed to throw exceptions from the library -
+    // so we need to prevent operator ::new from doing this
+    #include <new>
+    using std::nothrow;
+    #define new new(nothrow)
+#endif
+
+Q_GLOBAL_STATIC(PrlRequestsPerf, getRequestsPerf)
+
+PrlRequestsPerf::PrlRequestsPerf()
+{
+	m_Clock.start();
+}
+
+PrlRequestsPerf::~PrlRequestsPerf()
+{
+	qDeleteAll(m_Counters);
+}
+
+qint64 PrlRequestsPerf::Now()
+{
+	PrlRequestsPerf *p = getRequestsPerf();
+	return (p ? p->m_Clock.nsecsElapsed() : 0);
+}
+
+void PrlRequestsPerf::RequestHeld(const PrlUuidKey &key, quint32 nOpCode)
+{
+	PrlRequestsPerf *p = getRequestsPerf();
+	if (!p || key.isNull())
+		return;
+
+	// Held request is sent later by another call, so the switch is accounted now
+	Counters *pCounters = p->GetCommandCounters(nOpCode);
+	if (pCounters)
+		p->RecordSwitch(pCounters);
+
+	if (p->m_Held.insert(key, p->m_Clock.nsecsElapsed()))
+		p->m_nHeld.ref();
+}
+
+void PrlRequestsPerf::RequestSent(const PrlUuidKey &key, quint32 nOpCode)
+{
+	PrlRequestsPerf *p = getRequestsPerf();
+	if (!p || key.isNull())
+		return;
+
+	Counters *pCounters = p->GetCommandCounters(nOpCode);
+	if (!pCounters)
+		return;
+
+	qint64 nNow = p->m_Clock.nsecsElapsed();
+	qint64 nHeldTime;
+	// Most requests are sent directly, so the held map is not locked for them
+	if (p->m_nHeld.loadAcquire() > 0 && p->m_Held.take(key, nHeldTime))
+	{
+		p->m_nHeld.deref();
+		p->Record(pCounters, PRQS_QUEUE, nHeldTime, nNow);
+	}
+	else
+		p->RecordSwitch(pCounters);
+
+	if (p->m_Requests.insert(key, Request(nOpCode, nNow)))
+		pCounters->nInFlight.ref();
+}
+
+void PrlRequestsPerf::ResponsePosted(const PrlUuidKey &key, qint64 nReceivedTime)
+{
+	PrlRequestsPerf *p = getRequestsPerf();
+	if (!p)
+		return;
+
+	Request r;
+	if (!p->m_Requests.find(key, [&r](const Request &_r) { r = _r; }))
+		return;
+
+	Counters *pCounters = p->GetCommandCounters(r.nOpCode);
+	if (!pCounters)
+		return;
+
+	qint64 nNow = p->m_Clock.nsecsElapsed();
+	p->Record(pCounters, PRQS_WIRE, r.nTime, nReceivedTime);
+	p->Record(pCounters, PRQS_PARSE, nReceivedTime, nNow);
+	if (p->m_Posted.insert(key, Request(r.nOpCode, nNow)))
+		p->m_nPosted.ref();
+}
+
+void PrlRequestsPerf::ResponseDelivered(const PrlUuidKey &key)
+{
+	PrlRequestsPerf *p = getRequestsPerf();
+	if (!p || p->m_nPosted.loadAcquire() <= 0)
+		return;
+
+	Request r;
+	if (!p->m_Posted.take(key, r))
+		return;
+	p->m_nPosted.deref();
+
+	Counters *pCounters = p->GetCommandCounters(r.nOpCode);
+	if (pCounters)
+		p->Record(pCounters, PRQS_DELIVER, r.nTime, p->m_Clock.nsecsElapsed());
+}
+
+void PrlRequestsPerf::RequestFinished(const PrlUuidKey &key)
+{
+	PrlRequestsPerf *p = getRequestsPerf();
+	if (!p || key.isNull())
+		return;
+
+	if (p->m_nHeld.loadAcquire() > 0 && p->m_Held.remove(key))
+		p->m_nHeld.deref();
+
+	Request r;
+	if (!p->m_Requests.take(key, r))
+		return;
+
+	Counters *pCounters = p->GetCommandCounters(r.nOpCode);
+	if (pCounters)
+		pCounters->nInFlight.deref();
+}
+
+QList<PRL_REQUEST_PERF_COUNTER> PrlRequestsPerf::GetCounters()
+{
+	QList<PRL_REQUEST_PERF_COUNTER> lstCounters;
+	PrlRequestsPerf *p = getRequestsPerf();
+	if (!p)
+		return lstCounters;
+
+	QReadLocker _lock(&p->m_CountersLock);
+	QList<quint32> lstOpCodes = p->m_Counters.keys();
+	std::sort(lstOpCodes.begin(), lstOpCodes.end());
+	foreach(quint32 nOpCode, lstOpCodes)
+	{
+		const Counters *pCounters = p->m_Counters.value(nOpCode);
+		for (int nStage = 0; nStage <= PRQS_MAX; ++nStage)
+		{
+			const Histogram &h = pCounters->aStages[nStage];
+
+			PRL_REQUEST_PERF_COUNTER c;
+			::memset(&c, 0, sizeof(c));
+			c.nOpCode = nOpCode;
+			c.nStage = nStage;
+			c.nCount = h.nCount.loadRelaxed();
+			c.nTotalTime = h.nTotal.loadRelaxed();
+			c.nMaxTime = h.nMax.loadRelaxed();
+			c.nInFlight = qMax(0, pCounters->nInFlight.loadRelaxed());
+
+			// Buckets are copied as they are updated concurrently
+			quint32 aBuckets[BucketsCount];
+			quint64 nTotal = 0;
+			for (int i = 0; i < BucketsCount; ++i)
+				nTotal += (aBuckets[i] = h.aBuckets[i].loadRelaxed());
+
+			const int aPercents[] = { 50, 90, 99 };
+			PRL_UINT64 *aResults[] = { &c.nP50Time, &c.nP90Time, &c.nP99Time };
+			for (int i = 0; i < 3 && nTotal; ++i)
+			{
+				quint64 nRank = (nTotal * aPercents[i] + 99) / 100;
+				quint64 nSeen = 0;
+				int nBucket = 0;
+				// The last bucket holds all too long values, so its limit is the maximum
+				for (; nBucket < BucketsCount - 1; ++nBucket)
+				{
+					nSeen += aBuckets[nBucket];
+					if (nSeen >= nRank)
+						break;
+				}
+				*aResults[i] = (nBucket < BucketsCount - 1)
+					? qMin(GetBucketLimit(nBucket), c.nMaxTime) : c.nMaxTime;
+			}
+
+			lstCounters.append(c);
+		}
+	}
+	return lstCounters;
+}
+
+int PrlRequestsPerf::GetBucket(quint64 nValue)
+{
+	if (nValue < LinearBucketsCount)
+		return int(nValue);
+
+	int nBits = 64 - qCountLeadingZeroBits(nValue);
+	if (nBits > MaxValueBits)
+		return BucketsCount - 1;
+
+	// Top bits after the leading one select the sub-bucket
+	int nShift = nBits - SubBucketBits - 1;
+	return LinearBucketsCount + (nShift - 1) * SubBucketsCount
+		+ int((nValue >> nShift) & (SubBucketsCount - 1));
+}
+
+quint64 PrlRequestsPerf::GetBucketLimit(int nBucket)
+{
+	if (nBucket < LinearBucketsCount)
+		return quint64(nBucket);
+
+	int nShift = (nBucket - LinearBucketsCount) / SubBucketsCount + 1;
+	int nSubBucket = (nBucket - LinearBucketsCount) % SubBucketsCount;
+	return ((quint64(SubBucketsCount + nSubBucket + 1)) << nShift) - 1;
+}
+
+PrlRequestsPerf::Counters *PrlRequestsPerf::GetCommandCounters(quint32 nOpCode)
+{
+	{
+		QReadLocker _lock(&m_CountersLock);
+		Counters *pCounters = m_Counters.value(nOpCode);
+		if (pCounters)
+			return pCounters;
+	}
+
+	QWriteLocker _lock(&m_CountersLock);
+	Counters *pCounters = m_Counters.value(nOpCode);
+	if (pCounters)
+		return pCounters;
+
+	pCounters = new Counters;
+	if (pCounters)
+		m_Counters.insert(nOpCode, pCounters);
+	return pCounters;
+}
+
+void PrlRequestsPerf::Record(Counters *pCounters, PRL_REQUEST_STAGE nStage, qint64 nStart, qint64 nEnd)
+{
+	quint64 nValue = nEnd > nStart ? quint64(nEnd - nStart) / 1000 : 0;
+	Histogram &h = pCounters->aStages[nStage];
+
+	h.nCount.fetchAndAddRelaxed(1);
+	h.nTotal.fetchAndAddRelaxed(nValue);
+	h.aBuckets[GetBucket(nValue)].fetchAndAddRelaxed(1);
+
+	quint64 nMax = h.nMax.loadRelaxed();
+	while (nValue > nMax && !h.nMax.testAndSetRelaxed(nMax, nValue, nMax))
+		;
+}
+
+void PrlRequestsPerf::RecordSwitch(Counters *pCounters)
+{
+	// Requests sent by direct calls are not switched
+	qint64 nQueueTime = ContextSwitcher::GetCurrentCallQueueTime();
+	if (nQueueTime >= 0)
+		Record(pCounters, PRQS_SWITCH, 0, nQueueTime);
+}
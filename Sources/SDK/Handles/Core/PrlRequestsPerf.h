@@ -0,0 +1,155 @@
+/*
+ * PrlRequestsPerf.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_REQUESTS_PERF_H__
+#define __VIRTUOZZO_REQUESTS_PERF_H__
+
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+
+#include "SDK/Include/PrlIOStructs.h"
+#include "PrlUuidMap.h"
+
+/**
+ * Client side requests latency counters. Time of each request processing
+ * stage is accounted in the log-linear histogram of its protocol command,
+ * so recording costs a few atomic increments and is kept always on.
+ * Requests are tracked by their job UUID from sending until completion.
+ */
+class PrlRequestsPerf
+{
+public:
+	PrlRequestsPerf();
+	~PrlRequestsPerf();
+
+	/**
+	 * Returns monotonic time in nanoseconds stages are measured with
+	 */
+	static qint64 Now();
+	/**
+	 * Marks request held by the SDK instead of sending it (requests queue
+	 * or batch)
+	 * @param request job UUID
+	 * @param protocol command code
+	 */
+	static void RequestHeld(const PrlUuidKey &key, quint32 nOpCode);
+	/**
+	 * Marks request passed to the transport
+	 * @param request job UUID
+	 * @param protocol command code
+	 */
+	static void RequestSent(const PrlUuidKey &key, quint32 nOpCode);
+	/**
+	 * Marks response parsed and posted to the events handler
+	 * @param request job UUID
+	 * @param time response was received at
+	 */
+	static void ResponsePosted(const PrlUuidKey &key, qint64 nReceivedTime);
+	/**
+	 * Marks posted response reached the events handler
+	 * @param request job UUID
+	 */
+	static void ResponseDelivered(const PrlUuidKey &key);
+	/**
+	 * Stops tracking of completed or dropped request
+	 * @param request job UUID
+	 */
+	static void RequestFinished(const PrlUuidKey &key);
+	/**
+	 * Returns counters snapshot of all stages of all sent commands
+	 */
+	static QList<PRL_REQUEST_PERF_COUNTER> GetCounters();
+
+private:
+	enum
+	{
+		/** Sub-buckets per power of two bits (relative error is 1/8) */
+		SubBucketBits = 3,
+		SubBucketsCount = 1 << SubBucketBits,
+		/** Values below are counted exactly */
+		LinearBucketsCount = SubBucketsCount << 1,
+		/** Values starting from 2^40 us (about 12 days) are not split */
+		MaxValueBits = 40,
+		BucketsCount = LinearBucketsCount
+			+ (MaxValueBits - SubBucketBits - 1) * SubBucketsCount,
+	};
+
+	/** Stage time histogram, in microseconds */
+	struct Histogram
+	{
+		QAtomicInteger<quint64> nCount;
+		QAtomicInteger<quint64> nTotal;
+		QAtomicInteger<quint64> nMax;
+		QAtomicInteger<quint32> aBuckets[BucketsCount];
+	};
+
+	/** Counters of the protocol command */
+	struct Counters
+	{
+		Histogram aStages[PRQS_MAX + 1];
+		/** Number of requests sent and not finished yet */
+		QAtomicInt nInFlight;
+	};
+
+	/** Tracked request */
+	struct Request
+	{
+		Request() : nOpCode(0), nTime(0) {}
+		Request(quint32 _opcode, qint64 _time) : nOpCode(_opcode), nTime(_time) {}
+
+		quint32 nOpCode;
+		/** Time current stage is started at */
+		qint64 nTime;
+	};
+
+	static int GetBucket(quint64 nValue);
+	static quint64 GetBucketLimit(int nBucket);
+
+	Counters *GetCommandCounters(quint32 nOpCode);
+	void Record(Counters *pCounters, PRL_REQUEST_STAGE nStage, qint64 nStart, qint64 nEnd);
+	void RecordSwitch(Counters *pCounters);
+
+private:
+	/** Monotonic clock started on the first use */
+	QElapsedTimer m_Clock;
+	/** Commands counters are never freed, so pointers are used unlocked */
+	QReadWriteLock m_CountersLock;
+	QHash<quint32, Counters *> m_Counters;
+	/** Held requests with their hold time */
+	PrlUuidMap<qint64> m_Held;
+	QAtomicInt m_nHeld;
+	/** Requests sent and not finished */
+	PrlUuidMap<Request> m_Requests;
+	/** Responses posted and not delivered */
+	PrlUuidMap<Request> m_Posted;
+	QAtomicInt m_nPosted;
+};
+
+#endif // __VIRTUOZZO_REQUESTS_PERF_H__
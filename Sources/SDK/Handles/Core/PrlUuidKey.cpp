@@ -0,0 +1,76 @@
+/*
+ * PrlUuidKey.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "PrlUuidKey.h"
+
+namespace {
+
+int HexDigit(ushort c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+} // namespace
+
+PrlUuidKey PrlUuidKey::FromString(const QString &sUuid)
+{
+	const QChar *p = sUuid.constData();
+	int nSize = sUuid.size();
+	if (nSize == 38 && p[0] == QLatin1Char('{') && p[37] == QLatin1Char('}'))
+	{
+		++p;
+		nSize -= 2;
+	}
+	if (nSize != 36)
+		return PrlUuidKey();
+
+	PrlUuidKey key;
+	int nDigits = 0;
+	for (int i = 0; i < nSize; ++i)
+	{
+		// Hyphens are allowed at the canonical positions only
+		if (i == 8 || i == 13 || i == 18 || i == 23)
+		{
+			if (p[i] != QLatin1Char('-'))
+				return PrlUuidKey();
+			continue;
+		}
+		int d = HexDigit(p[i].unicode());
+		if (d < 0)
+			return PrlUuidKey();
+		quint64 &word = (nDigits < 16 ? key.nHigh : key.nLow);
+		word = (word << 4) | quint64(d);
+		++nDigits;
+	}
+	return key;
+}
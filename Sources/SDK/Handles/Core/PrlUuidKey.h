@@ -0,0 +1,73 @@
+/*
+ * PrlUuidKey.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_UUID_KEY_H__
+#define __VIRTUOZZO_UUID_KEY_H__
+
+#include <QHash>
+#include <QString>
+
+/**
+ * Binary 128-bit UUID used as a key of jobs registries instead of its
+ * text form. Text is parsed once so lookups hash and compare two words
+ * only. Text which is not a UUID (for example empty job UUID of not sent
+ * request) is mapped to the null key.
+ */
+struct PrlUuidKey
+{
+	PrlUuidKey() : nHigh(0), nLow(0) {}
+
+	/**
+	 * Parses UUID text with or without braces, case insensitive
+	 * @param UUID text
+	 * @return parsed key or null key for malformed text
+	 */
+	static PrlUuidKey FromString(const QString &sUuid);
+
+	bool isNull() const { return !nHigh && !nLow; }
+
+	bool operator==(const PrlUuidKey &other) const
+	{
+		return nHigh == other.nHigh && nLow == other.nLow;
+	}
+
+	bool operator!=(const PrlUuidKey &other) const
+	{
+		return !(*this == other);
+	}
+
+	quint64 nHigh;
+	quint64 nLow;
+};
+
+inline uint qHash(const PrlUuidKey &key, uint seed = 0)
+{
+	// UUIDs are random enough to fold them without mixing
+	return qHash(key.nHigh ^ key.nLow, seed);
+}
+
+#endif // __VIRTUOZZO_UUID_KEY_H__
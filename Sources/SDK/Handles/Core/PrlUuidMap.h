@@ -0,0 +1,201 @@
+/*
+ * PrlUuidMap.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_UUID_MAP_H__
+#define __VIRTUOZZO_UUID_MAP_H__
+
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+
+#include "PrlUuidKey.h"
+
+/**
+ * Concurrent map keyed by binary UUID. Map is split into shards with own
+ * read-write locks, so lookups never block each other and registration of
+ * new requests serializes with lookups of the same shard only.
+ */
+template <typename T>
+class PrlUuidMap
+{
+public:
+	enum
+	{
+		ShardBits = 4,
+		ShardsCount = 1 << ShardBits,
+		ShardMask = ShardsCount - 1,
+	};
+
+	/**
+	 * Inserts value replacing existing one with the same key
+	 * @return sign whether key was absent
+	 */
+	bool insert(const PrlUuidKey &key, const T &value)
+	{
+		Shard &s = shard(key);
+		QWriteLocker _lock(&s.lock);
+		typename QHash<PrlUuidKey, T>::iterator it = s.hash.find(key);
+		if (it != s.hash.end())
+		{
+			it.value() = value;
+			return false;
+		}
+		s.hash.insert(key, value);
+		return true;
+	}
+
+	/**
+	 * Returns value by key or default constructed value
+	 */
+	T value(const PrlUuidKey &key) const
+	{
+		const Shard &s = shard(key);
+		QReadLocker _lock(&s.lock);
+		return s.hash.value(key);
+	}
+
+	/**
+	 * Removes value by key
+	 * @return sign whether value was removed
+	 */
+	bool remove(const PrlUuidKey &key)
+	{
+		Shard &s = shard(key);
+		QWriteLocker _lock(&s.lock);
+		return s.hash.remove(key) != 0;
+	}
+
+	/**
+	 * Removes value by key and returns it
+	 * @return sign whether value was removed
+	 */
+	bool take(const PrlUuidKey &key, T &value)
+	{
+		Shard &s = shard(key);
+		QWriteLocker _lock(&s.lock);
+		typename QHash<PrlUuidKey, T>::iterator it = s.hash.find(key);
+		if (it == s.hash.end())
+			return false;
+		value = it.value();
+		s.hash.erase(it);
+		return true;
+	}
+
+	/**
+	 * Removes value by key if it is equal to specified one
+	 * @return sign whether value was removed
+	 */
+	bool remove(const PrlUuidKey &key, const T &value)
+	{
+		Shard &s = shard(key);
+		QWriteLocker _lock(&s.lock);
+		typename QHash<PrlUuidKey, T>::iterator it = s.hash.find(key);
+		if (it == s.hash.end() || !(it.value() == value))
+			return false;
+		s.hash.erase(it);
+		return true;
+	}
+
+	/**
+	 * Removes all values
+	 */
+	void clear()
+	{
+		for (int i = 0; i < ShardsCount; ++i)
+		{
+			QWriteLocker _lock(&m_Shards[i].lock);
+			m_Shards[i].hash.clear();
+		}
+	}
+
+	/**
+	 * Returns number of values
+	 */
+	int size() const
+	{
+		int nSize = 0;
+		for (int i = 0; i < ShardsCount; ++i)
+		{
+			QReadLocker _lock(&m_Shards[i].lock);
+			nSize += m_Shards[i].hash.size();
+		}
+		return nSize;
+	}
+
+	/**
+	 * Returns per shard consistent copy of all values
+	 */
+	QList<T> values() const
+	{
+		QList<T> lstValues;
+		for (int i = 0; i < ShardsCount; ++i)
+		{
+			QReadLocker _lock(&m_Shards[i].lock);
+			lstValues += m_Shards[i].hash.values();
+		}
+		return lstValues;
+	}
+
+	/**
+	 * Performs functor on the value under shard read lock. Lets to take
+	 * a reference on the found object before it can be removed.
+	 * @return sign whether value was found
+	 */
+	template <typename F>
+	bool find(const PrlUuidKey &key, F f) const
+	{
+		const Shard &s = shard(key);
+		QReadLocker _lock(&s.lock);
+		typename QHash<PrlUuidKey, T>::const_iterator it = s.hash.constFind(key);
+		if (it == s.hash.constEnd())
+			return false;
+		f(it.value());
+		return true;
+	}
+
+private:
+	struct Shard
+	{
+		mutable QReadWriteLock lock;
+		QHash<PrlUuidKey, T> hash;
+	};
+
+	Shard &shard(const PrlUuidKey &key)
+	{
+		return m_Shards[key.nLow & ShardMask];
+	}
+
+	const Shard &shard(const PrlUuidKey &key) const
+	{
+		return m_Shards[key.nLow & ShardMask];
+	}
+
+private:
+	Shard m_Shards[ShardsCount];
+};
+
+#endif // __VIRTUOZZO_UUID_MAP_H__
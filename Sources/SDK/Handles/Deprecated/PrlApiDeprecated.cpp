@@ -80,12 +80,10 @@ PRL_METHOD (PrlResult_GetParamToken ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(data_ptr))
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(data_ptr))
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
-
 	return pResult->GetParamToken( index, data_ptr );
 }
 
@@ -104,12 +102,10 @@ PRL_METHOD (PrlResult_GetError ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(data_ptr))
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(data_ptr))
 		return PRL_ERR_INVALID_ARG;
 
-	// We need to be sure that this job was registered one day
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
-
 	return pResult->GetError( data_ptr );
 }
 
@@ -126,10 +122,10 @@ PRL_METHOD ( PrlLoginResponse_ToString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLoginResp, PHT_LOGIN_RESPONSE) || PRL_WRONG_PTR(pLoginRespStr) )
+	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp, PHT_LOGIN_RESPONSE );
+	if ( !pLoginResp || PRL_WRONG_PTR(pLoginRespStr) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp );
 	*pLoginRespStr = strdup(pLoginResp->toString().toUtf8().data());
 	return (PRL_ERR_SUCCESS);
 }
@@ -147,10 +143,10 @@ PRL_METHOD( PrlResult_FromString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hResult, PHT_RESULT) || PRL_WRONG_PTR(sResult) )
+	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult, PHT_RESULT );
+	if ( !pResult || PRL_WRONG_PTR(sResult) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleResultPtr pResult = PRL_OBJECT_BY_HANDLE<PrlHandleResult>( hResult );
 
 	return pResult->FromString( sResult );
 }
@@ -168,10 +164,10 @@ PRL_METHOD ( PrlUsrCfg_FromString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hUsrCfg, PHT_USER_PROFILE) || PRL_WRONG_PTR(sUsrCfg) )
+	PrlHandleUserProfilePtr pUsrCfg = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUsrCfg, PHT_USER_PROFILE );
+	if ( !pUsrCfg || PRL_WRONG_PTR(sUsrCfg) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleUserProfilePtr pUsrCfg = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUsrCfg );
 
 	return pUsrCfg->fromString( sUsrCfg );
 }
@@ -189,10 +185,10 @@ PRL_METHOD ( PrlUsrCfg_ToString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hUsrCfg, PHT_USER_PROFILE) || PRL_WRONG_PTR(pUsrCfg) )
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUsrCfg, PHT_USER_PROFILE );
+	if ( !pUserProfile || PRL_WRONG_PTR(pUsrCfg) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUsrCfg );
 	*pUsrCfg = strdup(pUserProfile->toString().toUtf8().data());
 	return (PRL_ERR_SUCCESS);
 }
@@ -213,10 +209,10 @@ PRL_METHOD( PrlUsrCfg_AddProxy ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE))
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->AddProxy(sProxyHost, nProxyPort, sProxyUserLogin, sProxyUserPasswd, nReserved));
 }
@@ -234,10 +230,10 @@ PRL_METHOD ( PrlDispCfg_FromString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG) || PRL_WRONG_PTR(sDispCfg) )
+	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if ( !pDispCfg || PRL_WRONG_PTR(sDispCfg) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg );
 
 	return pDispCfg->fromString( sDispCfg );
 }
@@ -255,10 +251,10 @@ PRL_METHOD ( PrlDispCfg_ToString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pDispCfg) )
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if ( !pDispConfig || PRL_WRONG_PTR(pDispCfg) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg );
 	*pDispCfg = strdup(pDispConfig->toString().toUtf8().data());
 	return (PRL_ERR_SUCCESS);
 }
@@ -277,10 +273,10 @@ PRL_METHOD ( PrlVm_FromString ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(vm_config) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(vm_config) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->fromString( vm_config );
 }
@@ -300,10 +296,10 @@ PRL_METHOD ( PrlVm_ToString ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(vm_config) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(vm_config) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 	*vm_config = strdup(pVm->toString().toUtf8().data());
 	return (PRL_ERR_SUCCESS);
 }
@@ -362,9 +358,9 @@ PRL_HANDLE PrlVmDev_UpdateInfo_Impl(PRL_HANDLE hServer,PRL_HANDLE hVmInputDev)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_UNKNOWN))
 
 		PrlHandleVmDevicePtr pVmDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDevice>(hVmInputDev);
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_UNKNOWN))
-		PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdUpdateDeviceInfo( pVmDevice->toString().toUtf8().data() );
 
 	if (!pJob)
@@ -382,7 +378,7 @@ PRL_ASYNC_METHOD( PrlVmDev_UpdateInfo )(
 		hVmInputDev
 		);
 	ASYNC_CHECK_API_INITIALIZED(PJOC_UNKNOWN)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVmDev_UpdateInfo, (hServer,hVmInputDev) )
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlVmDev_UpdateInfo, (hServer,hVmInputDev) )
 }
 
 PRL_METHOD ( PrlLic_FromString ) (
@@ -398,10 +394,10 @@ PRL_METHOD ( PrlLic_FromString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLic, PHT_LICENSE) || PRL_WRONG_PTR(sLic) )
+	PrlHandleLicensePtr pLic = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLic, PHT_LICENSE );
+	if ( !pLic || PRL_WRONG_PTR(sLic) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleLicensePtr pLic = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLic );
 
 	return pLic->fromString( sLic );
 }
@@ -419,10 +415,10 @@ PRL_METHOD ( PrlLic_ToString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLic, PHT_LICENSE) || PRL_WRONG_PTR(pLicStr) )
+	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLic, PHT_LICENSE );
+	if ( !pLicense || PRL_WRONG_PTR(pLicStr) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLic );
 	*pLicStr = strdup(pLicense->toString().toUtf8().data());
 	return (PRL_ERR_SUCCESS);
 }
@@ -476,7 +472,7 @@ PRL_ASYNC_METHOD( PrlVm_UpdateToolsSection ) (
 							   )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UPDATE_TOOLS_SECTION);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_UpdateToolsSection, (hVm, sToolsSection));
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_UpdateToolsSection, (hVm, sToolsSection));
 }
 
 PRL_METHOD( PrlVm_SetCpuVtxEnabled ) (
@@ -492,10 +488,10 @@ PRL_METHOD( PrlVm_SetCpuVtxEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return (pVm->SetCpuVtxEnabled(bVmCpuVtxEnabled));
 }
@@ -505,10 +501,10 @@ PRL_HANDLE PrlSrv_StartConvertHdd_Impl(
 					  PRL_HANDLE hStringsList
 					   )
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER)
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if ( !pServer
 		|| (hStringsList != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hStringsList, PHT_STRINGS_LIST)) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_UNKNOWN))
-		PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->StartConvertHdd(hStringsList);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -521,7 +517,7 @@ PRL_ASYNC_METHOD( PrlSrv_StartConvertHdd) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_UNKNOWN)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_StartConvertHdd, (hServer, hStringsList))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_StartConvertHdd, (hServer, hStringsList))
 }
 
 PRL_HANDLE PrlSrv_SmcGetRuntimeInfo_Impl(PRL_HANDLE hServer)
@@ -534,7 +530,7 @@ PRL_ASYNC_METHOD( PrlSrv_SmcGetRuntimeInfo ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_UNKNOWN)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SmcGetRuntimeInfo, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SmcGetRuntimeInfo, (hServer))
 }
 
 PRL_METHOD( PrlVm_CreateAnswerEvent ) (
@@ -552,10 +548,10 @@ PRL_METHOD( PrlVm_CreateAnswerEvent ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(phEvent))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm || PRL_WRONG_PTR(phEvent))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return (pVm->CreateAnswerEvent(phEvent, nAnswer));
 }
@@ -573,10 +569,10 @@ PRL_METHOD ( PrlDispNet_PortForwardingFromString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR(sPortForwarding) )
+	PrlHandleDispNetPtr pNetCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if ( !pNetCfg || PRL_WRONG_PTR(sPortForwarding) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pNetCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return pNetCfg->SetPortForwardingFromString( sPortForwarding );
 }
@@ -594,10 +590,10 @@ PRL_METHOD ( PrlDispNet_PortForwardingToString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR(pPortForwarding) )
+	PrlHandleDispNetPtr pNetCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if ( !pNetCfg || PRL_WRONG_PTR(pPortForwarding) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pNetCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return pNetCfg->GetPortForwardingToString( pPortForwarding );
 }
@@ -627,7 +623,7 @@ PRL_ASYNC_METHOD( PrlSrv_PrepareForHibernate ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_PREPARE_FOR_HIBERNATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_PrepareForHibernate, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_PrepareForHibernate, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_AfterHostResume_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
@@ -641,7 +637,7 @@ PRL_ASYNC_METHOD( PrlSrv_AfterHostResume ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_AFTER_HOST_RESUME)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_AfterHostResume, (hServer, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_AfterHostResume, (hServer, nFlags))
 }
 
 PRL_METHOD( PrlDispNet_Remove ) (
@@ -655,10 +651,10 @@ PRL_METHOD( PrlDispNet_Remove ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->Remove());
 }
 
@@ -675,10 +671,10 @@ PRL_METHOD( PrlDispNet_IsEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR(pbEnabled))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet || PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->IsEnabled(pbEnabled));
 }
 
@@ -695,10 +691,10 @@ PRL_METHOD( PrlDispNet_SetEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->SetEnabled(bEnabled));
 }
 
@@ -715,10 +711,10 @@ PRL_METHOD( PrlDispNet_IsHidden ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR(pbHidden))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet || PRL_WRONG_PTR(pbHidden))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->IsHidden(pbHidden));
 }
 
@@ -735,10 +731,10 @@ PRL_METHOD( PrlDispNet_SetHidden ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->SetHidden(bHidden));
 }
 
@@ -755,10 +751,10 @@ PRL_METHOD( PrlDispNet_IsDhcpEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR(pbDhcpEnabled))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet || PRL_WRONG_PTR(pbDhcpEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->IsDhcpEnabled(pbDhcpEnabled));
 }
 
@@ -775,10 +771,10 @@ PRL_METHOD( PrlDispNet_SetDhcpEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->SetDhcpEnabled(bDhcpEnabled));
 }
 
@@ -795,10 +791,10 @@ PRL_METHOD( PrlDispNet_GetNetworkType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR(pnNetworkType))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet || PRL_WRONG_PTR(pnNetworkType))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->GetNetworkType(pnNetworkType));
 }
 
@@ -815,10 +811,10 @@ PRL_METHOD( PrlDispNet_SetNetworkType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->SetNetworkType(nNetworkType));
 }
 
@@ -837,11 +833,11 @@ PRL_METHOD( PrlDispNet_GetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(pnDispNetNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetName(sDispNetName, pnDispNetNameBufLength));
 }
@@ -859,11 +855,11 @@ PRL_METHOD( PrlDispNet_SetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(sNewDispNetName))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetName(sNewDispNetName));
 }
@@ -883,11 +879,11 @@ PRL_METHOD( PrlDispNet_GetUuid) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(pnDispNetUuidBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetUuid(sDispNetUuid, pnDispNetUuidBufLength));
 }
@@ -907,11 +903,11 @@ PRL_METHOD( PrlDispNet_GetSysName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(pnDispNetSysNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetSysName(sDispNetSysName, pnDispNetSysNameBufLength));
 }
@@ -929,11 +925,11 @@ PRL_METHOD( PrlDispNet_SetSysName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(sNewDispNetSysName))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetSysName(sNewDispNetSysName));
 }
@@ -951,10 +947,10 @@ PRL_METHOD( PrlDispNet_GetIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR( pnIndex ))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet || PRL_WRONG_PTR( pnIndex ))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->GetIndex(pnIndex));
 }
 
@@ -971,10 +967,10 @@ PRL_METHOD( PrlDispNet_SetIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER))
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->SetIndex(nIndex));
 }
 
@@ -993,11 +989,11 @@ PRL_METHOD( PrlDispNet_GetDhcpScopeStartIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(pnDispNetDhcpScopeStartIpBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetDhcpScopeStartIp(sDispNetDhcpScopeStartIp, pnDispNetDhcpScopeStartIpBufLength));
 }
@@ -1015,11 +1011,11 @@ PRL_METHOD( PrlDispNet_SetDhcpScopeStartIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(sNewDispNetDhcpScopeStartIp))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetDhcpScopeStartIp(sNewDispNetDhcpScopeStartIp));
 }
@@ -1039,11 +1035,11 @@ PRL_METHOD( PrlDispNet_GetDhcpScopeEndIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(pnDispNetDhcpScopeEndIpBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetDhcpScopeEndIp(sDispNetDhcpScopeEndIp, pnDispNetDhcpScopeEndIpBufLength));
 }
@@ -1061,11 +1057,11 @@ PRL_METHOD( PrlDispNet_SetDhcpScopeEndIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(sNewDispNetDhcpScopeEndIp))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetDhcpScopeEndIp(sNewDispNetDhcpScopeEndIp));
 }
@@ -1085,11 +1081,11 @@ PRL_METHOD( PrlDispNet_GetDhcpScopeMask) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(pnDispNetDhcpScopeMaskBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetDhcpScopeMask(sDispNetDhcpScopeMask, pnDispNetDhcpScopeMaskBufLength));
 }
@@ -1107,11 +1103,11 @@ PRL_METHOD( PrlDispNet_SetDhcpScopeMask) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+	if (!pDispNet ||
 		PRL_WRONG_PTR(sNewDispNetDhcpScopeMask))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetDhcpScopeMask(sNewDispNetDhcpScopeMask));
 }
@@ -1131,10 +1127,10 @@ PRL_METHOD( PrlDispNet_IsDhcp6Enabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) || PRL_WRONG_PTR(pbDhcp6Enabled))
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet || PRL_WRONG_PTR(pbDhcp6Enabled))
 			return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->IsDhcp6Enabled(pbDhcp6Enabled));
 }
 
@@ -1151,10 +1147,10 @@ PRL_METHOD( PrlDispNet_SetDhcp6Enabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER))
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet)
 			return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>(hDispNet);
 	return (pDispNet->SetDhcp6Enabled(bDhcp6Enabled));
 }
 
@@ -1173,11 +1169,11 @@ PRL_METHOD( PrlDispNet_GetDhcp6ScopeStartIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet ||
 			PRL_WRONG_PTR(pnDispNetDhcp6ScopeStartIpBufLength))
 			return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetDhcp6ScopeStartIp(sDispNetDhcp6ScopeStartIp, pnDispNetDhcp6ScopeStartIpBufLength));
 }
@@ -1195,11 +1191,11 @@ PRL_METHOD( PrlDispNet_SetDhcp6ScopeStartIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet ||
 			PRL_WRONG_PTR(sNewDispNetDhcp6ScopeStartIp))
 			return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetDhcp6ScopeStartIp(sNewDispNetDhcp6ScopeStartIp));
 }
@@ -1219,11 +1215,11 @@ PRL_METHOD( PrlDispNet_GetDhcp6ScopeEndIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet ||
 			PRL_WRONG_PTR(pnDispNetDhcp6ScopeEndIpBufLength))
 			return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetDhcp6ScopeEndIp(sDispNetDhcp6ScopeEndIp, pnDispNetDhcp6ScopeEndIpBufLength));
 }
@@ -1241,11 +1237,11 @@ PRL_METHOD( PrlDispNet_SetDhcp6ScopeEndIp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet ||
 			PRL_WRONG_PTR(sNewDispNetDhcp6ScopeEndIp))
 			return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetDhcp6ScopeEndIp(sNewDispNetDhcp6ScopeEndIp));
 }
@@ -1265,11 +1261,11 @@ PRL_METHOD( PrlDispNet_GetDhcp6ScopeMask) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet ||
 			PRL_WRONG_PTR(pnDispNetDhcp6ScopeMaskBufLength))
 			return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->GetDhcp6ScopeMask(sDispNetDhcp6ScopeMask, pnDispNetDhcp6ScopeMaskBufLength));
 }
@@ -1287,20 +1283,20 @@ PRL_METHOD( PrlDispNet_SetDhcp6ScopeMask) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hDispNet, PHT_DISP_NET_ADAPTER) ||
+		PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet, PHT_DISP_NET_ADAPTER );
+		if (!pDispNet ||
 			PRL_WRONG_PTR(sNewDispNetDhcp6ScopeMask))
 			return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispNetPtr pDispNet = PRL_OBJECT_BY_HANDLE<PrlHandleDispNet>( hDispNet );
 
 	return (pDispNet->SetDhcp6ScopeMask(sNewDispNetDhcp6ScopeMask));
 }
 
 PRL_HANDLE PrlSrv_AddNetAdapter_Impl(PRL_HANDLE hServer,	PRL_HANDLE hNetAdapter)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hNetAdapter, PHT_DISP_NET_ADAPTER) )
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_HANDLE(hNetAdapter, PHT_DISP_NET_ADAPTER) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_ADD_NET_ADAPTER))
-		PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->AddNetAdapter(hNetAdapter);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1313,14 +1309,14 @@ PRL_ASYNC_METHOD( PrlSrv_AddNetAdapter ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_ADD_NET_ADAPTER)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_AddNetAdapter, (hServer, hNetAdapter))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_AddNetAdapter, (hServer, hNetAdapter))
 }
 
 PRL_HANDLE PrlSrv_DeleteNetAdapter_Impl(PRL_HANDLE hServer,	PRL_UINT32 nIndex)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_DELETE_NET_ADAPTER))
-		PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->DeleteNetAdapter(nIndex);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1333,14 +1329,14 @@ PRL_ASYNC_METHOD( PrlSrv_DeleteNetAdapter ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_DELETE_NET_ADAPTER)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_DeleteNetAdapter, (hServer, nIndex))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_DeleteNetAdapter, (hServer, nIndex))
 }
 
 PRL_HANDLE PrlSrv_UpdateNetAdapter_Impl(PRL_HANDLE hServer,	PRL_HANDLE hNetAdapter)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hNetAdapter, PHT_DISP_NET_ADAPTER) )
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_HANDLE(hNetAdapter, PHT_DISP_NET_ADAPTER) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_NET_ADAPTER))
-		PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->UpdateNetAdapter(hNetAdapter);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1353,7 +1349,7 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateNetAdapter ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_NET_ADAPTER)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateNetAdapter, (hServer, hNetAdapter))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateNetAdapter, (hServer, hNetAdapter))
 }
 
 PRL_HANDLE PrlSrv_StoreValueByKey_Impl(
@@ -1362,13 +1358,13 @@ PRL_HANDLE PrlSrv_StoreValueByKey_Impl(
 	PRL_CONST_STR sValue,
 	PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER)
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if (!pServer
 		|| PRL_WRONG_PTR(sKey)
 		|| PRL_WRONG_PTR(sValue)
 		)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_STORE_VALUE_BY_KEY));
 
-	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdStorageSetValue(sKey, sValue, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -1383,7 +1379,7 @@ PRL_ASYNC_METHOD( PrlSrv_StoreValueByKey ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_STORE_VALUE_BY_KEY)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_StoreValueByKey, (hServer, sKey, sValue, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_StoreValueByKey, (hServer, sKey, sValue, nFlags))
 }
 
 PRL_HANDLE PrlVm_StoreValueByKey_Impl(
@@ -1392,13 +1388,13 @@ PRL_HANDLE PrlVm_StoreValueByKey_Impl(
 	PRL_CONST_STR sValue,
 	PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE)
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm
 		|| PRL_WRONG_PTR(sKey)
 		|| PRL_WRONG_PTR(sValue)
 		)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_STORE_VALUE_BY_KEY));
 
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm );
 	PrlHandleJobPtr pJob = pVm->StoreValueByKey(sKey, sValue, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -1413,7 +1409,7 @@ PRL_ASYNC_METHOD( PrlVm_StoreValueByKey ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_STORE_VALUE_BY_KEY)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_StoreValueByKey, (hVm, sKey, sValue, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_StoreValueByKey, (hVm, sKey, sValue, nFlags))
 }
 
 PRL_METHOD( PrlDispCfg_CreateDispNet) (
@@ -1429,10 +1425,10 @@ PRL_METHOD( PrlDispCfg_CreateDispNet) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG) || PRL_WRONG_PTR(phDispNet) )
+	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if ( !pDispCfg || PRL_WRONG_PTR(phDispNet) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>(hDispCfg);
 	return (pDispCfg->CreateDispNet(phDispNet));
 }
 
@@ -1449,10 +1445,10 @@ PRL_METHOD( PrlDispCfg_GetDispNetCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pnDispNetCount) )
+	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if ( !pDispCfg || PRL_WRONG_PTR(pnDispNetCount) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>(hDispCfg);
 	return (pDispCfg->GetDispNetCount(pnDispNetCount));
 }
 
@@ -1471,10 +1467,10 @@ PRL_METHOD( PrlDispCfg_GetDispNet) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG) || PRL_WRONG_PTR(phDispNet) )
+	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if ( !pDispCfg || PRL_WRONG_PTR(phDispNet) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispCfg = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>(hDispCfg);
 	return (pDispCfg->GetDispNet(nDispNetIndex, phDispNet));
 }
 
@@ -1511,11 +1507,11 @@ PRL_METHOD( PrlVmCfg_GetDevsList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm
 		|| PRL_WRONG_PTR(vmdev_handles) || PRL_WRONG_PTR(vmdev_handles_count) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return (pVm->GetDevicesList(vmdev_handles, vmdev_handles_count));
 }
@@ -1525,9 +1521,8 @@ PRL_HANDLE PrlSrv_SendClientStatistics_Impl(PRL_HANDLE hServer, PRL_CONST_STR sS
 	if ( PRL_WRONG_PTR(sStatistics) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_SEND_CLIENT_STATISTICS));
 
-	PRL_CntxSw_CHECK_HANDLE_ASYNC(hServer, PHT_SERVER, PJOC_SRV_SEND_CLIENT_STATISTICS) ;
+	PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(PrlHandleServerDeprecated, pServer, hServer, PHT_SERVER, PJOC_SRV_SEND_CLIENT_STATISTICS) ;
 
-	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdSendClientStatistics( sStatistics, nFlags );
 
 	if (!pJob)
@@ -1538,7 +1533,7 @@ PRL_HANDLE PrlSrv_SendClientStatistics_Impl(PRL_HANDLE hServer, PRL_CONST_STR sS
 PRL_ASYNC_METHOD( PrlSrv_SendClientStatistics ) (PRL_HANDLE hServer, PRL_CONST_STR sStatistics, PRL_UINT32 nFlags)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_SEND_CLIENT_STATISTICS) ;
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SendClientStatistics, (hServer, sStatistics, nFlags)) ;
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SendClientStatistics, (hServer, sStatistics, nFlags)) ;
 }
 
 PRL_HANDLE PrlSrv_UpdateUsbDevicesAssociationsList_Impl(PRL_HANDLE hServer,
@@ -1546,10 +1541,10 @@ PRL_HANDLE PrlSrv_UpdateUsbDevicesAssociationsList_Impl(PRL_HANDLE hServer,
 												PRL_UINT32 nListVersion,
 												PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER)
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if ( !pServer
 		|| (hStringsList != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hStringsList, PHT_STRINGS_LIST)) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_USB_ASSOC_LIST))
-		PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdUpdateUsbAssocList(hStringsList,nListVersion,nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1564,7 +1559,7 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateUsbDevicesAssociationsList ) (
 				)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_USB_ASSOC_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateUsbDevicesAssociationsList, (hServer, hStringsList,nListVersion,nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateUsbDevicesAssociationsList, (hServer, hStringsList,nListVersion,nFlags))
 }
 
 PRL_HANDLE PrlVm_RunCompressor_Impl(PRL_HANDLE hVm)
@@ -1577,7 +1572,7 @@ PRL_ASYNC_METHOD( PrlVm_RunCompressor ) (
 							   )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_RUN_COMPRESSOR)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_RunCompressor, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_RunCompressor, (hVm))
 }
 
 PRL_HANDLE PrlVm_CancelCompressor_Impl(PRL_HANDLE hVm)
@@ -1590,16 +1585,16 @@ PRL_ASYNC_METHOD( PrlVm_CancelCompressor ) (
 							   )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_CANCEL_COMPRESSOR)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_CancelCompressor, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_CancelCompressor, (hVm))
 }
 
 PRL_HANDLE PrlVm_InternalCommand_Impl(PRL_HANDLE hVm, PRL_CONST_STR sCmdName, PRL_HANDLE hArgsList)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sCmdName) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm || PRL_WRONG_PTR(sCmdName) ||
 		(PRL_INVALID_HANDLE != hArgsList && PRL_WRONG_HANDLE(hArgsList, PHT_STRINGS_LIST)))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_CMD_INTERNAL))
 
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->InternalCmd(sCmdName, hArgsList);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1610,7 +1605,7 @@ PRL_HANDLE PrlVm_InternalCommand_Impl(PRL_HANDLE hVm, PRL_CONST_STR sCmdName, PR
 PRL_ASYNC_METHOD( PrlVm_InternalCommand ) (PRL_HANDLE hVm, PRL_CONST_STR sCmd, PRL_HANDLE hArgsList)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_CMD_INTERNAL)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_InternalCommand, (hVm, sCmd, hArgsList))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_InternalCommand, (hVm, sCmd, hArgsList))
 }
 
 PRL_HANDLE PrlSrv_RestartNetworkShaping_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
@@ -1624,7 +1619,7 @@ PRL_ASYNC_METHOD( PrlSrv_RestartNetworkShaping) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_RESTART_NETWORK_SHAPING)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_RestartNetworkShaping, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_RestartNetworkShaping, (hServer, nFlags))
 }
 
 PRL_ASYNC_METHOD( PrlSrv_UpdateNetworkShapingList) (
@@ -1662,11 +1657,11 @@ PRL_METHOD( PrlVmCfg_SetDefaultGateway) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmDefaultGateway))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetDefaultGateway(sNewVmDefaultGateway));
 }
@@ -1684,11 +1679,11 @@ PRL_METHOD( PrlVmCfg_SetDefaultGatewayIPv6) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmDefaultGateway))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetDefaultGatewayIPv6(sNewVmDefaultGateway));
 }
@@ -1708,11 +1703,11 @@ PRL_METHOD( PrlVmCfg_GetDefaultGateway) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmDefaultGatewayBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetDefaultGateway(sVmDefaultGateway, pnVmDefaultGatewayBufLength));
 }
@@ -1732,11 +1727,11 @@ PRL_METHOD( PrlVmCfg_GetDefaultGatewayIPv6) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmDefaultGatewayBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetDefaultGatewayIPv6(sVmDefaultGateway, pnVmDefaultGatewayBufLength));
 }
@@ -1748,11 +1743,11 @@ PRL_METHOD( PrlVmDevHd_GetBlockSize ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnBytes))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->GetBlockSize(pnBytes));
 }
 
@@ -1763,10 +1758,10 @@ PRL_METHOD( PrlVmDevHd_SetBlockSize ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK))
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->SetBlockSize(nBytes));
 }
 
@@ -1783,11 +1778,11 @@ PRL_METHOD( PrlVmCfg_Is3DAccelerationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVm3DAccelerationEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->Is3DAccelerationEnabled(pbVm3DAccelerationEnabled));
 }
@@ -1805,10 +1800,10 @@ PRL_METHOD( PrlVmCfg_Set3DAccelerationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->Set3DAccelerationEnabled(bVm3DAccelerationEnabled));
 }
@@ -1824,7 +1819,7 @@ PRL_HANDLE PrlSrv_StartClusterService_Impl(PRL_HANDLE hServer, PRL_CONST_STR sSe
 PRL_ASYNC_METHOD( PrlSrv_StartClusterService ) (PRL_HANDLE hServer, PRL_CONST_STR sServiceName, PRL_UINT32 nFlags)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_START_CLUSTER_SERVICE) ;
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_StartClusterService, (hServer, sServiceName, nFlags)) ;
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_StartClusterService, (hServer, sServiceName, nFlags)) ;
 }
 
 PRL_HANDLE PrlSrv_StopClusterService_Impl(PRL_HANDLE hServer, PRL_CONST_STR sServiceName, PRL_UINT32 nFlags)
@@ -1839,7 +1834,7 @@ PRL_HANDLE PrlSrv_StopClusterService_Impl(PRL_HANDLE hServer, PRL_CONST_STR sSer
 PRL_ASYNC_METHOD( PrlSrv_StopClusterService ) (PRL_HANDLE hServer, PRL_CONST_STR sServiceName, PRL_UINT32 nFlags)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_STOP_CLUSTER_SERVICE) ;
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_StopClusterService, (hServer, sServiceName, nFlags)) ;
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_StopClusterService, (hServer, sServiceName, nFlags)) ;
 }
 
 PRL_METHOD( PrlDispCfg_SetClusterMode ) (
@@ -1880,11 +1875,11 @@ PRL_METHOD( PrlDispCfg_GetHostId ) (
 		pnHostIdBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG)
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig
 		|| PRL_WRONG_PTR(pnHostIdBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return pDispConfig->GetHostId(sHostId, pnHostIdBufLength);
 }
@@ -1902,11 +1897,11 @@ PRL_METHOD( PrlDispCfg_SetHostId ) (
 		sHostId
 	);
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(sHostId))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return pDispConfig->SetHostId(sHostId);
 }
@@ -1917,10 +1912,10 @@ PRL_HANDLE PrlVm_SendProblemReport_Impl(
     PRL_UINT32 nFlags
 )
 {
-    if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+    PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+    if ( !pVm || PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
         RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_SEND_PROBLEM_REPORT))
 
-    PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm );
     PrlHandleJobPtr pJob = pVm->SendProblemReport( hProblemReport, nFlags );
     if ( !pJob )
         RETURN_RES(PRL_INVALID_HANDLE);
@@ -1934,7 +1929,7 @@ PRL_ASYNC_METHOD( PrlVm_SendProblemReport ) (
         )
 {
     ASYNC_CHECK_API_INITIALIZED(PJOC_VM_SEND_PROBLEM_REPORT)
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_SendProblemReport, (hVm, hProblemReport, nFlags))
+    CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_SendProblemReport, (hVm, hProblemReport, nFlags))
 }
 
 PRL_METHOD( PrlVmCfg_GetHostMemQuotaMin ) (
@@ -1950,11 +1945,11 @@ PRL_METHOD( PrlVmCfg_GetHostMemQuotaMin ) (
 		pnHostMemQuotaMin
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnHostMemQuotaMin))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetHostMemQuotaMin(pnHostMemQuotaMin);
 }
@@ -1972,10 +1967,10 @@ PRL_METHOD( PrlVmCfg_SetHostMemQuotaMin ) (
 		nHostMemQuotaMin
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetHostMemQuotaMin(nHostMemQuotaMin);
 }
@@ -1993,11 +1988,11 @@ PRL_METHOD( PrlVmCfg_GetHostMemQuotaMax ) (
 		pnHostMemQuotaMax
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnHostMemQuotaMax))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetHostMemQuotaMax(pnHostMemQuotaMax);
 }
@@ -2015,10 +2010,10 @@ PRL_METHOD( PrlVmCfg_SetHostMemQuotaMax ) (
 		nHostMemQuotaMax
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetHostMemQuotaMax(nHostMemQuotaMax);
 }
@@ -2036,11 +2031,11 @@ PRL_METHOD( PrlVmCfg_GetHostMemQuotaPriority ) (
 		pnHostMemQuotaPriority
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnHostMemQuotaPriority))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetHostMemQuotaPriority(pnHostMemQuotaPriority);
 }
@@ -2058,10 +2053,10 @@ PRL_METHOD( PrlVmCfg_SetHostMemQuotaPriority ) (
 		nHostMemQuotaPriority
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetHostMemQuotaPriority(nHostMemQuotaPriority);
 }
@@ -2079,11 +2074,11 @@ PRL_METHOD( PrlVmCfg_IsHostMemAutoQuota ) (
 		pbHostMemAutoQuota
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbHostMemAutoQuota))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->IsHostMemAutoQuota(pbHostMemAutoQuota);
 }
@@ -2101,10 +2096,10 @@ PRL_METHOD( PrlVmCfg_SetHostMemAutoQuota ) (
 		bHostMemAutoQuota
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetHostMemAutoQuota(bHostMemAutoQuota);
 }
@@ -2122,11 +2117,11 @@ PRL_METHOD( PrlVmCfg_GetMaxBalloonSize ) (
 		pnMaxBalloonSize
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnMaxBalloonSize))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetMaxBalloonSize(pnMaxBalloonSize);
 }
@@ -2144,10 +2139,10 @@ PRL_METHOD( PrlVmCfg_SetMaxBalloonSize ) (
 		nMaxBalloonSize
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetMaxBalloonSize(nMaxBalloonSize);
 }
@@ -2165,9 +2160,9 @@ PRL_METHOD( PrlStat_GetDispUptime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnUptime) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnUptime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetDispUptime(pnUptime));
 }
 
@@ -2184,9 +2179,9 @@ PRL_METHOD( PrlStat_GetTotalSwapSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetTotalSwapSize(pnSize));
 }
 
@@ -2203,9 +2198,9 @@ PRL_METHOD( PrlStat_GetUsageSwapSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetUsageSwapSize(pnSize));
 }
 
@@ -2222,9 +2217,9 @@ PRL_METHOD( PrlStat_GetFreeSwapSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetFreeSwapSize(pnSize));
 }
 
@@ -2241,9 +2236,9 @@ PRL_METHOD( PrlStat_GetIfacesStatsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnCount) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetIfacesStatsCount(pnCount));
 }
 
@@ -2262,9 +2257,9 @@ PRL_METHOD( PrlStat_GetIfaceStat) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(phIfaceStat) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(phIfaceStat) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetIfaceStat(nIndex, phIfaceStat));
 }
 
@@ -2283,10 +2278,10 @@ PRL_METHOD( PrlStatIface_GetSystemName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE)
+	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE );
+	if ( !pSystemStatisticsIface
 				|| PRL_WRONG_PTR(pnSystemNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat );
 	return (pSystemStatisticsIface->GetSystemName(sSystemName, pnSystemNameBufLength));
 }
 
@@ -2303,9 +2298,9 @@ PRL_METHOD( PrlStatIface_GetInDataSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE) || PRL_WRONG_PTR(pnDataSize) )
+	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE );
+	if ( !pSystemStatisticsIface || PRL_WRONG_PTR(pnDataSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat );
 	return (pSystemStatisticsIface->GetInDataSize(pnDataSize));
 }
 
@@ -2322,9 +2317,9 @@ PRL_METHOD( PrlStatIface_GetOutDataSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE) || PRL_WRONG_PTR(pnDataSize) )
+	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE );
+	if ( !pSystemStatisticsIface || PRL_WRONG_PTR(pnDataSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat );
 	return (pSystemStatisticsIface->GetOutDataSize(pnDataSize));
 }
 
@@ -2341,9 +2336,9 @@ PRL_METHOD( PrlStatIface_GetInPkgsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE) || PRL_WRONG_PTR(pnPkgsCount) )
+	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE );
+	if ( !pSystemStatisticsIface || PRL_WRONG_PTR(pnPkgsCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat );
 	return (pSystemStatisticsIface->GetInPkgsCount(pnPkgsCount));
 }
 
@@ -2360,9 +2355,9 @@ PRL_METHOD( PrlStatIface_GetOutPkgsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE) || PRL_WRONG_PTR(pnPkgsCount) )
+	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat, PHT_SYSTEM_STATISTICS_IFACE );
+	if ( !pSystemStatisticsIface || PRL_WRONG_PTR(pnPkgsCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsIfacePtr pSystemStatisticsIface = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsIface>( hIfaceStat );
 	return (pSystemStatisticsIface->GetOutPkgsCount(pnPkgsCount));
 }
 
@@ -2379,9 +2374,9 @@ PRL_METHOD( PrlStat_GetUsersStatsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnCount) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetUsersStatsCount(pnCount));
 }
 
@@ -2400,9 +2395,9 @@ PRL_METHOD( PrlStat_GetUserStat) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(phUserStat) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(phUserStat) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetUserStat(nIndex, phUserStat));
 }
 
@@ -2421,10 +2416,10 @@ PRL_METHOD( PrlStatUser_GetUserName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION)
+	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION );
+	if ( !pSystemStatisticsUser
 				|| PRL_WRONG_PTR(pnUserNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat );
 #ifdef _WIN_
 #ifdef GetUserName
 #undef GetUserName
@@ -2448,10 +2443,10 @@ PRL_METHOD( PrlStatUser_GetServiceName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION)
+	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION );
+	if ( !pSystemStatisticsUser
 				|| PRL_WRONG_PTR(pnServiceNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat );
 	return (pSystemStatisticsUser->GetServiceName(sServiceName, pnServiceNameBufLength));
 }
 
@@ -2470,10 +2465,10 @@ PRL_METHOD( PrlStatUser_GetHostName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION)
+	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION );
+	if ( !pSystemStatisticsUser
 				|| PRL_WRONG_PTR(pnHostNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat );
 	return (pSystemStatisticsUser->GetHostName(sHostName, pnHostNameBufLength));
 }
 
@@ -2490,9 +2485,9 @@ PRL_METHOD( PrlStatUser_GetSessionTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat, PHT_SYSTEM_STATISTICS_USER_SESSION );
+	if ( !pSystemStatisticsUser || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsUserPtr pSystemStatisticsUser = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsUser>( hUserStat );
 	return (pSystemStatisticsUser->GetSessionTime(pnTime));
 }
 
@@ -2509,9 +2504,9 @@ PRL_METHOD( PrlStat_GetDisksStatsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnCount) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetDisksStatsCount(pnCount));
 }
 
@@ -2530,9 +2525,9 @@ PRL_METHOD( PrlStat_GetDiskStat) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(phDiskStat) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(phDiskStat) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetDiskStat(nIndex, phDiskStat));
 }
 
@@ -2551,10 +2546,10 @@ PRL_METHOD( PrlStatDisk_GetSystemName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDiskStat, PHT_SYSTEM_STATISTICS_DISK)
+	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat, PHT_SYSTEM_STATISTICS_DISK );
+	if ( !pSystemStatisticsDisk
 				|| PRL_WRONG_PTR(pnSystemNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat );
 	return (pSystemStatisticsDisk->GetSystemName(sSystemName, pnSystemNameBufLength));
 }
 
@@ -2571,9 +2566,9 @@ PRL_METHOD( PrlStatDisk_GetUsageDiskSpace) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDiskStat, PHT_SYSTEM_STATISTICS_DISK) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat, PHT_SYSTEM_STATISTICS_DISK );
+	if ( !pSystemStatisticsDisk || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat );
 	return (pSystemStatisticsDisk->GetUsageDiskSpace(pnSize));
 }
 
@@ -2590,9 +2585,9 @@ PRL_METHOD( PrlStatDisk_GetFreeDiskSpace) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDiskStat, PHT_SYSTEM_STATISTICS_DISK) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat, PHT_SYSTEM_STATISTICS_DISK );
+	if ( !pSystemStatisticsDisk || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat );
 	return (pSystemStatisticsDisk->GetFreeDiskSpace(pnSize));
 }
 
@@ -2609,9 +2604,9 @@ PRL_METHOD( PrlStatDisk_GetPartsStatsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDiskStat, PHT_SYSTEM_STATISTICS_DISK) || PRL_WRONG_PTR(pnCount) )
+	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat, PHT_SYSTEM_STATISTICS_DISK );
+	if ( !pSystemStatisticsDisk || PRL_WRONG_PTR(pnCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat );
 	return (pSystemStatisticsDisk->GetPartsStatsCount(pnCount));
 }
 
@@ -2630,9 +2625,9 @@ PRL_METHOD( PrlStatDisk_GetPartStat) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDiskStat, PHT_SYSTEM_STATISTICS_DISK) || PRL_WRONG_PTR(phPartStat) )
+	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat, PHT_SYSTEM_STATISTICS_DISK );
+	if ( !pSystemStatisticsDisk || PRL_WRONG_PTR(phPartStat) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPtr pSystemStatisticsDisk = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDisk>( hDiskStat );
 	return (pSystemStatisticsDisk->GetPartStat(nIndex, phPartStat));
 }
 
@@ -2651,10 +2646,10 @@ PRL_METHOD( PrlStatDiskPart_GetSystemName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hPartStat, PHT_SYSTEM_STATISTICS_DISK_PARTITION)
+	PrlHandleSystemStatisticsDiskPartPtr pSystemStatisticsDiskPart = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDiskPart>( hPartStat, PHT_SYSTEM_STATISTICS_DISK_PARTITION );
+	if ( !pSystemStatisticsDiskPart
 				|| PRL_WRONG_PTR(pnSystemNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPartPtr pSystemStatisticsDiskPart = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDiskPart>( hPartStat );
 	return (pSystemStatisticsDiskPart->GetSystemName(sSystemName, pnSystemNameBufLength));
 }
 
@@ -2671,9 +2666,9 @@ PRL_METHOD( PrlStatDiskPart_GetUsageDiskSpace) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hPartStat, PHT_SYSTEM_STATISTICS_DISK_PARTITION) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsDiskPartPtr pSystemStatisticsDiskPart = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDiskPart>( hPartStat, PHT_SYSTEM_STATISTICS_DISK_PARTITION );
+	if ( !pSystemStatisticsDiskPart || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPartPtr pSystemStatisticsDiskPart = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDiskPart>( hPartStat );
 	return (pSystemStatisticsDiskPart->GetUsageDiskSpace(pnSize));
 }
 
@@ -2690,9 +2685,9 @@ PRL_METHOD( PrlStatDiskPart_GetFreeDiskSpace) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hPartStat, PHT_SYSTEM_STATISTICS_DISK_PARTITION) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsDiskPartPtr pSystemStatisticsDiskPart = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDiskPart>( hPartStat, PHT_SYSTEM_STATISTICS_DISK_PARTITION );
+	if ( !pSystemStatisticsDiskPart || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsDiskPartPtr pSystemStatisticsDiskPart = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsDiskPart>( hPartStat );
 	return (pSystemStatisticsDiskPart->GetFreeDiskSpace(pnSize));
 }
 
@@ -2709,9 +2704,9 @@ PRL_METHOD( PrlStat_GetProcsStatsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnCount) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetProcsStatsCount(pnCount));
 }
 
@@ -2730,9 +2725,9 @@ PRL_METHOD( PrlStat_GetProcStat) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(phProcStat) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(phProcStat) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetProcStat(nIndex, phProcStat));
 }
 
@@ -2751,10 +2746,10 @@ PRL_METHOD( PrlStatProc_GetCommandName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS)
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc
 				|| PRL_WRONG_PTR(pnCommandNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetCommandName(sCommandName, pnCommandNameBufLength));
 }
 
@@ -2771,9 +2766,9 @@ PRL_METHOD( PrlStatProc_GetId) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnId) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnId) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetId(pnId));
 }
 
@@ -2792,10 +2787,10 @@ PRL_METHOD( PrlStatProc_GetOwnerUserName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS)
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc
 				|| PRL_WRONG_PTR(pnOwnerUserNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetOwnerUserName(sOwnerUserName, pnOwnerUserNameBufLength));
 }
 
@@ -2812,9 +2807,9 @@ PRL_METHOD( PrlStatProc_GetTotalMemUsage) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetTotalMemUsage(pnSize));
 }
 
@@ -2831,9 +2826,9 @@ PRL_METHOD( PrlStatProc_GetRealMemUsage) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetRealMemUsage(pnSize));
 }
 
@@ -2850,9 +2845,9 @@ PRL_METHOD( PrlStatProc_GetVirtMemUsage) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetVirtMemUsage(pnSize));
 }
 
@@ -2869,9 +2864,9 @@ PRL_METHOD( PrlStatProc_GetStartTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetStartTime(pnTime));
 }
 
@@ -2888,9 +2883,9 @@ PRL_METHOD( PrlStatProc_GetTotalTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetTotalTime(pnTime));
 }
 
@@ -2907,9 +2902,9 @@ PRL_METHOD( PrlStatProc_GetUserTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetUserTime(pnTime));
 }
 
@@ -2926,9 +2921,9 @@ PRL_METHOD( PrlStatProc_GetSystemTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetSystemTime(pnTime));
 }
 
@@ -2945,9 +2940,9 @@ PRL_METHOD( PrlStatProc_GetState) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnState) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnState) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetState(pnState));
 }
 
@@ -2964,9 +2959,9 @@ PRL_METHOD( PrlStatProc_GetCpuUsage) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hProcStat, PHT_SYSTEM_STATISTICS_PROCESS) || PRL_WRONG_PTR(pnPercents) )
+	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat, PHT_SYSTEM_STATISTICS_PROCESS );
+	if ( !pSystemStatisticsProc || PRL_WRONG_PTR(pnPercents) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsProcPtr pSystemStatisticsProc = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsProc>( hProcStat );
 	return (pSystemStatisticsProc->GetCpuUsage(pnPercents));
 }
 
@@ -2983,9 +2978,9 @@ PRL_METHOD( PrlStat_GetVmDataStat) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(phVmDataStat) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(phVmDataStat) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetVmDataStat(phVmDataStat));
 }
 
@@ -3004,12 +2999,12 @@ PRL_METHOD( PrlStatVmData_GetSegmentCapacity) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmDataStat, PHT_SYSTEM_STATISTICS_VM_DATA)
+	PrlHandleSystemStatisticsVmDataPtr pSystemStatisticsVmData = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsVmData>( hVmDataStat, PHT_SYSTEM_STATISTICS_VM_DATA );
+	if ( !pSystemStatisticsVmData
 		|| (nSegment <= PDSS_UNKNOWN || nSegment > PDSS_VM_FULL_SPACE)
 		|| PRL_WRONG_PTR(pnCapacity) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSystemStatisticsVmDataPtr pSystemStatisticsVmData = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsVmData>( hVmDataStat );
 	return (pSystemStatisticsVmData->GetSegmentCapacity(nSegment, pnCapacity));
 }
 
@@ -113,11 +113,11 @@ PRL_RESULT PrlHandleDisk::getPolicyList(
 	for (PRL_UINT32 i = 0; i < items; ++i)
 	{
 		res = pPolicyList->GetItem(i, &hPolicy);
-		if (PRL_WRONG_HANDLE(hPolicy, PHT_VIRTUAL_DISK_OPEN_POLICY))
+		PrlHandleSmartPtr<PrlHandleDiskOpenPolicy> pPolicy =
+			PRL_OBJECT_BY_HANDLE<PrlHandleDiskOpenPolicy>(hPolicy, PHT_VIRTUAL_DISK_OPEN_POLICY);
+		if (!pPolicy)
 			return PRL_ERR_INVALID_ARG;
-		policies.push_back(
-				PRL_OBJECT_BY_HANDLE<PrlHandleDiskOpenPolicy>(hPolicy)
-				->getPolicy());
+		policies.push_back(pPolicy->getPolicy());
 	}
 	return PRL_ERR_SUCCESS;
 }
@@ -135,10 +135,9 @@ PRL_METHOD(PrlDisk_OpenDisk_Local) (
 	PrlHandleHandlesListPtr phList;
 	if (PRL_RIGHT_HANDLE(hPolicyList))
 	{
-		if (PRL_WRONG_HANDLE(hPolicyList, PHT_HANDLES_LIST))
+		phList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hPolicyList, PHT_HANDLES_LIST);
+		if (!phList)
 			return retVal;
-
-		phList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hPolicyList);
 	}
 
 	// Create default disk class
@@ -198,10 +197,10 @@ PRL_METHOD(PrlDisk_WaitForCompletion) (
 		// Disk handle
 		const PRL_HANDLE Handle)
 {
-	if (PRL_WRONG_HANDLE(Handle, PHT_VIRTUAL_DISK))
+	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>( Handle, PHT_VIRTUAL_DISK );
+	if (!pDisk)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>(Handle);
 
 	return pDisk->WaitForCompletion();
 }
@@ -233,13 +232,12 @@ PRL_METHOD(PrlDisk_SwitchToState) (
 	Q_UNUSED(pCallback)
 	Q_UNUSED(pParameter)
 
-	if (PRL_WRONG_HANDLE(Handle, PHT_VIRTUAL_DISK))
+	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>( Handle, PHT_VIRTUAL_DISK );
+	if (!pDisk)
 		return PRL_ERR_INVALID_ARG;
 	if (PRL_WRONG_PTR(pDirectoryName) || PRL_WRONG_PTR(pUid))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>(Handle);
-
 	return pDisk->SwitchToState(pUid, pCallback, pParameter);
 }
 
@@ -263,14 +261,13 @@ PRL_METHOD(PrlDisk_Write) (
 		// Offset of block (in sectors)
 		const PRL_UINT64 uiBlockOffset)
 {
-	if ( PRL_WRONG_HANDLE(Handle, PHT_VIRTUAL_DISK) )
+	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>( Handle, PHT_VIRTUAL_DISK );
+	if ( !pDisk )
 		return PRL_ERR_INVALID_ARG;
 
 	if ( PRL_WRONG_PTR(pBlock) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>(Handle);
-
 	return pDisk->Write(pBlock, uiSize, uiBlockOffset);
 }
 
@@ -294,14 +291,13 @@ PRL_METHOD(PrlDisk_Read) (
 		// Offset of block (in sectors)
 		const PRL_UINT64 uiBlockOffset)
 {
-	if ( PRL_WRONG_HANDLE(Handle, PHT_VIRTUAL_DISK) )
+	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>( Handle, PHT_VIRTUAL_DISK );
+	if ( !pDisk )
 		return PRL_ERR_INVALID_ARG;
 
 	if ( PRL_WRONG_PTR(pBlock) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>(Handle);
-
 	return pDisk->Read(pBlock, uiSize, uiBlockOffset);
 }
 
@@ -332,7 +328,8 @@ PRL_METHOD(PrlDisk_GetDiskInfo) (
 		// Parameter value buffer size
 		PRL_UINT32_PTR BufferSize)
 {
-	if ( PRL_WRONG_HANDLE(Handle, PHT_VIRTUAL_DISK) )
+	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>( Handle, PHT_VIRTUAL_DISK );
+	if ( !pDisk )
 	{
 		WRITE_TRACE(DBG_FATAL, "wrong handle");
 		return PRL_ERR_INVALID_ARG;
@@ -352,8 +349,6 @@ PRL_METHOD(PrlDisk_GetDiskInfo) (
 			return PRL_ERR_INVALID_ARG;
 		}
 
-	PrlHandleDiskPtr pDisk = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>(Handle);
-
 	return pDisk->GetDiskInfo(ppDDesc, BufferSize);
 }
 
@@ -377,16 +372,13 @@ PRL_METHOD( PrlDisk_GetChangesMap_Local ) (
 	// Pointer to a variable which receives the map handle
 	PRL_HANDLE_PTR phMap)
 {
-	if (PRL_WRONG_HANDLE(hDisk, PHT_VIRTUAL_DISK))
+	PrlHandleDiskPtr d = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>( hDisk, PHT_VIRTUAL_DISK );
+	if (!d)
 		return PRL_ERR_INVALID_ARG;
 
 	if (PRL_WRONG_PTR(phMap))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskPtr d = PRL_OBJECT_BY_HANDLE<PrlHandleDisk>(hDisk);
-	if (!d.isValid())
-		return PRL_INVALID_HANDLE;
-
 	PrlHandleDiskMap* m;
 	PRL_RESULT e = d->GetChanges(sPit1Uuid, sPit2Uuid, m);
 	if (PRL_FAILED(e))
@@ -410,16 +402,13 @@ PRL_METHOD(PrlDiskMap_GetSize) (
 		// Pointer to a variable which receives the map size
 		PRL_UINT32_PTR pnSize)
 {
-	if (PRL_WRONG_HANDLE(hMap, PHT_VIRTUAL_DISK_MAP))
+	PrlHandleDiskMapPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleDiskMap>( hMap, PHT_VIRTUAL_DISK_MAP );
+	if (!m)
 		return PRL_ERR_INVALID_ARG;
 
 	if (PRL_WRONG_PTR(pnSize))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskMapPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleDiskMap>(hMap);
-	if (!m.isValid())
-		return PRL_INVALID_HANDLE;
-
 	*pnSize = m->getSize();
 	return PRL_ERR_SUCCESS;
 }
@@ -439,16 +428,13 @@ PRL_METHOD(PrlDiskMap_GetGranularity) (
 		// Pointer to a variable which receives the map block size
 		PRL_UINT32_PTR pnSize)
 {
-	if (PRL_WRONG_HANDLE(hMap, PHT_VIRTUAL_DISK_MAP))
+	PrlHandleDiskMapPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleDiskMap>( hMap, PHT_VIRTUAL_DISK_MAP );
+	if (!m)
 		return PRL_ERR_INVALID_ARG;
 
 	if (PRL_WRONG_PTR(pnSize))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskMapPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleDiskMap>(hMap);
-	if (!m.isValid())
-		return PRL_INVALID_HANDLE;
-
 	*pnSize = m->getGranularity();
 	return PRL_ERR_SUCCESS;
 }
@@ -470,15 +456,12 @@ PRL_METHOD(PrlDiskMap_Read) (
 		// Pointer to a variable holding the size of the store
 		PRL_UINT32_PTR pnCapacity)
 {
-	if (PRL_WRONG_HANDLE(hMap, PHT_VIRTUAL_DISK_MAP))
+	PrlHandleDiskMapPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleDiskMap>( hMap, PHT_VIRTUAL_DISK_MAP );
+	if (!m)
 		return PRL_ERR_INVALID_ARG;
 
 	if (PRL_WRONG_PTR(pnCapacity))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDiskMapPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleDiskMap>(hMap);
-	if (!m.isValid())
-		return PRL_INVALID_HANDLE;
-
 	return m->getBits(pBuffer, *pnCapacity);
 }
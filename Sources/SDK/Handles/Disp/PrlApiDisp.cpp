@@ -56,11 +56,13 @@
 #include "PrlHandleUsbIdentity.h"
 #include "PrlHandlePluginInfo.h"
 #include "PrlHandleBackupResult.h"
+#include "PrlHandleEventQueue.h"
 #include "PrlHandleDispConfig.h"
 #include "PrlHandleSrvConfig.h"
 #include "PrlHandleUserProfile.h"
 #include "PrlHandleUserInfo.h"
 #include "PrlHandleOpTypeList.h"
+#include "PrlHandleStringsList.h"
 #include "PrlHandleCpuFeatures.h"
 #include "PrlHandleCpuPool.h"
 #include "PrlHandleVcmmdConfig.h"
@@ -141,11 +143,10 @@ PRL_HANDLE PrlSrv_Login_Impl(PRL_HANDLE hServer, PRL_CONST_STR host, PRL_CONST_S
 				PRL_SECURITY_LEVEL security_level, PRL_UINT32 flags)
 {
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_LOGIN))
 
-	// Performing login operation to the server
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->Login(host, user, passwd, sPrevSessionUuid, cmd_port,
 						timeout, security_level, flags );
 	if (!pJob)
@@ -179,7 +180,7 @@ PRL_ASYNC_METHOD( PrlSrv_Login ) (
 		);
 
 	PRL_UINT32 nFlags = 0;
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_Login, (hServer, host, user,
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_Login, (hServer, host, user,
 				passwd, sPrevSessionUuid, port_cmd, timeout, security_level, nFlags));
 }
 
@@ -211,7 +212,7 @@ PRL_ASYNC_METHOD( PrlSrv_LoginEx ) (
 
 	flags = PRL_ELIMINATE_DEPRECATED_FLAGS(flags);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_Login, (hServer, host, user,
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_Login, (hServer, host, user,
 			passwd, sPrevSessionUuid, port_cmd, timeout, security_level, flags));
 }
 
@@ -231,14 +232,14 @@ PRL_ASYNC_METHOD( PrlSrv_Logoff ) (
 		hServer
 		);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_Logoff, (hServer))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_Logoff, (hServer))
 }
 
 PRL_HANDLE PrlSrv_SendAnswer_Impl(PRL_HANDLE hServer,	PRL_HANDLE hAnswer)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hAnswer, PHT_EVENT) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_HANDLE(hAnswer, PHT_EVENT) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_SEND_ANSWER))
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->SendAnswer(hAnswer);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -251,7 +252,7 @@ PRL_ASYNC_METHOD( PrlSrv_SendAnswer ) (
 									   )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_SEND_ANSWER)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SendAnswer, (hServer, hAnswer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SendAnswer, (hServer, hAnswer))
 }
 
 PRL_HANDLE PrlSrv_SendProblemReport_Impl(
@@ -260,10 +261,10 @@ PRL_HANDLE PrlSrv_SendProblemReport_Impl(
 	PRL_UINT32 nFlags
 )
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_HANDLE(hProblemReport, PHT_PROBLEM_REPORT) )
         RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_SEND_PROBLEM_REPORT))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
     PrlHandleJobPtr pJob = pServer->SrvSendProblemReport( hProblemReport,
                                                                nFlags );
 	if ( !pJob )
@@ -278,16 +279,16 @@ PRL_ASYNC_METHOD( PrlSrv_SendProblemReport ) (
 		)
 {
     ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_SEND_PROBLEM_REPORT)
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SendProblemReport, (hServer, hProblemReport, nFlags))
+    CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SendProblemReport, (hServer, hProblemReport, nFlags))
 }
 
 PRL_HANDLE PrlSrv_LoginLocal_Impl(PRL_HANDLE hServer, PRL_CONST_STR sPrevSessionUuid, PRL_UINT32 port,
 					PRL_SECURITY_LEVEL security_level, PRL_UINT32 flags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_LOGIN_LOCAL))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->LoginLocal( sPrevSessionUuid, port, security_level, flags );
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -312,7 +313,7 @@ PRL_ASYNC_METHOD( PrlSrv_LoginLocal ) (
 		);
 
 	PRL_UINT32 nFlags = 0;
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_LoginLocal,
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_LoginLocal,
 				(hServer, sPrevSessionUuid, port, security_level, nFlags))
 }
 
@@ -336,7 +337,7 @@ PRL_ASYNC_METHOD( PrlSrv_LoginLocalEx ) (
 
 	flags = PRL_ELIMINATE_DEPRECATED_FLAGS(flags);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_LoginLocal, (hServer,
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_LoginLocal, (hServer,
 				sPrevSessionUuid, port, security_level, flags));
 }
 
@@ -349,6 +350,334 @@ PRL_METHOD( PrlSrv_RegEventHandler ) (
 	return PrlHandle_RegEventHandler(hServer, handler, userData);
 }
 
+PRL_METHOD( PrlSrv_RegEventHandlerBatch ) (
+		PRL_HANDLE hServer,
+		PRL_EVENT_HANDLER_PTR handler,
+		PRL_UINT32 nMaxBatch,
+		PRL_UINT32 nMaxDelayMs,
+		PRL_VOID_PTR userData
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, handler=%.8X, nMaxBatch=%u, nMaxDelayMs=%u, userData=%.8X)",
+		__FUNCTION__,
+		hServer,
+		handler,
+		nMaxBatch,
+		nMaxDelayMs,
+		userData
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(handler) || !nMaxBatch )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pServer->RegEventHandlerBatch(handler, nMaxBatch, nMaxDelayMs, userData));
+}
+
+PRL_METHOD( PrlSrv_UnregEventHandlerBatch ) (
+		PRL_HANDLE hServer,
+		PRL_EVENT_HANDLER_PTR handler,
+		PRL_VOID_PTR userData
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, handler=%.8X, userData=%.8X)",
+		__FUNCTION__,
+		hServer,
+		handler,
+		userData
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pServer->UnregEventHandlerBatch(handler, userData));
+}
+
+PRL_METHOD( PrlSrv_OpenEventQueue ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nCapacity,
+		PRL_HANDLE_PTR phQueue
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nCapacity=%u, phQueue=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nCapacity,
+		phQueue
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || !nCapacity || PRL_WRONG_PTR(phQueue) )
+		return (PRL_ERR_INVALID_ARG);
+
+	PrlHandleEventQueue *pQueue = new PrlHandleEventQueue( pServer, nCapacity );
+	if ( !pQueue )
+		return (PRL_ERR_OUT_OF_MEMORY);
+
+	if ( !pQueue->IsValid() )
+	{
+		pQueue->Release();
+		return (PRL_ERR_FAILURE);
+	}
+
+	*phQueue = pQueue->GetHandle();
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlEventQueue_Poll ) (
+		PRL_HANDLE hQueue,
+		PRL_UINT32 nTimeoutMs,
+		PRL_UINT32 nMaxEvents,
+		PRL_HANDLE_PTR phEventsList
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hQueue=%.8X, nTimeoutMs=%u, nMaxEvents=%u, phEventsList=%.8X)",
+		__FUNCTION__,
+		hQueue,
+		nTimeoutMs,
+		nMaxEvents,
+		phEventsList
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleEventQueuePtr pQueue = PRL_OBJECT_BY_HANDLE<PrlHandleEventQueue>( hQueue, PHT_EVENT_QUEUE );
+	if ( !pQueue || !nMaxEvents || PRL_WRONG_PTR(phEventsList) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pQueue->Poll(nTimeoutMs, nMaxEvents, phEventsList));
+}
+
+PRL_METHOD( PrlEventQueue_GetFd ) (
+		PRL_HANDLE hQueue,
+		PRL_INT32_PTR pnFd
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hQueue=%.8X, pnFd=%.8X)",
+		__FUNCTION__,
+		hQueue,
+		pnFd
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleEventQueuePtr pQueue = PRL_OBJECT_BY_HANDLE<PrlHandleEventQueue>( hQueue, PHT_EVENT_QUEUE );
+	if ( !pQueue || PRL_WRONG_PTR(pnFd) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pQueue->GetFd(pnFd));
+}
+
+PRL_METHOD( PrlEventQueue_GetOverflowCount ) (
+		PRL_HANDLE hQueue,
+		PRL_UINT64_PTR pnOverflowCount
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hQueue=%.8X, pnOverflowCount=%.8X)",
+		__FUNCTION__,
+		hQueue,
+		pnOverflowCount
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleEventQueuePtr pQueue = PRL_OBJECT_BY_HANDLE<PrlHandleEventQueue>( hQueue, PHT_EVENT_QUEUE );
+	if ( !pQueue || PRL_WRONG_PTR(pnOverflowCount) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pQueue->GetOverflowCount(pnOverflowCount));
+}
+
+PRL_METHOD( PrlSrv_GetJobsCompletionFd ) (
+		PRL_HANDLE hServer,
+		PRL_INT32_PTR pnFd
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, pnFd=%.8X)",
+		__FUNCTION__,
+		hServer,
+		pnFd
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pnFd) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pServer->GetJobsCompletionFd(pnFd));
+}
+
+PRL_METHOD( PrlSrv_ReapCompletedJobs ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nMaxJobs,
+		PRL_HANDLE_PTR phJobsList
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nMaxJobs=%u, phJobsList=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nMaxJobs,
+		phJobsList
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(phJobsList) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pServer->ReapCompletedJobs(nMaxJobs, phJobsList));
+}
+
+PRL_METHOD( PrlSrv_SetRequestsQueue ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nCapacity,
+		PRL_UINT32 nTimeout,
+		PRL_UINT32 nFlags
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nCapacity=%u, nTimeout=%u, nFlags=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nCapacity,
+		nTimeout,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->SetRequestsQueue(nCapacity, nTimeout);
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlSrv_GetRequestsQueueStat ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32_PTR pnDepth,
+		PRL_UINT32_PTR pnMaxDepth,
+		PRL_UINT64_PTR pnQueued,
+		PRL_UINT64_PTR pnRejected
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, pnDepth=%.8X, pnMaxDepth=%.8X, pnQueued=%.8X, pnRejected=%.8X)",
+		__FUNCTION__,
+		hServer,
+		pnDepth,
+		pnMaxDepth,
+		pnQueued,
+		pnRejected
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pnDepth) || PRL_WRONG_PTR(pnMaxDepth)
+		|| PRL_WRONG_PTR(pnQueued) || PRL_WRONG_PTR(pnRejected) )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->GetRequestsQueueStat(pnDepth, pnMaxDepth, pnQueued, pnRejected);
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlSrv_SetConnectionPool ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nConnections,
+		PRL_UINT32 nFlags
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nConnections=%u, nFlags=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nConnections,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || nConnections > PVE_MAX_CONNECTION_POOL_SIZE )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->SetConnectionPool(nConnections);
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlSrv_BeginBatch ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nFlags
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nFlags=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->BeginBatch();
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlSrv_SubmitBatch ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nFlags
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nFlags=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->SubmitBatch();
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlSrv_GetInFlightJobs ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32_PTR pnJobs,
+		PRL_UINT32_PTR pnRequests
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, pnJobs=%.8X, pnRequests=%.8X)",
+		__FUNCTION__,
+		hServer,
+		pnJobs,
+		pnRequests
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pnJobs) || PRL_WRONG_PTR(pnRequests) )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->GetInFlightJobs(pnJobs, pnRequests);
+	return (PRL_ERR_SUCCESS);
+}
+
 PRL_METHOD( PrlSrv_UnregEventHandler ) (
 										PRL_HANDLE hServer,
 										PRL_EVENT_HANDLER_PTR handler,
@@ -358,6 +687,154 @@ PRL_METHOD( PrlSrv_UnregEventHandler ) (
 	return PrlHandle_UnregEventHandler(hServer, handler, userData);
 }
 
+PRL_METHOD( PrlSrv_SetEventFilter ) (
+									 PRL_HANDLE hServer,
+									 PRL_HANDLE hEventTypesList,
+									 PRL_HANDLE hVmUuidsList,
+									 PRL_UINT32 nFlags
+									 )
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, hEventTypesList=%.8X, hVmUuidsList=%.8X, nFlags=%.8X)",
+		__FUNCTION__,
+		hServer,
+		hEventTypesList,
+		hVmUuidsList,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	PrlHandleOpTypeListPtr pEventTypes = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hEventTypesList, PHT_OPAQUE_TYPE_LIST );
+	PrlHandleStringsListPtr pVmUuids = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hVmUuidsList, PHT_STRINGS_LIST );
+	if ( !pServer
+		|| (PRL_INVALID_HANDLE != hEventTypesList && !pEventTypes)
+		|| (PRL_INVALID_HANDLE != hVmUuidsList && !pVmUuids) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pServer->GetEventsFilter().SetFilter(pEventTypes.getHandle(), pVmUuids.getHandle()));
+}
+
+PRL_METHOD( PrlSrv_GetEventFilterStat ) (
+										 PRL_HANDLE hServer,
+										 PRL_UINT64_PTR pnDelivered,
+										 PRL_UINT64_PTR pnFiltered
+										 )
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, pnDelivered=%.8X, pnFiltered=%.8X)",
+		__FUNCTION__,
+		hServer,
+		pnDelivered,
+		pnFiltered
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pnDelivered) || PRL_WRONG_PTR(pnFiltered) )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->GetEventsFilter().GetStat(pnDelivered, pnFiltered);
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlSrv_SetNotificationShards ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nShardsCount,
+		PRL_UINT32 nFlags
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nShardsCount=%u, nFlags=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nShardsCount,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pServer->SetNotificationShards(nShardsCount));
+}
+
+PRL_METHOD( PrlSrv_GetNotificationShardStat ) (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nShard,
+		PRL_UINT32_PTR pnQueueDepth,
+		PRL_UINT64_PTR pnDelivered,
+		PRL_UINT64_PTR pnAvgLatency,
+		PRL_UINT64_PTR pnMaxLatency
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, nShard=%u, pnQueueDepth=%.8X, pnDelivered=%.8X,"
+		" pnAvgLatency=%.8X, pnMaxLatency=%.8X)",
+		__FUNCTION__,
+		hServer,
+		nShard,
+		pnQueueDepth,
+		pnDelivered,
+		pnAvgLatency,
+		pnMaxLatency
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pnQueueDepth) || PRL_WRONG_PTR(pnDelivered)
+		|| PRL_WRONG_PTR(pnAvgLatency) || PRL_WRONG_PTR(pnMaxLatency) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pServer->GetNotificationShardStat(nShard, pnQueueDepth,
+		pnDelivered, pnAvgLatency, pnMaxLatency));
+}
+
+PRL_METHOD( PrlSrv_SetProgressEventsCoalescing ) (
+		PRL_HANDLE hServer,
+		PRL_BOOL bEnable,
+		PRL_UINT32 nFlags
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, bEnable=%.8X, nFlags=%.8X)",
+		__FUNCTION__,
+		hServer,
+		bEnable,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
+		return (PRL_ERR_INVALID_ARG);
+
+	pServer->SetProgressCoalescing(PRL_FALSE != bEnable);
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_METHOD( PrlSrv_GetCoalescedEventsCount ) (
+		PRL_HANDLE hServer,
+		PRL_UINT64_PTR pnCoalesced
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hServer=%.8X, pnCoalesced=%.8X)",
+		__FUNCTION__,
+		hServer,
+		pnCoalesced
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pnCoalesced) )
+		return (PRL_ERR_INVALID_ARG);
+
+	*pnCoalesced = pServer->GetCoalescedEventsCount();
+	return (PRL_ERR_SUCCESS);
+}
+
 PRL_METHOD( PrlSrv_GetQuestions ) (
 								   PRL_HANDLE hServer,
 								   PRL_HANDLE_PTR pQuestionsList
@@ -371,10 +848,10 @@ PRL_METHOD( PrlSrv_GetQuestions ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(pQuestionsList) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pQuestionsList) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	try
 	{
 		PrlHandleHandlesList  *pHandlesList =
@@ -394,10 +871,10 @@ PRL_HANDLE PrlSrv_SetNonInteractiveSession_Impl(PRL_HANDLE hServer,
 														 PRL_BOOL bNonInteractive,
 														 PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER))
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if (!pServer)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_SET_NON_INTERACTIVE_SESSION));
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->SetNonInteractiveSession(bNonInteractive, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -419,7 +896,7 @@ PRL_ASYNC_METHOD( PrlSrv_SetNonInteractiveSession ) (
 	nFlags
 	);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SetNonInteractiveSession, (hServer, bNonInteractive, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SetNonInteractiveSession, (hServer, bNonInteractive, nFlags))
 }
 
 PRL_METHOD( PrlSrv_IsNonInteractiveSession ) (
@@ -435,10 +912,10 @@ PRL_METHOD( PrlSrv_IsNonInteractiveSession ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(pbNonInteractive))
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_PTR(pbNonInteractive))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 
 	return pServer->IsNonInteractiveSession(pbNonInteractive);
 }
@@ -486,7 +963,8 @@ PRL_HANDLE PrlSrv_DisableConfirmationMode_Impl(PRL_HANDLE hServer,
 														PRL_CONST_STR sPasswd,
 														PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER)
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if (!pServer
 		|| PRL_WRONG_PTR(sUser)
 		|| PRL_WRONG_PTR(sPasswd)
 		)
@@ -494,7 +972,6 @@ PRL_HANDLE PrlSrv_DisableConfirmationMode_Impl(PRL_HANDLE hServer,
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_SET_SESSION_CONFIRMATION_MODE));
 	}
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->DisableConfirmationMode(sUser, sPasswd, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -518,17 +995,17 @@ PRL_ASYNC_METHOD( PrlSrv_DisableConfirmationMode ) (
 		nFlags
 		);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_DisableConfirmationMode,\
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_DisableConfirmationMode,\
 		(hServer, sUser, sPasswd, nFlags))
 }
 
 PRL_HANDLE PrlSrv_EnableConfirmationMode_Impl(PRL_HANDLE hServer,
 													PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER))
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if (!pServer)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_SET_SESSION_CONFIRMATION_MODE));
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->EnableConfirmationMode(nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -548,7 +1025,7 @@ PRL_ASYNC_METHOD( PrlSrv_EnableConfirmationMode ) (
 		nFlags
 		);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_EnableConfirmationMode,\
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_EnableConfirmationMode,\
 		(hServer, nFlags))
 }
 
@@ -565,10 +1042,10 @@ PRL_METHOD( PrlSrv_IsConfirmationModeEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(pbConfirmationModeEnabled))
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_PTR(pbConfirmationModeEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 
 	return pServer->IsConfirmationModeEnabled(pbConfirmationModeEnabled);
 }
@@ -583,7 +1060,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetSrvConfig ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_SRV_CONFIG)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetSrvConfig, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetSrvConfig, (hServer))
 }
 
 PRL_HANDLE PrlSrv_GetCommonPrefs_Impl(PRL_HANDLE hServer)
@@ -596,7 +1073,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetCommonPrefs ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_COMMON_PREFS)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetCommonPrefs, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetCommonPrefs, (hServer))
 }
 
 PRL_HANDLE PrlSrv_CommonPrefsBeginEdit_Impl(PRL_HANDLE hServer)
@@ -609,15 +1086,15 @@ PRL_ASYNC_METHOD( PrlSrv_CommonPrefsBeginEdit ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_COMMON_PREFS_BEGIN_EDIT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_CommonPrefsBeginEdit, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_CommonPrefsBeginEdit, (hServer))
 }
 
 PRL_HANDLE PrlSrv_CommonPrefsCommitEx_Impl(PRL_HANDLE hServer,	PRL_HANDLE hDispCfg, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_COMMON_PREFS_COMMIT))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->CommonPrefsCommit(hDispCfg, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -639,7 +1116,7 @@ PRL_ASYNC_METHOD( PrlSrv_CommonPrefsCommitEx ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_COMMON_PREFS_COMMIT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_CommonPrefsCommitEx, (hServer, hDispCfg, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_CommonPrefsCommitEx, (hServer, hDispCfg, nFlags))
 }
 
 PRL_HANDLE PrlSrv_GetUserProfile_Impl(PRL_HANDLE hServer)
@@ -652,7 +1129,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetUserProfile ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_USER_PROFILE)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetUserProfile, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetUserProfile, (hServer))
 }
 
 PRL_HANDLE PrlSrv_GetUserInfoList_Impl(PRL_HANDLE hServer)
@@ -665,7 +1142,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetUserInfoList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_USER_INFO_LIST)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetUserInfoList, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetUserInfoList, (hServer))
 }
 
 PRL_HANDLE PrlSrv_GetUserInfo_Impl(PRL_HANDLE hServer, PRL_CONST_STR sUserId)
@@ -679,21 +1156,21 @@ PRL_ASYNC_METHOD( PrlSrv_GetUserInfo ) (
 										)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_USER_INFO)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetUserInfo, (hServer, sUserId))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetUserInfo, (hServer, sUserId))
 }
 
 PRL_HANDLE PrlSrv_ConfigureGenericPci_Impl(PRL_HANDLE hServer, PRL_HANDLE hDevList, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hDevList, PHT_HANDLES_LIST)
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	PrlHandleHandlesListPtr pDevList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>( hDevList, PHT_HANDLES_LIST );
+	if (!pServer || !pDevList
 		|| PRL_WRONG_HANDLES_LIST(hDevList, PHT_HW_GENERIC_PCI_DEVICE))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CONFIGURE_GENERIC_PCI));
 
-	PrlHandleHandlesListPtr pDevList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hDevList);
 	QList<PrlHandleBasePtr> dev_list = pDevList->GetHandlesList();
 	if (dev_list.isEmpty())
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CONFIGURE_GENERIC_PCI));
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->ConfigureGenericPci(dev_list, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -714,7 +1191,7 @@ PRL_ASYNC_METHOD( PrlSrv_ConfigureGenericPci ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CONFIGURE_GENERIC_PCI)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_ConfigureGenericPci, (hServer, hDevList, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_ConfigureGenericPci, (hServer, hDevList, nFlags))
 }
 
 PRL_HANDLE PrlSrv_UserProfileBeginEdit_Impl(PRL_HANDLE hServer)
@@ -727,15 +1204,15 @@ PRL_ASYNC_METHOD( PrlSrv_UserProfileBeginEdit ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_USER_PROFILE_BEGIN_EDIT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UserProfileBeginEdit, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UserProfileBeginEdit, (hServer))
 }
 
 PRL_HANDLE PrlSrv_UserProfileCommit_Impl(PRL_HANDLE hServer,	PRL_HANDLE hUserProfile)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_USER_PROFILE_COMMIT))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->UserProfileCommit(hUserProfile);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -748,7 +1225,7 @@ PRL_ASYNC_METHOD( PrlSrv_UserProfileCommit ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_USER_PROFILE_COMMIT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UserProfileCommit, (hServer, hUserProfile))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UserProfileCommit, (hServer, hUserProfile))
 }
 
 PRL_METHOD( PrlSrv_IsConnected ) (
@@ -765,10 +1242,10 @@ PRL_METHOD( PrlSrv_IsConnected ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(pbConnected) || PRL_WRONG_PTR(pbIsConnectionLocal) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pbConnected) || PRL_WRONG_PTR(pbIsConnectionLocal) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 
 	PRL_RESULT ret = pServer->IsConnected(pbConnected);
 
@@ -791,10 +1268,10 @@ PRL_METHOD( PrlSrv_IsProxyConnection ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(pbProxyConnection) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pbProxyConnection) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 
 	PRL_RESULT ret = PRL_ERR_SUCCESS;
 	*pbProxyConnection = pServer->IsProxyConnection();
@@ -814,20 +1291,20 @@ PRL_METHOD( PrlSrv_GetServerInfo ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(phServerInfo) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(phServerInfo) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 
 	return (pServer->GetServerInfo(phServerInfo));
 }
 
 PRL_HANDLE PrlSrv_Shutdown_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER))
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if (!pServer)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_SHUTDOWN))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->Shutdown(nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -848,7 +1325,7 @@ PRL_ASYNC_METHOD( PrlSrv_ShutdownEx) (
 									)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_SHUTDOWN)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_Shutdown, (hServer, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_Shutdown, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_FsGetDiskList_Impl(PRL_HANDLE hServer)
@@ -861,7 +1338,7 @@ PRL_ASYNC_METHOD( PrlSrv_FsGetDiskList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_FS_GET_DISK_LIST)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_FsGetDiskList, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_FsGetDiskList, (hServer))
 }
 
 PRL_HANDLE PrlSrv_FsGetDirEntries_Impl(PRL_HANDLE hServer,	PRL_CONST_STR path)
@@ -875,7 +1352,7 @@ PRL_ASYNC_METHOD( PrlSrv_FsGetDirEntries ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_FS_GET_DIR_ENTRIES)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_FsGetDirEntries, (hServer, path))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_FsGetDirEntries, (hServer, path))
 }
 
 PRL_HANDLE PrlSrv_FsCreateDir_Impl(PRL_HANDLE hServer,	PRL_CONST_STR path)
@@ -889,7 +1366,7 @@ PRL_ASYNC_METHOD( PrlSrv_FsCreateDir ) (
 										)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_FS_CREATE_DIR)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_FsCreateDir, (hServer, path))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_FsCreateDir, (hServer, path))
 }
 
 PRL_HANDLE PrlSrv_FsRemoveEntry_Impl(PRL_HANDLE hServer,	PRL_CONST_STR path)
@@ -903,7 +1380,7 @@ PRL_ASYNC_METHOD( PrlSrv_FsRemoveEntry ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_FS_REMOVE_ENTRY)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_FsRemoveEntry, (hServer, path))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_FsRemoveEntry, (hServer, path))
 }
 
 PRL_HANDLE PrlSrv_FsCanCreateFile_Impl(PRL_HANDLE hServer,	PRL_CONST_STR path)
@@ -917,15 +1394,15 @@ PRL_ASYNC_METHOD( PrlSrv_FsCanCreateFile ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_FS_CAN_CREATE_FILE)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_FsCanCreateFile, (hServer, path))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_FsCanCreateFile, (hServer, path))
 }
 
 PRL_HANDLE PrlSrv_FsRenameEntry_Impl(PRL_HANDLE hServer,	PRL_CONST_STR oldPath, PRL_CONST_STR newPath)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(oldPath) || PRL_WRONG_PTR(newPath) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(oldPath) || PRL_WRONG_PTR(newPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_FS_RENAME_ENTRY))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->FsRenameEntry(oldPath, newPath);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -939,7 +1416,7 @@ PRL_ASYNC_METHOD( PrlSrv_FsRenameEntry ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_FS_RENAME_ENTRY)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_FsRenameEntry, (hServer, oldPath, newPath))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_FsRenameEntry, (hServer, oldPath, newPath))
 }
 
 PRL_HANDLE PrlSrv_FsGenerateEntryName_Impl(
@@ -950,10 +1427,10 @@ PRL_HANDLE PrlSrv_FsGenerateEntryName_Impl(
 							PRL_CONST_STR sIndexDelimiter
 							)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(sDirPath) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(sDirPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_FS_GENERATE_ENTRY_NAME))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->FsGenerateEntryName(sDirPath, sFilenamePrefix, sFilenameSuffix, sIndexDelimiter);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -969,7 +1446,7 @@ PRL_ASYNC_METHOD( PrlSrv_FsGenerateEntryName ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_FS_GENERATE_ENTRY_NAME)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_FsGenerateEntryName,\
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_FsGenerateEntryName,\
 		(hServer, sDirPath, sFilenamePrefix, sFilenameSuffix, sIndexDelimiter))
 }
 
@@ -980,10 +1457,10 @@ PRL_HANDLE PrlSrv_UpdateLicense_Impl(PRL_HANDLE hServer,
 											  PRL_UINT32 nFlags
 											  )
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER)  || PRL_WRONG_PTR( sKey ) || PRL_WRONG_PTR( sUser ) || PRL_WRONG_PTR( sCompany ) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer  || PRL_WRONG_PTR( sKey ) || PRL_WRONG_PTR( sUser ) || PRL_WRONG_PTR( sCompany ) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_LICENSE))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdUserUpdateLicense( sKey, sUser, sCompany, nFlags );
 	if ( !pJob )
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1009,7 +1486,7 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateLicenseEx ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_LICENSE)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateLicense, (hServer, sKey, sUser, sCompany, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateLicense, (hServer, sKey, sUser, sCompany, nFlags))
 }
 
 PRL_HANDLE PrlSrv_GetLicenseInfo_Impl(PRL_HANDLE hServer)
@@ -1022,7 +1499,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetLicenseInfo ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_LICENSE_INFO)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetLicenseInfo, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetLicenseInfo, (hServer))
 }
 
 PRL_HANDLE PrlSrv_RefreshPlugins_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
@@ -1037,14 +1514,14 @@ PRL_ASYNC_METHOD( PrlSrv_RefreshPlugins ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REFRESH_PLUGINS)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_RefreshPlugins, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_RefreshPlugins, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_GetPluginsList_Impl(PRL_HANDLE hServer, PRL_CONST_STR sClassId, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_GET_PLUGINS_LIST));
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->GetPluginsList(sClassId, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -1058,7 +1535,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetPluginsList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_PLUGINS_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetPluginsList, (hServer, sClassId, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetPluginsList, (hServer, sClassId, nFlags))
 }
 
 PRL_HANDLE PrlSrv_GetProblemReport_Impl(PRL_HANDLE hServer)
@@ -1071,7 +1548,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetProblemReport ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_PROBLEM_REPORT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetProblemReport, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetProblemReport, (hServer))
 }
 
 PRL_HANDLE PrlSrv_GetPackedProblemReport_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
@@ -1085,7 +1562,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetPackedProblemReport ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_PROBLEM_REPORT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetPackedProblemReport, (hServer,nFlags))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetPackedProblemReport, (hServer,nFlags))
 }
 
 PRL_HANDLE PrlSrv_AttachToLostTask_Impl(PRL_HANDLE hServer, PRL_CONST_STR sTaskId)
@@ -1099,7 +1576,7 @@ PRL_ASYNC_METHOD( PrlSrv_AttachToLostTask ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_ATTACH_TO_LOST_TASK)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_AttachToLostTask, (hServer, sTaskId))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_AttachToLostTask, (hServer, sTaskId))
 }
 
 PRL_METHOD( PrlSrv_IsFeatureSupported ) (
@@ -1117,20 +1594,20 @@ PRL_METHOD( PrlSrv_IsFeatureSupported ) (
 		pbIsSupported
 	);
 
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(pbIsSupported))
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_PTR(pbIsSupported))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 
 	return pServer->IsFeatureSupported(nFeatureId, pbIsSupported);
 }
 
 PRL_HANDLE PrlSrv_GetDiskFreeSpace_Impl(PRL_HANDLE hServer, PRL_CONST_STR sPath, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(sPath) )
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(sPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_GET_DISK_FREE_SPACE))
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->GetFreeDiskSpace(sPath, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -1144,7 +1621,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetDiskFreeSpace ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_DISK_FREE_SPACE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetDiskFreeSpace, (hServer, sPath, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetDiskFreeSpace, (hServer, sPath, nFlags))
 }
 
 PRL_HANDLE PrlSrv_SetVNCEncryption_Impl(
@@ -1154,7 +1631,8 @@ PRL_HANDLE PrlSrv_SetVNCEncryption_Impl(
 		PRL_UINT32 nFlags
 		)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) ||
+	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer, PHT_SERVER );
+	if (!pServer ||
 			PRL_WRONG_PTR(sPubKey) || PRL_WRONG_PTR(sPrivKey))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_STORE_VALUE_BY_KEY));
 
@@ -1167,7 +1645,6 @@ PRL_HANDLE PrlSrv_SetVNCEncryption_Impl(
 			EVT_PARAM_VNC_SSL_PRIVATE_KEY);
 	pEvent->addEventParameter(pEventParam);
 
-	PrlHandleServerDeprecatedPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDeprecated>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdStorageSetValue(PRL_KEY_SET_VNC_ENCRYPTION_DATA,
 				QSTR2UTF8(pEvent->toString()), nFlags);
 	if (!pJob)
@@ -1183,7 +1660,7 @@ PRL_ASYNC_METHOD( PrlSrv_SetVNCEncryption ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_STORE_VALUE_BY_KEY)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SetVNCEncryption,
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SetVNCEncryption,
 				(hServer, sPubKey, sPrivKey, nFlags))
 }
 
@@ -1200,10 +1677,10 @@ PRL_METHOD( PrlFsInfo_GetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsInfo, PHT_REMOTE_FILESYSTEM_INFO) || PRL_WRONG_PTR(pnFsType) )
+	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo, PHT_REMOTE_FILESYSTEM_INFO );
+	if ( !pFsInfo || PRL_WRONG_PTR(pnFsType) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo );
 
 	return pFsInfo->GetFSType(pnFsType);
 }
@@ -1221,10 +1698,10 @@ PRL_METHOD( PrlFsInfo_GetFsType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsInfo, PHT_REMOTE_FILESYSTEM_INFO) || PRL_WRONG_PTR(pnFsType) )
+	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo, PHT_REMOTE_FILESYSTEM_INFO );
+	if ( !pFsInfo || PRL_WRONG_PTR(pnFsType) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo );
 
 	return pFsInfo->GetFileSystemType(pnFsType);
 }
@@ -1242,10 +1719,10 @@ PRL_METHOD( PrlFsInfo_GetChildEntriesCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsInfo, PHT_REMOTE_FILESYSTEM_INFO) || PRL_WRONG_PTR(pnChildEntriesCount) )
+	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo, PHT_REMOTE_FILESYSTEM_INFO );
+	if ( !pFsInfo || PRL_WRONG_PTR(pnChildEntriesCount) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo );
 
 	return pFsInfo->GetChildEntriesCount(pnChildEntriesCount);
 }
@@ -1265,10 +1742,10 @@ PRL_METHOD( PrlFsInfo_GetChildEntry ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsInfo, PHT_REMOTE_FILESYSTEM_INFO) || PRL_WRONG_PTR(phChildEntry) )
+	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo, PHT_REMOTE_FILESYSTEM_INFO );
+	if ( !pFsInfo || PRL_WRONG_PTR(phChildEntry) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo );
 
 	return pFsInfo->GetChildEntry(nIndex, phChildEntry);
 }
@@ -1286,10 +1763,10 @@ PRL_METHOD( PrlFsInfo_GetParentEntry ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsInfo, PHT_REMOTE_FILESYSTEM_INFO) || PRL_WRONG_PTR(phParentEntry) )
+	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo, PHT_REMOTE_FILESYSTEM_INFO );
+	if ( !pFsInfo || PRL_WRONG_PTR(phParentEntry) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsInfoPtr pFsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsInfo>( hFsInfo );
 
 	return pFsInfo->GetParentEntry(phParentEntry);
 }
@@ -1309,11 +1786,11 @@ PRL_METHOD( PrlFsEntry_GetAbsolutePath ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY)
+	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY );
+	if ( !pFsEntry
 		|| PRL_WRONG_PTR(pnAbsolutePathBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry );
 
 	return pFsEntry->GetAbsolutePath(sAbsolutePath, pnAbsolutePathBufLength);
 }
@@ -1333,11 +1810,11 @@ PRL_METHOD( PrlFsEntry_GetRelativeName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY)
+	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY );
+	if ( !pFsEntry
 		|| PRL_WRONG_PTR(pnRelativeNameBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry );
 
 	return pFsEntry->GetRelativeName(sRelativeName, pnRelativeNameBufLength);
 }
@@ -1357,11 +1834,11 @@ PRL_METHOD( PrlFsEntry_GetLastModifiedDate ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY)
+	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY );
+	if ( !pFsEntry
 		|| PRL_WRONG_PTR(pnFsEntryLastModifiedDateBufLength) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry );
 
 	return pFsEntry->GetLastModifiedDate(sFsEntryLastModifiedDate, pnFsEntryLastModifiedDateBufLength);
 }
@@ -1379,10 +1856,10 @@ PRL_METHOD( PrlFsEntry_GetSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY );
+	if ( !pFsEntry || PRL_WRONG_PTR(pnSize) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry );
 
 	return pFsEntry->GetSize(pnSize);
 }
@@ -1400,10 +1877,10 @@ PRL_METHOD( PrlFsEntry_GetPermissions ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY) || PRL_WRONG_PTR(pnPermissions) )
+	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY );
+	if ( !pFsEntry || PRL_WRONG_PTR(pnPermissions) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry );
 
 	return pFsEntry->GetPermissions(pnPermissions);
 }
@@ -1421,10 +1898,10 @@ PRL_METHOD( PrlFsEntry_GetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY) || PRL_WRONG_PTR(pnFsEntryType) )
+	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry, PHT_REMOTE_FILESYSTEM_ENTRY );
+	if ( !pFsEntry || PRL_WRONG_PTR(pnFsEntryType) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleRemoteFsEntryPtr pFsEntry = PRL_OBJECT_BY_HANDLE<PrlHandleRemoteFsEntry>( hFsEntry );
 
 	return pFsEntry->GetEntryType(pnFsEntryType);
 }
@@ -1442,10 +1919,10 @@ PRL_METHOD( PrlSrvCfg_GetHostRamSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnHostRamSize))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnHostRamSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetHostRamSize(pnHostRamSize);
 }
@@ -1465,11 +1942,11 @@ PRL_METHOD( PrlSrvCfg_GetCpuModel ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) ||
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig ||
 		PRL_WRONG_PTR(pnCpuModelBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetCpuModel(sCpuModel, pnCpuModelBufLength));
 }
@@ -1487,10 +1964,10 @@ PRL_METHOD( PrlSrvCfg_GetCpuCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnCpuCount))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnCpuCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetCpuCount(pnCpuCount);
 }
@@ -1508,10 +1985,10 @@ PRL_METHOD( PrlSrvCfg_GetCpuSpeed ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnCpuSpeed))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnCpuSpeed))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetCpuSpeed(pnCpuSpeed);
 }
@@ -1529,10 +2006,10 @@ PRL_METHOD( PrlSrvCfg_GetCpuMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnCpuMode))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnCpuMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetCpuMode(pnCpuMode);
 }
@@ -1550,10 +2027,10 @@ PRL_METHOD( PrlSrvCfg_GetCpuHvt ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnCpuHvt))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnCpuHvt))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetCpuVtxMode(pnCpuHvt);
 }
@@ -1571,10 +2048,10 @@ PRL_METHOD( PrlSrvCfg_GetHostOsType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnHostOsType))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnHostOsType))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetHostOsType(pnHostOsType);
 }
@@ -1592,10 +2069,10 @@ PRL_METHOD( PrlSrvCfg_GetHostOsMajor ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnHostOsMajor))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnHostOsMajor))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetHostOsMajor(pnHostOsMajor);
 }
@@ -1613,10 +2090,10 @@ PRL_METHOD( PrlSrvCfg_GetHostOsMinor ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnHostOsMinor))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnHostOsMinor))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetHostOsMinor(pnHostOsMinor);
 }
@@ -1634,10 +2111,10 @@ PRL_METHOD( PrlSrvCfg_GetHostOsSubMinor ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnHostOsSubMinor))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnHostOsSubMinor))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetHostOsSubMinor(pnHostOsSubMinor);
 }
@@ -1657,11 +2134,11 @@ PRL_METHOD( PrlSrvCfg_GetHostOsStrPresentation ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) ||
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig ||
 		PRL_WRONG_PTR(pnHostOsStrPresentationBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetHostOsStrPresentation(sHostOsStrPresentation, pnHostOsStrPresentationBufLength));
 }
@@ -1679,10 +2156,10 @@ PRL_METHOD( PrlSrvCfg_IsSoundDefaultEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pbSoundDefaultEnabled))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pbSoundDefaultEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->IsSoundDefaultEnabled(pbSoundDefaultEnabled);
 }
@@ -1700,10 +2177,10 @@ PRL_METHOD( PrlSrvCfg_IsUsbSupported ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pbUsbSupported))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pbUsbSupported))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->IsUsbSupported(pbUsbSupported);
 }
@@ -1721,10 +2198,10 @@ PRL_METHOD( PrlSrvCfg_IsVtdSupported ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pbVtdSupported))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pbVtdSupported))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->IsVtdSupported(pbVtdSupported);
 }
@@ -1742,10 +2219,10 @@ PRL_METHOD( PrlSrvCfg_GetMaxHostNetAdapters ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnMaxNetAdaptersCount))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnMaxNetAdaptersCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetMaxHostNetAdapters(pnMaxNetAdaptersCount);
 }
@@ -1763,10 +2240,10 @@ PRL_METHOD( PrlSrvCfg_GetMaxVmNetAdapters ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pnMaxNetAdaptersCount))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pnMaxNetAdaptersCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetMaxVmNetAdapters(pnMaxNetAdaptersCount);
 }
@@ -1786,11 +2263,11 @@ PRL_METHOD( PrlSrvCfg_GetHostname ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) ||
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig ||
 		PRL_WRONG_PTR(pnHostnameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetHostname(sHostname, pnHostnameBufLength));
 }
@@ -1810,11 +2287,11 @@ PRL_METHOD( PrlSrvCfg_GetDefaultGateway ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) ||
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig ||
 		PRL_WRONG_PTR(pnDefaultGatewayBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetDefaultGateway(sDefaultGateway, pnDefaultGatewayBufLength));
 }
@@ -1834,11 +2311,11 @@ PRL_METHOD( PrlSrvCfg_GetDefaultGatewayIPv6 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) ||
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig ||
 		PRL_WRONG_PTR(pnDefaultGatewayBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetDefaultGatewayIPv6(sDefaultGateway, pnDefaultGatewayBufLength));
 }
@@ -1856,11 +2333,11 @@ PRL_METHOD( PrlSrvCfg_GetDnsServers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) ||
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig ||
 		PRL_WRONG_PTR(phDnsServersList))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetDnsServers(phDnsServersList));
 }
@@ -1878,11 +2355,11 @@ PRL_METHOD( PrlSrvCfg_GetSearchDomains ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) ||
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig ||
 		PRL_WRONG_PTR(phSearchDomainsList))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetSearchDomains(phSearchDomainsList));
 }
@@ -1894,9 +2371,9 @@ PRL_METHOD( PrlSrvCfg_GetSearchDomains ) (
 	pn##device_name##sCount\
 	);\
 	SYNC_CHECK_API_INITIALIZED\
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pn##device_name##sCount))\
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );\
+	if (!pSrvConfig || PRL_WRONG_PTR(pn##device_name##sCount))\
 	return (PRL_ERR_INVALID_ARG);\
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );\
 	return pSrvConfig->Get##device_name##sCount(pn##device_name##sCount);
 
 #define GET_HW_DEVICE(device_name)\
@@ -1906,9 +2383,9 @@ PRL_METHOD( PrlSrvCfg_GetSearchDomains ) (
 	phDevice\
 	);\
 	SYNC_CHECK_API_INITIALIZED\
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(phDevice))\
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );\
+	if (!pSrvConfig || PRL_WRONG_PTR(phDevice))\
 	return (PRL_ERR_INVALID_ARG);\
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );\
 	return pSrvConfig->Get##device_name(nIndex, phDevice);
 
 PRL_METHOD(PrlSrvCfg_GetFloppyDisksCount) (
@@ -2121,10 +2598,10 @@ PRL_METHOD( PrlSrvCfg_GetCpuFeatures) (PRL_HANDLE hSrvConfig, PRL_CPU_FEATURES_P
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(pCpuFeatures))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(pCpuFeatures))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return (pSrvConfig->GetCpuFeatures(pCpuFeatures));
 }
@@ -2142,10 +2619,10 @@ PRL_METHOD( PrlSrvCfg_GetCpuFeaturesEx ) (
 		phCpuFeatures
 	);
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(phCpuFeatures))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(phCpuFeatures))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetCpuFeaturesEx(phCpuFeatures);
 }
@@ -2163,10 +2640,10 @@ PRL_METHOD( PrlSrvCfg_GetCpuFeaturesMaskingCapabilities ) (
 		phCpuFeatures
 	);
 
-	if (PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG) || PRL_WRONG_PTR(phCpuFeatures))
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (!pSrvConfig || PRL_WRONG_PTR(phCpuFeatures))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig );
 
 	return pSrvConfig->GetCpuFeaturesMaskingCapabilities(phCpuFeatures);
 }
@@ -2329,11 +2806,11 @@ PRL_METHOD(PrlSrvCfgHdd_GetDevName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHardDisk, PHT_HW_HARD_DISK) ||
+	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk, PHT_HW_HARD_DISK );
+	if (!pHardDisk ||
 		PRL_WRONG_PTR(pnDevNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk );
 
 	return (pHardDisk->GetDevName(sDevName, pnDevNameBufLength));
 }
@@ -2353,11 +2830,11 @@ PRL_METHOD(PrlSrvCfgHdd_GetDevId) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHardDisk, PHT_HW_HARD_DISK) ||
+	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk, PHT_HW_HARD_DISK );
+	if (!pHardDisk ||
 		PRL_WRONG_PTR(pnDevIdBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk );
 
 	return (pHardDisk->GetDevId(sDevId, pnDevIdBufLength));
 }
@@ -2375,11 +2852,11 @@ PRL_METHOD(PrlSrvCfgHdd_GetDevSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHardDisk, PHT_HW_HARD_DISK) ||
+	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk, PHT_HW_HARD_DISK );
+	if (!pHardDisk ||
 		PRL_WRONG_PTR(pnSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk );
 
 	return (pHardDisk->GetDevSize(pnSize));
 }
@@ -2397,11 +2874,11 @@ PRL_METHOD(PrlSrvCfgHdd_GetDiskIndex) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHardDisk, PHT_HW_HARD_DISK) ||
+	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk, PHT_HW_HARD_DISK );
+	if (!pHardDisk ||
 		PRL_WRONG_PTR(pnIndex))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk );
 
 	return (pHardDisk->GetDiskIndex(pnIndex));
 }
@@ -2419,11 +2896,11 @@ PRL_METHOD(PrlSrvCfgHdd_GetPartsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHardDisk, PHT_HW_HARD_DISK) ||
+	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk, PHT_HW_HARD_DISK );
+	if (!pHardDisk ||
 		PRL_WRONG_PTR(pnPartsCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk );
 
 	return (pHardDisk->GetPartsCount(pnPartsCount));
 }
@@ -2442,11 +2919,11 @@ PRL_METHOD(PrlSrvCfgHdd_GetPart) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hHardDisk, PHT_HW_HARD_DISK) ||
+	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk, PHT_HW_HARD_DISK );
+	if (!pHardDisk ||
 		PRL_WRONG_PTR(phPart))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHardDiskPtr pHardDisk = PRL_OBJECT_BY_HANDLE<PrlHandleHwHardDisk>( hHardDisk );
 
 	return (pHardDisk->GetPart(nIndex, phPart));
 }
@@ -2466,11 +2943,11 @@ PRL_METHOD(PrlSrvCfgHddPart_GetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pnNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->GetName(sName, pnNameBufLength));
 }
@@ -2490,11 +2967,11 @@ PRL_METHOD(PrlSrvCfgHddPart_GetSysName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pnSysNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->GetSysName(sSysName, pnSysNameBufLength));
 }
@@ -2512,11 +2989,11 @@ PRL_METHOD(PrlSrvCfgHddPart_GetSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pnSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->GetSize(pnSize));
 }
@@ -2534,11 +3011,11 @@ PRL_METHOD(PrlSrvCfgHddPart_GetIndex) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pnIndex))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->GetIndex(pnIndex));
 }
@@ -2556,11 +3033,11 @@ PRL_METHOD(PrlSrvCfgHddPart_GetType) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pnType))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->GetPartType(pnType));
 }
@@ -2578,11 +3055,11 @@ PRL_METHOD(PrlSrvCfgHddPart_IsInUse) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pbInUse))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->IsInUse(pbInUse));
 }
@@ -2600,11 +3077,11 @@ PRL_METHOD(PrlSrvCfgHddPart_IsLogical) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pbLogical))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->IsLogical(pbLogical));
 }
@@ -2622,11 +3099,11 @@ PRL_METHOD(PrlSrvCfgHddPart_IsActive) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPart, PHT_HW_HARD_DISK_PARTITION) ||
+	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart, PHT_HW_HARD_DISK_PARTITION );
+	if (!pHddPart ||
 		PRL_WRONG_PTR(pbActive))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwHddPartPtr pHddPart = PRL_OBJECT_BY_HANDLE<PrlHandleHwHddPart>( hPart );
 
 	return (pHddPart->IsActive(pbActive));
 }
@@ -2644,11 +3121,11 @@ PRL_METHOD(PrlSrvCfgNet_GetNetAdapterType) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pnNetAdapterType))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetNetAdapterType(pnNetAdapterType));
 }
@@ -2666,11 +3143,11 @@ PRL_METHOD(PrlSrvCfgNet_GetSysIndex) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pnSysIndex))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetSysIndex(pnSysIndex));
 }
@@ -2688,11 +3165,11 @@ PRL_METHOD(PrlSrvCfgNet_IsEnabled) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pbEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->IsEnabled(pbEnabled));
 }
@@ -2710,11 +3187,11 @@ PRL_METHOD(PrlSrvCfgNet_IsConfigureWithDhcp) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pbConfigureWithDhcp))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->IsConfigureWithDhcp(pbConfigureWithDhcp));
 }
@@ -2732,11 +3209,11 @@ PRL_METHOD(PrlSrvCfgNet_IsConfigureWithDhcpIPv6) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pbConfigureWithDhcp))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->IsConfigureWithDhcpIPv6(pbConfigureWithDhcp));
 }
@@ -2756,11 +3233,11 @@ PRL_METHOD(PrlSrvCfgNet_GetDefaultGateway) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pnDefaultGatewayBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetDefaultGateway(sDefaultGateway, pnDefaultGatewayBufLength));
 }
@@ -2780,11 +3257,11 @@ PRL_METHOD(PrlSrvCfgNet_GetDefaultGatewayIPv6) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pnDefaultGatewayBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetDefaultGatewayIPv6(sDefaultGateway, pnDefaultGatewayBufLength));
 }
@@ -2804,11 +3281,11 @@ PRL_METHOD(PrlSrvCfgNet_GetMacAddress) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pnMacAddressBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetMacAddress(sMacAddress, pnMacAddressBufLength));
 }
@@ -2826,11 +3303,11 @@ PRL_METHOD( PrlSrvCfgNet_GetNetAddresses ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(phNetAddressesList))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetNetAddresses(phNetAddressesList));
 }
@@ -2848,11 +3325,11 @@ PRL_METHOD( PrlSrvCfgNet_GetDnsServers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(phDnsServersList))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetDnsServers(phDnsServersList));
 }
@@ -2870,11 +3347,11 @@ PRL_METHOD( PrlSrvCfgNet_GetSearchDomains ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(phSearchDomainsList))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetSearchDomains(phSearchDomainsList));
 }
@@ -2892,11 +3369,11 @@ PRL_METHOD(PrlSrvCfgNet_GetVlanTag) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetAdapter, PHT_HW_NET_ADAPTER) ||
+	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter, PHT_HW_NET_ADAPTER );
+	if (!pNetAdapter ||
 		PRL_WRONG_PTR(pnVlanTag))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleHwNetAdapter>( hNetAdapter );
 
 	return (pNetAdapter->GetVlanTag(pnVlanTag));
 }
@@ -2914,11 +3391,11 @@ PRL_METHOD( PrlSrvCfgPci_GetDeviceClass ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hGenericPci, PHT_HW_GENERIC_PCI_DEVICE) ||
+	PrlHandleHwGenericPciDevicePtr pGenericPci = PRL_OBJECT_BY_HANDLE<PrlHandleHwGenericPciDevice>( hGenericPci, PHT_HW_GENERIC_PCI_DEVICE );
+	if (!pGenericPci ||
 		PRL_WRONG_PTR(pnGenericPciClass))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwGenericPciDevicePtr pGenericPci = PRL_OBJECT_BY_HANDLE<PrlHandleHwGenericPciDevice>( hGenericPci );
 
 	return (pGenericPci->GetDeviceClass(pnGenericPciClass));
 }
@@ -2936,11 +3413,11 @@ PRL_METHOD( PrlSrvCfgPci_IsPrimaryDevice ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-		if (PRL_WRONG_HANDLE(hGenericPci, PHT_HW_GENERIC_PCI_DEVICE) ||
+		PrlHandleHwGenericPciDevicePtr pGenericPci = PRL_OBJECT_BY_HANDLE<PrlHandleHwGenericPciDevice>( hGenericPci, PHT_HW_GENERIC_PCI_DEVICE );
+		if (!pGenericPci ||
 			PRL_WRONG_PTR(pbIsPrimaryDevice))
 			return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleHwGenericPciDevicePtr pGenericPci = PRL_OBJECT_BY_HANDLE<PrlHandleHwGenericPciDevice>( hGenericPci );
 
 	return (pGenericPci->IsPrimary(pbIsPrimaryDevice));
 }
@@ -2960,11 +3437,11 @@ PRL_METHOD( PrlUsrCfg_GetVmDirUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) ||
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile ||
 		PRL_WRONG_PTR(pnVmDirUuidBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->GetVmDirUuid(sVmDirUuid, pnVmDirUuidBufLength));
 }
@@ -2982,11 +3459,11 @@ PRL_METHOD( PrlUsrCfg_SetVmDirUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) ||
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile ||
 		PRL_WRONG_PTR(sNewVmDirUuid))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->SetVmDirUuid(sNewVmDirUuid));
 }
@@ -3006,11 +3483,11 @@ PRL_METHOD( PrlUsrCfg_GetDefaultVmFolder ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) ||
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile ||
 		PRL_WRONG_PTR(pnDefaultVmFolderBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->GetDefaultVmFolder(sDefaultVmFolder, pnDefaultVmFolderBufLength));
 }
@@ -3028,11 +3505,11 @@ PRL_METHOD( PrlUsrCfg_SetDefaultVmFolder ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) ||
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile ||
 		PRL_WRONG_PTR(sNewDefaultVmFolder))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->SetDefaultVmFolder(sNewDefaultVmFolder));
 }
@@ -3050,11 +3527,11 @@ PRL_METHOD( PrlUsrCfg_CanUseMngConsole ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) ||
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile ||
 		PRL_WRONG_PTR(pbCanUseMngConsole))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->CanUseMngConsole(pbCanUseMngConsole));
 }
@@ -3072,11 +3549,11 @@ PRL_METHOD( PrlUsrCfg_CanChangeSrvSets ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) ||
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile ||
 		PRL_WRONG_PTR(pbCanChangeSrvSets))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->CanChangeSrvSets(pbCanChangeSrvSets));
 }
@@ -3094,11 +3571,11 @@ PRL_METHOD( PrlUsrCfg_IsLocalAdministrator ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserProfile, PHT_USER_PROFILE) ||
+	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile, PHT_USER_PROFILE );
+	if (!pUserProfile ||
 		PRL_WRONG_PTR(pbIsLocalAdministrator))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserProfilePtr pUserProfile = PRL_OBJECT_BY_HANDLE<PrlHandleUserProfile>( hUserProfile );
 
 	return (pUserProfile->IsLocalAdministrator(pbIsLocalAdministrator));
 }
@@ -3118,11 +3595,11 @@ PRL_METHOD( PrlUsrInfo_GetName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserInfo, PHT_USER_INFO) ||
+	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo, PHT_USER_INFO );
+	if (!pUserInfo ||
 		PRL_WRONG_PTR(pnNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo );
 
 	return (pUserInfo->GetName(sName, pnNameBufLength));
 }
@@ -3142,11 +3619,11 @@ PRL_METHOD( PrlUsrInfo_GetUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserInfo, PHT_USER_INFO) ||
+	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo, PHT_USER_INFO );
+	if (!pUserInfo ||
 		PRL_WRONG_PTR(pnUuidBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo );
 
 	return (pUserInfo->GetUuid(sUuid, pnUuidBufLength));
 }
@@ -3164,11 +3641,11 @@ PRL_METHOD( PrlUsrInfo_GetSessionCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserInfo, PHT_USER_INFO) ||
+	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo, PHT_USER_INFO );
+	if (!pUserInfo ||
 		PRL_WRONG_PTR(pnSessionCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo );
 
 	return (pUserInfo->GetSessionCount(pnSessionCount));
 }
@@ -3188,11 +3665,11 @@ PRL_METHOD( PrlUsrInfo_GetDefaultVmFolder ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserInfo, PHT_USER_INFO) ||
+	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo, PHT_USER_INFO );
+	if (!pUserInfo ||
 		PRL_WRONG_PTR(pnDefaultVmFolderBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo );
 
 	return (pUserInfo->GetDefaultVmFolder(sDefaultVmFolder, pnDefaultVmFolderBufLength));
 }
@@ -3210,11 +3687,11 @@ PRL_METHOD( PrlUsrInfo_CanChangeSrvSets ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hUserInfo, PHT_USER_INFO) ||
+	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo, PHT_USER_INFO );
+	if (!pUserInfo ||
 		PRL_WRONG_PTR(pbCanChangeSrvSets))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleUserInfoPtr pUserInfo = PRL_OBJECT_BY_HANDLE<PrlHandleUserInfo>( hUserInfo );
 
 	return (pUserInfo->CanChangeSrvSets(pbCanChangeSrvSets));
 }
@@ -3234,11 +3711,11 @@ PRL_METHOD( PrlDispCfg_GetDefaultVmDir ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnDefaultVmDirBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetDefaultVmDir(sDefaultVmDir, pnDefaultVmDirBufLength));
 }
@@ -3251,11 +3728,11 @@ PRL_METHOD( PrlDispCfg_GetDefaultCtDir ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnDefaultVmDirBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetDefaultCtDir(sDefaultVmDir, pnDefaultVmDirBufLength));
 }
@@ -3273,11 +3750,11 @@ PRL_METHOD( PrlDispCfg_GetReservedMemLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnMemSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetReservedMemLimit(pnMemSize));
 }
@@ -3295,10 +3772,10 @@ PRL_METHOD( PrlDispCfg_SetReservedMemLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetReservedMemLimit(nMemSize));
 }
@@ -3316,11 +3793,11 @@ PRL_METHOD( PrlDispCfg_GetMinVmMem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnMemSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetMinVmMem(pnMemSize));
 }
@@ -3338,10 +3815,10 @@ PRL_METHOD( PrlDispCfg_SetMinVmMem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetMinVmMem(nMemSize));
 }
@@ -3359,11 +3836,11 @@ PRL_METHOD( PrlDispCfg_GetMaxVmMem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnMemSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetMaxVmMem(pnMemSize));
 }
@@ -3381,10 +3858,10 @@ PRL_METHOD( PrlDispCfg_SetMaxVmMem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetMaxVmMem(nMemSize));
 }
@@ -3402,11 +3879,11 @@ PRL_METHOD( PrlDispCfg_GetRecommendMaxVmMem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnMemSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetRecommendMaxVmMem(pnMemSize));
 }
@@ -3424,10 +3901,10 @@ PRL_METHOD( PrlDispCfg_SetRecommendMaxVmMem ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetRecommendMaxVmMem(nMemSize));
 }
@@ -3445,11 +3922,11 @@ PRL_METHOD( PrlDispCfg_GetMaxReservMemLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnMemSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetMaxReservMemLimit(pnMemSize));
 }
@@ -3467,10 +3944,10 @@ PRL_METHOD( PrlDispCfg_SetMaxReservMemLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetMaxReservMemLimit(nMemSize));
 }
@@ -3488,11 +3965,11 @@ PRL_METHOD( PrlDispCfg_GetMinReservMemLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnMemSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetMinReservMemLimit(pnMemSize));
 }
@@ -3510,10 +3987,10 @@ PRL_METHOD( PrlDispCfg_SetMinReservMemLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetMinReservMemLimit(nMemSize));
 }
@@ -3531,11 +4008,11 @@ PRL_METHOD( PrlDispCfg_IsAdjustMemAuto ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbAdjustMemAuto))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsAdjustMemAuto(pbAdjustMemAuto));
 }
@@ -3553,10 +4030,10 @@ PRL_METHOD( PrlDispCfg_SetAdjustMemAuto ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetAdjustMemAuto(bAdjustMemAuto));
 }
@@ -3574,11 +4051,11 @@ PRL_METHOD( PrlDispCfg_IsSendStatisticReport ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbSendStatisticReport))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsSendStatisticReport(pbSendStatisticReport));
 }
@@ -3596,10 +4073,10 @@ PRL_METHOD( PrlDispCfg_SetSendStatisticReport ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetSendStatisticReport(bSendStatisticReport));
 }
@@ -3619,11 +4096,11 @@ PRL_METHOD( PrlDispCfg_GetDefaultVNCHostName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnBaseHostNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetRemoteDisplayBaseHostName(sBaseHostName, pnBaseHostNameBufLength));
 }
@@ -3641,11 +4118,11 @@ PRL_METHOD( PrlDispCfg_SetDefaultVNCHostName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(sNewBaseHostName))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetRemoteDisplayBaseHostName(sNewBaseHostName));
 }
@@ -3663,11 +4140,11 @@ PRL_METHOD( PrlDispCfg_GetVNCBasePort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnPort))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetRemoteDisplayBasePort(pnPort));
 }
@@ -3685,10 +4162,10 @@ PRL_METHOD( PrlDispCfg_SetVNCBasePort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetRemoteDisplayBasePort(nPort));
 }
@@ -3700,11 +4177,11 @@ PRL_METHOD( PrlDispCfg_GetVNCMaxPort ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnPort))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetRemoteDisplayMaxPort(pnPort));
 }
@@ -3722,11 +4199,11 @@ PRL_METHOD( PrlDispCfg_CanChangeDefaultSettings ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbDefaultChangeSettings))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->CanChangeDefaultSettings(pbDefaultChangeSettings));
 }
@@ -3744,10 +4221,10 @@ PRL_METHOD( PrlDispCfg_SetCanChangeDefaultSettings ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetCanChangeDefaultSettings(bDefaultChangeSettings));
 }
@@ -3765,11 +4242,11 @@ PRL_METHOD( PrlDispCfg_GetMinSecurityLevel ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnMinSecurityLevel))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetMinSecurityLevel(pnMinSecurityLevel));
 }
@@ -3787,10 +4264,10 @@ PRL_METHOD( PrlDispCfg_SetMinSecurityLevel ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetMinSecurityLevel(nMinSecurityLevel));
 }
@@ -3808,11 +4285,11 @@ PRL_METHOD( PrlDispCfg_GetConfirmationsList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(phConfirmList))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetConfirmationsList(phConfirmList));
 }
@@ -3830,11 +4307,11 @@ PRL_METHOD( PrlDispCfg_GetCpuPool ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(phCpuPool))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetCpuPool(phCpuPool));
 }
@@ -3852,13 +4329,12 @@ PRL_METHOD( PrlDispCfg_SetConfirmationsList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG)
-		 || PRL_WRONG_HANDLE(hConfirmList, PHT_OPAQUE_TYPE_LIST))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	PrlHandleOpTypeListPtr pList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hConfirmList, PHT_OPAQUE_TYPE_LIST );
+	if ( !pDispConfig
+		 || !pList)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
-	PrlHandleOpTypeListPtr pList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>(hConfirmList);
-
 	return (pDispConfig->SetConfirmationsList(pList));
 }
 
@@ -3877,11 +4353,11 @@ PRL_METHOD( PrlDispCfg_GetDefaultBackupServer) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnBackupServerBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetDefaultBackupServer(sBackupServer, pnBackupServerBufLength));
 }
@@ -3899,10 +4375,10 @@ PRL_METHOD( PrlDispCfg_SetDefaultBackupServer) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetDefaultBackupServer(sBackupServer));
 }
@@ -3922,11 +4398,11 @@ PRL_METHOD( PrlDispCfg_GetBackupTmpDir) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnBackupTmpDirBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetBackupTmpDir(sBackupTmpDir, pnBackupTmpDirBufLength));
 }
@@ -3944,10 +4420,10 @@ PRL_METHOD( PrlDispCfg_SetBackupTmpDir) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupTmpDir(sBackupTmpDir));
 }
@@ -3967,11 +4443,11 @@ PRL_METHOD( PrlDispCfg_GetBackupUserLogin) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnUserLoginBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetBackupUserLogin(sUserLogin, pnUserLoginBufLength));
 }
@@ -3989,10 +4465,10 @@ PRL_METHOD( PrlDispCfg_SetBackupUserLogin) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupUserLogin(sUserLogin));
 }
@@ -4010,10 +4486,10 @@ PRL_METHOD( PrlDispCfg_SetBackupUserPassword) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupUserPassword(sUserPassword));
 }
@@ -4031,11 +4507,11 @@ PRL_METHOD( PrlDispCfg_IsBackupUserPasswordEnabled) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbUserPasswordEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsBackupUserPasswordEnabled(pbUserPasswordEnabled));
 }
@@ -4053,10 +4529,10 @@ PRL_METHOD( PrlDispCfg_SetBackupUserPasswordEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupUserPasswordEnabled(bUserPasswordEnabled));
 }
@@ -4076,11 +4552,11 @@ PRL_METHOD( PrlDispCfg_GetDefaultBackupDirectory ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnBackupDirectoryBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetDefaultBackupDirectory(sBackupDirectory, pnBackupDirectoryBufLength));
 }
@@ -4098,10 +4574,10 @@ PRL_METHOD( PrlDispCfg_SetDefaultBackupDirectory ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetDefaultBackupDirectory(sBackupDirectory));
 }
@@ -4118,10 +4594,10 @@ PRL_METHOD( PrlDispCfg_SetBackupMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupMode(sBackupMode));
 }
@@ -4138,10 +4614,10 @@ PRL_METHOD( PrlDispCfg_GetBackupMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pnBackupMode))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_PTR(pnBackupMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetBackupMode(pnBackupMode));
 }
@@ -4159,10 +4635,10 @@ PRL_METHOD( PrlDispCfg_GetBackupTimeout ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pnBackupTimeout))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_PTR(pnBackupTimeout))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetBackupTimeout(pnBackupTimeout));
 }
@@ -4180,10 +4656,10 @@ PRL_METHOD( PrlDispCfg_SetBackupTimeout ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupTimeout(nTimeout));
 }
@@ -4201,10 +4677,10 @@ PRL_METHOD( PrlDispCfg_IsBackupCompressionEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pbFlag))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_PTR(pbFlag))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsBackupCompressionEnabled(pbFlag));
 }
@@ -4222,10 +4698,10 @@ PRL_METHOD( PrlDispCfg_SetBackupCompression ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupCompressionFlag(bFlag));
 }
@@ -4243,10 +4719,10 @@ PRL_METHOD( PrlDispCfg_IsBackupTunnelEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pbFlag))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_PTR(pbFlag))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsBackupTunnelEnabled(pbFlag));
 }
@@ -4264,10 +4740,10 @@ PRL_METHOD( PrlDispCfg_SetBackupTunnel ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetBackupTunnelFlag(bFlag));
 }
@@ -4285,11 +4761,11 @@ PRL_METHOD( PrlDispCfg_ArePluginsEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbIsPluginsAllowed))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->ArePluginsEnabled(pbIsPluginsAllowed));
 }
@@ -4307,10 +4783,10 @@ PRL_METHOD( PrlDispCfg_EnablePlugins ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->EnablePlugins(bEnablePluginsSupport));
 }
@@ -4328,11 +4804,11 @@ PRL_METHOD( PrlDispCfg_GetVmCpuLimitType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pnVmCpuLimitType))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->GetVmCpuLimitType(pnVmCpuLimitType));
 }
@@ -4350,10 +4826,10 @@ PRL_METHOD( PrlDispCfg_SetVmCpuLimitType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->SetVmCpuLimitType(nVmCpuLimitType));
 }
@@ -4371,11 +4847,11 @@ PRL_METHOD( PrlDispCfg_IsVerboseLogEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsVerboseLogEnabled(pbEnabled));
 }
@@ -4393,10 +4869,10 @@ PRL_METHOD( PrlDispCfg_SetVerboseLogEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return ( pDispConfig->SetVerboseLogEnabled( bEnabled ) );
 }
@@ -4414,11 +4890,11 @@ PRL_METHOD( PrlDispCfg_IsAllowMultiplePMC ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsAllowMultiplePMC(pbEnabled));
 }
@@ -4436,10 +4912,10 @@ PRL_METHOD( PrlDispCfg_SetAllowMultiplePMC ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return ( pDispConfig->SetAllowMultiplePMC( bEnabled ) );
 }
@@ -4457,11 +4933,11 @@ PRL_METHOD( PrlDispCfg_IsLogRotationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) ||
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig ||
 		PRL_WRONG_PTR(pbEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return (pDispConfig->IsLogRotationEnabled(pbEnabled));
 }
@@ -4479,10 +4955,10 @@ PRL_METHOD( PrlDispCfg_SetLogRotationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return ( pDispConfig->SetLogRotationEnabled( bEnabled ) );
 }
@@ -4500,10 +4976,10 @@ PRL_METHOD( PrlDispCfg_GetUsbIdentityCount ) (
 		pnUsbIdentityCount
 	);
 
-	if (PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg );
 
 	return pDispConfig->GetUsbIdentityCount(pnUsbIdentityCount);
 }
@@ -4523,11 +4999,11 @@ PRL_METHOD( PrlDispCfg_GetUsbIdentity ) (
 		phUsbIdent
 	);
 
-	if (PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG)
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if (!pDispConfig
 			|| PRL_WRONG_PTR( phUsbIdent ) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg );
 
 	return pDispConfig->GetUsbIdentity(nUsbIdentIndex, phUsbIdent);
 }
@@ -4548,10 +5024,10 @@ PRL_METHOD( PrlDispCfg_SetUsbIdentAssociation ) (
 		sVmUuid
 	);
 
-	if (PRL_WRONG_HANDLE(hDispCfg, PHT_DISP_CONFIG))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg, PHT_DISP_CONFIG );
+	if (!pDispConfig)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispCfg );
 
 	return pDispConfig->SetUsbIdentAssociation(sSystemName, sVmUuid, nFlags);
 }
@@ -4562,10 +5038,10 @@ PRL_METHOD( PrlDispCfg_GetCpuFeaturesMask ) (PRL_HANDLE hDispConfig, PRL_CPU_FEA
 
 	LOG_MESSAGE( DBG_DEBUG, "%s (hDispConfig=%.8X, pMasks=%.8X)", __FUNCTION__, hDispConfig, pMasks);
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pMasks))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_PTR(pMasks))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return pDispConfig->GetCpuFeaturesMask(pMasks);
 }
@@ -4576,10 +5052,10 @@ PRL_METHOD( PrlDispCfg_SetCpuFeaturesMask ) (PRL_HANDLE hDispConfig, PRL_CONST_C
 
 	LOG_MESSAGE( DBG_DEBUG, "%s (hDispConfig=%.8X, nMasks=%.8X)", __FUNCTION__, hDispConfig, pMasks);
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_PTR(pMasks))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_PTR(pMasks))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return pDispConfig->SetCpuFeaturesMask(pMasks);
 }
@@ -4597,10 +5073,10 @@ PRL_METHOD( PrlDispCfg_GetCpuFeaturesMaskEx ) (
 		phCpuFeatures
 	);
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_PTR(phCpuFeatures))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_PTR(phCpuFeatures))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return pDispConfig->GetCpuFeaturesMaskEx(phCpuFeatures);
 }
@@ -4618,10 +5094,10 @@ PRL_METHOD( PrlDispCfg_SetCpuFeaturesMaskEx ) (
 		hCpuFeatures
 	);
 
-	if (PRL_WRONG_HANDLE(hDispConfig, PHT_DISP_CONFIG) || PRL_WRONG_HANDLE(hCpuFeatures, PHT_CPU_FEATURES))
+	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig, PHT_DISP_CONFIG );
+	if (!pDispConfig || PRL_WRONG_HANDLE(hCpuFeatures, PHT_CPU_FEATURES))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleDispConfigPtr pDispConfig = PRL_OBJECT_BY_HANDLE<PrlHandleDispConfig>( hDispConfig );
 
 	return pDispConfig->SetCpuFeaturesMaskEx(hCpuFeatures);
 }
@@ -4640,7 +5116,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetCpuMaskSupport ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_CPU_MASKING_FEATURE_SUPPORT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetCpuMaskSupport, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetCpuMaskSupport, (hServer, nFlags))
 }
 
 PRL_METHOD( PrlCpuFeatures_Create ) (
@@ -4680,10 +5156,10 @@ PRL_METHOD( PrlCpuFeatures_GetValue ) (
 		pnValue
 	);
 
-	if (PRL_WRONG_HANDLE(hCpuFeatures, PHT_CPU_FEATURES) || PRL_WRONG_PTR(pnValue))
+	PrlHandleCpuFeaturesPtr pCpuFeatures = PRL_OBJECT_BY_HANDLE<PrlHandleCpuFeatures>( hCpuFeatures, PHT_CPU_FEATURES );
+	if (!pCpuFeatures || PRL_WRONG_PTR(pnValue))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCpuFeaturesPtr pCpuFeatures = PRL_OBJECT_BY_HANDLE<PrlHandleCpuFeatures>( hCpuFeatures );
 
 	return pCpuFeatures->GetValue(nId, pnValue);
 }
@@ -4703,10 +5179,10 @@ PRL_METHOD( PrlCpuFeatures_SetValue ) (
 		nValue
 	);
 
-	if (PRL_WRONG_HANDLE(hCpuFeatures, PHT_CPU_FEATURES))
+	PrlHandleCpuFeaturesPtr pCpuFeatures = PRL_OBJECT_BY_HANDLE<PrlHandleCpuFeatures>( hCpuFeatures, PHT_CPU_FEATURES );
+	if (!pCpuFeatures)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCpuFeaturesPtr pCpuFeatures = PRL_OBJECT_BY_HANDLE<PrlHandleCpuFeatures>( hCpuFeatures );
 
 	return pCpuFeatures->SetValue(nId, nValue);
 }
@@ -4724,9 +5200,9 @@ PRL_METHOD( PrlLic_IsValid) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLicense, PHT_LICENSE) || PRL_WRONG_PTR(pbValue) )
+	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense, PHT_LICENSE );
+	if ( !pLicense || PRL_WRONG_PTR(pbValue) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense );
 	return (pLicense->IsValid(pbValue));
 }
 
@@ -4743,9 +5219,9 @@ PRL_METHOD( PrlLic_GetStatus) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLicense, PHT_LICENSE) || PRL_WRONG_PTR(pnValue) )
+	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense, PHT_LICENSE );
+	if ( !pLicense || PRL_WRONG_PTR(pnValue) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense );
 	return (pLicense->GetStatus(pnValue));
 }
 
@@ -4764,9 +5240,9 @@ PRL_METHOD( PrlLic_GetLicenseKey) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLicense, PHT_LICENSE) || PRL_WRONG_PTR(pnLicenseKeyBufLength) )
+	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense, PHT_LICENSE );
+	if ( !pLicense || PRL_WRONG_PTR(pnLicenseKeyBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense );
 	return (pLicense->GetLicenseKey(sLicenseKey, pnLicenseKeyBufLength));
 }
 
@@ -4785,9 +5261,9 @@ PRL_METHOD( PrlLic_GetUserName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLicense, PHT_LICENSE) || PRL_WRONG_PTR(pnUserNameBufLength) )
+	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense, PHT_LICENSE );
+	if ( !pLicense || PRL_WRONG_PTR(pnUserNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense );
 #ifdef _WIN_
 #ifdef GetUserName
 #undef GetUserName
@@ -4811,9 +5287,9 @@ PRL_METHOD( PrlLic_GetCompanyName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLicense, PHT_LICENSE) || PRL_WRONG_PTR(pnCompanyNameBufLength) )
+	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense, PHT_LICENSE );
+	if ( !pLicense || PRL_WRONG_PTR(pnCompanyNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLicensePtr pLicense = PRL_OBJECT_BY_HANDLE<PrlHandleLicense>( hLicense );
 	return (pLicense->GetCompanyName(sCompanyName, pnCompanyNameBufLength));
 }
 
@@ -4832,9 +5308,9 @@ PRL_METHOD( PrlSrvInfo_GetHostName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnHostNameBufLength) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnHostNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetHostName(sHostName, pnHostNameBufLength));
 }
 
@@ -4853,9 +5329,9 @@ PRL_METHOD( PrlSrvInfo_GetOsVersion) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnOsVersionBufLength) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnOsVersionBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetOsVersion(sOsVersion, pnOsVersionBufLength));
 }
 
@@ -4872,9 +5348,9 @@ PRL_METHOD( PrlSrvInfo_GetCmdPort) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnPort) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnPort) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetCmdPort(pnPort));
 }
 
@@ -4893,9 +5369,9 @@ PRL_METHOD( PrlSrvInfo_GetServerUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnServerUuidBufLength) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnServerUuidBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetServerUuid(sServerUuid, pnServerUuidBufLength));
 }
 
@@ -4914,9 +5390,9 @@ PRL_METHOD( PrlSrvInfo_GetProductVersion) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnProductVersionBufLength) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnProductVersionBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetProductVersion(sProductVersion, pnProductVersionBufLength));
 }
 
@@ -4933,9 +5409,9 @@ PRL_METHOD( PrlSrvInfo_GetApplicationMode) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnApplicationMode) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnApplicationMode) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetApplicationMode(pnApplicationMode));
 }
 
@@ -4952,9 +5428,9 @@ PRL_METHOD( PrlSrvInfo_GetStartTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnStartTime) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnStartTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetStartTime(pnStartTime));
 }
 
@@ -4971,9 +5447,9 @@ PRL_METHOD( PrlSrvInfo_GetStartTimeMonotonic) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServerInfo, PHT_SERVER_INFO) || PRL_WRONG_PTR(pnStartTimeMonotonic) )
+	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo, PHT_SERVER_INFO );
+	if ( !pServerInfo || PRL_WRONG_PTR(pnStartTimeMonotonic) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleServerInfoPtr pServerInfo = PRL_OBJECT_BY_HANDLE<PrlHandleServerInfo>( hServerInfo );
 	return (pServerInfo->GetStartTimeMonotonic(pnStartTimeMonotonic));
 }
 
@@ -4992,9 +5468,9 @@ PRL_METHOD ( PrlLoginResponse_GetSessionUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLoginResp, PHT_LOGIN_RESPONSE) || PRL_WRONG_PTR(pnSessionUuidBufLength) )
+	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp, PHT_LOGIN_RESPONSE );
+	if ( !pLoginResp || PRL_WRONG_PTR(pnSessionUuidBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp );
 	return (pLoginResp->GetSessionUuid(sSessionUuid, pnSessionUuidBufLength));
 }
 
@@ -5013,9 +5489,9 @@ PRL_METHOD ( PrlLoginResponse_GetServerUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLoginResp, PHT_LOGIN_RESPONSE) || PRL_WRONG_PTR(pnServerUuidBufLength) )
+	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp, PHT_LOGIN_RESPONSE );
+	if ( !pLoginResp || PRL_WRONG_PTR(pnServerUuidBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp );
 	return (pLoginResp->GetServerUuid(sServerUuid, pnServerUuidBufLength));
 }
 
@@ -5034,9 +5510,9 @@ PRL_METHOD ( PrlLoginResponse_GetHostOsVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLoginResp, PHT_LOGIN_RESPONSE) || PRL_WRONG_PTR(pnHostOsVersionBufLength) )
+	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp, PHT_LOGIN_RESPONSE );
+	if ( !pLoginResp || PRL_WRONG_PTR(pnHostOsVersionBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp );
 	return (pLoginResp->GetHostOsVersion(sHostOsVersion, pnHostOsVersionBufLength));
 }
 
@@ -5055,9 +5531,9 @@ PRL_METHOD ( PrlLoginResponse_GetProductVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLoginResp, PHT_LOGIN_RESPONSE) || PRL_WRONG_PTR(pnProductVersionBufLength) )
+	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp, PHT_LOGIN_RESPONSE );
+	if ( !pLoginResp || PRL_WRONG_PTR(pnProductVersionBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp );
 	return (pLoginResp->GetProductVersion(sProductVersion, pnProductVersionBufLength));
 }
 
@@ -5074,9 +5550,9 @@ PRL_METHOD ( PrlLoginResponse_GetRunningTaskCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLoginResp, PHT_LOGIN_RESPONSE) || PRL_WRONG_PTR(pnCount) )
+	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp, PHT_LOGIN_RESPONSE );
+	if ( !pLoginResp || PRL_WRONG_PTR(pnCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp );
 	return (pLoginResp->GetRunningTaskCount( pnCount ));
 }
 
@@ -5095,9 +5571,9 @@ PRL_METHOD ( PrlLoginResponse_GetRunningTaskByIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hLoginResp, PHT_LOGIN_RESPONSE) || PRL_WRONG_PTR(phRunningTask) )
+	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp, PHT_LOGIN_RESPONSE );
+	if ( !pLoginResp || PRL_WRONG_PTR(phRunningTask) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleLoginResponsePtr pLoginResp = PRL_OBJECT_BY_HANDLE<PrlHandleLoginResponse>( hLoginResp );
 	return ( pLoginResp->GetRunningTaskByIndex( nIndex, phRunningTask ) );
 }
 
@@ -5116,9 +5592,9 @@ PRL_METHOD ( PrlRunningTask_GetTaskUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hRunningTask, PHT_RUNNING_TASK) || PRL_WRONG_PTR(pnTaskUuidBufLength) )
+	PrlHandleRunningTaskPtr pTask = PRL_OBJECT_BY_HANDLE<PrlHandleRunningTask>( hRunningTask, PHT_RUNNING_TASK );
+	if ( !pTask || PRL_WRONG_PTR(pnTaskUuidBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleRunningTaskPtr pTask = PRL_OBJECT_BY_HANDLE<PrlHandleRunningTask>( hRunningTask );
 	return ( pTask->GetTaskUuid( sTaskUuid, pnTaskUuidBufLength ) );
 }
 
@@ -5135,9 +5611,9 @@ PRL_METHOD ( PrlRunningTask_GetTaskType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hRunningTask, PHT_RUNNING_TASK) || PRL_WRONG_PTR(pnType) )
+	PrlHandleRunningTaskPtr pTask = PRL_OBJECT_BY_HANDLE<PrlHandleRunningTask>( hRunningTask, PHT_RUNNING_TASK );
+	if ( !pTask || PRL_WRONG_PTR(pnType) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleRunningTaskPtr pTask = PRL_OBJECT_BY_HANDLE<PrlHandleRunningTask>( hRunningTask );
 	return ( pTask->GetTaskType( pnType ) );
 }
 
@@ -5156,9 +5632,9 @@ PRL_METHOD ( PrlRunningTask_GetTaskParametersAsString ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hRunningTask, PHT_RUNNING_TASK) || PRL_WRONG_PTR(pnsParamsStrBufLength) )
+	PrlHandleRunningTaskPtr pTask = PRL_OBJECT_BY_HANDLE<PrlHandleRunningTask>( hRunningTask, PHT_RUNNING_TASK );
+	if ( !pTask || PRL_WRONG_PTR(pnsParamsStrBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleRunningTaskPtr pTask = PRL_OBJECT_BY_HANDLE<PrlHandleRunningTask>( hRunningTask );
 	return ( pTask->GetTaskParametersAsString( sParamsStr, pnsParamsStrBufLength ) );
 }
 
@@ -5177,10 +5653,10 @@ PRL_METHOD( PrlUsbIdent_GetSystemName ) (
 		pnSystemNameBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hUsbIdent, PHT_USB_IDENTITY))
+	PrlHandleUsbIdentityPtr pUsbIdentity = PRL_OBJECT_BY_HANDLE<PrlHandleUsbIdentity>( hUsbIdent, PHT_USB_IDENTITY );
+	if (!pUsbIdentity)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleUsbIdentityPtr pUsbIdentity = PRL_OBJECT_BY_HANDLE<PrlHandleUsbIdentity>( hUsbIdent );
 
 	return pUsbIdentity->GetSystemName(sSystemName, pnSystemNameBufLength);
 }
@@ -5200,10 +5676,10 @@ PRL_METHOD( PrlUsbIdent_GetFriendlyName ) (
 		pnFriendlyNameBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hUsbIdent, PHT_USB_IDENTITY))
+	PrlHandleUsbIdentityPtr pUsbIdentity = PRL_OBJECT_BY_HANDLE<PrlHandleUsbIdentity>( hUsbIdent, PHT_USB_IDENTITY );
+	if (!pUsbIdentity)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleUsbIdentityPtr pUsbIdentity = PRL_OBJECT_BY_HANDLE<PrlHandleUsbIdentity>( hUsbIdent );
 
 	return pUsbIdentity->GetFriendlyName(sFriendlyName, pnFriendlyNameBufLength);
 }
@@ -5223,10 +5699,10 @@ PRL_METHOD( PrlUsbIdent_GetVmUuidAssociation ) (
 		pnVmUuidBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hUsbIdent, PHT_USB_IDENTITY))
+	PrlHandleUsbIdentityPtr pUsbIdentity = PRL_OBJECT_BY_HANDLE<PrlHandleUsbIdentity>( hUsbIdent, PHT_USB_IDENTITY );
+	if (!pUsbIdentity)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleUsbIdentityPtr pUsbIdentity = PRL_OBJECT_BY_HANDLE<PrlHandleUsbIdentity>( hUsbIdent );
 
 	return pUsbIdentity->GetVmUuidAssociation(sVmUuid, pnVmUuidBufLength);
 }
@@ -5246,11 +5722,11 @@ PRL_METHOD( PrlPluginInfo_GetVendor ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hPluginInfo, PHT_PLUGIN_INFO)
+	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo, PHT_PLUGIN_INFO );
+	if (!pPluginInfo
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo );
 
 	return pPluginInfo->GetVendor(sVendor, pnBufLength);
 }
@@ -5270,11 +5746,11 @@ PRL_METHOD( PrlPluginInfo_GetCopyright ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hPluginInfo, PHT_PLUGIN_INFO)
+	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo, PHT_PLUGIN_INFO );
+	if (!pPluginInfo
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo );
 
 	return pPluginInfo->GetCopyright(sCopyright, pnBufLength);
 }
@@ -5294,11 +5770,11 @@ PRL_METHOD( PrlPluginInfo_GetShortDescription ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hPluginInfo, PHT_PLUGIN_INFO)
+	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo, PHT_PLUGIN_INFO );
+	if (!pPluginInfo
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo );
 
 	return pPluginInfo->GetShortDescription(sDescr, pnBufLength);
 }
@@ -5318,11 +5794,11 @@ PRL_METHOD( PrlPluginInfo_GetLongDescription ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hPluginInfo, PHT_PLUGIN_INFO)
+	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo, PHT_PLUGIN_INFO );
+	if (!pPluginInfo
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo );
 
 	return pPluginInfo->GetLongDescription(sDescr, pnBufLength);
 }
@@ -5342,11 +5818,11 @@ PRL_METHOD( PrlPluginInfo_GetVersion ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hPluginInfo, PHT_PLUGIN_INFO)
+	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo, PHT_PLUGIN_INFO );
+	if (!pPluginInfo
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo );
 
 	return pPluginInfo->GetVersion(sVersion, pnBufLength);
 }
@@ -5366,11 +5842,11 @@ PRL_METHOD( PrlPluginInfo_GetId ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hPluginInfo, PHT_PLUGIN_INFO)
+	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo, PHT_PLUGIN_INFO );
+	if (!pPluginInfo
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePluginInfoPtr pPluginInfo = PRL_OBJECT_BY_HANDLE<PrlHandlePluginInfo>( hPluginInfo );
 
 	return pPluginInfo->GetId(sId, pnBufLength);
 }
@@ -5390,13 +5866,12 @@ PRL_METHOD( PrlBackupResult_GetBackupUuid ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hBackupResult, PHT_BACKUP_RESULT) ||
+	PrlHandleBackupResultPtr pBackupResult =
+			PRL_OBJECT_BY_HANDLE<PrlHandleBackupResult>( hBackupResult, PHT_BACKUP_RESULT );
+	if (!pBackupResult ||
 			PRL_WRONG_PTR(pnBackupUuidBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleBackupResultPtr pBackupResult =
-			PRL_OBJECT_BY_HANDLE<PrlHandleBackupResult>( hBackupResult );
-
 	return (pBackupResult->GetBackupUuid(sBackupUuid, pnBackupUuidBufLength));
 }
 
@@ -5415,11 +5890,11 @@ PRL_METHOD( PrlCPUPool_GetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hCpuPool, PHT_CPU_POOL) ||
+	PrlHandleCpuPoolPtr pCpuPool = PRL_OBJECT_BY_HANDLE<PrlHandleCpuPool>( hCpuPool, PHT_CPU_POOL );
+	if (!pCpuPool ||
 		PRL_WRONG_PTR(pnBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleCpuPoolPtr pCpuPool = PRL_OBJECT_BY_HANDLE<PrlHandleCpuPool>( hCpuPool );
 
 	return (pCpuPool->GetName(sBuf, pnBufLength));
 }
@@ -5439,11 +5914,11 @@ PRL_METHOD( PrlCPUPool_GetVendor) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hCpuPool, PHT_CPU_POOL) ||
+	PrlHandleCpuPoolPtr pCpuPool = PRL_OBJECT_BY_HANDLE<PrlHandleCpuPool>( hCpuPool, PHT_CPU_POOL );
+	if (!pCpuPool ||
 		PRL_WRONG_PTR(pnBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleCpuPoolPtr pCpuPool = PRL_OBJECT_BY_HANDLE<PrlHandleCpuPool>( hCpuPool );
 
 	return (pCpuPool->GetVendor(sBuf, pnBufLength));
 }
@@ -5461,20 +5936,20 @@ PRL_METHOD( PrlCPUPool_GetCpuFeaturesMask ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hCpuPool, PHT_CPU_POOL) ||
+	PrlHandleCpuPoolPtr pCpuPool = PRL_OBJECT_BY_HANDLE<PrlHandleCpuPool>( hCpuPool, PHT_CPU_POOL );
+	if (!pCpuPool ||
 		PRL_WRONG_PTR(phCpuFeatures))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleCpuPoolPtr pCpuPool = PRL_OBJECT_BY_HANDLE<PrlHandleCpuPool>( hCpuPool );
 
 	return (pCpuPool->GetCpuFeaturesMask(phCpuFeatures));
 }
 
 PRL_HANDLE PrlSrv_JoinCPUPool_Impl(PRL_HANDLE hServer)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER))
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if (!pServer)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CPU_POOLS_JOIN))
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>(hServer);
 	PrlHandleJobPtr pJob = pServer->JoinCPUPool();
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5486,14 +5961,14 @@ PRL_ASYNC_METHOD( PrlSrv_JoinCPUPool ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CPU_POOLS_LIST_POOLS);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_JoinCPUPool, (hServer))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_JoinCPUPool, (hServer))
 }
 
 PRL_HANDLE PrlSrv_LeaveCPUPool_Impl(PRL_HANDLE hServer)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER))
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if (!pServer)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CPU_POOLS_LEAVE))
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>(hServer);
 	PrlHandleJobPtr pJob = pServer->LeaveCPUPool();
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5505,14 +5980,14 @@ PRL_ASYNC_METHOD( PrlSrv_LeaveCPUPool ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CPU_POOLS_LIST_POOLS);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_LeaveCPUPool, (hServer))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_LeaveCPUPool, (hServer))
 }
 
 PRL_HANDLE PrlSrv_GetCPUPoolsList_Impl(PRL_HANDLE hServer)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CPU_POOLS_LIST_POOLS))
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer );
 	PrlHandleJobPtr pJob = pServer->GetCPUPoolsList();
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5524,14 +5999,14 @@ PRL_ASYNC_METHOD( PrlSrv_GetCPUPoolsList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CPU_POOLS_LIST_POOLS);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetCPUPoolsList, (hServer))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetCPUPoolsList, (hServer))
 }
 
 PRL_HANDLE PrlSrv_MoveToCPUPool_Impl(PRL_HANDLE hServer, PRL_CONST_STR sCpuPool)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CPU_POOLS_MOVE))
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer );
 	PrlHandleJobPtr pJob = pServer->MoveToCPUPool(sCpuPool);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5544,14 +6019,14 @@ PRL_ASYNC_METHOD( PrlSrv_MoveToCPUPool ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CPU_POOLS_MOVE);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_MoveToCPUPool , (hServer, sCpuPool))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_MoveToCPUPool , (hServer, sCpuPool))
 }
 
 PRL_HANDLE PrlSrv_RecalculateCPUPool_Impl(PRL_HANDLE hServer, PRL_CONST_STR sCpuPool)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CPU_POOLS_RECALCULATE))
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer );
 	PrlHandleJobPtr pJob = pServer->RecalculateCPUPool(sCpuPool);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5564,7 +6039,7 @@ PRL_ASYNC_METHOD( PrlSrv_RecalculateCPUPool ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CPU_POOLS_RECALCULATE);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_RecalculateCPUPool, (hServer, sCpuPool))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_RecalculateCPUPool, (hServer, sCpuPool))
 }
 
 PRL_METHOD( PrlVcmmdConfig_GetPolicy ) (
@@ -5573,11 +6048,11 @@ PRL_METHOD( PrlVcmmdConfig_GetPolicy ) (
 	PRL_UINT32_PTR pnSize
 	)
 {
-	if (PRL_WRONG_HANDLE(hVcmmdConfig, PHT_VCMMD_CONFIG) ||
+	PrlHandleVcmmdConfigPtr pConfig = PRL_OBJECT_BY_HANDLE<PrlHandleVcmmdConfig>( hVcmmdConfig, PHT_VCMMD_CONFIG );
+	if (!pConfig ||
 		PRL_WRONG_PTR(pnSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVcmmdConfigPtr pConfig = PRL_OBJECT_BY_HANDLE<PrlHandleVcmmdConfig>( hVcmmdConfig );
 	return pConfig->GetPolicy(sPolicy, pnSize);
 }
 
@@ -5586,10 +6061,10 @@ PRL_METHOD( PrlVcmmdConfig_SetPolicy ) (
 	PRL_CONST_STR sPolicy
 	)
 {
-	if (PRL_WRONG_HANDLE(hVcmmdConfig, PHT_VCMMD_CONFIG))
+	PrlHandleVcmmdConfigPtr pConfig = PRL_OBJECT_BY_HANDLE<PrlHandleVcmmdConfig>( hVcmmdConfig, PHT_VCMMD_CONFIG );
+	if (!pConfig)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVcmmdConfigPtr pConfig = PRL_OBJECT_BY_HANDLE<PrlHandleVcmmdConfig>( hVcmmdConfig );
 	return pConfig->SetPolicy(sPolicy);
 }
 
@@ -5607,7 +6082,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetVcmmdConfig ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_VCMMD_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetVcmmdConfig, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetVcmmdConfig, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_SetVcmmdConfig_Impl(
@@ -5616,12 +6091,12 @@ PRL_HANDLE PrlSrv_SetVcmmdConfig_Impl(
 		PRL_UINT32 nFlags
 		)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) ||
-				PRL_WRONG_HANDLE(hVcmmdConfig, PHT_VCMMD_CONFIG))
+	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer, PHT_SERVER );
+	PrlHandleVcmmdConfigPtr pConfig = PRL_OBJECT_BY_HANDLE<PrlHandleVcmmdConfig>( hVcmmdConfig, PHT_VCMMD_CONFIG );
+	if (!pServer ||
+				!pConfig)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_STORE_VALUE_BY_KEY))
 
-	PrlHandleVcmmdConfigPtr pConfig = PRL_OBJECT_BY_HANDLE<PrlHandleVcmmdConfig>( hVcmmdConfig );
-
 	CVmEventParameter *pEventParam;
 	SmartPtr<CVmEvent> pEvent(new CVmEvent());
 
@@ -5629,7 +6104,6 @@ PRL_HANDLE PrlSrv_SetVcmmdConfig_Impl(
 			EVT_PARAM_VCMMD_CONFIG_VALUE);
 	pEvent->addEventParameter(pEventParam);
 
-	PrlHandleServerDispPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerDisp>( hServer );
 	PrlHandleJobPtr pJob = pServer->SetVcmmdConfig(QSTR2UTF8(pEvent->toString()), nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -5643,15 +6117,15 @@ PRL_ASYNC_METHOD( PrlSrv_SetVcmmdConfig ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_STORE_VALUE_BY_KEY)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SetVcmmdConfig, (hServer, hVcmmdConfig, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SetVcmmdConfig, (hServer, hVcmmdConfig, nFlags))
 }
 
 PRL_HANDLE PrlVm_BeginBackup_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE))
+	PrlHandleVmPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleVm>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!m)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_BEGIN_VM_BACKUP))
 
-	PrlHandleVmPtr m = PRL_OBJECT_BY_HANDLE<PrlHandleVm>(hVm);
 	if (!m.isValid() || !m->GetServer().isValid())
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_BEGIN_VM_BACKUP))
 
@@ -5669,15 +6143,15 @@ PRL_ASYNC_METHOD( PrlVm_BeginBackup ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_BEGIN_VM_BACKUP)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_BeginBackup, (hVm, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_BeginBackup, (hVm, nFlags))
 }
 
 PRL_HANDLE PrlVmBackup_Commit_Impl(PRL_HANDLE hBackup)
 {
-	if (PRL_WRONG_HANDLE(hBackup, PHT_BACKUP))
+	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup, PHT_BACKUP );
+	if (!b)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_END_BACKUP))
 
-	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>(hBackup);
 	if (!b.isValid() || !b->getVm().isValid() || !b->getVm()->GetServer().isValid())
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_END_BACKUP))
 
@@ -5698,10 +6172,10 @@ PRL_ASYNC_METHOD( PrlVmBackup_Commit ) (
 
 PRL_HANDLE PrlVmBackup_Rollback_Impl(PRL_HANDLE hBackup)
 {
-	if (PRL_WRONG_HANDLE(hBackup, PHT_BACKUP))
+	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup, PHT_BACKUP );
+	if (!b)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_END_BACKUP))
 
-	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>(hBackup);
 	if (!b.isValid() || !b->getVm().isValid() || !b->getVm()->GetServer().isValid())
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_END_BACKUP))
 
@@ -5734,10 +6208,10 @@ PRL_METHOD( PrlVmBackup_GetDisksCount ) (
 		pnDisksCount
 	);
 
-	if (PRL_WRONG_HANDLE(hBackup, PHT_BACKUP) || pnDisksCount == NULL)
+	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup, PHT_BACKUP );
+	if (!b || pnDisksCount == NULL)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup );
 	if (!b.isValid())
 		return PRL_INVALID_HANDLE;
 
@@ -5759,10 +6233,10 @@ PRL_METHOD( PrlVmBackup_GetUuid ) (
 		pnUuidBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hBackup, PHT_BACKUP))
+	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup, PHT_BACKUP );
+	if (!b)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup );
 	if (!b.isValid())
 		return PRL_INVALID_HANDLE;
 
@@ -5784,10 +6258,10 @@ PRL_METHOD( PrlVmBackup_GetDisk ) (
 		phDisk
 	);
 
-	if (PRL_WRONG_HANDLE(hBackup, PHT_BACKUP) || phDisk == NULL)
+	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup, PHT_BACKUP );
+	if (!b || phDisk == NULL)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleBackupPtr b = PRL_OBJECT_BY_HANDLE<PrlHandleBackup>( hBackup );
 	if (!b.isValid())
 		return PRL_INVALID_HANDLE;
 
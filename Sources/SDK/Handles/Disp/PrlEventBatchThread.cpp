@@ -0,0 +1,224 @@
+/*
+ * PrlEventBatchThread.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "PrlEventBatchThread.h"
+#include "BuiltinEventSource.h"
+#include "PrlHandleHandlesList.h"
+#include "PrlCommon.h"
+
+#include <prlcommon/Logging/Logging.h>
+
+CEventBatchThread::CEventBatchThread ()
+: m_bStop(false)
+{
+	setStackSize(PRL_STACK_SIZE);
+	m_Clock.start();
+}
+
+PRL_RESULT CEventBatchThread::RegHandler ( BuiltinEventSource *pSource, PRL_EVENT_HANDLER_PTR handler,
+	PRL_UINT32 nMaxBatch, PRL_UINT32 nMaxDelayMs, PRL_VOID_PTR userData )
+{
+	SmartPtr<Batch> pBatch( new Batch(this, handler, userData, nMaxBatch, nMaxDelayMs) );
+	if ( !pBatch.getImpl() )
+		return (PRL_ERR_OUT_OF_MEMORY);
+
+	{
+		QMutexLocker _lock(&m_Mutex);
+		if ( m_bStop )
+			return (PRL_ERR_UNEXPECTED);
+		m_lstBatches.append(pBatch);
+		if ( !isRunning() )
+			start();
+	}
+
+	PRL_RESULT nRetCode = pSource->RegEventHandler(OnEvent, pBatch.getImpl());
+	if ( PRL_FAILED(nRetCode) )
+	{
+		QMutexLocker _lock(&m_Mutex);
+		m_lstBatches.removeAll(pBatch);
+	}
+	return (nRetCode);
+}
+
+PRL_RESULT CEventBatchThread::UnregHandler ( BuiltinEventSource *pSource, PRL_EVENT_HANDLER_PTR handler,
+	PRL_VOID_PTR userData )
+{
+	SmartPtr<Batch> pBatch;
+	{
+		QMutexLocker _lock(&m_Mutex);
+		foreach( const SmartPtr<Batch> &b, m_lstBatches )
+		{
+			if ( b->handler == handler && b->userData == userData )
+			{
+				pBatch = b;
+				break;
+			}
+		}
+	}
+	if ( !pBatch.getImpl() )
+		return (PRL_ERR_SUCCESS);
+
+	// No events are accumulated after source handler unregistration returned
+	pSource->UnregEventHandler(OnEvent, pBatch.getImpl());
+
+	{
+		QMutexLocker _lock(&m_Mutex);
+		m_lstBatches.removeAll(pBatch);
+		pBatch->bRemoved.storeRelaxed(1);
+	}
+
+	// Wait for handlers being called now
+	if ( QThread::currentThread() != this )
+	{
+		m_DeliveryMutex.lock();
+		m_DeliveryMutex.unlock();
+	}
+
+	return (PRL_ERR_SUCCESS);
+}
+
+bool CEventBatchThread::Stop ()
+{
+	// Batches are kept as events source may still refer them
+	QList<PrlHandleBasePtr> lstEvents;
+	{
+		QMutexLocker _lock(&m_Mutex);
+		m_bStop = true;
+		foreach( const SmartPtr<Batch> &pBatch, m_lstBatches )
+		{
+			lstEvents += pBatch->lstEvents;
+			pBatch->lstEvents.clear();
+		}
+		m_Condition.wakeAll();
+	}
+	lstEvents.clear();
+
+	if ( QThread::currentThread() == this )
+	{
+		bool res = QObject::connect( this, SIGNAL(finished()), SLOT(deleteLater()) );
+		Q_ASSERT(res);
+		(void)res;
+		return false;
+	}
+
+	QThread::wait();
+	return true;
+}
+
+PRL_RESULT CEventBatchThread::OnEvent ( PRL_HANDLE hEvent, PRL_VOID_PTR pData )
+{
+	PrlHandleBasePtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleBase>(hEvent);
+	if ( !pEvent )
+		return (PRL_ERR_SUCCESS);
+
+	// Drop reference passed to the handler, batch keeps own one
+	pEvent->Release();
+
+	Batch *pBatch = static_cast<Batch *>(pData);
+	pBatch->pThread->Queue(pBatch, pEvent);
+	return (PRL_ERR_SUCCESS);
+}
+
+void CEventBatchThread::Queue ( Batch *pBatch, const PrlHandleBasePtr &pEvent )
+{
+	QMutexLocker _lock(&m_Mutex);
+	if ( m_bStop )
+		return;
+
+	if ( pBatch->lstEvents.isEmpty() )
+		pBatch->nDeadline = m_Clock.elapsed() + pBatch->nMaxDelayMs;
+	pBatch->lstEvents.append(pEvent);
+
+	// Thread sleeps until the earliest deadline so it should be woken up
+	// on new deadline or full batch only
+	if ( pBatch->lstEvents.size() == 1
+		|| PRL_UINT32(pBatch->lstEvents.size()) == pBatch->nMaxBatch )
+		m_Condition.wakeOne();
+}
+
+void CEventBatchThread::run ()
+{
+	QMutexLocker _lock(&m_Mutex);
+	while ( !m_bStop )
+	{
+		QList<QPair<SmartPtr<Batch>, QList<PrlHandleBasePtr> > > lstReady;
+		qint64 nNow = m_Clock.elapsed();
+		qint64 nWait = -1;
+
+		foreach( const SmartPtr<Batch> &pBatch, m_lstBatches )
+		{
+			if ( pBatch->lstEvents.isEmpty() )
+				continue;
+
+			if ( PRL_UINT32(pBatch->lstEvents.size()) >= pBatch->nMaxBatch
+				|| pBatch->nDeadline <= nNow )
+			{
+				// Oversized batch is split to respect the handler limit
+				QList<PrlHandleBasePtr> lstEvents = pBatch->lstEvents.mid(0, pBatch->nMaxBatch);
+				pBatch->lstEvents = pBatch->lstEvents.mid(pBatch->nMaxBatch);
+				pBatch->nDeadline = nNow + pBatch->nMaxDelayMs;
+				lstReady.append(qMakePair(pBatch, lstEvents));
+			}
+			else if ( nWait < 0 || pBatch->nDeadline - nNow < nWait )
+				nWait = pBatch->nDeadline - nNow;
+		}
+
+		if ( lstReady.isEmpty() )
+		{
+			if ( nWait < 0 )
+				m_Condition.wait(&m_Mutex);
+			else
+				m_Condition.wait(&m_Mutex, (unsigned long)nWait);
+			continue;
+		}
+
+		QMutexLocker _delivery(&m_DeliveryMutex);
+		_lock.unlock();
+
+		for ( int i = 0; i < lstReady.size(); ++i )
+		{
+			const SmartPtr<Batch> &pBatch = lstReady.at(i).first;
+			if ( pBatch->bRemoved.loadRelaxed() )
+				continue;
+
+			// List reference is passed to the handler
+			PrlHandleHandlesList *pList = new PrlHandleHandlesList(lstReady.at(i).second);
+			if ( !pList )
+			{
+				WRITE_TRACE(DBG_FATAL, "Failed to allocate events batch of %d events",
+					lstReady.at(i).second.size());
+				continue;
+			}
+			pBatch->handler(pList->GetHandle(), pBatch->userData);
+		}
+
+		// Events are released without holding the lock
+		lstReady.clear();
+		_delivery.unlock();
+		_lock.relock();
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * PrlEventBatchThread.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_EVENT_BATCH_THREAD_H__
+#define __VIRTUOZZO_EVENT_BATCH_THREAD_H__
+
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+#include "PrlHandleBase.h"
+
+#include <prlcommon/Std/SmartPtr.h>
+
+class BuiltinEventSource;
+
+/**
+ * Delivers server events to batch event handlers. Events are accumulated
+ * per handler and passed to it as a PHT_HANDLES_LIST once batch size or
+ * delay bound is reached. Batch handlers are called by own thread in order
+ * events were received, so slow batch handler does not delay notification
+ * threads.
+ */
+class CEventBatchThread : public QThread
+{
+public:
+	CEventBatchThread ();
+
+	/**
+	 * Registers batch event handler at the events source
+	 * @param source of events
+	 * @param handler called with list of events
+	 * @param maximum number of events in the list
+	 * @param maximum delay in msecs of the first event in the list
+	 * @param user data passed to the handler
+	 * @return PRL_ERR_UNEXPECTED if thread is already stopped
+	 */
+	PRL_RESULT RegHandler ( BuiltinEventSource *pSource, PRL_EVENT_HANDLER_PTR handler,
+							PRL_UINT32 nMaxBatch, PRL_UINT32 nMaxDelayMs, PRL_VOID_PTR userData );
+
+	/**
+	 * Unregisters batch event handler. Undelivered events of the handler are
+	 * dropped. Handler is not called after return unless it is unregistered
+	 * from the handler itself.
+	 */
+	PRL_RESULT UnregHandler ( BuiltinEventSource *pSource, PRL_EVENT_HANDLER_PTR handler,
+							  PRL_VOID_PTR userData );
+
+	/**
+	 * Stops thread and drops undelivered events. Waits until thread finished
+	 * if called outside of it, otherwise thread object deletes itself after finish.
+	 * @return sign whether caller is responsible for thread object deletion
+	 */
+	bool Stop ();
+
+private:
+	struct Batch
+	{
+		Batch ( CEventBatchThread *t, PRL_EVENT_HANDLER_PTR h, PRL_VOID_PTR d,
+				PRL_UINT32 nBatch, PRL_UINT32 nDelay )
+		: pThread(t), handler(h), userData(d), nMaxBatch(nBatch), nMaxDelayMs(nDelay),
+		  nDeadline(0), bRemoved(0)
+		{}
+
+		CEventBatchThread *pThread;
+		PRL_EVENT_HANDLER_PTR handler;
+		PRL_VOID_PTR userData;
+		PRL_UINT32 nMaxBatch;
+		PRL_UINT32 nMaxDelayMs;
+		/** Accumulated events */
+		QList<PrlHandleBasePtr> lstEvents;
+		/** Time when accumulated events should be delivered */
+		qint64 nDeadline;
+		/** Sign whether handler was unregistered */
+		QAtomicInt bRemoved;
+	};
+
+	/** Events source handler which accumulates events */
+	static PRL_RESULT OnEvent ( PRL_HANDLE hEvent, PRL_VOID_PTR pData );
+
+	void Queue ( Batch *pBatch, const PrlHandleBasePtr &pEvent );
+
+	void run ();
+
+private:
+	/** Batches and stop sign access synchronization object */
+	QMutex m_Mutex;
+	QWaitCondition m_Condition;
+	QList<SmartPtr<Batch> > m_lstBatches;
+	bool m_bStop;
+	/** Held by the thread while handlers are called */
+	QMutex m_DeliveryMutex;
+	QElapsedTimer m_Clock;
+};
+
+#endif // __VIRTUOZZO_EVENT_BATCH_THREAD_H__
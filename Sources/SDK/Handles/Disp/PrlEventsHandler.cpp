@@ -30,7 +30,10 @@
 #include "PrlHandleServerDisp.h"
 #include "PrlHandleServerJob.h"
 #include "PrlHandleVmEvent.h"
+#include "PrlLazyVmEvent.h"
+#include "PrlHandleEventQueue.h"
 #include "PrlContextSwitcher.h"
+#include "PrlRequestsPerf.h"
 
 #include <prlcommon/Messaging/CVmEvent.h>
 #include <prlcommon/Messaging/CVmBinaryEventParameter.h>
@@ -39,6 +42,7 @@
 #include <prlcommon/PrlUuid/Uuid.h>
 #include <prlcommon/Std/PrlAssert.h>
 #include <prlcommon/HostUtils/HostUtils.h>
+#include <QElapsedTimer>
 
 #include "PrlHandleVmCfg.h"
 #include "PrlFileDescriptorsMech.h"
@@ -76,7 +80,11 @@ void CNotificationMapper::NotificationStarted ()
 /** Notification thread implementation */
 
 CNotificationThread::CNotificationThread () :
-	m_bNotificationStarted(false)
+	m_bNotificationStarted(false),
+	m_nQueueDepth(0),
+	m_nDelivered(0),
+	m_nLatencySum(0),
+	m_nLatencyMax(0)
 {
 	setStackSize(PRL_STACK_SIZE);
 	LOG_MESSAGE(DBG_DEBUG, "Notification thread %p created", this);
@@ -89,8 +97,8 @@ CNotificationThread::~CNotificationThread ()
 
 void CNotificationThread::run ()
 {
-	CServerNotifier *pServNotifier = new CServerNotifier;
-	CVmNotifier *pVmNotifier = new CVmNotifier;
+	CServerNotifier *pServNotifier = new CServerNotifier( this );
+	CVmNotifier *pVmNotifier = new CVmNotifier( this );
 	CNotificationMapper *pMapper = new CNotificationMapper( this );
 
 	bool res = false;
@@ -98,17 +106,17 @@ void CNotificationThread::run ()
 
 	// Connect server notification
 	res = QObject::connect( this,
-							SIGNAL(ToNotifyServer(PrlHandleServerPtr,PrlHandleBasePtr)),
+							SIGNAL(ToNotifyServer(PrlHandleServerPtr,PrlHandleBasePtr,qint64,QString)),
 							pServNotifier,
-							SLOT(Notify(PrlHandleServerPtr,PrlHandleBasePtr)),
+							SLOT(Notify(PrlHandleServerPtr,PrlHandleBasePtr,qint64,QString)),
 							Qt::QueuedConnection);
 	Q_ASSERT(res);
 
 	// Connect vm notification
 	res = QObject::connect( this,
-							SIGNAL(ToNotifyVm(PrlHandleVmPtr,PrlHandleBasePtr)),
+							SIGNAL(ToNotifyVm(PrlHandleVmPtr,PrlHandleBasePtr,qint64,QString)),
 							pVmNotifier,
-							SLOT(Notify(PrlHandleVmPtr,PrlHandleBasePtr)),
+							SLOT(Notify(PrlHandleVmPtr,PrlHandleBasePtr,qint64,QString)),
 							Qt::QueuedConnection);
 	Q_ASSERT(res);
 
@@ -126,12 +134,12 @@ void CNotificationThread::run ()
 	//We should move these objects deletion to the main SDK event loop thread
 	//due implicit QCoreApplication::removePostedEvents() can be called and
 	//destruction of SDK objects (transport participants) can be initiated.
-	QObject::disconnect(SIGNAL(ToNotifyServer(PrlHandleServerPtr,PrlHandleBasePtr)),
+	QObject::disconnect(SIGNAL(ToNotifyServer(PrlHandleServerPtr,PrlHandleBasePtr,qint64,QString)),
 						pServNotifier,
-						SLOT(Notify(PrlHandleServerPtr,PrlHandleBasePtr)));
-	QObject::disconnect(SIGNAL(ToNotifyVm(PrlHandleVmPtr,PrlHandleBasePtr)),
+						SLOT(Notify(PrlHandleServerPtr,PrlHandleBasePtr,qint64,QString)));
+	QObject::disconnect(SIGNAL(ToNotifyVm(PrlHandleVmPtr,PrlHandleBasePtr,qint64,QString)),
 						pVmNotifier,
-						SLOT(Notify(PrlHandleVmPtr,PrlHandleBasePtr)));
+						SLOT(Notify(PrlHandleVmPtr,PrlHandleBasePtr,qint64,QString)));
 	QObject::disconnect(SIGNAL(finished()), this, SLOT(NotificationFinished()));
 
 	pServNotifier->moveToThread( QCoreApplication::instance()->thread() );
@@ -157,6 +165,86 @@ bool CNotificationThread::isStarted() const
 	return m_bNotificationStarted;
 }
 
+qint64 CNotificationThread::GetTimestamp()
+{
+	static const QElapsedTimer s_Timer = [] { QElapsedTimer t; t.start(); return t; }();
+	return s_Timer.nsecsElapsed() / 1000;
+}
+
+bool CNotificationThread::NotifyServer ( const PrlHandleServerPtr &pServer, const PrlHandleBasePtr &pEvent,
+	const QString &sCoalesceKey )
+{
+	bool bReplaced = Coalesce(sCoalesceKey, pEvent);
+	m_nQueueDepth.fetchAndAddRelaxed(1);
+	emit ToNotifyServer(pServer, pEvent, GetTimestamp(), sCoalesceKey);
+	return bReplaced;
+}
+
+bool CNotificationThread::NotifyVm ( const PrlHandleVmPtr &pVm, const PrlHandleBasePtr &pEvent,
+	const QString &sCoalesceKey )
+{
+	bool bReplaced = Coalesce(sCoalesceKey, pEvent);
+	m_nQueueDepth.fetchAndAddRelaxed(1);
+	emit ToNotifyVm(pVm, pEvent, GetTimestamp(), sCoalesceKey);
+	return bReplaced;
+}
+
+bool CNotificationThread::Coalesce ( const QString &sCoalesceKey, const PrlHandleBasePtr &pEvent )
+{
+	if (sCoalesceKey.isEmpty())
+		return false;
+
+	// Replaced event object is kept alive by its queued notification
+	// so pointer is unique while it is in the hash
+	QMutexLocker _lock(&m_CoalesceMutex);
+	bool bReplaced = m_CoalescedEvents.contains(sCoalesceKey);
+	m_CoalescedEvents.insert(sCoalesceKey, pEvent.getHandle());
+	return bReplaced;
+}
+
+bool CNotificationThread::IsSuperseded ( const QString &sCoalesceKey, const PrlHandleBasePtr &pEvent )
+{
+	if (sCoalesceKey.isEmpty())
+		return false;
+
+	{
+		QMutexLocker _lock(&m_CoalesceMutex);
+		QHash<QString, PrlHandleBase* >::iterator it = m_CoalescedEvents.find(sCoalesceKey);
+		if (it != m_CoalescedEvents.end() && it.value() == pEvent.getHandle())
+		{
+			m_CoalescedEvents.erase(it);
+			return false;
+		}
+	}
+
+	m_nQueueDepth.fetchAndSubRelaxed(1);
+	return true;
+}
+
+void CNotificationThread::NotificationDelivered ( qint64 nQueuedAt )
+{
+	quint64 nLatency = quint64(qMax(GetTimestamp() - nQueuedAt, qint64(0)));
+
+	m_nQueueDepth.fetchAndSubRelaxed(1);
+	m_nDelivered.fetchAndAddRelaxed(1);
+	m_nLatencySum.fetchAndAddRelaxed(nLatency);
+
+	// Maximum is updated by the thread only but read by the statistics callers
+	if (nLatency > m_nLatencyMax.loadRelaxed())
+		m_nLatencyMax.storeRelaxed(nLatency);
+}
+
+void CNotificationThread::GetStat ( PRL_UINT32_PTR pnQueueDepth, PRL_UINT64_PTR pnDelivered,
+	PRL_UINT64_PTR pnAvgLatency, PRL_UINT64_PTR pnMaxLatency ) const
+{
+	quint64 nDelivered = m_nDelivered.loadRelaxed();
+
+	*pnQueueDepth = m_nQueueDepth.loadRelaxed();
+	*pnDelivered = nDelivered;
+	*pnAvgLatency = nDelivered ? m_nLatencySum.loadRelaxed() / nDelivered : 0;
+	*pnMaxLatency = m_nLatencyMax.loadRelaxed();
+}
+
 void CNotificationThread::ExitNotification ( int retcode )
 {
 	if ( QThread::currentThread() != this ) {
@@ -183,22 +271,70 @@ void CNotificationThread::start ( Priority priority )
 	}
 }
 
+/** Server execution context thread implementation */
+
+CServerContextThread::CServerContextThread ()
+{
+	setStackSize(PRL_STACK_SIZE);
+	m_ContextSwitcher.moveToThread(this);
+}
+
+void CServerContextThread::run ()
+{
+	exec();
+}
+
+bool CServerContextThread::Stop ()
+{
+	QThread::exit(0);
+	if ( QThread::currentThread() == this )
+	{
+		// Thread object lives in SDK event loop thread so it will be deleted there
+		bool res = QObject::connect( this, SIGNAL(finished()), SLOT(deleteLater()) );
+		Q_ASSERT(res);
+		(void)res;
+		return false;
+	}
+
+	QThread::wait();
+	return true;
+}
+
 /** Server notifier object implementation */
 
-void CServerNotifier::Notify ( PrlHandleServerPtr pServer, PrlHandleBasePtr pEvent )
+CServerNotifier::CServerNotifier ( CNotificationThread* t )
+: m_pThread(t)
+{}
+
+void CServerNotifier::Notify ( PrlHandleServerPtr pServer, PrlHandleBasePtr pEvent, qint64 nQueuedAt,
+	QString sCoalesceKey )
 {
+	if (m_pThread->IsSuperseded(sCoalesceKey, pEvent))
+		return;
+
 	pServer->eventSource()->NotifyListeners(pEvent);
+	m_pThread->NotificationDelivered(nQueuedAt);
 }
 
 /** Vm notifier object implementation */
-void CVmNotifier::Notify ( PrlHandleVmPtr pVm, PrlHandleBasePtr pEvent )
+
+CVmNotifier::CVmNotifier ( CNotificationThread* t )
+: m_pThread(t)
+{}
+
+void CVmNotifier::Notify ( PrlHandleVmPtr pVm, PrlHandleBasePtr pEvent, qint64 nQueuedAt,
+	QString sCoalesceKey )
 {
+	if (m_pThread->IsSuperseded(sCoalesceKey, pEvent))
+		return;
+
 	if (pVm.isValid() && pVm->GetType() == PHT_VIRTUAL_MACHINE
 		&& pVm->GetHandle() != PRL_INVALID_HANDLE)
 	{
 		pVm->ProcessVmEvent(pEvent);
 		pVm->eventSource()->NotifyListeners(pEvent);
 	}
+	m_pThread->NotificationDelivered(nQueuedAt);
 }
 
 /**
@@ -206,11 +342,14 @@ void CVmNotifier::Notify ( PrlHandleVmPtr pVm, PrlHandleBasePtr pEvent )
  */
 CEventsHandler::CEventsHandler(PRL_HANDLE hServer)
 :	m_ServerHandle(hServer),
-	m_NotificationThread( new CNotificationThread ),
-	m_Mutex()
+	m_Mutex(),
+	m_bNotificationsRouted(false),
+	m_bCoalesceProgress(0),
+	m_nCoalescedEvents(0)
 {
 	// Start notification thread
-	m_NotificationThread->start();
+	m_NotificationThreads.append(SmartPtr<CNotificationThread>( new CNotificationThread ));
+	m_NotificationThreads.first()->start();
 
 	Q_ASSERT(PrlContextSwitcher::Instance());
 
@@ -226,21 +365,135 @@ CEventsHandler::CEventsHandler(PRL_HANDLE hServer)
 
 bool CEventsHandler::isStarted() const
 {
-	return m_NotificationThread->isStarted();
+	QMutexLocker locker(&m_Mutex);
+	return !m_NotificationThreads.isEmpty() && m_NotificationThreads.first()->isStarted();
 }
 
 void CEventsHandler::FinalizeWork()
 {
 	QMutexLocker locker(&m_Mutex);
 
-	SmartPtr<CNotificationThread> pNotificationThread = m_NotificationThread;
-	if (pNotificationThread.getImpl())
+	for (int i = 0; i < m_NotificationThreads.size(); ++i)
+		PrlHandleServer::RegisterThreadToDeleteFinMech(m_NotificationThreads[i]);
+	m_NotificationThreads.clear();
+}
+
+PRL_RESULT CEventsHandler::SetNotificationShards( PRL_UINT32 nShardsCount )
+{
+	if (!nShardsCount || nShardsCount > PRL_MAX_NOTIFICATION_SHARDS)
+		return (PRL_ERR_INVALID_ARG);
+
+	QMutexLocker locker(&m_Mutex);
+
+	if (m_NotificationThreads.isEmpty())
+		return (PRL_ERR_UNEXPECTED);
+
+	// Queued events of a VM would be delivered concurrently with newer ones
+	if (m_bNotificationsRouted)
+		return (PRL_ERR_ALREADY_CONNECTED_TO_DISPATCHER);
+
+	// First thread is kept so server wide notifications order is not broken
+	while (PRL_UINT32(m_NotificationThreads.size()) > nShardsCount)
+	{
+		SmartPtr<CNotificationThread> pNotificationThread = m_NotificationThreads.takeLast();
+		PrlHandleServer::RegisterThreadToDelete(pNotificationThread);
+	}
+	while (PRL_UINT32(m_NotificationThreads.size()) < nShardsCount)
+	{
+		SmartPtr<CNotificationThread> pNotificationThread( new CNotificationThread );
+		pNotificationThread->start();
+		m_NotificationThreads.append(pNotificationThread);
+	}
+
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_RESULT CEventsHandler::GetNotificationShardStat( PRL_UINT32 nShard, PRL_UINT32_PTR pnQueueDepth,
+	PRL_UINT64_PTR pnDelivered, PRL_UINT64_PTR pnAvgLatency, PRL_UINT64_PTR pnMaxLatency )
+{
+	QVector<SmartPtr<CNotificationThread> > threads = GetNotificationThreads();
+	if (nShard >= PRL_UINT32(threads.size()))
+		return (PRL_ERR_INVALID_ARG);
+
+	threads.at(nShard)->GetStat(pnQueueDepth, pnDelivered, pnAvgLatency, pnMaxLatency);
+	return (PRL_ERR_SUCCESS);
+}
+
+void CEventsHandler::SetProgressCoalescing( bool bEnabled )
+{
+	m_bCoalesceProgress.storeRelaxed(bEnabled ? 1 : 0);
+}
+
+quint64 CEventsHandler::GetCoalescedEventsCount() const
+{
+	return m_nCoalescedEvents.loadRelaxed();
+}
+
+void CEventsHandler::PostToEventQueues( const PrlHandleServerPtr &pServer, const PrlHandleBasePtr &pEvent )
+{
+	foreach( PRL_HANDLE hQueue, pServer->GetEventQueues() )
 	{
-		PrlHandleServer::RegisterThreadToDeleteFinMech(pNotificationThread);
-		m_NotificationThread = SmartPtr<CNotificationThread>(0);
+		PrlHandleEventQueuePtr pQueue = PRL_OBJECT_BY_HANDLE<PrlHandleEventQueue>(hQueue, PHT_EVENT_QUEUE);
+		if (pQueue)
+			pQueue->Push(pEvent);
 	}
 }
 
+bool CEventsHandler::IsProgressEvent( PRL_EVENT_TYPE nEventType )
+{
+	switch (nEventType)
+	{
+	case PET_DSP_EVT_VM_MIGRATE_PROGRESS_CHANGED:
+	case PET_DSP_EVT_BACKUP_PROGRESS_CHANGED:
+	case PET_DSP_EVT_JOB_PROGRESS_CHANGED:
+	case PET_DSP_EVT_RESTORE_PROGRESS_CHANGED:
+	case PET_DSP_EVT_DISK_RESIZE_PROGRESS_CHANGED:
+	case PET_DSP_EVT_CONVERSION_DISKS_PROGRESS_CHANGED:
+	case PET_DSP_EVT_CONVERT_THIRD_PARTY_PROGRESS_CHANGED:
+	case PET_DSP_EVT_RECONFIG_VM_PROGRESS_CHANGED:
+	case PET_JOB_DELETE_VM_PROGRESS_CHANGED:
+	case PET_JOB_HDD_CREATE_PROGRESS_CHANGED:
+	case PET_JOB_FILE_COPY_PROGRESS_CHANGED:
+	case PET_JOB_SUSPEND_PROGRESS_CHANGED:
+	case PET_JOB_RESUME_PROGRESS_CHANGED:
+	case PET_JOB_CREATE_SNAPSHOT_PROGRESS_CHANGED:
+	case PET_JOB_SWITCH_TO_SNAPSHOT_PROGRESS_CHANGED:
+	case PET_JOB_DELETE_SNAPSHOT_PROGRESS_CHANGED:
+	case PET_JOB_COMMIT_UNFINISHED_DISK_OP_PROGRESS_CHANGED:
+	case PET_DSP_EVT_VM_ENCRYPT_PROGRESS_CHANGED:
+	case PET_DSP_EVT_VM_DECRYPT_PROGRESS_CHANGED:
+	case PET_JOB_STAGE_PROGRESS_CHANGED:
+	case PET_DSP_EVT_APPLIANCE_DOWNLOAD_PROGRESS_CHANGED:
+		return true;
+	default:
+		return false;
+	}
+}
+
+QVector<SmartPtr<CNotificationThread> > CEventsHandler::GetNotificationThreads()
+{
+	QMutexLocker locker(&m_Mutex);
+	return m_NotificationThreads;
+}
+
+QVector<SmartPtr<CNotificationThread> > CEventsHandler::GetRoutingNotificationThreads()
+{
+	QMutexLocker locker(&m_Mutex);
+	m_bNotificationsRouted = true;
+	return m_NotificationThreads;
+}
+
+SmartPtr<CNotificationThread> CEventsHandler::SelectNotificationThread(
+	const QVector<SmartPtr<CNotificationThread> > &threads, const QString &sVmUuid )
+{
+	if (threads.isEmpty())
+		return SmartPtr<CNotificationThread>(0);
+	if (threads.size() == 1 || sVmUuid.isEmpty())
+		return threads.first();
+
+	return threads.at(qHash(sVmUuid) % uint(threads.size()));
+}
+
 /**
  * Destructor
  */
@@ -265,14 +518,24 @@ bool CEventsHandler::event( QEvent *pEvent )
 
 	PVE::VmEventClassType type = (PVE::VmEventClassType) pEvent->type();
 	PrlHandleVmPtr pVm;
+	QString sVmUuid;
+	QString sCoalesceKey;
 	PRL_HANDLE event_handle = PRL_INVALID_HANDLE;
 
 	if ( type == PVE::CResultType )
 	{
 		CResult* pResult = static_cast<CResult*>(pEvent);
 
+		const PrlUuidKey requestUuid = PrlUuidKey::FromString(pResult->getRequestId());
+		PrlRequestsPerf::ResponseDelivered(requestUuid);
+
 		// Searching for registered job by its uuid
-		PrlHandleServerJobPtr pJob = PrlHandleServerJob::GetJobByUuid( pResult->getRequestId() );
+		PrlHandleServerJobPtr pJob = PrlHandleServerJob::GetJobByUuid( requestUuid );
+		// Request might be sent directly from the caller thread which is
+		// still registering job object for it. Only that call is waited for.
+		if ( (!pJob || PRL_INVALID_HANDLE == pJob->GetVmHandle())
+				&& pServer->WaitForPendingRequest(requestUuid) )
+			pJob = PrlHandleServerJob::GetJobByUuid( requestUuid );
 
 		// If job was found - setting it's result
 		if ( pJob )
@@ -333,6 +596,15 @@ bool CEventsHandler::event( QEvent *pEvent )
 				}
 			}
 			pJob->SetCResult( *pResult );
+
+			// Job with own completion callback is not dispatched to the
+			// server and VM event handlers, but events queues still get it
+			if (pJob->InvokeCompletionCallback())
+			{
+				PostToEventQueues(pServer, PrlHandleBasePtr(pJob.getHandle()));
+				pServer->RemoveJobFromResponseAwaitingList(pJob);
+				return (true);
+			}
 		}
 	}
 	else if ( type == PVE::CVmEventType )
@@ -352,6 +624,9 @@ bool CEventsHandler::event( QEvent *pEvent )
 		}
 		if (pVmEvent->getEventType() == PET_DSP_EVT_LICENSE_CHANGED)
 		{
+			CLazyVmEvent *pLazyEvent = dynamic_cast<CLazyVmEvent *>(pVmEvent);
+			if (pLazyEvent)
+				pLazyEvent->Materialize();
 			CVmEventParameter* pParam = pVmEvent->getEventParameter(EVT_PARAM_SESSION_RESTRICT_EVENT);
 			if (pParam)
 				pServer->SetRestrictionEvent(pParam->getParamValue());
@@ -359,19 +634,51 @@ bool CEventsHandler::event( QEvent *pEvent )
 				WRITE_TRACE(DBG_INFO, "License changed event doesn't contain restriction event");
 		}
 
-		PrlHandleVmEvent *vm_event = new PrlHandleVmEvent(pServer, pVmEvent->getEventType(), pVmEvent);
-		if (vm_event)
-			event_handle = vm_event->GetHandle();
-
 		// NOTE: lot of vm events from dispatcher send with PIE_DISPATCHER issuer type
 		//       but with vm_uuid in IssuerId field
 		// For example: any type of progress vm operations, VmConfigChanged, etc.
+		// Server UUID is unknown until login response, so dispatcher events
+		// are not related to VMs by issuer id mismatch before that
 		const PRL_EVENT_ISSUER_TYPE nIssuer = pVmEvent->getEventIssuerType();
 		if ( nIssuer == PIE_VIRTUAL_MACHINE
 			|| nIssuer == PIE_DISPATCHER )
 		{
-			pVm = pServer->GetVmHandleByUuid(pVmEvent->getEventIssuerId());
+			const QString sIssuerId = pVmEvent->getEventIssuerId();
+			pVm = pServer->GetVmHandleByUuid(sIssuerId);
+			if (nIssuer == PIE_VIRTUAL_MACHINE || pVm)
+				sVmUuid = sIssuerId;
+			else
+			{
+				const QString sServerUuid = pServer->GetServerUuid();
+				if (!sServerUuid.isEmpty() && sIssuerId != sServerUuid)
+					sVmUuid = sIssuerId;
+			}
+			// Same VM uuid may come in different forms from events and VM
+			// configs, so it is normalized once for filtering and sharding
+			if (!sVmUuid.isEmpty())
+				sVmUuid = Uuid(sVmUuid).toString();
+		}
+
+		// Unwanted events are dropped before event handle is created.
+		// Questions are never filtered as server waits for answer on them.
+		if (pVmEvent->getEventType() != PET_DSP_EVT_VM_QUESTION)
+		{
+			bool bAccepted = pServer->GetEventsFilter().Accept(pVmEvent->getEventType(), sVmUuid)
+				&& (!pVm || pVm->GetEventsFilter().Accept(pVmEvent->getEventType(), QString()));
+			pServer->GetEventsFilter().CountEvent(bAccepted);
+			if (!bAccepted)
+				return (true);
 		}
+
+		// Progress of the same operation is reported by events with the same
+		// type, issuer and initial request
+		if (m_bCoalesceProgress.loadRelaxed() && IsProgressEvent(pVmEvent->getEventType()))
+			sCoalesceKey = QString("%1:%2:%3").arg(pVmEvent->getEventType())
+				.arg(pVmEvent->getEventIssuerId()).arg(pVmEvent->getInitRequestId());
+
+		PrlHandleVmEvent *vm_event = new PrlHandleVmEvent(pServer, pVmEvent->getEventType(), pVmEvent);
+		if (vm_event)
+			event_handle = vm_event->GetHandle();
 		//Check whether processing event object is question and register it at questions list if necessary
 		if (pVmEvent->getEventType() == PET_DSP_EVT_VM_QUESTION)
 			pServerDisp->GetQuestionsList().RegisterQuestionObject(PrlHandleVmEventPtr(vm_event));
@@ -380,14 +687,24 @@ bool CEventsHandler::event( QEvent *pEvent )
 	if ( event_handle != PRL_INVALID_HANDLE )
 	{
 		PrlHandleBasePtr pEvent = PRL_OBJECT_BY_HANDLE<PrlHandleBase>(event_handle);
-		SmartPtr<CNotificationThread> pNotificationThread = m_NotificationThread;
+		// Events queues are filled directly, bypassing notification threads
+		if (pEvent)
+			PostToEventQueues(pServer, pEvent);
+		QVector<SmartPtr<CNotificationThread> > threads = GetRoutingNotificationThreads();
+		if (threads.size() > 1 && sVmUuid.isEmpty() && pVm.isValid())
+			sVmUuid = Uuid(pVm->GetUuid()).toString();
+		SmartPtr<CNotificationThread> pNotificationThread = SelectNotificationThread(threads, sVmUuid);
 		if (pEvent && pNotificationThread.getImpl())
 		{
-			emit pNotificationThread->ToNotifyServer(pServer, pEvent);
+			// Server and VM notifications of the same event are coalesced separately
+			if (pNotificationThread->NotifyServer(pServer, pEvent,
+					sCoalesceKey.isEmpty() ? sCoalesceKey : "S:" + sCoalesceKey))
+				m_nCoalescedEvents.fetchAndAddRelaxed(1);
 
 			if (pVm.isValid() && pVm->GetType() == PHT_VIRTUAL_MACHINE
 				&& pVm->GetHandle() != PRL_INVALID_HANDLE)
-				emit pNotificationThread->ToNotifyVm(pVm, pEvent);
+				pNotificationThread->NotifyVm(pVm, pEvent,
+					sCoalesceKey.isEmpty() ? sCoalesceKey : "V:" + sCoalesceKey);
 
 			if (PHT_EVENT == pEvent->GetType())
 				pEvent->Release();
@@ -404,20 +721,19 @@ bool CEventsHandler::event( QEvent *pEvent )
 
 void CEventsHandler::RegisterNotification( PrlHandleServerPtr pServer, PrlHandleBasePtr pEvent )
 {
-	SmartPtr<CNotificationThread> pNotificationThread = m_NotificationThread;
+	SmartPtr<CNotificationThread> pNotificationThread =
+		SelectNotificationThread( GetRoutingNotificationThreads(), QString() );
+	PostToEventQueues( pServer, pEvent );
 	if ( pNotificationThread.getImpl() )
-		emit pNotificationThread->ToNotifyServer( pServer, pEvent );
+		pNotificationThread->NotifyServer( pServer, pEvent );
 }
 
 void CEventsHandler::StopNotificationThread()
 {
 	QMutexLocker locker(&m_Mutex);
 
-	// Deferred thread clean
-	SmartPtr<CNotificationThread> pNotificationThread = m_NotificationThread;
-	if (pNotificationThread.getImpl())
-	{
-		PrlHandleServer::RegisterThreadToDelete(pNotificationThread);
-		m_NotificationThread = SmartPtr<CNotificationThread>(0);
-	}
+	// Deferred threads clean
+	for (int i = 0; i < m_NotificationThreads.size(); ++i)
+		PrlHandleServer::RegisterThreadToDelete(m_NotificationThreads[i]);
+	m_NotificationThreads.clear();
 }
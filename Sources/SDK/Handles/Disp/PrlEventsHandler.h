@@ -33,13 +33,19 @@
 #include <QPair>
 #include <QMutex>
 #include <QThread>
+#include <QVector>
+#include <QAtomicInteger>
 
 #include "PrlHandleBase.h"
 #include "PrlCommon.h"
 #include "BuiltinEventSource.h"
+#include "Libraries/ContextSwitcher/ContextSwitcher.h"
 
 #include <prlcommon/Std/SmartPtr.h>
 
+/** Maximum number of notification threads of the server */
+#define PRL_MAX_NOTIFICATION_SHARDS 64
+
 /**
  * Notification thread
  */
@@ -53,9 +59,43 @@ public:
 
 	bool isStarted() const;
 
+	/**
+	 * Queues server notification and accounts it in thread statistics
+	 * @param key of coalesced notifications: only the last queued
+	 * notification with the same key is delivered, empty key disables coalescing
+	 * @return sign whether notification replaced an earlier undelivered one
+	 */
+	bool NotifyServer(const PrlHandleServerPtr &pServer, const PrlHandleBasePtr &pEvent,
+					  const QString &sCoalesceKey = QString());
+	/** Queues VM notification, see NotifyServer() */
+	bool NotifyVm(const PrlHandleVmPtr &pVm, const PrlHandleBasePtr &pEvent,
+				  const QString &sCoalesceKey = QString());
+
+	/**
+	 * Checks whether queued notification was replaced by a newer one with the
+	 * same key and should be skipped. Accounts skipped notification.
+	 */
+	bool IsSuperseded(const QString &sCoalesceKey, const PrlHandleBasePtr &pEvent);
+
+	/**
+	 * Accounts notification delivered by the thread
+	 * @param time in usecs when notification was queued
+	 */
+	void NotificationDelivered(qint64 nQueuedAt);
+
+	/**
+	 * Returns thread statistics. Latency is measured from notification
+	 * queueing up to return from the listeners callbacks.
+	 */
+	void GetStat(PRL_UINT32_PTR pnQueueDepth, PRL_UINT64_PTR pnDelivered,
+				 PRL_UINT64_PTR pnAvgLatency, PRL_UINT64_PTR pnMaxLatency) const;
+
+	/** Returns monotonic time in usecs used to measure notifications latency */
+	static qint64 GetTimestamp();
+
 signals:
-	void ToNotifyVm(PrlHandleVmPtr, PrlHandleBasePtr);
-	void ToNotifyServer(PrlHandleServerPtr, PrlHandleBasePtr);
+	void ToNotifyVm(PrlHandleVmPtr, PrlHandleBasePtr, qint64, QString);
+	void ToNotifyServer(PrlHandleServerPtr, PrlHandleBasePtr, qint64, QString);
 
 public slots:
 	void NotificationStarted ();
@@ -66,11 +106,53 @@ public slots:
 private:
 	void run ();
 
+	bool Coalesce(const QString &sCoalesceKey, const PrlHandleBasePtr &pEvent);
+
 private:
 	// Friend class to call signals
 	friend class CEventsHandler;
 
 	volatile bool m_bNotificationStarted;
+
+	/** Number of queued but not delivered yet notifications */
+	QAtomicInteger<quint32> m_nQueueDepth;
+	/** Number of delivered notifications */
+	QAtomicInteger<quint64> m_nDelivered;
+	/** Sum and maximum of delivered notifications latency in usecs */
+	QAtomicInteger<quint64> m_nLatencySum;
+	QAtomicInteger<quint64> m_nLatencyMax;
+
+	QMutex m_CoalesceMutex;
+	/** Last queued notification event by coalescing key */
+	QHash<QString, PrlHandleBase* > m_CoalescedEvents;
+};
+
+/**
+ * Server execution context thread. Runs own event loop where server requests
+ * and responses are processed, so servers do not share SDK event loop.
+ */
+class CServerContextThread : public QThread
+{
+	Q_OBJECT
+public:
+	CServerContextThread ();
+
+	/** Returns context switcher which executes calls in the thread */
+	ContextSwitcher* GetContextSwitcher () { return &m_ContextSwitcher; }
+
+	/**
+	 * Stops thread event loop. Waits until thread finished if called outside of it,
+	 * otherwise thread object deletes itself after finish.
+	 * @return sign whether caller is responsible for thread object deletion
+	 */
+	bool Stop ();
+
+private:
+	void run ();
+
+private:
+	/** Calls executor living in the thread */
+	ContextSwitcher m_ContextSwitcher;
 };
 
 /**
@@ -96,8 +178,14 @@ private:
 class CServerNotifier : public QObject
 {
 	Q_OBJECT
+public:
+	CServerNotifier ( CNotificationThread* t );
+
 public slots:
-    void Notify(PrlHandleServerPtr, PrlHandleBasePtr);
+    void Notify(PrlHandleServerPtr, PrlHandleBasePtr, qint64, QString);
+
+private:
+	CNotificationThread* m_pThread;
 };
 
 /**
@@ -106,8 +194,14 @@ public slots:
 class CVmNotifier : public QObject
 {
 	Q_OBJECT
+public:
+	CVmNotifier ( CNotificationThread* t );
+
 public slots:
-    void Notify(PrlHandleVmPtr, PrlHandleBasePtr);
+    void Notify(PrlHandleVmPtr, PrlHandleBasePtr, qint64, QString);
+
+private:
+	CNotificationThread* m_pThread;
 };
 
 /**
@@ -139,18 +233,67 @@ public:
 
 	bool isStarted() const;
 
+	/**
+	 * Sets number of notification threads. Notifications related to the same
+	 * VM are always delivered by the same thread so their order is kept, the
+	 * rest notifications are delivered by the first thread.
+	 * @param number of threads, 1 means default single thread delivery
+	 * @return PRL_ERR_INVALID_ARG for out of range count or
+	 * PRL_ERR_UNEXPECTED if notification threads were already stopped
+	 */
+	PRL_RESULT SetNotificationShards( PRL_UINT32 nShardsCount );
+
+	/**
+	 * Returns statistics of notification thread
+	 * @return PRL_ERR_INVALID_ARG if there is no thread with specified index
+	 */
+	PRL_RESULT GetNotificationShardStat( PRL_UINT32 nShard, PRL_UINT32_PTR pnQueueDepth,
+		PRL_UINT64_PTR pnDelivered, PRL_UINT64_PTR pnAvgLatency, PRL_UINT64_PTR pnMaxLatency );
+
+	/**
+	 * Enables or disables coalescing of progress events: undelivered progress
+	 * event is dropped when newer progress event of the same job is queued
+	 */
+	void SetProgressCoalescing( bool bEnabled );
+
+	/** Returns number of progress events dropped by coalescing */
+	quint64 GetCoalescedEventsCount() const;
+
 private:
 	/**
 	 * Handler of the events from the server.
 	 */
 	bool event(QEvent *pEvent);
 
+	/** Returns copy of current notification threads list */
+	QVector<SmartPtr<CNotificationThread> > GetNotificationThreads();
+
+	/**
+	 * Returns copy of notification threads list to route a notification.
+	 * The list is fixed since then as a VM events order is kept only while
+	 * they are routed to the same thread.
+	 */
+	QVector<SmartPtr<CNotificationThread> > GetRoutingNotificationThreads();
+
+	/**
+	 * Selects notification thread for the VM
+	 * @param normalized VM uuid or empty string for server wide notification
+	 */
+	static SmartPtr<CNotificationThread> SelectNotificationThread(
+		const QVector<SmartPtr<CNotificationThread> > &threads, const QString &sVmUuid );
+
+	/** Puts event into all events queues of the server */
+	static void PostToEventQueues( const PrlHandleServerPtr &pServer, const PrlHandleBasePtr &pEvent );
+
+	/** Returns sign whether event reports progress of long running operation */
+	static bool IsProgressEvent( PRL_EVENT_TYPE nEventType );
+
 public:
 	/// Handle to the server object
 	PRL_HANDLE m_ServerHandle;
 
-	/** Notification thread */
-	SmartPtr<CNotificationThread> m_NotificationThread;
+	/** Notification threads, VM notifications are sharded by VM uuid */
+	QVector<SmartPtr<CNotificationThread> > m_NotificationThreads;
 
 public slots:
 	/**
@@ -160,8 +303,15 @@ public slots:
 	void FinalizeWork();
 
 private:
-	/** Notification thread removal mutex*/
-	QMutex m_Mutex;
+	/** Notification threads list mutex */
+	mutable QMutex m_Mutex;
+	/** Sign whether notifications were routed, protected by m_Mutex */
+	bool m_bNotificationsRouted;
+
+	/** Progress events coalescing sign */
+	QAtomicInt m_bCoalesceProgress;
+	/** Number of progress events dropped by coalescing */
+	QAtomicInteger<quint64> m_nCoalescedEvents;
 };
 
 #endif // __VIRTUOZZO_EVENTS_HANDLER_H__
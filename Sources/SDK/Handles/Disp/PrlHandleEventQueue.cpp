@@ -0,0 +1,159 @@
+/*
+ * PrlHandleEventQueue.cpp
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "PrlHandleEventQueue.h"
+#include "PrlHandleHandlesList.h"
+
+#include <prlcommon/Logging/Logging.h>
+
+#ifdef _LIN_
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
+#include <QDeadlineTimer>
+#include <climits>
+
+PrlHandleEventQueue::PrlHandleEventQueue(const PrlHandleServerPtr &pServer, PRL_UINT32 nCapacity)
+: PrlHandleBase(PHT_EVENT_QUEUE),
+  m_pServer(pServer),
+  m_vEvents(nCapacity),
+  m_nHead(0),
+  m_nCount(0),
+  m_nOverflowCount(0),
+  m_nFd(-1)
+{
+#ifdef _LIN_
+	m_nFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_nFd < 0)
+		WRITE_TRACE(DBG_FATAL, "Failed to create events queue descriptor: %s", strerror(errno));
+#endif
+	m_pServer->RegisterEventQueue(GetHandle());
+}
+
+PrlHandleEventQueue::~PrlHandleEventQueue()
+{
+	m_pServer->UnregisterEventQueue(GetHandle());
+#ifdef _LIN_
+	if (m_nFd >= 0)
+		close(m_nFd);
+#endif
+}
+
+bool PrlHandleEventQueue::IsValid() const
+{
+#ifdef _LIN_
+	if (m_nFd < 0)
+		return false;
+#endif
+	return !m_vEvents.isEmpty();
+}
+
+void PrlHandleEventQueue::Push(const PrlHandleBasePtr &pEvent)
+{
+	// Dropped event is released after the lock
+	PrlHandleBasePtr pDropped;
+
+	QMutexLocker _lock(&m_Mutex);
+	int nCapacity = m_vEvents.size();
+	if (m_nCount == nCapacity)
+	{
+		pDropped = m_vEvents[m_nHead];
+		m_vEvents[m_nHead] = pEvent;
+		m_nHead = (m_nHead + 1) % nCapacity;
+		m_nOverflowCount.fetchAndAddRelaxed(1);
+		return;
+	}
+
+	m_vEvents[(m_nHead + m_nCount) % nCapacity] = pEvent;
+	if (m_nCount++)
+		return;
+
+	m_Condition.wakeAll();
+#ifdef _LIN_
+	if (m_nFd >= 0 && eventfd_write(m_nFd, 1) < 0)
+		WRITE_TRACE(DBG_FATAL, "Failed to signal events queue descriptor: %s", strerror(errno));
+#endif
+}
+
+PRL_RESULT PrlHandleEventQueue::Poll(PRL_UINT32 nTimeoutMs, PRL_UINT32 nMaxEvents, PRL_HANDLE_PTR phEventsList)
+{
+	QList<PrlHandleBasePtr> lstEvents;
+	{
+		QMutexLocker _lock(&m_Mutex);
+		// Events may be taken by concurrent poller after wake up
+		QDeadlineTimer deadline(QDeadlineTimer::Forever);
+		if (nTimeoutMs != UINT_MAX)
+			deadline.setRemainingTime(qint64(nTimeoutMs));
+		while (!m_nCount && !deadline.hasExpired())
+			m_Condition.wait(&m_Mutex, deadline);
+		if (!m_nCount)
+			return (PRL_ERR_TIMEOUT);
+
+		int nCapacity = m_vEvents.size();
+		while (m_nCount && PRL_UINT32(lstEvents.size()) < nMaxEvents)
+		{
+			lstEvents.append(m_vEvents[m_nHead]);
+			m_vEvents[m_nHead] = PrlHandleBasePtr();
+			m_nHead = (m_nHead + 1) % nCapacity;
+			--m_nCount;
+		}
+
+#ifdef _LIN_
+		// Descriptor is readable while the queue is not empty
+		eventfd_t nValue;
+		if (!m_nCount && m_nFd >= 0)
+			eventfd_read(m_nFd, &nValue);
+#endif
+	}
+
+	PrlHandleHandlesList *pList = new PrlHandleHandlesList(lstEvents);
+	if (!pList)
+		return (PRL_ERR_OUT_OF_MEMORY);
+
+	*phEventsList = pList->GetHandle();
+	return (PRL_ERR_SUCCESS);
+}
+
+PRL_RESULT PrlHandleEventQueue::GetFd(PRL_INT32_PTR pnFd)
+{
+#ifdef _LIN_
+	*pnFd = m_nFd;
+	return (PRL_ERR_SUCCESS);
+#else
+	(void)pnFd;
+	return (PRL_ERR_UNIMPLEMENTED);
+#endif
+}
+
+PRL_RESULT PrlHandleEventQueue::GetOverflowCount(PRL_UINT64_PTR pnOverflowCount)
+{
+	*pnOverflowCount = m_nOverflowCount.loadRelaxed();
+	return (PRL_ERR_SUCCESS);
+}
@@ -0,0 +1,116 @@
+/*
+ * PrlHandleEventQueue.h
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_HANDLE_EVENT_QUEUE_H__
+#define __VIRTUOZZO_HANDLE_EVENT_QUEUE_H__
+
+#include <QVector>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInteger>
+
+#include "PrlHandleServer.h"
+
+/**
+ * Handle object represents queue of server events read by the client on
+ * its own (pull model). Events are put into fixed capacity ring buffer right
+ * from the server events processing, bypassing notification threads. When
+ * the buffer is full the oldest event is dropped.
+ *
+ * On Linux queue owns eventfd descriptor which is readable while the queue
+ * is not empty, so it may be watched by the client event loop.
+ */
+class PrlHandleEventQueue : public PrlHandleBase
+{
+public:
+	/**
+	 * Class constructor. Registers queue at the server.
+	 * @param server which events are queued
+	 * @param maximum number of queued events
+	 */
+	PrlHandleEventQueue(const PrlHandleServerPtr &pServer, PRL_UINT32 nCapacity);
+
+	/**
+	 * Class destructor. Unregisters queue from the server.
+	 */
+	~PrlHandleEventQueue();
+
+	/**
+	 * Returns sign whether queue was initialized successfully
+	 */
+	bool IsValid() const;
+
+	/**
+	 * Puts event into the queue dropping the oldest one if queue is full
+	 */
+	void Push(const PrlHandleBasePtr &pEvent);
+
+public://API helpers
+	/**
+	 * Takes queued events waiting for the first one up to specified timeout
+	 * @param timeout in msecs, UINT_MAX to wait forever
+	 * @param maximum number of taken events
+	 * @param [out] pointer to the handle of PHT_HANDLES_LIST of taken events
+	 * @return PRL_RESULT. Possible values:
+	 * * PRL_ERR_TIMEOUT			- no events were queued during the timeout
+	 * * PRL_ERR_OUT_OF_MEMORY	- not enough memory to allocate events list
+	 * * PRL_ERR_SUCCESS			- operation completed successfully
+	 */
+	PRL_RESULT Poll(PRL_UINT32 nTimeoutMs, PRL_UINT32 nMaxEvents, PRL_HANDLE_PTR phEventsList);
+
+	/**
+	 * Returns descriptor which is readable while the queue is not empty
+	 * @return PRL_ERR_UNIMPLEMENTED on platforms without eventfd
+	 */
+	PRL_RESULT GetFd(PRL_INT32_PTR pnFd);
+
+	/**
+	 * Returns number of events dropped due queue overflow
+	 */
+	PRL_RESULT GetOverflowCount(PRL_UINT64_PTR pnOverflowCount);
+
+private:
+	/** Server which events are queued */
+	PrlHandleServerPtr m_pServer;
+	/** Ring buffer access synchronization object */
+	QMutex m_Mutex;
+	QWaitCondition m_Condition;
+	/** Ring buffer of queued events */
+	QVector<PrlHandleBasePtr> m_vEvents;
+	/** Index of the oldest queued event */
+	int m_nHead;
+	/** Number of queued events */
+	int m_nCount;
+	/** Number of events dropped due overflow */
+	QAtomicInteger<quint64> m_nOverflowCount;
+	/** Notification descriptor (eventfd) or -1 */
+	int m_nFd;
+};
+
+typedef PrlHandleSmartPtr<PrlHandleEventQueue> PrlHandleEventQueuePtr;
+
+#endif // __VIRTUOZZO_HANDLE_EVENT_QUEUE_H__
@@ -76,10 +76,9 @@ PRL_HANDLE PrlHandleLoginHelperJob::Cancel()
 	return hJob;
 }
 
-QString PrlHandleLoginHelperJob::EncodePassword(const QString &sPassword)
+QString PrlHandleLoginHelperJob::EncodePassword(const QString &sPassword, IOClient *pClient)
 {
     IOCommunication::ProtocolVersion ver;
-	IOClient *pClient = m_pServer->GetPveControl()->GetIoClient();
 
     if (pClient && pClient->serverProtocolVersion(ver) && IOPROTOCOL_NEW_LOGIN_SUPPORT(ver))
 	{
@@ -97,7 +96,8 @@ void PrlHandleLoginHelperJob::doJob()
 		QMutexLocker _lock( &m_mutex );
 		CProtoCommandPtr pRequest = CProtoSerializer::CreateDspCmdUserLoginCommand(
 												m_sUser,
-												EncodePassword(m_sPassword),
+												EncodePassword(m_sPassword,
+													m_pServer->GetPveControl()->GetIoClient()),
 												m_sPrevSessionUuid,
 												m_flags);
 		SmartPtr<IOPackage> pPackage = DispatcherPackage::createInstance(pRequest->GetCommandId(),
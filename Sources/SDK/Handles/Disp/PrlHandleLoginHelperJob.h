@@ -62,10 +62,16 @@ public:
 	void SetHost( const QString &host ) { m_sHost = host; }
 	QString GetHost() const { return m_sHost; }
 	PRL_UINT32 GetFlags() const { return m_flags; }
+	QString GetUser() const { return m_sUser; }
+	QString GetPassword() const { return m_sPassword; }
 	PRL_RESULT processPublicKeyAuth(Virtuozzo::CProtoCommandDspWsResponse* pResponseCommand);
 
+	/**
+	 * Encodes password in the form expected by the peer of specified connection
+	 */
+	static QString EncodePassword(const QString &sPassword, IOClient *pClient);
+
 private:
-	QString EncodePassword(const QString &sPassword);
 
 	PrlHandleServerPtr m_pServer;
 	QString m_sUser;
@@ -32,6 +32,9 @@
 #include "PrlHandleProblemReportBase.h"
 #include "PrlHandleCpuPool.h"
 #include "PrlHandleBackup.h"
+#include "PrlEventBatchThread.h"
+#include "PrlHandleHandlesList.h"
+#include "PveCompression.h"
 
 #include <prlcommon/Messaging/CVmBinaryEventParameter.h>
 
@@ -47,6 +50,12 @@
 #include <sys/types.h>
 #endif
 
+#ifdef _LIN_
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#endif
+
 #ifdef ENABLE_MALLOC_DEBUG
     // By adding this interface we enable allocations tracing in the module
     #include "Interfaces/Debug.h"
@@ -71,9 +80,15 @@ PrlHandleServer::PrlHandleServer()
   m_isConnectionLocal( false ),
   m_isProxyConnection( false ),
   m_pPveControl(NULL),
+  m_pContextThread( new CServerContextThread ),
   m_pEventsHandler( new CEventsHandler(GetHandle()) ),
+  m_pEventBatchThread(NULL),
   m_nManagePort(0),
   m_nSecurityLevel(PSL_LOW_SECURITY),
+  m_nJobsCompletionFd(-1),
+  m_nRequestsQueueCapacity(0),
+  m_nRequestsQueueTimeout(0),
+  m_nConnectionPoolSize(0),
   m_bNonInteractiveSession(PRL_FALSE),
   m_bConfirmationModeEnabled(PRL_FALSE),
   m_nServerAppExecuteMode(PAM_UNKNOWN),
@@ -81,27 +96,34 @@ PrlHandleServer::PrlHandleServer()
   m_nStartTimeMonotonic(0)
   , m_pSupportedOsesMatrix(0)
 {
+	// Server requests and responses are processed in own event loop
+	m_pContextThread->start();
+	m_pEventsHandler->moveToThread(m_pContextThread);
 	InitializeConnection();
 }
 
 bool PrlHandleServer::isStarted() const
 {
-	return m_pEventsHandler->isStarted();
+	return m_pEventsHandler && m_pEventsHandler->isStarted();
 }
 
 PrlHandleServer::~PrlHandleServer()
 {
+#ifdef _LIN_
+	if (m_nJobsCompletionFd >= 0)
+		close(m_nJobsCompletionFd);
+#endif
+
 	if (QCoreApplication::closingDown())
 		return;
-	if (m_pPveControl)
-	{
-		m_pPveControl->stopTransport();
-		m_pPveControl->deleteLater();
-	}
+	DestroyContextObjects();
 
-	//CEventsHandler object should to be destroyed from native event loop
-	m_pEventsHandler->StopNotificationThread();
-	m_pEventsHandler->deleteLater();
+	if (m_pEventBatchThread && m_pEventBatchThread->Stop())
+		delete m_pEventBatchThread;
+
+	//Objects scheduled for deletion are destroyed on thread finish
+	if (m_pContextThread->Stop())
+		delete m_pContextThread;
 }
 
 void PrlHandleServer::InitConnectionSettings(const QString& hostName,
@@ -147,6 +169,194 @@ QString PrlHandleServer::toString()
 	return m_evtRestriction.toString();
 }
 
+PRL_RESULT PrlHandleServer::RegEventHandlerBatch(PRL_EVENT_HANDLER_PTR handler, PRL_UINT32 nMaxBatch,
+	PRL_UINT32 nMaxDelayMs, PRL_VOID_PTR userData)
+{
+	CEventBatchThread *pEventBatchThread;
+	{
+		// Most of servers have no batch handlers, so thread is created on demand
+		QMutexLocker _lock(&m_MembersMutex);
+		if (!m_pEventBatchThread)
+			m_pEventBatchThread = new CEventBatchThread;
+		pEventBatchThread = m_pEventBatchThread;
+	}
+	if (!pEventBatchThread)
+		return (PRL_ERR_OUT_OF_MEMORY);
+	return pEventBatchThread->RegHandler(eventSource(), handler, nMaxBatch, nMaxDelayMs, userData);
+}
+
+PRL_RESULT PrlHandleServer::UnregEventHandlerBatch(PRL_EVENT_HANDLER_PTR handler, PRL_VOID_PTR userData)
+{
+	CEventBatchThread *pEventBatchThread;
+	{
+		QMutexLocker _lock(&m_MembersMutex);
+		pEventBatchThread = m_pEventBatchThread;
+	}
+	if (!pEventBatchThread)
+		return (PRL_ERR_SUCCESS);
+	return pEventBatchThread->UnregHandler(eventSource(), handler, userData);
+}
+
+void PrlHandleServer::RegisterEventQueue(PRL_HANDLE hQueue)
+{
+	QMutexLocker _lock(&m_MembersMutex);
+	m_lstEventQueues.append(hQueue);
+}
+
+void PrlHandleServer::UnregisterEventQueue(PRL_HANDLE hQueue)
+{
+	QMutexLocker _lock(&m_MembersMutex);
+	m_lstEventQueues.removeAll(hQueue);
+}
+
+QList<PRL_HANDLE> PrlHandleServer::GetEventQueues() const
+{
+	QMutexLocker _lock(&m_MembersMutex);
+	return m_lstEventQueues;
+}
+
+PRL_RESULT PrlHandleServer::GetJobsCompletionFd(PRL_INT32_PTR pnFd)
+{
+#ifdef _LIN_
+	QMutexLocker _lock(&m_MembersMutex);
+	if (m_nJobsCompletionFd < 0)
+	{
+		m_nJobsCompletionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (m_nJobsCompletionFd < 0)
+		{
+			WRITE_TRACE(DBG_FATAL, "Failed to create jobs completion descriptor: %s", strerror(errno));
+			return (PRL_ERR_OUT_OF_MEMORY);
+		}
+	}
+	*pnFd = m_nJobsCompletionFd;
+	return (PRL_ERR_SUCCESS);
+#else
+	(void)pnFd;
+	return (PRL_ERR_UNIMPLEMENTED);
+#endif
+}
+
+void PrlHandleServer::JobCompleted(PRL_HANDLE hJob)
+{
+#ifdef _LIN_
+	QMutexLocker _lock(&m_MembersMutex);
+	// Nobody reaps completed jobs until descriptor was requested
+	if (m_nJobsCompletionFd < 0)
+		return;
+
+	m_lstCompletedJobs.append(hJob);
+	if (1 == m_lstCompletedJobs.size() && eventfd_write(m_nJobsCompletionFd, 1) < 0)
+		WRITE_TRACE(DBG_FATAL, "Failed to signal jobs completion descriptor: %s", strerror(errno));
+#else
+	(void)hJob;
+#endif
+}
+
+void PrlHandleServer::SetRequestsQueue(PRL_UINT32 nCapacity, PRL_UINT32 nTimeout)
+{
+	// Connection object is replaced under direct calls lock
+	QReadLocker _lock(&m_DirectCallsLock);
+	QMutexLocker _members_lock(&m_MembersMutex);
+	m_nRequestsQueueCapacity = nCapacity;
+	m_nRequestsQueueTimeout = nTimeout;
+	if (m_pPveControl)
+		m_pPveControl->SetSendQueue(nCapacity, nTimeout);
+}
+
+void PrlHandleServer::GetRequestsQueueStat(PRL_UINT32_PTR pnDepth, PRL_UINT32_PTR pnMaxDepth,
+										   PRL_UINT64_PTR pnQueued, PRL_UINT64_PTR pnRejected)
+{
+	quint32 nDepth = 0, nMaxDepth = 0;
+	quint64 nQueued = 0, nRejected = 0;
+	{
+		QReadLocker _lock(&m_DirectCallsLock);
+		if (m_pPveControl)
+			m_pPveControl->GetSendQueueStat(nDepth, nMaxDepth, nQueued, nRejected);
+	}
+	*pnDepth = nDepth;
+	*pnMaxDepth = nMaxDepth;
+	*pnQueued = nQueued;
+	*pnRejected = nRejected;
+}
+
+void PrlHandleServer::SetConnectionPool(PRL_UINT32 nConnections)
+{
+	QReadLocker _lock(&m_DirectCallsLock);
+	{
+		QMutexLocker _members_lock(&m_MembersMutex);
+		m_nConnectionPoolSize = nConnections;
+	}
+	// Pool connections are opened and closed without members lock
+	if (m_pPveControl)
+		m_pPveControl->SetConnectionPool(nConnections);
+}
+
+void PrlHandleServer::BeginBatch()
+{
+	QReadLocker _lock(&m_DirectCallsLock);
+	if (m_pPveControl)
+		m_pPveControl->BeginBatch();
+}
+
+void PrlHandleServer::SubmitBatch()
+{
+	QReadLocker _lock(&m_DirectCallsLock);
+	if (m_pPveControl)
+		m_pPveControl->SubmitBatch();
+}
+
+void PrlHandleServer::GetInFlightJobs(PRL_UINT32_PTR pnJobs, PRL_UINT32_PTR pnRequests)
+{
+	quint32 nJobs = 0, nRequests = 0;
+	{
+		SYNCHRO_INTERNAL_DATA_ACCESS
+		nJobs = m_ResponseAwaitingList.size();
+	}
+	{
+		QReadLocker _lock(&m_DirectCallsLock);
+		if (m_pPveControl)
+			nRequests = m_pPveControl->GetSentRequestsCount();
+	}
+	*pnJobs = nJobs;
+	*pnRequests = nRequests;
+}
+
+PRL_RESULT PrlHandleServer::ReapCompletedJobs(PRL_UINT32 nMaxJobs, PRL_HANDLE_PTR phJobsList)
+{
+	QList<PRL_HANDLE> lstHandles;
+	{
+		QMutexLocker _lock(&m_MembersMutex);
+		if (!nMaxJobs || nMaxJobs >= PRL_UINT32(m_lstCompletedJobs.size()))
+			lstHandles.swap(m_lstCompletedJobs);
+		else
+		{
+			lstHandles = m_lstCompletedJobs.mid(0, nMaxJobs);
+			m_lstCompletedJobs.erase(m_lstCompletedJobs.begin(),
+									 m_lstCompletedJobs.begin() + nMaxJobs);
+		}
+#ifdef _LIN_
+		eventfd_t nValue;
+		if (m_lstCompletedJobs.isEmpty() && m_nJobsCompletionFd >= 0)
+			eventfd_read(m_nJobsCompletionFd, &nValue);
+#endif
+	}
+
+	PrlHandleHandlesList *pList = new PrlHandleHandlesList;
+	if (!pList)
+		return (PRL_ERR_OUT_OF_MEMORY);
+
+	// Jobs already freed by the user are skipped
+	foreach(PRL_HANDLE hJob, lstHandles)
+	{
+		PrlHandleBasePtr pJob = PRL_OBJECT_BY_HANDLE<PrlHandleBase>(hJob, PHT_JOB);
+		if (pJob)
+			pList->AddItem(pJob);
+	}
+
+	*phJobsList = pList->GetHandle();
+	return (PRL_ERR_SUCCESS);
+}
+
 PrlHandleJobPtr PrlHandleServer::create_job(const QString& job_uuid, PRL_JOB_OPERATION_CODE job_code)
 {
     return PrlHandleJobPtr(new PrlHandleServerJob(PrlHandleServerPtr(this), job_uuid, job_code)) ;
@@ -159,16 +369,12 @@ void PrlHandleServer::FinalizeAllTransportConnections()
 
 	QSet<PRL_HANDLE> _servers;
 	QSet<PRL_HANDLE> _vms;
+	foreach(const SmartPtr<PrlHandleBase> &pHandle, s_pHandlesTable->Snapshot())
 	{
-		QMutexLocker lock(PrlHandleBase::s_pHandlesMapMutex);
-		HandlesMap::const_iterator _it = s_pHandlesMap->begin();
-		for(; _it != s_pHandlesMap->end(); ++_it)
-		{
-			if (_it.value()->GetType() == PHT_SERVER)
-				_servers.insert(_it.key());
-			else if (_it.value()->GetType() == PHT_VIRTUAL_MACHINE)
-				_vms.insert(_it.key());
-		}
+		if (pHandle->GetType() == PHT_SERVER)
+			_servers.insert(pHandle->GetHandle());
+		else if (pHandle->GetType() == PHT_VIRTUAL_MACHINE)
+			_vms.insert(pHandle->GetHandle());
 	}
 	foreach(PRL_HANDLE hVm, _vms)
 	{
@@ -182,6 +388,7 @@ void PrlHandleServer::FinalizeAllTransportConnections()
 		if (pServer) {
 			pServer->StopTransport();
 			pServer->StopNotificationThread();
+			pServer->StopContextThread();
 		}
 	}
 }
@@ -281,17 +488,120 @@ void PrlHandleServer::StopTransport()
 
 void PrlHandleServer::StopNotificationThread()
 {
-	m_pEventsHandler->StopNotificationThread();
+	if (m_pEventsHandler)
+		m_pEventsHandler->StopNotificationThread();
+}
+
+PRL_RESULT PrlHandleServer::SetNotificationShards(PRL_UINT32 nShardsCount)
+{
+	return m_pEventsHandler->SetNotificationShards(nShardsCount);
+}
+
+PRL_RESULT PrlHandleServer::GetNotificationShardStat(PRL_UINT32 nShard, PRL_UINT32_PTR pnQueueDepth,
+	PRL_UINT64_PTR pnDelivered, PRL_UINT64_PTR pnAvgLatency, PRL_UINT64_PTR pnMaxLatency)
+{
+	return m_pEventsHandler->GetNotificationShardStat(nShard, pnQueueDepth,
+		pnDelivered, pnAvgLatency, pnMaxLatency);
+}
+
+void PrlHandleServer::SetProgressCoalescing(bool bEnabled)
+{
+	m_pEventsHandler->SetProgressCoalescing(bEnabled);
+}
+
+quint64 PrlHandleServer::GetCoalescedEventsCount() const
+{
+	return m_pEventsHandler->GetCoalescedEventsCount();
+}
+
+ContextSwitcher* PrlHandleServer::GetContextSwitcher() const
+{
+	return m_pContextThread->GetContextSwitcher();
+}
+
+bool PrlHandleServer::IsContextThread() const
+{
+	return (QThread::currentThread() == m_pContextThread);
+}
+
+void PrlHandleServer::StopContextThread()
+{
+	// Deferred deletions are processed by the thread before it is finished
+	DestroyContextObjects();
+	m_pContextThread->exit(0);
+	m_pContextThread->wait();
+}
+
+void PrlHandleServer::DestroyContextObjects()
+{
+	CPveControl *pPveControl = NULL;
+	{
+		QWriteLocker _lock(&m_DirectCallsLock);
+		pPveControl = m_pPveControl;
+		m_pPveControl = NULL;
+	}
+	if (pPveControl)
+	{
+		pPveControl->stopTransport();
+		pPveControl->deleteLater();
+	}
+
+	//CEventsHandler object should to be destroyed from native event loop
+	if (m_pEventsHandler)
+	{
+		m_pEventsHandler->StopNotificationThread();
+		m_pEventsHandler->deleteLater();
+		m_pEventsHandler = NULL;
+	}
+}
+
+QReadWriteLock *PrlHandleServer::GetDirectCallsLock()
+{
+	return &m_DirectCallsLock;
+}
+
+void PrlHandleServer::AddPendingRequest(const PrlUuidKey &requestUuid)
+{
+	QMutexLocker _lock(&m_PendingRequestsMutex);
+	m_setPendingRequests.insert(requestUuid);
+}
+
+void PrlHandleServer::RemovePendingRequests(const QList<PrlUuidKey> &lstRequestsUuids)
+{
+	QMutexLocker _lock(&m_PendingRequestsMutex);
+	foreach(const PrlUuidKey &requestUuid, lstRequestsUuids)
+		m_setPendingRequests.remove(requestUuid);
+	m_PendingRequestsCondition.wakeAll();
+}
+
+bool PrlHandleServer::WaitForPendingRequest(const PrlUuidKey &requestUuid)
+{
+	QMutexLocker _lock(&m_PendingRequestsMutex);
+	if (!m_setPendingRequests.contains(requestUuid))
+		return false;
+	while (m_setPendingRequests.contains(requestUuid))
+		m_PendingRequestsCondition.wait(&m_PendingRequestsMutex);
+	return true;
 }
 
 void PrlHandleServer::InitializeConnection()
 {
 	if (m_pPveControl)
-	{
 		m_pPveControl->stopTransport();
-		delete m_pPveControl;
+
+	CPveControl *pPrevPveControl = m_pPveControl;
+	{
+		// Requests sending directly from the callers threads use connection object
+		QWriteLocker _lock(&m_DirectCallsLock);
+		m_pPveControl = new CPveControl(m_pEventsHandler);
+		QMutexLocker _members_lock(&m_MembersMutex);
+		m_pPveControl->SetSendQueue(m_nRequestsQueueCapacity, m_nRequestsQueueTimeout);
+		m_pPveControl->SetConnectionPool(m_nConnectionPoolSize);
 	}
-	m_pPveControl = new CPveControl(m_pEventsHandler);
+	m_pPveControl->moveToThread(m_pContextThread);
+	// Previous connection object is destroyed by its own thread as in DestroyContextObjects()
+	if (pPrevPveControl)
+		pPrevPveControl->deleteLater();
 }
 
 bool PrlHandleServer::IsConnectionLocal () const
@@ -319,13 +629,15 @@ QString PrlHandleServer::GetRemoteHost () const
 void PrlHandleServer::AddJobToResponseAwaitingList(const PrlHandleServerJobPtr &pJob)
 {
 	SYNCHRO_INTERNAL_DATA_ACCESS
-	m_ResponseAwaitingList.append(pJob);
+	m_ResponseAwaitingList.insert(pJob.getHandle(), pJob);
 }
 
 void PrlHandleServer::RemoveJobFromResponseAwaitingList(const PrlHandleServerJobPtr &pJob)
 {
+	// Declared before the lock to release the last job reference without it
+	PrlHandleServerJobPtr pRemovedJob;
 	SYNCHRO_INTERNAL_DATA_ACCESS
-	m_ResponseAwaitingList.removeAll(pJob);
+	pRemovedJob = m_ResponseAwaitingList.take(pJob.getHandle());
 }
 
 PRL_UINT32 PrlHandleServer::GetManagePort () const
@@ -352,6 +664,12 @@ void PrlHandleServer::SetRestrictionEvent(QString qsRestrictEvt)
 	m_evtRestriction.fromString(qsRestrictEvt);
 }
 
+QString PrlHandleServer::GetServerUuid() const
+{
+	QMutexLocker _lock(&m_MembersMutex);
+	return (m_sServerUuid);
+}
+
 CPveControl* PrlHandleServer::GetPveControl() const
 {
     return m_pPveControl;
@@ -552,6 +870,22 @@ void PrlHandleServer::ProcessLoginResponse(CResult *pResult)
 	else
 		WRITE_TRACE(DBG_FATAL, "Wrong login response received: error code: %.8X '%s' data: [%s]",\
 			pLoginResponse->m_uiRcInit, PRL_RESULT_TO_STRING(pLoginResponse->m_uiRcInit), QSTR2UTF8(pLoginResponse->toString()));
+
+	if (PRL_SUCCEEDED(pLoginResponse->m_uiRcInit))
+	{
+		// Dispatcher confirms that it accepts compressed requests
+		CVmEventParameter *pParam
+			= pLoginResponse->getEventParameter(EVT_PARAM_PRL_SERVER_INFO_COMPRESSION);
+		bool bCompression = (pParam && pParam->getParamValue().toUInt() != 0);
+
+		// Session is opened, pool connections may log in now
+		QReadLocker _lock(&m_DirectCallsLock);
+		if (m_pPveControl)
+		{
+			m_pPveControl->SetRequestsCompression(bCompression);
+			m_pPveControl->StartConnectionPool();
+		}
+	}
 }
 
 PrlHandleJobPtr PrlHandleServer::DspCmdVmStorageSetValue(PRL_CONST_STR sVmUuid, PRL_CONST_STR sKey,
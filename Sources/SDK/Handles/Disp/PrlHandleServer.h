@@ -28,15 +28,19 @@
 #ifndef __VIRTUOZZO_HANDLE_SERVER_H__
 #define __VIRTUOZZO_HANDLE_SERVER_H__
 
+#include <QSet>
+
 #include "PrlEventsHandler.h"
 #include "PveControl.h"
 #include "PrlQuestionsList.h"
 #include "PrlHandleHandlesList.h"
+#include "PrlEventsFilter.h"
 
 #include <prlcommon/PrlCommonUtilsBase/CFeaturesMatrix.h>
 #include "PrlHandleGuestOsesMatrix.h"
 
 class PrlHandleBackup;
+class CEventBatchThread;
 
 /**
  * Base handle object - all objects representation on the client
@@ -110,11 +114,102 @@ public:
 	*/
 	void SetRestrictionEvent(QString qsRestrictEvt);
 
+	/**
+	 * Returns server UUID received on login
+	 */
+	QString GetServerUuid() const;
+
+	/**
+	 * Returns client side filter of the server events
+	 */
+	PrlEventsFilter &GetEventsFilter() { return m_EventsFilter; }
+
 	/**
 	 * Returns EventSource object.
 	 */
 	BuiltinEventSource *eventSource() { return &m_eventSource; }
 
+	/**
+	 * Registers handler which receives server events in batches
+	 */
+	PRL_RESULT RegEventHandlerBatch(PRL_EVENT_HANDLER_PTR handler, PRL_UINT32 nMaxBatch,
+		PRL_UINT32 nMaxDelayMs, PRL_VOID_PTR userData);
+
+	/**
+	 * Unregisters batch events handler
+	 */
+	PRL_RESULT UnregEventHandlerBatch(PRL_EVENT_HANDLER_PTR handler, PRL_VOID_PTR userData);
+
+	/**
+	 * Registers events queue which receives server events
+	 */
+	void RegisterEventQueue(PRL_HANDLE hQueue);
+
+	/**
+	 * Unregisters events queue
+	 */
+	void UnregisterEventQueue(PRL_HANDLE hQueue);
+
+	/**
+	 * Returns handles of registered events queues
+	 */
+	QList<PRL_HANDLE> GetEventQueues() const;
+
+	/**
+	 * Returns eventfd descriptor which is readable while there are completed
+	 * jobs to reap. Completed jobs are collected since the first call only.
+	 * @param pointer to buffer for storing result
+	 */
+	PRL_RESULT GetJobsCompletionFd(PRL_INT32_PTR pnFd);
+
+	/**
+	 * Registers completion of the server job
+	 * @param job handle
+	 */
+	void JobCompleted(PRL_HANDLE hJob);
+
+	/**
+	 * Takes completed jobs in order of their completion
+	 * @param maximum number of jobs to take (0 means all)
+	 * @param pointer to buffer for storing handles list with jobs
+	 */
+	PRL_RESULT ReapCompletedJobs(PRL_UINT32 nMaxJobs, PRL_HANDLE_PTR phJobsList);
+
+	/**
+	 * Configures requests queue holding requests while transport send queue is full
+	 * @param queue capacity (0 disables queue)
+	 * @param time in msecs to wait for free space in full queue
+	 */
+	void SetRequestsQueue(PRL_UINT32 nCapacity, PRL_UINT32 nTimeout);
+
+	/**
+	 * Returns requests queue metrics of the current connection
+	 */
+	void GetRequestsQueueStat(PRL_UINT32_PTR pnDepth, PRL_UINT32_PTR pnMaxDepth,
+							  PRL_UINT64_PTR pnQueued, PRL_UINT64_PTR pnRejected);
+
+	/**
+	 * Configures pool of additional connections used for bulk requests
+	 * @param number of additional connections (0 disables pool)
+	 */
+	void SetConnectionPool(PRL_UINT32 nConnections);
+
+	/**
+	 * Opens requests batch of the current connection
+	 */
+	void BeginBatch();
+
+	/**
+	 * Sends requests held in the batch of the current connection
+	 */
+	void SubmitBatch();
+
+	/**
+	 * Returns numbers of jobs awaiting completion and of requests
+	 * awaiting response of the current connection
+	 */
+	void GetInFlightJobs(PRL_UINT32_PTR pnJobs, PRL_UINT32_PTR pnRequests);
+
 	/**
 	 * Registers notification for specified object
 	 */
@@ -152,6 +247,72 @@ public:
 	 */
 	void StopNotificationThread();
 
+	/**
+	 * Sets number of notification threads which deliver server events
+	 */
+	PRL_RESULT SetNotificationShards(PRL_UINT32 nShardsCount);
+
+	/**
+	 * Returns statistics of notification thread with specified index
+	 */
+	PRL_RESULT GetNotificationShardStat(PRL_UINT32 nShard, PRL_UINT32_PTR pnQueueDepth,
+		PRL_UINT64_PTR pnDelivered, PRL_UINT64_PTR pnAvgLatency, PRL_UINT64_PTR pnMaxLatency);
+
+	/**
+	 * Enables or disables coalescing of undelivered progress events
+	 */
+	void SetProgressCoalescing(bool bEnabled);
+
+	/**
+	 * Returns number of progress events dropped by coalescing
+	 */
+	quint64 GetCoalescedEventsCount() const;
+
+	/**
+	 * Returns context switcher of the server execution context thread
+	 */
+	ContextSwitcher* GetContextSwitcher() const;
+
+	/**
+	 * Returns sign whether current thread is the server execution context thread
+	 */
+	bool IsContextThread() const;
+
+	/**
+	 * Stops server execution context thread. Connection and events handler
+	 * objects living in the thread are destroyed before it is finished.
+	 */
+	void StopContextThread();
+
+	/**
+	 * Returns lock of the API calls sending requests of this server directly
+	 * from the callers threads (see PrlDirectCall). It is held for reading
+	 * during such call and for writing while connection object is replaced.
+	 */
+	QReadWriteLock *GetDirectCallsLock();
+
+	/**
+	 * Marks request sent by a direct call as pending till the call is completed
+	 * (see PrlDirectCall::AddPendingRequest())
+	 * @param request UUID
+	 */
+	void AddPendingRequest(const PrlUuidKey &requestUuid);
+
+	/**
+	 * Unmarks pending requests of the completed direct call and wakes up
+	 * responses waiting for them
+	 * @param requests UUIDs
+	 */
+	void RemovePendingRequests(const QList<PrlUuidKey> &lstRequestsUuids);
+
+	/**
+	 * Blocks while request is pending, so direct call which has sent it
+	 * completes registration of its job. Returns at once for other requests.
+	 * @param request UUID
+	 * @return sign whether request was pending
+	 */
+	bool WaitForPendingRequest(const PrlUuidKey &requestUuid);
+
 	/**
 	 * Applies server information (server UUID and host OS version) from login response
 	 * @param pointer to result object
@@ -294,9 +455,15 @@ protected:
 	/// Stub object of client/dispatcher interoperations
 	CPveControl* m_pPveControl;
 
+	/// Server execution context thread
+	CServerContextThread* m_pContextThread;
+
 	/// Events processing object
 	CEventsHandler* m_pEventsHandler;
 
+	/// Batch events handlers delivery thread created on the first batch handler registration or NULL
+	CEventBatchThread* m_pEventBatchThread;
+
 	/// Events handlers list
 	BuiltinEventSource m_eventSource;
 
@@ -312,12 +479,36 @@ protected:
 	/// Object for synchronizing remote host name and IO port values access
 	mutable QRecursiveMutex m_MembersMutex;
 
+	/// Direct calls lock (see GetDirectCallsLock())
+	QReadWriteLock m_DirectCallsLock;
+
+	/// Requests sent by direct calls in progress and their guard
+	QSet<PrlUuidKey> m_setPendingRequests;
+	QMutex m_PendingRequestsMutex;
+	QWaitCondition m_PendingRequestsCondition;
+
 	/**
 	 * Map holding all VM handle objects by their uuid's.
 	 */
 	typedef std::map< QString, PRL_HANDLE > HandleVmUuidMap;
 	HandleVmUuidMap m_HandleVmUuidMap;
 
+	/** Handles of events queues receiving server events */
+	QList<PRL_HANDLE> m_lstEventQueues;
+
+	/** Jobs completion descriptor (eventfd) or -1 */
+	int m_nJobsCompletionFd;
+
+	/** Handles of completed jobs which were not reaped yet */
+	QList<PRL_HANDLE> m_lstCompletedJobs;
+
+	/** Requests queue settings applied to each new connection object */
+	PRL_UINT32 m_nRequestsQueueCapacity;
+	PRL_UINT32 m_nRequestsQueueTimeout;
+
+	/** Number of pool connections opened by each new connection object */
+	PRL_UINT32 m_nConnectionPoolSize;
+
 	/** Session UUID string */
 	QString m_sSessionUuid;
 
@@ -333,12 +524,18 @@ protected:
 	/** Proxy peer handle */
 	IOSender::Handle m_sProxyPeerHandle;
 
-	/** Response awaiting objects list */
-	QList<PrlHandleServerJobPtr> m_ResponseAwaitingList;
+	/**
+	 * Response awaiting objects keyed by object pointer, so completion
+	 * does not scan all outstanding jobs
+	 */
+	QHash<PrlHandleServerJob*, PrlHandleServerJobPtr> m_ResponseAwaitingList;
 
 	/** Questions list */
 	PrlQuestionsList m_QuestionsList;
 
+	/** Client side events filter */
+	PrlEventsFilter m_EventsFilter;
+
 	/** Noninteractive session mode */
 	PRL_BOOL m_bNonInteractiveSession;
 
@@ -368,6 +565,12 @@ protected:
 	 */
 	void InitializeConnection();
 
+	/**
+	 * Schedules deletion of the connection and events handler objects in the
+	 * server execution context thread while it is still running
+	 */
+	void DestroyContextObjects();
+
 	/**
 	 * Init connection settings
 	 */
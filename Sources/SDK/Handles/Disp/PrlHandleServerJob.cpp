@@ -36,13 +36,21 @@
 #include <prlcommon/HostUtils/HostUtils.h>
 #include <prlcommon/PrlCommonUtilsBase/CommandConvHelper.h>
 
-#include <map>
 #include <new>
 #include <QHash>
 
+#include "PrlUuidMap.h"
+
 #include <prlcommon/PrlUuid/Uuid.h>
 #include <prlcommon/Std/PrlAssert.h>
 
+#ifdef _LIN_
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
 #ifdef ENABLE_MALLOC_DEBUG
     // By adding this interface we enable allocations tracing in the module
     #include "Interfaces/Debug.h"
@@ -57,12 +65,10 @@
 
 
 /**
- * Statical map holding all jobs by their uuid's.
+ * Statical concurrent map holding all jobs by their binary uuid's.
  */
-typedef std::map< QString, PrlHandleServerJob* > JobUuidMap;
+typedef PrlUuidMap< PrlHandleServerJob* > JobUuidMap;
 Q_GLOBAL_STATIC(JobUuidMap, getJobUuidMap)
-/** Object synchronizing access to jobs list */
-Q_GLOBAL_STATIC(QMutex, getJobUuidMapMutex)
 
 PrlHandleJobPtr CreateErrorHandle(PRL_RESULT error_code,
                                   PRL_CONST_STR strErrorSource,
@@ -93,16 +99,21 @@ PrlHandleServerJob::PrlHandleServerJob(
 PrlHandleJob(nJobOpCode, bIsRequestWasSent),
 m_pServer(server),
 m_Result(job_uuid, DispatcherCmdsToJobTypeConverter::Convert(nJobOpCode), PRL_ERR_UNINITIALIZED),
-m_JobStatus(PJS_RUNNING)
+m_JobStatus(PJS_RUNNING),
+m_nCompletionFd(-1),
+m_bCompletionSignalled(false),
+m_pfnCompletionCallback(NULL),
+m_pCompletionUserData(NULL)
 {
 	m_Uuid = job_uuid;
+	m_UuidKey = PrlUuidKey::FromString(job_uuid);
 
-	QMutexLocker _lock(::getJobUuidMapMutex());
-	if (NULL == _lock.mutex())
+	JobUuidMap *pJobUuidMap = ::getJobUuidMap();
+	if (NULL == pJobUuidMap)
 		return;
 
 	// Registering object in the map
-	(*::getJobUuidMap())[ m_Uuid ] = this;
+	pJobUuidMap->insert( m_UuidKey, this );
 	//Register job at notification awaiting jobs list
 	if (m_pServer)
 		m_pServer->AddJobToResponseAwaitingList(PrlHandleServerJobPtr(this));
@@ -111,9 +122,14 @@ m_JobStatus(PJS_RUNNING)
 
 PrlHandleServerJob::~PrlHandleServerJob()
 {
-	QMutexLocker _lock(::getJobUuidMapMutex());
-	if (NULL != _lock.mutex())
-		::getJobUuidMap()->erase( m_Uuid );
+#ifdef _LIN_
+	if (m_nCompletionFd >= 0)
+		close(m_nCompletionFd);
+#endif
+
+	JobUuidMap *pJobUuidMap = ::getJobUuidMap();
+	if (NULL != pJobUuidMap)
+		pJobUuidMap->remove( m_UuidKey, this );
 }
 
 QString PrlHandleServerJob::GetJobUuid() const
@@ -121,9 +137,15 @@ QString PrlHandleServerJob::GetJobUuid() const
 	return (m_Uuid);
 }
 
+bool PrlHandleServerJob::IsResultProcessedByCurrentThread()
+{
+	return (QThread::currentThread() == QCoreApplication::instance()->thread()
+		|| (m_pServer && m_pServer->IsContextThread()));
+}
+
 PRL_RESULT PrlHandleServerJob::Wait(PRL_UINT32 msecs)
 {
-	if (QThread::currentThread() != QCoreApplication::instance()->thread())
+	if (!IsResultProcessedByCurrentThread())
 	{
 		QMutexLocker _lock(&m_JobStatusMutex);
 		if (m_JobStatus != PJS_FINISHED)
@@ -132,7 +154,7 @@ PRL_RESULT PrlHandleServerJob::Wait(PRL_UINT32 msecs)
 	}
 	else
 	{
-		//Special case to prevent block of main event loop owner thread
+		//Special case to prevent block of event loop owner thread which processes job result
 		PRL_UINT32 nRestTimeout = msecs;
 		PRL_UINT32 nPartialTimeout = 50;
 		while (PJS_FINISHED != GetInternalJobStatus() && nRestTimeout)
@@ -235,6 +257,7 @@ void PrlHandleServerJob::SetCResult( const CResult& result )
 	SetPackageId(result.getPackageId());
 	m_JobStatus = PJS_FINISHED;
 	m_JobStatusCondition.wakeAll();
+	SignalCompletion(_lock);
 }
 
 void PrlHandleServerJob::InitializeError(const QString &strUuid, PRL_RESULT error_code, PRL_CONST_STR strErrorSource)
@@ -254,20 +277,24 @@ void PrlHandleServerJob::InitializeError(const QString &strUuid, PRL_RESULT erro
 	m_Result.setError(pEvent);
 	m_JobStatus = PJS_FINISHED;
 	m_JobStatusCondition.wakeAll();
+	SignalCompletion(_lock);
 }
 
 PrlHandleServerJobPtr PrlHandleServerJob::GetJobByUuid( QString job_uuid )
 {
-	QMutexLocker _lock(::getJobUuidMapMutex());
-	if (NULL == _lock.mutex())
-		return PrlHandleServerJobPtr((PrlHandleServerJob *)0);
-
-	JobUuidMap::iterator it = ::getJobUuidMap()->find( job_uuid );
-
-	if ( it == ::getJobUuidMap()->end() )
-		return PrlHandleServerJobPtr((PrlHandleServerJob *)0);
+	return GetJobByUuid( PrlUuidKey::FromString(job_uuid) );
+}
 
-	return PrlHandleServerJobPtr(it->second);
+PrlHandleServerJobPtr PrlHandleServerJob::GetJobByUuid( const PrlUuidKey &job_uuid )
+{
+	PrlHandleServerJobPtr pJob((PrlHandleServerJob *)0);
+	JobUuidMap *pJobUuidMap = ::getJobUuidMap();
+	if (NULL == pJobUuidMap)
+		return pJob;
+
+	// Reference is taken under the map lock to not race with job destruction
+	pJobUuidMap->find( job_uuid, [&pJob](PrlHandleServerJob *p) { pJob = PrlHandleServerJobPtr(p); } );
+	return pJob;
 }
 
 PRL_RESULT PrlHandleServerJob::GetError( PRL_HANDLE_PTR phEvent )
@@ -290,10 +317,15 @@ PRL_RESULT PrlHandleServerJob::GetError( PRL_HANDLE_PTR phEvent )
 
 void PrlHandleServerJob::SetReturnCode(PRL_RESULT nRetCode)
 {
-	QMutexLocker _lock(&m_JobStatusMutex);
-	m_Result.setReturnCode(nRetCode);
-	m_JobStatus = PJS_FINISHED;
-	m_JobStatusCondition.wakeAll();
+	{
+		QMutexLocker _lock(&m_JobStatusMutex);
+		m_Result.setReturnCode(nRetCode);
+		m_JobStatus = PJS_FINISHED;
+		m_JobStatusCondition.wakeAll();
+		SignalCompletion(_lock);
+	}
+	// Locally completed jobs have no server response to dispatch
+	InvokeCompletionCallback();
 }
 
 CResult PrlHandleServerJob::GetResult()
@@ -307,3 +339,107 @@ PRL_JOB_STATUS PrlHandleServerJob::GetInternalJobStatus()
 	QMutexLocker _lock(&m_JobStatusMutex);
 	return (m_JobStatus);
 }
+
+PRL_RESULT PrlHandleServerJob::AttachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter, PRL_UINT32 nIndex )
+{
+	QMutexLocker _lock(&m_JobStatusMutex);
+	if (PJS_FINISHED == m_JobStatus)
+		pWaiter->Completed(nIndex);
+	else
+		m_Waiters.append(qMakePair(pWaiter, nIndex));
+	return (PRL_ERR_SUCCESS);
+}
+
+void PrlHandleServerJob::DetachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter )
+{
+	QMutexLocker _lock(&m_JobStatusMutex);
+	for (int i = 0; i < m_Waiters.size(); ++i)
+	{
+		if (m_Waiters.at(i).first.getImpl() == pWaiter.getImpl())
+		{
+			m_Waiters.removeAt(i);
+			break;
+		}
+	}
+}
+
+PRL_RESULT PrlHandleServerJob::GetCompletionFd( PRL_INT32_PTR pnFd )
+{
+#ifdef _LIN_
+	QMutexLocker _lock(&m_JobStatusMutex);
+	if (m_nCompletionFd < 0)
+	{
+		m_nCompletionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (m_nCompletionFd < 0)
+		{
+			WRITE_TRACE(DBG_FATAL, "Failed to create job completion descriptor: %s", strerror(errno));
+			return (PRL_ERR_OUT_OF_MEMORY);
+		}
+		if (PJS_FINISHED == m_JobStatus)
+			eventfd_write(m_nCompletionFd, 1);
+	}
+	*pnFd = m_nCompletionFd;
+	return (PRL_ERR_SUCCESS);
+#else
+	Q_UNUSED(pnFd);
+	return (PRL_ERR_UNIMPLEMENTED);
+#endif
+}
+
+void PrlHandleServerJob::SignalCompletion(QMutexLocker &_lock)
+{
+	QList<QPair<SmartPtr<PrlJobsWaiter>, PRL_UINT32> > lstWaiters;
+	lstWaiters.swap(m_Waiters);
+	// Result may be overwritten but job is reaped once
+	bool bFirstCompletion = !m_bCompletionSignalled;
+	m_bCompletionSignalled = true;
+	// Waiters and server take their own locks
+	_lock.unlock();
+
+	for (int i = 0; i < lstWaiters.size(); ++i)
+		lstWaiters.at(i).first->Completed(lstWaiters.at(i).second);
+
+	if (!bFirstCompletion)
+		return;
+
+#ifdef _LIN_
+	if (m_nCompletionFd >= 0 && eventfd_write(m_nCompletionFd, 1) < 0)
+		WRITE_TRACE(DBG_FATAL, "Failed to signal job completion descriptor: %s", strerror(errno));
+#endif
+
+	if (m_pServer)
+		m_pServer->JobCompleted(GetHandle());
+}
+
+PRL_RESULT PrlHandleServerJob::SetCompletionCallback( PRL_EVENT_HANDLER_PTR handler, PRL_VOID_PTR userData )
+{
+	{
+		QMutexLocker _lock(&m_JobStatusMutex);
+		m_pfnCompletionCallback = handler;
+		m_pCompletionUserData = userData;
+		if (PJS_FINISHED != m_JobStatus)
+			return (PRL_ERR_SUCCESS);
+	}
+	InvokeCompletionCallback();
+	return (PRL_ERR_SUCCESS);
+}
+
+bool PrlHandleServerJob::InvokeCompletionCallback()
+{
+	PRL_EVENT_HANDLER_PTR handler;
+	PRL_VOID_PTR userData;
+	{
+		QMutexLocker _lock(&m_JobStatusMutex);
+		handler = m_pfnCompletionCallback;
+		userData = m_pCompletionUserData;
+		m_pfnCompletionCallback = NULL;
+		m_pCompletionUserData = NULL;
+	}
+	if (!handler)
+		return (false);
+
+	// Callback owns passed job reference as event handlers do
+	AddRef();
+	handler(GetHandle(), userData);
+	return (true);
+}
@@ -31,6 +31,7 @@
 
 #include "PrlHandleJob.h"
 #include "PrlHandleServer.h"
+#include "PrlUuidKey.h"
 #include <prlcommon/Messaging/CResult.h>
 #include <QWaitCondition>
 
@@ -136,6 +137,11 @@ public:
 	 */
 	static PrlHandleServerJobPtr GetJobByUuid( QString job_uuid );
 
+	/**
+	 * Return pointer to the job object by binary uuid identifier.
+	 */
+	static PrlHandleServerJobPtr GetJobByUuid( const PrlUuidKey &job_uuid );
+
 	/** Returns reference on storing job result for internal SDK lib usage */
 	CResult GetResult();
 
@@ -155,6 +161,46 @@ public:
 	 */
 	virtual void SetReturnCode(PRL_RESULT nRetCode);
 
+	/**
+	 * Attaches waiter which should be signalled on job completion
+	 * @param waiter object
+	 * @param job index which waiter should be signalled with
+	 */
+	virtual PRL_RESULT AttachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter, PRL_UINT32 nIndex );
+
+	/**
+	 * Detaches previously attached waiter
+	 * @param waiter object
+	 */
+	virtual void DetachWaiter( const SmartPtr<PrlJobsWaiter> &pWaiter );
+
+	/**
+	 * Returns sign whether job result is processed by event loop of the calling thread
+	 */
+	virtual bool IsResultProcessedByCurrentThread();
+
+	/**
+	 * Returns eventfd descriptor which is signalled on job completion.
+	 * Descriptor is created on the first call and owned by the job.
+	 * @param pointer to buffer for storing result
+	 */
+	virtual PRL_RESULT GetCompletionFd( PRL_INT32_PTR pnFd );
+
+	/**
+	 * Sets callback which is invoked once on job completion. Callback is
+	 * invoked immediately from the calling thread if job is already completed.
+	 * @param callback (NULL resets previously set one)
+	 * @param user data passed to the callback
+	 */
+	virtual PRL_RESULT SetCompletionCallback( PRL_EVENT_HANDLER_PTR handler, PRL_VOID_PTR userData );
+
+	/**
+	 * Invokes and resets completion callback if it was set.
+	 * Should be called without m_JobStatusMutex lock after job was completed.
+	 * @return sign whether callback was invoked
+	 */
+	bool InvokeCompletionCallback();
+
 	/**
 	 * Returns job UUID
 	 */
@@ -166,6 +212,14 @@ private:
 	 */
 	PRL_JOB_STATUS GetInternalJobStatus();
 
+	/**
+	 * Signals all attached waiters, completion descriptor and the server
+	 * about job completion. Takes the state under m_JobStatusMutex lock
+	 * and releases the lock before signalling.
+	 * @param locker holding m_JobStatusMutex
+	 */
+	void SignalCompletion(QMutexLocker &_lock);
+
 private:
 
 	/** Job owner */
@@ -174,6 +228,9 @@ private:
 	/** Job uuid */
 	QString m_Uuid;
 
+	/** Job binary uuid used as a jobs map key */
+	PrlUuidKey m_UuidKey;
+
 	/** Job result object */
 	CResult m_Result;
 
@@ -185,6 +242,19 @@ private:
 
 	/** Waiting job completion condition object */
 	QWaitCondition m_JobStatusCondition;
+
+	/** Waiters of job completion with job indexes */
+	QList<QPair<SmartPtr<PrlJobsWaiter>, PRL_UINT32> > m_Waiters;
+
+	/** Completion descriptor (eventfd) or -1 */
+	int m_nCompletionFd;
+
+	/** Sign whether server was already notified about job completion */
+	bool m_bCompletionSignalled;
+
+	/** Completion callback and its user data */
+	PRL_EVENT_HANDLER_PTR m_pfnCompletionCallback;
+	PRL_VOID_PTR m_pCompletionUserData;
 };
 
 #endif // __VIRTUOZZO_HANDLE_SERVER_JOB_H__
@@ -0,0 +1,198 @@
+/*
+ * PveChannel.cpp: Additional dispatcher connection of the connection pool
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2023 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "PveChannel.h"
+#include "PveControl.h"
+#include "PveCompression.h"
+#include "PrlHandleLoginHelperJob.h"
+#include <prlcommon/Interfaces/VirtuozzoQt.h>
+#include <prlcommon/PrlUuid/Uuid.h>
+#include <prlcommon/ProtoSerializer/CProtoSerializer.h>
+#include <prlcommon/IOService/IOCommunication/IORoutingTableHelper.h>
+#include <prlcommon/Std/PrlAssert.h>
+
+#include <QBuffer>
+#include <QDataStream>
+
+// By adding this interface we enable allocations tracing in the module
+#include "Interfaces/Debug.h"
+
+using namespace Virtuozzo;
+
+CPveChannel::CPveChannel(CPveControl *pControl, quint32 nId, const PveChannelLogin &login)
+: m_pControl(pControl),
+  m_nId(nId),
+  m_Login(login),
+  m_pClient(0),
+  m_nReady(0)
+{
+	IOCredentials credentials = IOCredentials::fromPrivateKeyAndCertificatesChain(
+		m_Login.baPrivateKey.isNull() ? NULL : m_Login.baPrivateKey.constData(),
+		m_Login.baCertificate.isNull() ? NULL : m_Login.baCertificate.constData());
+
+	m_pClient = new IOClient(
+						IORoutingTableHelper::GetClientRoutingTable(m_Login.connSec),
+						IOSender::Client, m_Login.sHost, m_Login.nPort, false, credentials);
+	if (!m_pClient)
+		return;
+
+	// Events are received by the primary connection only
+	bool res;
+	res = QObject::connect( m_pClient,
+					  SIGNAL(onResponsePackageReceived(IOSendJob::Handle, const SmartPtr<IOPackage>)),
+					  SLOT(handleResponsePackage(IOSendJob::Handle, const SmartPtr<IOPackage>)),
+					  Qt::DirectConnection );
+	PRL_ASSERT(res);
+	res = QObject::connect( m_pClient,
+					  SIGNAL(onStateChanged(IOSender::State)),
+					  SLOT(connectionStateChanged(IOSender::State)),
+					  Qt::DirectConnection );
+	PRL_ASSERT(res);
+	(void)res;
+
+	m_pClient->connectClient( m_Login.nTimeout );
+}
+
+CPveChannel::~CPveChannel()
+{
+	if (!m_pClient)
+		return;
+	// In-flight requests are failed by the owner, so nothing is passed to it anymore
+	QObject::disconnect(m_pClient, 0, this, 0);
+	delete m_pClient;
+	m_pClient = 0;
+}
+
+bool CPveChannel::IsReady() const
+{
+	return (m_nReady.loadAcquire() != 0);
+}
+
+IOSendJob::Handle CPveChannel::SendPackage(const SmartPtr<IOPackage> &pPackage)
+{
+	if (!IsReady())
+		return (IOSendJob::InvalidHandle);
+
+	IOSendJob::Handle hJob = m_pClient->sendPackage(pPackage);
+	if (hJob == IOSendJob::InvalidHandle
+		|| IOSendJob::SendQueueIsFull == m_pClient->getSendResult(hJob))
+		return (IOSendJob::InvalidHandle);
+	return (hJob);
+}
+
+void CPveChannel::SendLoginRequest()
+{
+	CProtoCommandPtr pRequest = CProtoSerializer::CreateDspCmdUserLoginCommand(
+		m_Login.sUser,
+		PrlHandleLoginHelperJob::EncodePassword(m_Login.sPassword, m_pClient),
+		QString(),
+		m_Login.nFlags);
+	SmartPtr<IOPackage> pPackage = DispatcherPackage::createInstance(pRequest->GetCommandId(),
+																		pRequest->GetCommand()->toString());
+	m_sLoginUuid = Uuid::toString(pPackage->header.uuid);
+	if (m_pClient->sendPackage(pPackage) == IOSendJob::InvalidHandle)
+	{
+		WRITE_TRACE(DBG_FATAL, "Pool connection %u: failed to send login request", m_nId);
+		m_pClient->disconnectClient();
+	}
+}
+
+PRL_RESULT CPveChannel::GetLoginResult(const SmartPtr<IOPackage> &p)
+{
+	bool bOk;
+	const QByteArray body = CPveCompression::GetBody(p,
+		(m_Login.nFlags & PLLF_ALLOW_COMPRESSION) != 0, bOk);
+	if (!bOk)
+		return (PRL_ERR_UNEXPECTED);
+
+	if (p->header.type == PVE::DspWsResponse)
+	{
+		CProtoCommandPtr pCmd = CProtoSerializer::ParseCommand(PVE::DspWsResponse,
+									UTF8_2QSTR(body.constData()));
+		CProtoCommandDspWsResponse *pResponseCmd
+			= CProtoSerializer::CastToProtoCommand<CProtoCommandDspWsResponse>(pCmd);
+		if (!pResponseCmd || !pResponseCmd->IsValid())
+			return (PRL_ERR_UNEXPECTED);
+		return (pResponseCmd->GetRetCode());
+	}
+
+	if (p->header.type == PVE::DspWsBinaryResponse && p->header.buffersNumber == 1)
+	{
+		QBuffer _buffer;
+		_buffer.setData(body);
+		if (!_buffer.open(QIODevice::ReadOnly))
+			return (PRL_ERR_UNEXPECTED);
+		QDataStream _data_stream(&_buffer);
+		_data_stream.setVersion(QDataStream::Qt_4_0);
+		CProtoCommandDspWsResponse _response_cmd;
+		_response_cmd.GetCommand()->Deserialize(_data_stream);
+		return (_response_cmd.GetRetCode());
+	}
+
+	return (PRL_ERR_UNEXPECTED);
+}
+
+void CPveChannel::handleResponsePackage(IOSendJob::Handle hJob, const SmartPtr<IOPackage> p)
+{
+	QString sJobUuid = m_pClient->getJobUuid(hJob);
+	if (m_nReady.loadAcquire() || sJobUuid != m_sLoginUuid)
+	{
+		m_pControl->HandleResponse(m_pClient, hJob, p);
+		return;
+	}
+
+	m_pClient->takeResponse(hJob);
+	PRL_RESULT nRetCode = GetLoginResult(p);
+	if (PRL_FAILED(nRetCode))
+	{
+		WRITE_TRACE(DBG_FATAL, "Pool connection %u: login failed with error %.8X '%s'",
+					m_nId, nRetCode, PRL_RESULT_TO_STRING(nRetCode));
+		m_pClient->disconnectClient();
+		return;
+	}
+
+	WRITE_TRACE(DBG_INFO, "Pool connection %u is ready", m_nId);
+	m_nReady.storeRelease(1);
+}
+
+void CPveChannel::connectionStateChanged(IOSender::State _state)
+{
+	WRITE_TRACE(DBG_DEBUG, "Pool connection %u: state=[%d]", m_nId, _state);
+
+	if (IOSender::Connected == _state)
+	{
+		SendLoginRequest();
+		return;
+	}
+
+	if (IOSender::Disconnected == _state)
+	{
+		m_nReady.storeRelease(0);
+		// Requests sent with this connection will never be responded
+		m_pControl->PostChannelLost(m_nId);
+	}
+}
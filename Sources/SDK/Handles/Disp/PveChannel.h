@@ -0,0 +1,153 @@
+/*
+ * PveChannel.h: Additional dispatcher connection of the connection pool
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2023 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef PVECHANNEL_H
+#define PVECHANNEL_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <prlcommon/Std/SmartPtr.h>
+#include <prlcommon/IOService/IOCommunication/IOClient.h>
+#include "SDK/Include/PrlTypes.h"
+#include "SDK/Include/PrlEnums.h"
+
+using namespace IOService;
+
+class CPveControl;
+
+/**
+ * Parameters of remote login which are repeated by each pool connection
+ */
+struct PveChannelLogin
+{
+	PveChannelLogin()
+	: nPort(0), connSec(PSL_HIGH_SECURITY), nTimeout(0), nFlags(0)
+	{}
+
+	/** Dispatcher host name */
+	QString sHost;
+	/** Dispatcher port number */
+	quint32 nPort;
+	/** Connection security level */
+	PRL_SECURITY_LEVEL connSec;
+	/** Client certificate and private key (null if not used) */
+	QByteArray baCertificate;
+	QByteArray baPrivateKey;
+	/** Connection establishment timeout */
+	quint32 nTimeout;
+	/** User credentials */
+	QString sUser;
+	QString sPassword;
+	/** Login flags */
+	quint32 nFlags;
+};
+
+/**
+ * Additional authenticated connection to the dispatcher. Pool connections
+ * carry requests only: events are received by the primary connection of
+ * CPveControl, responses are passed to it to be processed in the common way.
+ */
+class CPveChannel : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Class constructor. Starts connection establishment and login.
+	 * @param pointer to owning control object
+	 * @param connection identifier unique within control object
+	 * @param login parameters
+	 */
+	CPveChannel(CPveControl *pControl, quint32 nId, const PveChannelLogin &login);
+
+	/**
+	 * Class destructor. Closes connection.
+	 */
+	~CPveChannel();
+
+	/** Returns connection identifier */
+	quint32 GetId() const { return m_nId; }
+
+	/** Returns connection object */
+	IOClient *GetIoClient() const { return m_pClient; }
+
+	/**
+	 * Returns sign whether connection is established and logged in
+	 */
+	bool IsReady() const;
+
+	/**
+	 * Sends request package
+	 * @param pointer to sending package
+	 * @return handle of sent job or invalid handle if connection is not
+	 * ready or its send queue is full
+	 */
+	IOSendJob::Handle SendPackage(const SmartPtr<IOPackage> &pPackage);
+
+private slots:
+	/**
+	 * Slot that processing received response package
+	 * @param handle to request job
+	 * @param pointer to received package object
+	 */
+	void handleResponsePackage(IOSendJob::Handle hJob, const SmartPtr<IOPackage> _pkg);
+	/**
+	 * Slot that processing state changing events
+	 * @param chaged state value
+	 */
+	void connectionStateChanged(IOSender::State _state);
+
+private:
+	/**
+	 * Sends login request
+	 */
+	void SendLoginRequest();
+
+	/**
+	 * Extracts return code from login response package
+	 * @param pointer to response package
+	 */
+	PRL_RESULT GetLoginResult(const SmartPtr<IOPackage> &p);
+
+private:
+	/** Owning control object */
+	CPveControl *m_pControl;
+	/** Connection identifier */
+	quint32 m_nId;
+	/** Login parameters */
+	PveChannelLogin m_Login;
+	/** Pointer to client connection object */
+	IOClient *m_pClient;
+	/** UUID of login request */
+	QString m_sLoginUuid;
+	/** Sign whether connection is logged in */
+	QAtomicInt m_nReady;
+};
+
+#endif // PVECHANNEL_H
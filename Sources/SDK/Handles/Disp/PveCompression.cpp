@@ -0,0 +1,133 @@
+/*
+ * PveCompression.cpp: Compression of dispatcher packages bodies
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2023 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+
+#include "PveCompression.h"
+#include <prlcommon/Logging/Logging.h>
+#include <zlib.h>
+#include <string.h>
+
+// By adding this interface we enable allocations tracing in the module
+#include "Interfaces/Debug.h"
+
+namespace {
+
+/** Compressed body signature */
+const char s_Signature[8] = { '\0', 'P', 'R', 'L', 'Z', 'I', 'P', '1' };
+
+/** Compressed body header: signature and size of original body */
+enum { HEADER_SIZE = sizeof(s_Signature) + sizeof(quint32) };
+
+} // anonymous namespace
+
+bool CPveCompression::IsCompressed(const SmartPtr<IOPackage> &p)
+{
+	return (p->header.buffersNumber == 1
+			&& p->data[0].bufferSize > quint32(HEADER_SIZE)
+			&& 0 == ::memcmp(p->buffers[0].getImpl(), s_Signature, sizeof(s_Signature)));
+}
+
+QByteArray CPveCompression::GetBody(const SmartPtr<IOPackage> &p, bool bCompressionAllowed, bool &bOk)
+{
+	bOk = true;
+	if (!p->header.buffersNumber)
+		return QByteArray();
+
+	const char *pData = p->buffers[0].getImpl();
+	quint32 nSize = p->data[0].bufferSize;
+	if (!bCompressionAllowed || !IsCompressed(p))
+		return QByteArray::fromRawData(pData, nSize);
+
+	const uchar *pHeader = reinterpret_cast<const uchar *>(pData) + sizeof(s_Signature);
+	quint32 nBodySize = (quint32(pHeader[0]) << 24) | (quint32(pHeader[1]) << 16)
+						| (quint32(pHeader[2]) << 8) | quint32(pHeader[3]);
+	bOk = false;
+	if (nBodySize > PVE_COMPRESSION_MAX_BODY_SIZE)
+	{
+		WRITE_TRACE(DBG_FATAL, "Compressed package body is too large: %u", nBodySize);
+		return QByteArray();
+	}
+
+	QByteArray body(int(nBodySize), Qt::Uninitialized);
+	z_stream stream;
+	::memset(&stream, 0, sizeof(stream));
+	if (inflateInit(&stream) != Z_OK)
+	{
+		WRITE_TRACE(DBG_FATAL, "Failed to initialize inflate stream");
+		return QByteArray();
+	}
+
+	// Body size is known, so stream is inflated by the single call
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(pData)) + HEADER_SIZE;
+	stream.avail_in = nSize - HEADER_SIZE;
+	stream.next_out = reinterpret_cast<Bytef *>(body.data());
+	stream.avail_out = nBodySize;
+	int nRes = inflate(&stream, Z_FINISH);
+	inflateEnd(&stream);
+
+	if (nRes != Z_STREAM_END || stream.total_out != nBodySize)
+	{
+		WRITE_TRACE(DBG_FATAL, "Failed to inflate package body: %d", nRes);
+		return QByteArray();
+	}
+
+	bOk = true;
+	return body;
+}
+
+SmartPtr<IOPackage> CPveCompression::Deflate(const SmartPtr<IOPackage> &p)
+{
+	if (p->header.buffersNumber != 1 || p->data[0].bufferSize < PVE_COMPRESSION_THRESHOLD)
+		return p;
+
+	quint32 nSize = p->data[0].bufferSize;
+	uLongf nCompressedSize = compressBound(nSize);
+	QByteArray compressed(int(HEADER_SIZE + nCompressedSize), Qt::Uninitialized);
+	Bytef *pOut = reinterpret_cast<Bytef *>(compressed.data());
+
+	if (compress2(pOut + HEADER_SIZE, &nCompressedSize,
+				  reinterpret_cast<const Bytef *>(p->buffers[0].getImpl()), nSize,
+				  Z_BEST_SPEED) != Z_OK
+		|| nCompressedSize + HEADER_SIZE >= nSize)
+		return p;
+
+	::memcpy(pOut, s_Signature, sizeof(s_Signature));
+	pOut[sizeof(s_Signature)] = uchar(nSize >> 24);
+	pOut[sizeof(s_Signature) + 1] = uchar(nSize >> 16);
+	pOut[sizeof(s_Signature) + 2] = uchar(nSize >> 8);
+	pOut[sizeof(s_Signature) + 3] = uchar(nSize);
+
+	SmartPtr<IOPackage> pPackage = IOPackage::createInstance(p->header.type, 1);
+	if (!pPackage.isValid())
+		return p;
+	// Response is routed by the original package UUID
+	::memcpy(pPackage->header.uuid, p->header.uuid, sizeof(pPackage->header.uuid));
+	::memcpy(pPackage->header.parentUuid, p->header.parentUuid, sizeof(pPackage->header.parentUuid));
+	pPackage->fillBuffer(0, IOPackage::RawEncoding, compressed.constData(),
+						 quint32(HEADER_SIZE + nCompressedSize));
+	return pPackage;
+}
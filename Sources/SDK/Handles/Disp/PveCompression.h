@@ -0,0 +1,88 @@
+/*
+ * PveCompression.h: Compression of dispatcher packages bodies
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2023 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+
+#ifndef PVECOMPRESSION_H
+#define PVECOMPRESSION_H
+
+#include <QByteArray>
+#include <prlcommon/Std/SmartPtr.h>
+#include <prlcommon/IOService/IOCommunication/IOProtocol.h>
+
+using namespace IOService;
+
+/**
+ * Minimal size of package body which is worth compressing
+ */
+#define PVE_COMPRESSION_THRESHOLD (64 * 1024)
+
+/**
+ * Maximal size of inflated package body (protects from malformed packages)
+ */
+#define PVE_COMPRESSION_MAX_BODY_SIZE (512 * 1024 * 1024)
+
+/**
+ * Login response parameter by which dispatcher confirms that it accepts
+ * compressed requests bodies. Client offers compression with
+ * PLLF_ALLOW_COMPRESSION login flag.
+ */
+#define EVT_PARAM_PRL_SERVER_INFO_COMPRESSION "server_info_compression"
+
+/**
+ * Compression of dispatcher packages bodies. Compressed body is the
+ * signature, big-endian size of original body and zlib stream of it.
+ * Signature starts with zero byte, so text body is never taken for
+ * compressed one.
+ */
+class CPveCompression
+{
+public:
+	/**
+	 * Returns sign whether body of specified package is compressed
+	 * @param pointer to package
+	 */
+	static bool IsCompressed(const SmartPtr<IOPackage> &p);
+
+	/**
+	 * Returns body of package. Compressed body is inflated right into the
+	 * returned buffer, uncompressed one is returned without copying (so
+	 * package must outlive returned buffer).
+	 * @param pointer to package
+	 * @param sign whether compressed body is expected
+	 * @param [out] sign whether body was read successfully
+	 */
+	static QByteArray GetBody(const SmartPtr<IOPackage> &p, bool bCompressionAllowed, bool &bOk);
+
+	/**
+	 * Returns package with compressed body or specified package itself if
+	 * its body is small or can't be compressed
+	 * @param pointer to package
+	 */
+	static SmartPtr<IOPackage> Deflate(const SmartPtr<IOPackage> &p);
+};
+
+#endif // PVECOMPRESSION_H
@@ -43,12 +43,21 @@
 #include "PrlHandleLoginHelperJob.h"
 #include "PrlHandleLoginLocalHelperJob.h"
 #include <prlcommon/Std/PrlAssert.h>
+#include <prlcommon/HostUtils/HostUtils.h>
 #include "PrlCommon.h"
+#include "PrlContextSwitcher.h"
+#include "PrlLazyVmEvent.h"
+#include "PveCompression.h"
+#include "PrlRequestsPerf.h"
 
 #include <QFile>
 #include <QTextStream>
 #include <QCoreApplication>
 #include <QThread>
+#include <QRunnable>
+#include <QBuffer>
+#include <QDeadlineTimer>
+#include <climits>
 
 #ifdef _WIN_
 #include <windows.h>
@@ -61,13 +70,50 @@
 
 using namespace Virtuozzo;
 
+/** Maximum number of threads parsing received packages of a connection */
+#define PRL_MAX_PARSER_THREADS 4
+
+/** Maximum number of received packages of a connection queued for parsing or completion */
+#define PRL_MAX_RECEIVED_PACKAGES_IN_FLIGHT 256
+
+/** Time in msecs to wait for received package slot before checking for client destruction */
+#define PRL_RECEIVED_PACKAGE_SLOT_TIMEOUT 100
+
+/** Time in msecs to wait for transport send queue space before resending */
+#define PRL_SEND_QUEUE_RETRY_TIMEOUT 100
+
 CPveControl::CPveControl(QObject *pEventReceiverObj)
 : m_bUseSSL(IOService::initSSLLibrary()),
   m_pEventReceiverObj(pEventReceiverObj),
-  m_ioClient(0)
+  m_ioClient(0),
+  m_ReceivedPackagesSlots(PRL_MAX_RECEIVED_PACKAGES_IN_FLIGHT),
+  m_nReceivedPackagesCount(0),
+  m_nCompletedPackagesCount(0),
+  m_bCompletingPackages(false),
+  m_nReleasingClients(0),
+  m_nSendQueueCapacity(0),
+  m_nSendQueueTimeout(0),
+  m_bSendQueueDraining(false),
+  m_bSendQueueStopped(false),
+  m_hLastSentJob(IOSendJob::InvalidHandle),
+  m_nSendQueueMaxDepth(0),
+  m_nSendQueueQueued(0),
+  m_nSendQueueRejected(0),
+  m_nConnectionPoolSize(0),
+  m_bConnectionPoolLoginValid(false),
+  m_bConnectionPoolStarted(false),
+  m_nLastChannelId(0),
+  m_nNextPoolConnection(0),
+  m_nBatchOpened(0),
+  m_nCompressionOffered(0),
+  m_nCompressionAccepted(0)
 {
 	m_rl.rate = 1;
 	m_rl.last = -1;
+	m_ParserPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), int(PRL_MAX_PARSER_THREADS)));
+	m_ParserPool.setStackSize(PRL_STACK_SIZE);
+	m_SenderPool.setMaxThreadCount(1);
+	m_SenderPool.setStackSize(PRL_STACK_SIZE);
 
 	LOG_MESSAGE(DBG_DEBUG, "CPveControl::CPveControl() this=%p", this);
 	bool bRes = connect(this, SIGNAL(finalizeTransportWork()), SLOT(onFinalizeTransportWork()),
@@ -81,13 +127,21 @@ CPveControl::CPveControl(QObject *pEventReceiverObj)
 
 CPveControl::~CPveControl ()
 {
-	delete m_ioClient;
+	DiscardBatch();
+	StopSendQueue();
+	StopConnectionPool();
+	SetIoClient(NULL);
+	// Complete all received packages while object is still alive
+	m_ParserPool.waitForDone();
 	if (m_bUseSSL)
 		IOService::deinitSSLLibrary();
 }
 
 void CPveControl::stopTransport()
 {
+	DiscardBatch();
+	StopSendQueue();
+	StopConnectionPool();
 	WRITE_TRACE(DBG_DEBUG, "QThread::currentThread()=%p thread()=%p QCoreApplication::instance()->thread()=%p m_ioClient->thread()=%p",
 		QThread::currentThread(),
 		thread(),
@@ -106,10 +160,26 @@ void CPveControl::onFinalizeTransportWork()
 {
     Q_ASSERT(QThread::currentThread() == thread());
     // Destroy transport
-    if ( m_ioClient ) {
-        delete m_ioClient;
-        m_ioClient = 0;
-    }
+    if ( m_ioClient )
+        SetIoClient(NULL);
+}
+
+void CPveControl::SetIoClient(IOClient *pIoClient)
+{
+	// Client destruction waits for its transport thread (see AcquireReceivedPackageSlot())
+	m_nReleasingClients.ref();
+	{
+		QWriteLocker _lock(&m_ioClientLock);
+		delete m_ioClient;
+		m_ioClient = pIoClient;
+
+		// Requests are queued again to the new connection
+		QMutexLocker _queue_lock(&m_SendQueueMutex);
+		m_hLastSentJob = IOSendJob::InvalidHandle;
+		if (pIoClient)
+			m_bSendQueueStopped = false;
+	}
+	m_nReleasingClients.deref();
 }
 
 void CPveControl::onCleanupLoginHelperJob()
@@ -124,14 +194,33 @@ bool CPveControl::WaitForRequestComplete(const QString &sReqId, quint32 nWaitTim
 {
 	if (!m_ioClient)
 		return (false);
-	IOSendJob::Handle hJob;
-	{
-		QMutexLocker _lock(&m_JobsHandlesHashMutex);
-		hJob = m_JobsHandlesHash.value(sReqId);
-	}
+	IOSendJob::Handle hJob = GetJobHandleByUuid(PrlUuidKey::FromString(sReqId));
 	return (m_ioClient->waitForResponse(hJob, nWaitTimeout) == IOSendJob::Success);
 }
 
+/**
+ * Pool task which parses received package and passes it to ordered completion
+ */
+class CReceivedPackageTask : public QRunnable
+{
+public:
+	CReceivedPackageTask(CPveControl *pControl, quint64 nSequence,
+						 const CPveControl::ReceivedPackage &_pkg)
+	: m_pControl(pControl), m_nSequence(nSequence), m_Package(_pkg)
+	{}
+
+	void run()
+	{
+		m_pControl->ParseReceivedPackage(m_Package);
+		m_pControl->CompleteReceivedPackage(m_nSequence, m_Package);
+	}
+
+private:
+	CPveControl *m_pControl;
+	quint64 m_nSequence;
+	CPveControl::ReceivedPackage m_Package;
+};
+
 void CPveControl::handleEventPackage ( const SmartPtr<IOPackage> p )
 {
 	WRITE_TRACE(DBG_DEBUG, "event package=[Type=(%#x)%s, Sender=%s Parent=%s Reciever=%s]",
@@ -142,9 +231,127 @@ void CPveControl::handleEventPackage ( const SmartPtr<IOPackage> p )
 		);
 	LOG_MESSAGE(DBG_DEBUG, "PveControl::handleEventPackage() package=[%s]", p->buffers[0].getImpl());
 
+	ReceivedPackage _pkg(ReceivedPackage::Event);
+	_pkg.pPackage = p;
+	PostReceivedPackage(_pkg);
+}
+
+void CPveControl::handleResponsePackage ( IOSendJob::Handle hJob, const SmartPtr<IOPackage> p )
+{
+	LOG_MESSAGE(DBG_INFO, "response package=[Type=(%#x)%s, Sender=%s Parent=%s Reciever=%s]",
+		p->header.type, PVE::DispatcherCommandToString( p->header.type ),
+		QSTR2UTF8( Uuid::toString( p->header.senderUuid ) ),
+		QSTR2UTF8( Uuid::toString( p->header.parentUuid ) ),
+		QSTR2UTF8( Uuid::toString( p->header.receiverUuid ) )
+		);
+
+	HandleResponse(m_ioClient, hJob, p);
+}
+
+void CPveControl::HandleResponse(IOClient *pClient, IOSendJob::Handle hJob, const SmartPtr<IOPackage> &p)
+{
+	ReceivedPackage _pkg(ReceivedPackage::Response);
+	_pkg.pPackage = p;
+	_pkg.sJobUuid = pClient->getJobUuid(hJob);
+	_pkg.jobUuidKey = PrlUuidKey::FromString(_pkg.sJobUuid);
+	_pkg.nReceivedTime = PrlRequestsPerf::Now();
+	LOG_MESSAGE(DBG_DEBUG, "PveControl::handleResponsePackage() received response=[%s]",
+					QSTR2UTF8(_pkg.sJobUuid));
+
+	// NB. take one package from the io job to free space for another one. the socket
+	// client is eager to put it there.
+	pClient->takeResponse(hJob);
+	PostReceivedPackage(_pkg);
+}
+
+void CPveControl::PostChannelLost(quint32 nChannel)
+{
+	ReceivedPackage _pkg(ReceivedPackage::ChannelDisconnected);
+	_pkg.nChannel = nChannel;
+	PostReceivedPackage(_pkg);
+}
+
+void CPveControl::PostReceivedPackage(const ReceivedPackage &_pkg)
+{
+	// Connection state packages are posted by the completing threads too,
+	// so only packages coming from the transport wait for a slot
+	ReceivedPackage _queued(_pkg);
+	_queued.bHoldsSlot = (IsThrottledPackage(_pkg) && AcquireReceivedPackageSlot());
+
+	quint64 nSequence;
+	{
+		QMutexLocker _lock(&m_ReceivedPackagesMutex);
+		nSequence = m_nReceivedPackagesCount++;
+	}
+	m_ParserPool.start(new CReceivedPackageTask(this, nSequence, _queued));
+}
+
+bool CPveControl::AcquireReceivedPackageSlot()
+{
+	// Completion of the queued packages may wait for the client lock held by
+	// a thread destroying client, which waits for this transport thread in turn
+	while (!m_ReceivedPackagesSlots.tryAcquire(1, PRL_RECEIVED_PACKAGE_SLOT_TIMEOUT))
+	{
+		if (m_nReleasingClients.loadAcquire())
+			return (false);
+	}
+	return (true);
+}
+
+void CPveControl::CompleteReceivedPackage(quint64 nSequence, const ReceivedPackage &_pkg)
+{
+	QMutexLocker _lock(&m_ReceivedPackagesMutex);
+	m_ParsedPackages.insert(nSequence, _pkg);
+	// Packages are completed by the single thread at a time: whoever parsed
+	// the next awaited package completes it and all parsed packages after it
+	if (m_bCompletingPackages)
+		return;
+
+	m_bCompletingPackages = true;
+	while (m_ParsedPackages.contains(m_nCompletedPackagesCount))
+	{
+		ReceivedPackage _next = m_ParsedPackages.take(m_nCompletedPackagesCount++);
+		_lock.unlock();
+		// Slot is freed first: login and logoff completion takes the client lock
+		if (_next.bHoldsSlot)
+			m_ReceivedPackagesSlots.release();
+		CompleteParsedPackage(_next);
+		_lock.relock();
+	}
+	m_bCompletingPackages = false;
+}
+
+bool CPveControl::IsThrottledPackage(const ReceivedPackage &_pkg)
+{
+	return (ReceivedPackage::Event == _pkg.nKind || ReceivedPackage::Response == _pkg.nKind);
+}
+
+void CPveControl::ParseReceivedPackage(ReceivedPackage &_pkg)
+{
+	if (ReceivedPackage::Event == _pkg.nKind)
+		ParseEventPackage(_pkg);
+	else if (ReceivedPackage::Response == _pkg.nKind)
+		ParseResponsePackage(_pkg);
+}
+
+QByteArray CPveControl::GetPackageBody(const SmartPtr<IOPackage> &p)
+{
+	bool bOk;
+	QByteArray body = CPveCompression::GetBody(p, m_nCompressionOffered.loadAcquire(), bOk);
+	if (!bOk)
+		WRITE_TRACE(DBG_FATAL, "Failed to read body of package with type %d '%s'", p->header.type,
+					PVE::DispatcherCommandToString(p->header.type));
+	return body;
+}
+
+void CPveControl::ParseEventPackage(ReceivedPackage &_pkg)
+{
+	const SmartPtr<IOPackage> &p = _pkg.pPackage;
+	const QByteArray body = GetPackageBody(p);
     if ( p->header.type == PVE::DspVmEvent )
 	{
-		CVmEvent *pEvent = new CVmEvent(UTF8_2QSTR(p->buffers[0].getImpl()));
+		// Parameters are parsed on demand, header is enough for routing
+		CVmEvent *pEvent = new CLazyVmEvent(body);
 		if (p->isResponsePackage())//Event was inited on some request let add info about request into event
 			pEvent->setInitRequestId(Uuid::toString(p->header.parentUuid));
 		pEvent->setEventId(p->header.numericId);
@@ -155,20 +362,16 @@ void CPveControl::handleEventPackage ( const SmartPtr<IOPackage> p )
 				pEvent->setInitRequestId(Uuid::toString(p->header.uuid));
 			else
 				pEvent->setInitRequestId(Uuid::toString(p->header.parentUuid));
-			QMutexLocker _lock(&m_JobsHandlesHashMutex);
+			QMutexLocker _lock(&m_QuestionsRequestPkgsHashMutex);
 			m_QuestionsRequestPkgsHash[pEvent->getInitRequestId()] = p;
 		}
-		// Pass event to client
-		if (m_pEventReceiverObj)
-			QCoreApplication::postEvent(m_pEventReceiverObj, pEvent);
-		else
-			QCoreApplication::postEvent(QCoreApplication::instance(), pEvent);
+		_pkg.pEvent = pEvent;
     }
 	else if ( p->header.type == PVE::DspVmBinaryEvent )
 	{
 		Q_ASSERT(p->header.buffersNumber == 1);
 		QBuffer _buffer;
-		_buffer.setData(p->buffers[0].getImpl(), p->data[0].bufferSize);
+		_buffer.setData(body);
 		bool bRes = _buffer.open(QIODevice::ReadOnly);
 		Q_ASSERT(bRes);
 		if (!bRes)
@@ -185,117 +388,39 @@ void CPveControl::handleEventPackage ( const SmartPtr<IOPackage> p )
 		else if (pEvent->getEventType() == PET_DSP_EVT_VM_QUESTION)//Storing request question info now
 		{
 			pEvent->setInitRequestId(Uuid::toString(p->header.uuid));
-			QMutexLocker _lock(&m_JobsHandlesHashMutex);
+			QMutexLocker _lock(&m_QuestionsRequestPkgsHashMutex);
 			m_QuestionsRequestPkgsHash[Uuid::toString(p->header.uuid)] = p;
 		}
 
 		pEvent->setEventId(p->header.numericId);
-
-		// Pass event to client
-		if (m_pEventReceiverObj)
-			QCoreApplication::postEvent(m_pEventReceiverObj, pEvent);
-		else
-			QCoreApplication::postEvent(QCoreApplication::instance(), pEvent);
+		_pkg.pEvent = pEvent;
     }
 }
 
-void CPveControl::handleResponsePackage ( IOSendJob::Handle hJob, const SmartPtr<IOPackage> p )
+void CPveControl::ParseResponsePackage(ReceivedPackage &_pkg)
 {
-	LOG_MESSAGE(DBG_INFO, "response package=[Type=(%#x)%s, Sender=%s Parent=%s Reciever=%s]",
-		p->header.type, PVE::DispatcherCommandToString( p->header.type ),
-		QSTR2UTF8( Uuid::toString( p->header.senderUuid ) ),
-		QSTR2UTF8( Uuid::toString( p->header.parentUuid ) ),
-		QSTR2UTF8( Uuid::toString( p->header.receiverUuid ) )
-		);
-	LOG_MESSAGE(DBG_DEBUG, "PveControl::handleResponsePackage() received response=[%s]",
-					m_ioClient->getJobUuid(hJob).toString().toUtf8().data());
-
-	// NB. take one package from the io job to free space for another one. the socket
-	// client is eager to put it there.
-	m_ioClient->takeResponse(hJob);
+	const SmartPtr<IOPackage> &p = _pkg.pPackage;
+	const QByteArray body = GetPackageBody(p);
     if ( p->header.type == PVE::DspWsResponse )
 	{
 		if (!p->isResponsePackage())
 			LOG_MESSAGE(DBG_FATAL, "Response package received that not response with type %d '%s'", p->header.type,
 						PVE::DispatcherCommandToString(p->header.type));
-		CProtoCommandPtr pCmd = CProtoSerializer::ParseCommand(PVE::DspWsResponse,
-									UTF8_2QSTR(p->buffers[0].getImpl()));
+		_pkg.pResponseCmd = CProtoSerializer::ParseCommand(PVE::DspWsResponse,
+									UTF8_2QSTR(body.constData()));
 		CResult *pResult = new CResult;
 		CProtoCommandDspWsResponse *pResponseCmd
-			= CProtoSerializer::CastToProtoCommand<CProtoCommandDspWsResponse>(pCmd);
+			= CProtoSerializer::CastToProtoCommand<CProtoCommandDspWsResponse>(_pkg.pResponseCmd);
 		pResponseCmd->FillResult(pResult);
-		pResult->setRequestId(m_ioClient->getJobUuid(hJob));
-		PVE::IDispatcherCommands nOpCode = pResult->getOpCode();
+		pResult->setRequestId(_pkg.sJobUuid);
 		pResult->setPackageId(p->header.numericId);
-
-		if (m_pLoginLocalHelperJob)
-		{
-			bool bDoLoginLocalStage2 = (nOpCode == PVE::DspCmdUserLoginLocal
-				&& PRL_SUCCEEDED(pResult->getReturnCode()));
-			switch(nOpCode)
-			{
-			case PVE::DspCmdUserEasyLoginLocal:
-				if (!PRL_SUCCEEDED(pResult->getReturnCode()))
-				{
-					m_pLoginLocalHelperJob->switchToCompatibilityMode();
-					return;
-				}
-				break;
-			case PVE::DspCmdUserLoginLocal:
-				if (bDoLoginLocalStage2)
-				{
-					QString sFilePath = pResponseCmd->GetStandardParam(0);
-					QString sCheckData = pResponseCmd->GetStandardParam(1);
-
-					bDoLoginLocalStage2
-						= m_pLoginLocalHelperJob->prepareDataForValidation(sFilePath, sCheckData, pResult);
-				}
-				break;
-			default:
-				break;
-			}
-
-			if (m_pLoginLocalHelperJob->isCompatibilityMode())
-				emit cleanupLoginHelperJob();
-
-			if (bDoLoginLocalStage2)
-				return;
-		}
-
-		if (m_pLoginHelperJob && nOpCode == PVE::DspCmdUserLogin)
-		{
-			if (!m_pLoginHelperJob->wasCanceled() &&
-				PRL_SUCCEEDED(pResponseCmd->GetRetCode())
-				)
-			{
-				PRL_RESULT helper_res = m_pLoginHelperJob->processPublicKeyAuth(pResponseCmd);
-				// if second stage request is send successfully, wait for reply
-				if (PRL_SUCCEEDED(helper_res))
-					return;
-				else
-					pResult->setReturnCode(helper_res);
-			}
-			emit cleanupLoginHelperJob();
-		}
-
-		// Pass event to client
-		if (m_pEventReceiverObj)
-			QCoreApplication::postEvent(m_pEventReceiverObj, pResult);
-		else
-			QCoreApplication::postEvent(QCoreApplication::instance(), pResult);
-		// it is hack - need to process job after reattach to lost task
-		// job afeter DspCmdAttachToLostTask == job of lost task
-		if(nOpCode != PVE::DspCmdAttachToLostTask)
-			UnregisterJobHandle(hJob);
-		// manually close connection if logoff succeed
-		if(nOpCode == PVE::DspCmdUserLogoff)
-			m_ioClient->disconnectClient();
+		_pkg.pEvent = pResult;
     }
 	else if ( p->header.type == PVE::DspWsBinaryResponse )
 	{
 		Q_ASSERT(p->header.buffersNumber == 1);
 		QBuffer _buffer;
-		_buffer.setData(p->buffers[0].getImpl(), p->data[0].bufferSize);
+		_buffer.setData(body);
 		bool bRes = _buffer.open(QIODevice::ReadOnly);
 		Q_ASSERT(bRes);
 		if (!bRes)
@@ -305,38 +430,32 @@ void CPveControl::handleResponsePackage ( IOSendJob::Handle hJob, const SmartPtr
 		}
 		QDataStream _data_stream(&_buffer);
 		_data_stream.setVersion(QDataStream::Qt_4_0);
-		SmartPtr<CVmEvent> pResponseEvent(new CVmEvent);
-		pResponseEvent->Deserialize(_data_stream);
 
 		if (!p->isResponsePackage())
 			WRITE_TRACE(DBG_FATAL, "Response package received that not response with type %d '%s'", p->header.type,
 						PVE::DispatcherCommandToString(p->header.type));
-		CProtoCommandPtr pCmd = CProtoSerializer::ParseCommand(PVE::DspWsResponse, pResponseEvent->toString());
+		// Response command is deserialized right into the protocol package
+		// without rendering it to XML and parsing it back
+		CProtoCommandDspWsResponse _response_cmd;
+		_response_cmd.GetCommand()->Deserialize(_data_stream);
 		CResult *pResult = new CResult;
-		CProtoCommandDspWsResponse *pResponseCmd
-			= CProtoSerializer::CastToProtoCommand<CProtoCommandDspWsResponse>(pCmd);
-		pResponseCmd->FillResult(pResult);
-		pResult->setRequestId(m_ioClient->getJobUuid(hJob));
+		_response_cmd.FillResult(pResult);
+		pResult->setRequestId(_pkg.sJobUuid);
 		pResult->setPackageId(p->header.numericId);
 
 		//Extract and assign response binary data
 		CVmEvent *pBinaryData = new CVmEvent;
 		pBinaryData->Deserialize(_data_stream);
 		pResult->setBinaryContent( pBinaryData );
-
-		// Pass event to client
-		if (m_pEventReceiverObj)
-			QCoreApplication::postEvent(m_pEventReceiverObj, pResult);
-		else
-			QCoreApplication::postEvent(QCoreApplication::instance(), pResult);
-		UnregisterJobHandle(hJob);
+		_pkg.pEvent = pResult;
+		_pkg.bUnregisterJob = true;
     }
 	//To support old problem reports scheme
 	else if (p->header.type == PVE::DspVmBinaryResponse)
 	{
 		Q_ASSERT(p->header.buffersNumber == 1);
 		QBuffer _buffer;
-		_buffer.setData(p->buffers[0].getImpl(), p->data[0].bufferSize);
+		_buffer.setData(body);
 		bool bRes = _buffer.open(QIODevice::ReadOnly);
 		Q_ASSERT(bRes);
 		if (!bRes)
@@ -363,14 +482,10 @@ void CPveControl::handleResponsePackage ( IOSendJob::Handle hJob, const SmartPtr
 			pResult->setRequestId(pEvent->getInitRequestId());
 			pResult->setOpCode(PVE::DspCmdVmGetProblemReport);
 			pResult->m_hashResultSet[PVE::DspCmdVmGetProblemReport_strReport] = strReport;
-			pResult->setRequestId(m_ioClient->getJobUuid(hJob));
+			pResult->setRequestId(_pkg.sJobUuid);
 			pResult->setPackageId(p->header.numericId);
-			// Pass event to client
-			if (m_pEventReceiverObj)
-				QCoreApplication::postEvent(m_pEventReceiverObj, pResult);
-			else
-				QCoreApplication::postEvent(QCoreApplication::instance(), pResult);
-			UnregisterJobHandle(hJob);
+			_pkg.pEvent = pResult;
+			_pkg.bUnregisterJob = true;
 		}
 		delete pEvent;
 
@@ -380,6 +495,134 @@ void CPveControl::handleResponsePackage ( IOSendJob::Handle hJob, const SmartPtr
 						p->header.type, PVE::DispatcherCommandToString(p->header.type));
 }
 
+void CPveControl::CompleteParsedPackage(ReceivedPackage &_pkg)
+{
+	if (ReceivedPackage::Disconnected == _pkg.nKind)
+	{
+		PostToEventReceiver(new CVmEvent(PET_DSP_EVT_DISP_CONNECTION_CLOSED,
+								Uuid().toString(), PIE_DISPATCHER, PRL_ERR_WS_DISP_CONNECTION_CLOSED));
+		NotifyJobsThatConnectionWasLost();
+		ClearJobHandles();
+		// Session is closed, so are its pool connections
+		{
+			QMutexLocker _lock(&m_ConnectionPoolMutex);
+			m_bConnectionPoolStarted = false;
+		}
+		StopConnectionPool();
+		return;
+	}
+
+	if (ReceivedPackage::ChannelDisconnected == _pkg.nKind)
+	{
+		NotifyChannelJobsThatConnectionWasLost(_pkg.nChannel);
+		return;
+	}
+
+	if (!_pkg.pEvent)
+		return;
+
+	if (_pkg.pResponseCmd)
+	{
+		CompleteWsResponse(_pkg);
+		return;
+	}
+
+	// Pass event to client
+	if (ReceivedPackage::Response == _pkg.nKind)
+		PrlRequestsPerf::ResponsePosted(_pkg.jobUuidKey, _pkg.nReceivedTime);
+	PostToEventReceiver(_pkg.pEvent);
+	if (_pkg.bUnregisterJob)
+		UnregisterJobHandle(_pkg.jobUuidKey);
+}
+
+void CPveControl::CompleteWsResponse(ReceivedPackage &_pkg)
+{
+	CResult *pResult = static_cast<CResult *>(_pkg.pEvent);
+	CProtoCommandDspWsResponse *pResponseCmd
+		= CProtoSerializer::CastToProtoCommand<CProtoCommandDspWsResponse>(_pkg.pResponseCmd);
+	PVE::IDispatcherCommands nOpCode = pResult->getOpCode();
+
+	if (m_pLoginLocalHelperJob)
+	{
+		bool bDoLoginLocalStage2 = (nOpCode == PVE::DspCmdUserLoginLocal
+			&& PRL_SUCCEEDED(pResult->getReturnCode()));
+		switch(nOpCode)
+		{
+		case PVE::DspCmdUserEasyLoginLocal:
+			if (!PRL_SUCCEEDED(pResult->getReturnCode()))
+			{
+				m_pLoginLocalHelperJob->switchToCompatibilityMode();
+				delete pResult;
+				return;
+			}
+			break;
+		case PVE::DspCmdUserLoginLocal:
+			if (bDoLoginLocalStage2)
+			{
+				QString sFilePath = pResponseCmd->GetStandardParam(0);
+				QString sCheckData = pResponseCmd->GetStandardParam(1);
+
+				bDoLoginLocalStage2
+					= m_pLoginLocalHelperJob->prepareDataForValidation(sFilePath, sCheckData, pResult);
+			}
+			break;
+		default:
+			break;
+		}
+
+		if (m_pLoginLocalHelperJob->isCompatibilityMode())
+			emit cleanupLoginHelperJob();
+
+		if (bDoLoginLocalStage2)
+		{
+			delete pResult;
+			return;
+		}
+	}
+
+	if (m_pLoginHelperJob && nOpCode == PVE::DspCmdUserLogin)
+	{
+		if (!m_pLoginHelperJob->wasCanceled() &&
+			PRL_SUCCEEDED(pResponseCmd->GetRetCode())
+			)
+		{
+			PRL_RESULT helper_res = m_pLoginHelperJob->processPublicKeyAuth(pResponseCmd);
+			// if second stage request is send successfully, wait for reply
+			if (PRL_SUCCEEDED(helper_res))
+			{
+				delete pResult;
+				return;
+			}
+			else
+				pResult->setReturnCode(helper_res);
+		}
+		emit cleanupLoginHelperJob();
+	}
+
+	// Pass event to client
+	PrlRequestsPerf::ResponsePosted(_pkg.jobUuidKey, _pkg.nReceivedTime);
+	PostToEventReceiver(pResult);
+	// it is hack - need to process job after reattach to lost task
+	// job afeter DspCmdAttachToLostTask == job of lost task
+	if(nOpCode != PVE::DspCmdAttachToLostTask)
+		UnregisterJobHandle(_pkg.jobUuidKey);
+	// manually close connection if logoff succeed
+	if(nOpCode == PVE::DspCmdUserLogoff)
+	{
+		QReadLocker _lock(&m_ioClientLock);
+		if (m_ioClient)
+			m_ioClient->disconnectClient();
+	}
+}
+
+void CPveControl::PostToEventReceiver(QEvent *pEvent)
+{
+	if (m_pEventReceiverObj)
+		QCoreApplication::postEvent(m_pEventReceiverObj, pEvent);
+	else
+		QCoreApplication::postEvent(QCoreApplication::instance(), pEvent);
+}
+
 void CPveControl::connectionStateChanged (IOSender::State _state)
 {
 	WRITE_TRACE( DBG_DEBUG, "PveControl::connectionStateChanged() _state=[%d]", _state);
@@ -422,17 +665,8 @@ void CPveControl::connectionStateChanged (IOSender::State _state)
 		switch (_state)
 		{
 			case IOSender::Disconnected:
-			{
-				CVmEvent *pEvent = new CVmEvent(PET_DSP_EVT_DISP_CONNECTION_CLOSED,
-										Uuid().toString(), PIE_DISPATCHER, PRL_ERR_WS_DISP_CONNECTION_CLOSED);
-				// Pass event to client
-				if (m_pEventReceiverObj)
-					QCoreApplication::postEvent(m_pEventReceiverObj, pEvent);
-				else
-					QCoreApplication::postEvent(QCoreApplication::instance(), pEvent);
-				NotifyJobsThatConnectionWasLost();
-				ClearJobHandles();
-			}
+				// Connection loss is completed after all packages received before it
+				PostReceivedPackage(ReceivedPackage(ReceivedPackage::Disconnected));
 			break;
 
 			default:
@@ -441,36 +675,49 @@ void CPveControl::connectionStateChanged (IOSender::State _state)
 	}
 }
 
-void CPveControl::UnregisterJobHandle(IOSendJob::Handle hJob)
+void CPveControl::UnregisterJobHandle(const PrlUuidKey &jobUuid)
 {
-	QMutexLocker _lock(&m_JobsHandlesHashMutex);
-	m_JobsHandlesHash.remove(m_ioClient->getJobUuid(hJob));
+	m_JobsHandlesHash.remove(jobUuid);
+	PrlRequestsPerf::RequestFinished(jobUuid);
 }
 
-void CPveControl::RegisterJobHandle(IOSendJob::Handle hJob)
+void CPveControl::RegisterJobHandle(IOSendJob::Handle hJob, quint32 nOpCode,
+									IOClient *pClient, quint32 nChannel)
 {
-	QMutexLocker _lock(&m_JobsHandlesHashMutex);
-	m_JobsHandlesHash.insert(m_ioClient->getJobUuid(hJob), hJob);
+	QString sJobUuid = (pClient ? pClient : m_ioClient)->getJobUuid(hJob);
+	PrlUuidKey jobUuid = PrlUuidKey::FromString(sJobUuid);
+	m_JobsHandlesHash.insert(jobUuid, SentJob(sJobUuid, hJob, nChannel));
+	PrlRequestsPerf::RequestSent(jobUuid, nOpCode);
 }
 
-IOSendJob::Handle CPveControl::GetJobHandleByUuid(const QString &sJobUuid)
+IOSendJob::Handle CPveControl::GetJobHandleByUuid(const PrlUuidKey &jobUuid)
 {
-	QMutexLocker _lock(&m_JobsHandlesHashMutex);
-	return (m_JobsHandlesHash.value(sJobUuid));
+	return (m_JobsHandlesHash.value(jobUuid).hJob);
 }
 
 void CPveControl::ClearJobHandles()
 {
-	QMutexLocker _lock(&m_JobsHandlesHashMutex);
+	foreach(const SentJob &job, m_JobsHandlesHash.values())
+		PrlRequestsPerf::RequestFinished(PrlUuidKey::FromString(job.sUuid));
 	m_JobsHandlesHash.clear();
 }
 
 void CPveControl::NotifyJobsThatConnectionWasLost()
 {
-	QMutexLocker _lock(&m_JobsHandlesHashMutex);
-	foreach(const QString &sJobUuid, m_JobsHandlesHash.keys())
+	foreach(const SentJob &job, m_JobsHandlesHash.values())
 	{
-		PostFailedResult(sJobUuid, "transport layer", PRL_ERR_WS_DISP_CONNECTION_CLOSED);
+		PostFailedResult(job.sUuid, "transport layer", PRL_ERR_WS_DISP_CONNECTION_CLOSED);
+	}
+}
+
+void CPveControl::NotifyChannelJobsThatConnectionWasLost(quint32 nChannel)
+{
+	foreach(const SentJob &job, m_JobsHandlesHash.values())
+	{
+		if (job.nChannel != nChannel)
+			continue;
+		PostFailedResult(job.sUuid, "transport layer", PRL_ERR_WS_DISP_CONNECTION_CLOSED);
+		UnregisterJobHandle(PrlUuidKey::FromString(job.sUuid));
 	}
 }
 
@@ -481,6 +728,9 @@ void CPveControl::PostFailedResult(const QString &strUuid,
 {
     LOG_MESSAGE(DBG_DEBUG, "CPveControl::PostFailedResult()");
 
+	// Failed request is not awaited anymore
+	PrlRequestsPerf::RequestFinished(PrlUuidKey::FromString(strUuid));
+
     /// Create result set
     CResult *pResult = new CResult();
     pResult->setRequestId(strUuid);
@@ -567,12 +817,15 @@ QString CPveControl::SendRequestToServer(CProtoCommandPtr pRequest)
 {
 	SmartPtr<IOPackage> pPackage = DispatcherPackage::createInstance(pRequest->GetCommandId(),
 																		pRequest->GetCommand()->toString());
+	// Large requests are compressed once dispatcher confirmed it accepts them
+	if (m_nCompressionAccepted.loadAcquire())
+		pPackage = CPveCompression::Deflate(pPackage);
 	return (SendRequestToServer(pPackage));
 }
 
-QString CPveControl::PostNotConnected(const QString &strErrorSource)
+QString CPveControl::PostNotConnected(const QString &strErrorSource, const QString &strJobUuid)
 {
-	QString strUuid = (Uuid::createUuid()).toString(), rem;
+	QString strUuid = strJobUuid.isEmpty() ? (Uuid::createUuid()).toString() : strJobUuid, rem;
 	if (NULL != m_ioClient)
 		rem = m_ioClient->remoteHostName();
 
@@ -590,25 +843,401 @@ QString CPveControl::PostNotConnected(const QString &strErrorSource)
 
 QString CPveControl::SendRequestToServer(const SmartPtr<IOPackage> &pPackage)
 {
+	// Response must not be applied before direct call registers job for it
+	PrlDirectCall::AddPendingRequest(PrlUuidKey::FromString(Uuid::toString(pPackage->header.uuid)));
+
+	// Response is routed by the package UUID once batch is submitted
+	if (AddToBatch(pPackage))
+		return Uuid::toString(pPackage->header.uuid);
+
+	// Bulk requests go to the pool connections not to delay other requests
+	// behind their responses. Primary connection is used if pool is busy.
+	QString strPoolJobUuid;
+	if (IsBulkRequest(pPackage->header.type) && SendToConnectionPool(pPackage, strPoolJobUuid))
+		return strPoolJobUuid;
+
+	{
+		// Requests are sent behind already queued ones to keep submission order
+		QMutexLocker _queue_lock(&m_SendQueueMutex);
+		if (m_nSendQueueCapacity && !m_SendQueue.isEmpty())
+			return QueueRequest(pPackage, _queue_lock);
+	}
+
+	QReadLocker _lock(&m_ioClientLock);
 	if (!CheckConnectionStatus())
-		return PostNotConnected(PVE::DispatcherCommandToString(pPackage->header.type));
+		return PostNotConnected(PVE::DispatcherCommandToString(pPackage->header.type),
+								Uuid::toString(pPackage->header.uuid));
 
 	IOSendJob::Handle hJob = m_ioClient->sendPackage ( pPackage );
 
 	if (hJob == IOSendJob::InvalidHandle)
-		return PostNotConnected("SendRequestToServer");
+		return PostNotConnected("SendRequestToServer", Uuid::toString(pPackage->header.uuid));
 
 	if (IOSendJob::SendQueueIsFull == m_ioClient->getSendResult(hJob))
 	{
-		QString strUuid = (Uuid::createUuid()).toString();
+		QMutexLocker _queue_lock(&m_SendQueueMutex);
+		if (m_nSendQueueCapacity)
+		{
+			_lock.unlock();
+			return QueueRequest(pPackage, _queue_lock);
+		}
+		_queue_lock.unlock();
+
+		QString strUuid = Uuid::toString(pPackage->header.uuid);
 		PostFailedResult(strUuid, "SendRequestToServer", PRL_ERR_TRY_AGAIN);
 		return strUuid;
 	}
-	RegisterJobHandle(hJob);
+	RegisterJobHandle(hJob, pPackage->header.type);
+	{
+		QMutexLocker _queue_lock(&m_SendQueueMutex);
+		m_hLastSentJob = hJob;
+	}
     LOG_MESSAGE(DBG_DEBUG, "Sent request [%s]", m_ioClient->getJobUuid(hJob).toString().toUtf8().data());
 	return (m_ioClient->getJobUuid(hJob));
 }
 
+/**
+ * Pool task which sends queued requests
+ */
+class CSendQueueTask : public QRunnable
+{
+public:
+	explicit CSendQueueTask(CPveControl *pControl)
+	: m_pControl(pControl)
+	{}
+
+	void run()
+	{
+		m_pControl->DrainSendQueue();
+	}
+
+private:
+	CPveControl *m_pControl;
+};
+
+void CPveControl::SetSendQueue(quint32 nCapacity, quint32 nTimeout)
+{
+	QMutexLocker _lock(&m_SendQueueMutex);
+	m_nSendQueueCapacity = nCapacity;
+	m_nSendQueueTimeout = nTimeout;
+	// Already queued requests are drained anyway
+	m_SendQueueCondition.wakeAll();
+}
+
+void CPveControl::GetSendQueueStat(quint32 &nDepth, quint32 &nMaxDepth,
+								   quint64 &nQueued, quint64 &nRejected)
+{
+	QMutexLocker _lock(&m_SendQueueMutex);
+	nDepth = m_SendQueue.size();
+	nMaxDepth = m_nSendQueueMaxDepth;
+	nQueued = m_nSendQueueQueued;
+	nRejected = m_nSendQueueRejected;
+}
+
+QString CPveControl::QueueRequest(const SmartPtr<IOPackage> &pPackage, QMutexLocker &_lock)
+{
+	QDeadlineTimer deadline(QDeadlineTimer::Forever);
+	if (m_nSendQueueTimeout != UINT_MAX)
+		deadline.setRemainingTime(qint64(m_nSendQueueTimeout));
+
+	// Backpressure: submitter waits until queued requests are sent
+	while (!m_bSendQueueStopped && m_nSendQueueCapacity
+		&& quint32(m_SendQueue.size()) >= m_nSendQueueCapacity)
+	{
+		if (!m_SendQueueCondition.wait(&m_SendQueueMutex, deadline))
+			break;
+	}
+
+	if (m_bSendQueueStopped || quint32(m_SendQueue.size()) >= qMax(m_nSendQueueCapacity, 1u))
+	{
+		++m_nSendQueueRejected;
+		_lock.unlock();
+		QString strUuid = Uuid::toString(pPackage->header.uuid);
+		PostFailedResult(strUuid, "SendRequestToServer", PRL_ERR_TRY_AGAIN);
+		return strUuid;
+	}
+
+	m_SendQueue.enqueue(pPackage);
+	PrlRequestsPerf::RequestHeld(PrlUuidKey::FromString(Uuid::toString(pPackage->header.uuid)),
+		pPackage->header.type);
+	++m_nSendQueueQueued;
+	m_nSendQueueMaxDepth = qMax(m_nSendQueueMaxDepth, quint32(m_SendQueue.size()));
+	if (!m_bSendQueueDraining)
+	{
+		m_bSendQueueDraining = true;
+		m_SenderPool.start(new CSendQueueTask(this));
+	}
+	// Response is routed by the package UUID as if it was sent already
+	return Uuid::toString(pPackage->header.uuid);
+}
+
+void CPveControl::DrainSendQueue()
+{
+	forever
+	{
+		SmartPtr<IOPackage> pPackage;
+		{
+			QMutexLocker _lock(&m_SendQueueMutex);
+			if (m_SendQueue.isEmpty() || m_bSendQueueStopped)
+			{
+				m_bSendQueueDraining = false;
+				return;
+			}
+			pPackage = m_SendQueue.head();
+		}
+
+		if (!SendQueuedRequest(pPackage))
+			continue;
+
+		QMutexLocker _lock(&m_SendQueueMutex);
+		if (!m_SendQueue.isEmpty() && m_SendQueue.head().getImpl() == pPackage.getImpl())
+			m_SendQueue.dequeue();
+		m_SendQueueCondition.wakeAll();
+	}
+}
+
+bool CPveControl::SendQueuedRequest(const SmartPtr<IOPackage> &pPackage)
+{
+	QString strUuid = Uuid::toString(pPackage->header.uuid);
+	QReadLocker _lock(&m_ioClientLock);
+	if (!CheckConnectionStatus())
+	{
+		PostFailedResult(strUuid, PVE::DispatcherCommandToString(pPackage->header.type),
+						 PRL_ERR_NOT_CONNECTED_TO_DISPATCHER);
+		return (true);
+	}
+
+	IOSendJob::Handle hJob = m_ioClient->sendPackage ( pPackage );
+	if (hJob == IOSendJob::InvalidHandle)
+	{
+		PostFailedResult(strUuid, "SendRequestToServer", PRL_ERR_NOT_CONNECTED_TO_DISPATCHER);
+		return (true);
+	}
+
+	if (IOSendJob::SendQueueIsFull == m_ioClient->getSendResult(hJob))
+	{
+		IOSendJob::Handle hLastSentJob;
+		{
+			QMutexLocker _queue_lock(&m_SendQueueMutex);
+			hLastSentJob = m_hLastSentJob;
+		}
+		// Transport send queue is FIFO, so it has free space once the last
+		// sent request leaves it
+		if (hLastSentJob == IOSendJob::InvalidHandle
+			|| IOSendJob::InvalidJob == m_ioClient->waitForSend(hLastSentJob, PRL_SEND_QUEUE_RETRY_TIMEOUT))
+			HostUtils::Sleep(PRL_SEND_QUEUE_RETRY_TIMEOUT);
+		return (false);
+	}
+
+	RegisterJobHandle(hJob, pPackage->header.type);
+	QMutexLocker _queue_lock(&m_SendQueueMutex);
+	m_hLastSentJob = hJob;
+	return (true);
+}
+
+void CPveControl::StopSendQueue()
+{
+	QList<SmartPtr<IOPackage> > lstPackages;
+	{
+		QMutexLocker _lock(&m_SendQueueMutex);
+		m_bSendQueueStopped = true;
+		lstPackages = m_SendQueue;
+		m_SendQueue.clear();
+		m_SendQueueCondition.wakeAll();
+	}
+	m_SenderPool.waitForDone();
+
+	// Queued requests will never be sent with this connection
+	foreach(const SmartPtr<IOPackage> &pPackage, lstPackages)
+		PostFailedResult(Uuid::toString(pPackage->header.uuid),
+						 "SendRequestToServer", PRL_ERR_NOT_CONNECTED_TO_DISPATCHER);
+}
+
+void CPveControl::SetConnectionPool(quint32 nSize)
+{
+	bool bStarted;
+	{
+		QMutexLocker _lock(&m_ConnectionPoolMutex);
+		if (m_nConnectionPoolSize == nSize)
+			return;
+		m_nConnectionPoolSize = nSize;
+		bStarted = m_bConnectionPoolStarted;
+	}
+
+	// Pool of the current session is reopened with the new size
+	StopConnectionPool();
+	if (bStarted)
+		StartConnectionPool();
+}
+
+void CPveControl::StartConnectionPool()
+{
+	PveChannelLogin login;
+	quint32 nSize;
+	{
+		QMutexLocker _lock(&m_ConnectionPoolMutex);
+		m_bConnectionPoolStarted = true;
+		if (!m_bConnectionPoolLoginValid || !m_nConnectionPoolSize)
+			return;
+		login = m_ConnectionPoolLogin;
+		nSize = m_nConnectionPoolSize;
+	}
+
+	QWriteLocker _lock(&m_ConnectionPoolLock);
+	if (!m_ConnectionPool.isEmpty())
+		return;
+
+	for (quint32 i = 0; i < nSize; ++i)
+	{
+		CPveChannel *pChannel = new CPveChannel(this, ++m_nLastChannelId, login);
+		if (!pChannel)
+			break;
+		if (!pChannel->GetIoClient())
+		{
+			delete pChannel;
+			break;
+		}
+		m_ConnectionPool.append(pChannel);
+	}
+	WRITE_TRACE(DBG_INFO, "Connection pool of %d connections to '%s' is opened",
+				m_ConnectionPool.size(), QSTR2UTF8(login.sHost));
+}
+
+void CPveControl::StopConnectionPool()
+{
+	QList<CPveChannel *> lstChannels;
+	{
+		QWriteLocker _lock(&m_ConnectionPoolLock);
+		lstChannels.swap(m_ConnectionPool);
+	}
+
+	// Pool may be stopped by the completing thread (see AcquireReceivedPackageSlot())
+	m_nReleasingClients.ref();
+	foreach(CPveChannel *pChannel, lstChannels)
+	{
+		quint32 nChannel = pChannel->GetId();
+		delete pChannel;
+		// Requests sent with closed connection will never be responded
+		PostChannelLost(nChannel);
+	}
+	m_nReleasingClients.deref();
+}
+
+bool CPveControl::IsBulkRequest(quint32 nType)
+{
+	switch (nType)
+	{
+	case PVE::DspCmdDirGetVmList:
+	case PVE::DspCmdVmGetConfig:
+	case PVE::DspCmdGetVmConfigById:
+	case PVE::DspCmdGetVmInfo:
+	case PVE::DspCmdGetVmToolsInfo:
+	case PVE::DspCmdVmGetSnapshotsTree:
+	case PVE::DspCmdVmGetProblemReport:
+	case PVE::DspCmdVmGetPackedProblemReport:
+	case PVE::DspCmdGetHostCommonInfo:
+	case PVE::DspCmdUserGetHostHwInfo:
+	case PVE::DspCmdGetDefaultVmConfig:
+	case PVE::DspCmdGetVirtualNetworkList:
+	case PVE::DspCmdGetCtTemplateList:
+	case PVE::DspCmdFsGetDiskList:
+		return (true);
+	default:
+		return (false);
+	}
+}
+
+bool CPveControl::SendToConnectionPool(const SmartPtr<IOPackage> &pPackage, QString &strUuid)
+{
+	QReadLocker _lock(&m_ConnectionPoolLock);
+	quint32 nCount = m_ConnectionPool.size();
+	for (quint32 i = 0; i < nCount; ++i)
+	{
+		quint32 nIndex = quint32(m_nNextPoolConnection.fetchAndAddRelaxed(1)) % nCount;
+		CPveChannel *pChannel = m_ConnectionPool.at(nIndex);
+		IOSendJob::Handle hJob = pChannel->SendPackage(pPackage);
+		if (hJob == IOSendJob::InvalidHandle)
+			continue;
+
+		RegisterJobHandle(hJob, pPackage->header.type, pChannel->GetIoClient(), pChannel->GetId());
+		strUuid = pChannel->GetIoClient()->getJobUuid(hJob);
+		LOG_MESSAGE(DBG_DEBUG, "Sent request [%s] with pool connection %u",
+					QSTR2UTF8(strUuid), pChannel->GetId());
+		return (true);
+	}
+	return (false);
+}
+
+void CPveControl::BeginBatch()
+{
+	QMutexLocker _lock(&m_BatchMutex);
+	m_nBatchOpened.storeRelease(1);
+}
+
+void CPveControl::SubmitBatch()
+{
+	QList<SmartPtr<IOPackage> > lstPackages;
+	{
+		QMutexLocker _lock(&m_BatchMutex);
+		m_nBatchOpened.storeRelease(0);
+		lstPackages.swap(m_Batch);
+	}
+
+	LOG_MESSAGE(DBG_DEBUG, "Submitting batch of %d requests", lstPackages.size());
+	foreach(const SmartPtr<IOPackage> &pPackage, lstPackages)
+		SendRequestToServer(pPackage);
+}
+
+quint32 CPveControl::GetSentRequestsCount() const
+{
+	return quint32(m_JobsHandlesHash.size());
+}
+
+bool CPveControl::AddToBatch(const SmartPtr<IOPackage> &pPackage)
+{
+	if (!m_nBatchOpened.loadAcquire())
+		return (false);
+
+	// Session requests are never delayed
+	switch (pPackage->header.type)
+	{
+	case PVE::DspCmdUserLogin:
+	case PVE::DspCmdUserLogoff:
+	case PVE::DspCmdUserCancelOperation:
+		return (false);
+	default:
+		break;
+	}
+
+	QMutexLocker _lock(&m_BatchMutex);
+	if (!m_nBatchOpened.loadAcquire())
+		return (false);
+	m_Batch.append(pPackage);
+	PrlRequestsPerf::RequestHeld(PrlUuidKey::FromString(Uuid::toString(pPackage->header.uuid)),
+		pPackage->header.type);
+	return (true);
+}
+
+void CPveControl::DiscardBatch()
+{
+	QList<SmartPtr<IOPackage> > lstPackages;
+	{
+		QMutexLocker _lock(&m_BatchMutex);
+		m_nBatchOpened.storeRelease(0);
+		lstPackages.swap(m_Batch);
+	}
+
+	// Held requests will never be sent with this connection
+	foreach(const SmartPtr<IOPackage> &pPackage, lstPackages)
+		PostFailedResult(Uuid::toString(pPackage->header.uuid),
+						 "SubmitBatch", PRL_ERR_NOT_CONNECTED_TO_DISPATCHER);
+}
+
+void CPveControl::SetRequestsCompression(bool bEnable)
+{
+	m_nCompressionAccepted.storeRelease((bEnable && m_nCompressionOffered.loadAcquire()) ? 1 : 0);
+}
+
 bool CPveControl::IsDisplayEncodingsSupported () const
 {
 	if ( ! m_ioClient || m_ioClient->state() != IOSender::Connected )
@@ -684,10 +1313,29 @@ void CPveControl::DspCmdUserLogin(
 		return;
 	}
 
+	{
+		// Pool connections repeat remote password login only
+		QMutexLocker _lock(&m_ConnectionPoolMutex);
+		m_ConnectionPoolLogin.sHost = host;
+		m_ConnectionPoolLogin.nPort = port;
+		m_ConnectionPoolLogin.connSec = connSec;
+		m_ConnectionPoolLogin.baCertificate = QByteArray(certificate);
+		m_ConnectionPoolLogin.baPrivateKey = QByteArray(privateKey);
+		m_ConnectionPoolLogin.nTimeout = nConnectionTimeout;
+		m_ConnectionPoolLogin.sUser = pJob->GetUser();
+		m_ConnectionPoolLogin.sPassword = pJob->GetPassword();
+		m_ConnectionPoolLogin.nFlags = pJob->GetFlags();
+		m_bConnectionPoolLoginValid = !(pJob->GetFlags() & PLLF_LOGIN_WITH_RSA_KEYS);
+		m_bConnectionPoolStarted = false;
+	}
+	// Dispatcher may compress responses once client offered it at login
+	m_nCompressionOffered.storeRelease((pJob->GetFlags() & PLLF_ALLOW_COMPRESSION) ? 1 : 0);
+	m_nCompressionAccepted.storeRelease(0);
+
     // Create IO client
-    m_ioClient = new IOClient(
+    SetIoClient(new IOClient(
                         IORoutingTableHelper::GetClientRoutingTable(connSec),
-                        IOSender::Client, host, port, false, credentials);
+                        IOSender::Client, host, port, false, credentials));
 
     ClearJobHandles();
 
@@ -720,6 +1368,13 @@ QString CPveControl::DspCmdUserRelogin(	const char *sUser,
 {
     LOG_MESSAGE(DBG_DEBUG, "CPveControl::DspCmdUserRelogin()");
 
+	{
+		// Pool connections are not relogged in with the primary one
+		QMutexLocker _lock(&m_ConnectionPoolMutex);
+		m_bConnectionPoolLoginValid = false;
+	}
+	StopConnectionPool();
+
 	CProtoCommandPtr pRequest = CProtoSerializer::CreateDspCmdUserLoginCommand(
 											UTF8_2QSTR(sUser),
 											UTF8_2QSTR(sPassword),
@@ -786,21 +1441,30 @@ void CPveControl::DspCmdUserLoginLocal ( PrlHandleLoginLocalHelperJobPtr pJob,
 
 	m_pLoginLocalHelperJob = pJob;
 
+	{
+		// Local login can't be repeated by pool connections
+		QMutexLocker _lock(&m_ConnectionPoolMutex);
+		m_bConnectionPoolLoginValid = false;
+		m_bConnectionPoolStarted = false;
+	}
+	m_nCompressionOffered.storeRelease(0);
+	m_nCompressionAccepted.storeRelease(0);
+
     // Create IO client
 #ifndef _WIN_
     Q_UNUSED(nPort);
 	outPortNumber = 0;
-    m_ioClient = new IOClient(
+    SetIoClient(new IOClient(
 			IORoutingTableHelper::GetClientRoutingTable(connSec),
 			IOSender::Client,
 			VirtuozzoDirs::getDispatcherLocalSocketPath(),
-			0, true );
+			0, true ));
 #else
     quint32 port = (nPort ? nPort : PrlGetDefaultListenPort());
 	outPortNumber = port;
-    m_ioClient = new IOClient(
+    SetIoClient(new IOClient(
                         IORoutingTableHelper::GetClientRoutingTable(connSec),
-                        IOSender::Client, IOService::LoopbackAddr, port );
+                        IOSender::Client, IOService::LoopbackAddr, port ));
 #endif
 
 	ClearJobHandles();
@@ -1807,7 +2471,7 @@ QString CPveControl::DspCmdVmAnswer(const char *strEvent)
 	CVmEvent answerEvent(UTF8_2QSTR(strEvent));
 	SmartPtr<IOPackage> pRequestPkg;
 	{
-		QMutexLocker _lock(&m_JobsHandlesHashMutex);
+		QMutexLocker _lock(&m_QuestionsRequestPkgsHashMutex);
 		pRequestPkg = m_QuestionsRequestPkgsHash.take(answerEvent.getInitRequestId());
 	}
 
@@ -30,9 +30,15 @@
 #define PVECONTROL_H
 
 #include <QHash>
+#include <QMap>
 #include <QMutex>
 #include <QObject>
+#include <QReadWriteLock>
+#include <QSemaphore>
 #include <QStringList>
+#include <QThreadPool>
+#include <QQueue>
+#include <QWaitCondition>
 #include <prlcommon/Interfaces/VirtuozzoNamespace.h>
 #include <prlcommon/Std/SmartPtr.h>
 #include <prlcommon/Logging/Logging.h>
@@ -40,6 +46,8 @@
 #include <prlcommon/ProtoSerializer/CProtoSerializer.h>
 #include "SDK/Include/PrlIOStructs.h"
 #include "PrlHandleBase.h"
+#include "PrlUuidMap.h"
+#include "PveChannel.h"
 
 using namespace IOService;
 using Virtuozzo::CProtoCommandPtr;
@@ -50,6 +58,11 @@ using Virtuozzo::CProtoCommandPtr;
  */
 #define PVE_CONNECTION_TIMEOUT 60000
 
+/**
+ * Maximum number of additional connections of the connection pool
+ */
+#define PVE_MAX_CONNECTION_POOL_SIZE 16
+
 /**
  * Main interface for processing Client<->Dispatcher proto messages
  */
@@ -1319,6 +1332,61 @@ public://Protocol methods
 	 */
 	QString SendRequestToServer(const SmartPtr<IOPackage> &pPackage);
 
+	/**
+	 * Configures requests queue which holds requests while transport send
+	 * queue is full instead of failing them with PRL_ERR_TRY_AGAIN
+	 * @param queue capacity (0 disables queue)
+	 * @param time in msecs to wait for free space in full queue (UINT_MAX - infinite)
+	 */
+	void SetSendQueue(quint32 nCapacity, quint32 nTimeout);
+
+	/**
+	 * Returns requests queue metrics
+	 * @param [out] number of currently queued requests
+	 * @param [out] maximum number of simultaneously queued requests
+	 * @param [out] total number of queued requests
+	 * @param [out] number of requests rejected as queue was full
+	 */
+	void GetSendQueueStat(quint32 &nDepth, quint32 &nMaxDepth,
+						  quint64 &nQueued, quint64 &nRejected);
+
+	/**
+	 * Configures connection pool: additional sessions to the same dispatcher
+	 * opened after remote login with the same credentials. Bulk requests are
+	 * spread over them so small requests are not delayed behind bulk
+	 * responses at the primary connection.
+	 * @param number of additional connections (0 disables pool)
+	 */
+	void SetConnectionPool(quint32 nSize);
+
+	/**
+	 * Opens pool connections. Called once login of primary connection succeeded.
+	 */
+	void StartConnectionPool();
+
+	/**
+	 * Enables compression of large requests bodies. Called once dispatcher
+	 * confirmed at login that it accepts compressed requests.
+	 * @param sign whether compression is enabled
+	 */
+	void SetRequestsCompression(bool bEnable);
+
+	/**
+	 * Opens requests batch: requests are held until the batch is submitted
+	 * and then passed to transport back to back
+	 */
+	void BeginBatch();
+
+	/**
+	 * Closes requests batch and sends held requests in submission order
+	 */
+	void SubmitBatch();
+
+	/**
+	 * Returns number of requests sent and awaiting response
+	 */
+	quint32 GetSentRequestsCount() const;
+
 	/**
 	 * Removes Container template
 	 * @return id of performed asynchronous request
@@ -1509,8 +1577,9 @@ private:
 	/**
 	 * Post a lost connection error
 	 * @param  error source string
+	 * @param  UUID of failed job (new one is created if empty)
 	 */
-	QString PostNotConnected(const QString &strErrorSource);
+	QString PostNotConnected(const QString &strErrorSource, const QString &strJobUuid = QString());
 
 	/**
 	 * Posts error result to receiver
@@ -1525,27 +1594,39 @@ private:
 
 	/**
 	 * Unregistries sended job handle from handles hash
-	 * @param unregistering job handle
+	 * @param binary UUID of unregistering job
 	 */
-	void UnregisterJobHandle(IOSendJob::Handle hJob);
+	void UnregisterJobHandle(const PrlUuidKey &jobUuid);
 
 	/**
 	 * Registries sended job handle from handles hash
 	 * @param registering job handle
+	 * @param protocol command code of the sent request
+	 * @param connection object job was sent with (NULL - primary one)
+	 * @param identifier of pool connection job was sent with (0 - primary one)
 	 */
-	void RegisterJobHandle(IOSendJob::Handle hJob);
+	void RegisterJobHandle(IOSendJob::Handle hJob, quint32 nOpCode,
+						   IOClient *pClient = NULL, quint32 nChannel = 0);
 
 	/**
 	 * Cleanups jobs handles hash
 	 */
 	void ClearJobHandles();
 
+	/**
+	 * Destroys current client connection object and sets new one. Requests
+	 * may be sent from any thread so object replaced under the client
+	 * connection lock.
+	 * @param pointer to client connection object
+	 */
+	void SetIoClient(IOClient *pIoClient);
+
 	/**
 	 * Returns job handle by specified UUID
 	 * @param job UUID
 	 * @return requested job handle
 	 */
-	IOSendJob::Handle GetJobHandleByUuid(const QString &sJobUuid);
+	IOSendJob::Handle GetJobHandleByUuid(const PrlUuidKey &jobUuid);
 
 	/**
 	 * Notifies all awaiting jobs that connection to dispatcher was lost
@@ -1559,6 +1640,172 @@ private:
 	 */
 	QString SendRequestToServer(CProtoCommandPtr pRequest);
 
+private:
+	friend class CReceivedPackageTask;
+	friend class CSendQueueTask;
+	friend class CPveChannel;
+
+	/**
+	 * Returns sign whether request of specified type is sent with pool connections
+	 * @param request package type
+	 */
+	static bool IsBulkRequest(quint32 nType);
+
+	/**
+	 * Sends request with one of ready pool connections
+	 * @param sending package
+	 * @param [out] UUID of sent job
+	 * @return false if there is no ready pool connection with free send queue
+	 */
+	bool SendToConnectionPool(const SmartPtr<IOPackage> &pPackage, QString &strUuid);
+
+	/**
+	 * Closes pool connections and fails requests sent with them
+	 */
+	void StopConnectionPool();
+
+	/**
+	 * Holds request in the opened requests batch
+	 * @param holding package
+	 * @return false if batch is not opened or request is never held
+	 */
+	bool AddToBatch(const SmartPtr<IOPackage> &pPackage);
+
+	/**
+	 * Closes requests batch and fails held requests
+	 */
+	void DiscardBatch();
+
+	/**
+	 * Queues response received with any connection for parsing. Called on
+	 * the transport thread.
+	 * @param connection object response was received with
+	 * @param handle to request job
+	 * @param pointer to received package object
+	 */
+	void HandleResponse(IOClient *pClient, IOSendJob::Handle hJob, const SmartPtr<IOPackage> &p);
+
+	/**
+	 * Queues failing of requests sent with lost pool connection behind
+	 * responses already received with it
+	 * @param identifier of lost pool connection
+	 */
+	void PostChannelLost(quint32 nChannel);
+
+	/**
+	 * Fails requests sent with specified pool connection
+	 * @param identifier of pool connection
+	 */
+	void NotifyChannelJobsThatConnectionWasLost(quint32 nChannel);
+
+	/**
+	 * Queues request behind already queued ones waiting for free space
+	 * in the requests queue. Called under m_SendQueueMutex lock.
+	 * @param queueing package
+	 * @param locker of m_SendQueueMutex
+	 * @return UUID of pending job or of failed job if queue is full
+	 */
+	QString QueueRequest(const SmartPtr<IOPackage> &pPackage, QMutexLocker &_lock);
+
+	/**
+	 * Sends queued requests in submission order. Called on the sender pool.
+	 */
+	void DrainSendQueue();
+
+	/**
+	 * Tries to send queued request
+	 * @param sending package
+	 * @return false if transport send queue is still full and sending
+	 * should be retried
+	 */
+	bool SendQueuedRequest(const SmartPtr<IOPackage> &pPackage);
+
+	/**
+	 * Stops requests queue: releases waiting submitters, fails queued
+	 * requests and waits for queue draining completion
+	 */
+	void StopSendQueue();
+
+	/**
+	 * Package received from server. Packages are parsed concurrently on the
+	 * parser pool but completed (passed to receiver) strictly in the receiving
+	 * order, so order of responses and events of any job and VM is kept.
+	 */
+	struct ReceivedPackage
+	{
+		enum Kind { Event, Response, Disconnected, ChannelDisconnected };
+
+		explicit ReceivedPackage(Kind _kind = Event)
+		: nKind(_kind), pEvent(NULL), bUnregisterJob(false), nChannel(0), nReceivedTime(0),
+		  bHoldsSlot(false)
+		{}
+
+		/** Package kind */
+		Kind nKind;
+		/** Received package */
+		SmartPtr<IOPackage> pPackage;
+		/** UUID of the job response was received on */
+		QString sJobUuid;
+		/** Binary UUID of the job response was received on */
+		PrlUuidKey jobUuidKey;
+		/** Parsed event or result to pass to receiver */
+		QEvent *pEvent;
+		/** Parsed response command (DspWsResponse only) */
+		CProtoCommandPtr pResponseCmd;
+		/** Sign whether job must be unregistered on completion */
+		bool bUnregisterJob;
+		/** Identifier of lost pool connection (ChannelDisconnected only) */
+		quint32 nChannel;
+		/** Time response was received at (Response only) */
+		qint64 nReceivedTime;
+		/** Sign whether package holds received packages slot */
+		bool bHoldsSlot;
+	};
+
+	/**
+	 * Queues received package for parsing. Called on the transport thread.
+	 * Waits while too many received events and responses are in flight.
+	 * @param received package
+	 */
+	void PostReceivedPackage(const ReceivedPackage &_pkg);
+	/**
+	 * Returns sign whether package is an event or response taking received
+	 * packages slot until its completion starts
+	 * @param received package
+	 */
+	static bool IsThrottledPackage(const ReceivedPackage &_pkg);
+	/**
+	 * Waits for received packages slot. Gives up while a client connection
+	 * is destroyed, as destruction waits for the transport thread.
+	 * @return sign whether slot was taken
+	 */
+	bool AcquireReceivedPackageSlot();
+	/**
+	 * Parses received package. Called on the parser pool.
+	 * @param parsing package
+	 */
+	void ParseReceivedPackage(ReceivedPackage &_pkg);
+	void ParseEventPackage(ReceivedPackage &_pkg);
+	/**
+	 * Returns package body inflated if it's compressed (empty on failure)
+	 * @param pointer to package
+	 */
+	QByteArray GetPackageBody(const SmartPtr<IOPackage> &p);
+	void ParseResponsePackage(ReceivedPackage &_pkg);
+	/**
+	 * Completes parsed package and all next packages which are already parsed
+	 * @param package sequence number
+	 * @param parsed package
+	 */
+	void CompleteReceivedPackage(quint64 nSequence, const ReceivedPackage &_pkg);
+	void CompleteParsedPackage(ReceivedPackage &_pkg);
+	void CompleteWsResponse(ReceivedPackage &_pkg);
+	/**
+	 * Passes event to the events receiver
+	 * @param pointer to passing event
+	 */
+	void PostToEventReceiver(QEvent *pEvent);
+
 signals:
 	/**
 	 * Signal helper that using in finalize transport work mech
@@ -1600,20 +1847,116 @@ private:
 	bool m_bUseSSL;
 	/** Storing pointer to events processing object */
 	QObject *m_pEventReceiverObj;
-	/** Sended jobs handles hash */
-	QHash<QString, IOSendJob::Handle> m_JobsHandlesHash;
+	/** Sended job handle with its text UUID */
+	struct SentJob
+	{
+		SentJob() : hJob(), nChannel(0) {}
+		SentJob(const QString &_uuid, IOSendJob::Handle _handle, quint32 _channel)
+		: sUuid(_uuid), hJob(_handle), nChannel(_channel)
+		{}
+
+		QString sUuid;
+		IOSendJob::Handle hJob;
+		/** Pool connection identifier (0 - primary connection) */
+		quint32 nChannel;
+	};
+	/** Sended jobs handles concurrent map */
+	PrlUuidMap<SentJob> m_JobsHandlesHash;
 	/** Question requests packages hash */
 	QHash<QString, SmartPtr<IOPackage> > m_QuestionsRequestPkgsHash;
-	/** Sended jobs handles hash access synchronization object */
-	QRecursiveMutex m_JobsHandlesHashMutex;
+	/** Question requests packages hash access synchronization object */
+	QRecursiveMutex m_QuestionsRequestPkgsHashMutex;
 	/** Pointer to client connection object */
 	IOClient* m_ioClient;
+	/**
+	 * Client connection object lock: held for reading while request is sending
+	 * and for writing while connection object is created or destroyed
+	 */
+	QReadWriteLock m_ioClientLock;
 	/** Remote login helper object */
 	PrlHandleLoginHelperJobPtr m_pLoginHelperJob;
 	/** Local login helper object */
 	PrlHandleLoginLocalHelperJobPtr m_pLoginLocalHelperJob;
 	/** Loging limit rating object */
 	LogRateLimit	m_rl;
+	/** Received packages parser threads pool */
+	QThreadPool m_ParserPool;
+	/**
+	 * Free slots for received events and responses which are queued for
+	 * parsing or await completion. Receiving thread waits for a slot, so
+	 * a fast server is slowed down by the transport instead of growing the
+	 * parser queue without limits.
+	 */
+	QSemaphore m_ReceivedPackagesSlots;
+	/** Received packages sequencing synchronization object */
+	QMutex m_ReceivedPackagesMutex;
+	/** Number of packages queued for parsing */
+	quint64 m_nReceivedPackagesCount;
+	/** Number of completed packages (sequence number of next one to complete) */
+	quint64 m_nCompletedPackagesCount;
+	/** Parsed packages awaiting completion of previous ones */
+	QMap<quint64, ReceivedPackage> m_ParsedPackages;
+	/** Sign whether some thread completes parsed packages now */
+	bool m_bCompletingPackages;
+	/** Number of client connections being destroyed */
+	QAtomicInt m_nReleasingClients;
+
+	/** Requests queue synchronization object */
+	QMutex m_SendQueueMutex;
+	/** Signalled when requests queue has free space or was stopped */
+	QWaitCondition m_SendQueueCondition;
+	/** Requests awaiting free space in transport send queue */
+	QQueue<SmartPtr<IOPackage> > m_SendQueue;
+	/** Requests queue capacity (0 - queue is disabled) */
+	quint32 m_nSendQueueCapacity;
+	/** Time in msecs to wait for free space in full requests queue */
+	quint32 m_nSendQueueTimeout;
+	/** Sign whether requests queue is drained by the sender pool now */
+	bool m_bSendQueueDraining;
+	/** Sign whether requests queue was stopped with transport */
+	bool m_bSendQueueStopped;
+	/** Last request passed to transport */
+	IOSendJob::Handle m_hLastSentJob;
+	/** Requests queue metrics */
+	quint32 m_nSendQueueMaxDepth;
+	quint64 m_nSendQueueQueued;
+	quint64 m_nSendQueueRejected;
+	/** Queued requests sender pool (single thread keeps submission order) */
+	QThreadPool m_SenderPool;
+
+	/** Connection pool settings synchronization object */
+	QMutex m_ConnectionPoolMutex;
+	/** Number of additional pool connections (0 - pool is disabled) */
+	quint32 m_nConnectionPoolSize;
+	/** Login parameters repeated by pool connections */
+	PveChannelLogin m_ConnectionPoolLogin;
+	/** Sign whether primary connection was logged in with remote password login */
+	bool m_bConnectionPoolLoginValid;
+	/** Sign whether primary connection is logged in */
+	bool m_bConnectionPoolStarted;
+	/** Last assigned pool connection identifier */
+	quint32 m_nLastChannelId;
+	/**
+	 * Pool connections lock: held for reading while request is sending and
+	 * for writing while pool is opened or closed
+	 */
+	QReadWriteLock m_ConnectionPoolLock;
+	/** Pool connections */
+	QList<CPveChannel *> m_ConnectionPool;
+	/** Round robin counter for pool connections selection */
+	QAtomicInt m_nNextPoolConnection;
+
+	/** Requests batch synchronization object */
+	QMutex m_BatchMutex;
+	/** Sign whether requests batch is opened (checked without lock) */
+	QAtomicInt m_nBatchOpened;
+	/** Requests held in the opened batch */
+	QList<SmartPtr<IOPackage> > m_Batch;
+
+	/** Sign whether client offered compression at login */
+	QAtomicInt m_nCompressionOffered;
+	/** Sign whether dispatcher accepts compressed requests */
+	QAtomicInt m_nCompressionAccepted;
 };
 
 #endif // PVECONTROL_H
@@ -33,13 +33,12 @@ namespace HandleAdapter
 {
 	SmartPtr<PrlHandleBase> getHandleBase(const PRL_HANDLE h)
 	{
-		const QMutexLocker _lock(PrlHandleBase::s_pHandlesMapMutex);
-		const HandlesMap::iterator i = PrlHandleBase::s_pHandlesMap->find(h);
-		if (PrlHandleBase::s_pHandlesMap->end() == i)
+		const SmartPtr<PrlHandleBase> b = PrlHandleBase::s_pHandlesTable->Find(h);
+		if (!b.isValid())
 		{
 			throw (PRL_RESULT)PRL_ERR_INVALID_HANDLE;
 		}
-		return i.value();
+		return b;
 	}
 
 	SmartPtr<PrlHandleBase> getHandleBase(const PRL_HANDLE h,
@@ -68,15 +68,15 @@ PRL_ASYNC_METHOD( PrlSrv_GetVirtualNetworkList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_VIRTUAL_NETWORK_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetVirtualNetworkList, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetVirtualNetworkList, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_AddVirtualNetwork_Impl(PRL_HANDLE hServer, PRL_HANDLE hVirtNet, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_ADD_VIRTUAL_NETWORK));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
 	PrlHandleJobPtr pJob = pServer->AddVirtualNetwork(hVirtNet, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -90,15 +90,15 @@ PRL_ASYNC_METHOD( PrlSrv_AddVirtualNetwork ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_ADD_VIRTUAL_NETWORK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_AddVirtualNetwork, (hServer, hVirtNet, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_AddVirtualNetwork, (hServer, hVirtNet, nFlags))
 }
 
 PRL_HANDLE PrlSrv_UpdateVirtualNetwork_Impl(PRL_HANDLE hServer, PRL_HANDLE hVirtNet, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_VIRTUAL_NETWORK));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
 	PrlHandleJobPtr pJob = pServer->UpdateVirtualNetwork(hVirtNet, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -112,15 +112,15 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateVirtualNetwork ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_VIRTUAL_NETWORK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateVirtualNetwork, (hServer, hVirtNet, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateVirtualNetwork, (hServer, hVirtNet, nFlags))
 }
 
 PRL_HANDLE PrlSrv_DeleteVirtualNetwork_Impl(PRL_HANDLE hServer, PRL_HANDLE hVirtNet, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_DELETE_VIRTUAL_NETWORK));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
 	PrlHandleJobPtr pJob = pServer->DeleteVirtualNetwork(hVirtNet, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -134,7 +134,7 @@ PRL_ASYNC_METHOD( PrlSrv_DeleteVirtualNetwork ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_DELETE_VIRTUAL_NETWORK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_DeleteVirtualNetwork, (hServer, hVirtNet, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_DeleteVirtualNetwork, (hServer, hVirtNet, nFlags))
 }
 
 PRL_HANDLE PrlSrv_NetServiceStart_Impl(PRL_HANDLE hServer)
@@ -147,7 +147,7 @@ PRL_ASYNC_METHOD( PrlSrv_NetServiceStart ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_NET_SERVICE_START)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_NetServiceStart, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_NetServiceStart, (hServer))
 }
 
 PRL_HANDLE PrlSrv_NetServiceStop_Impl(PRL_HANDLE hServer)
@@ -160,7 +160,7 @@ PRL_ASYNC_METHOD( PrlSrv_NetServiceStop ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_NET_SERVICE_STOP)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_NetServiceStop, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_NetServiceStop, (hServer))
 }
 
 PRL_HANDLE PrlSrv_NetServiceRestart_Impl(PRL_HANDLE hServer)
@@ -173,7 +173,7 @@ PRL_ASYNC_METHOD( PrlSrv_NetServiceRestart ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_NET_SERVICE_RESTART)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_NetServiceRestart, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_NetServiceRestart, (hServer))
 }
 
 PRL_HANDLE PrlSrv_NetServiceRestoreDefaults_Impl(PRL_HANDLE hServer)
@@ -186,7 +186,7 @@ PRL_ASYNC_METHOD( PrlSrv_NetServiceRestoreDefaults ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_NET_SERVICE_RESTORE_DEFAULTS)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_NetServiceRestoreDefaults, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_NetServiceRestoreDefaults, (hServer))
 }
 
 PRL_HANDLE PrlSrv_GetNetServiceStatus_Impl(PRL_HANDLE hServer)
@@ -199,7 +199,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetNetServiceStatus ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_NET_SERVICE_STATUS)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetNetServiceStatus, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetNetServiceStatus, (hServer))
 }
 
 PRL_HANDLE PrlSrv_UpdateOfflineService_Impl(
@@ -209,12 +209,12 @@ PRL_HANDLE PrlSrv_UpdateOfflineService_Impl(
 	)
 {
 
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) ||
-			PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pServer ||
+			!pOffmgmtService)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_OFFLINE_SERVICE));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>(hOffmgmtService);
 	PrlHandleJobPtr pJob = pServer->UpdateOfflineService( pOffmgmtService, nFlags );
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -229,7 +229,7 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateOfflineService ) (
 {
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_OFFLINE_SERVICE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateOfflineService, (hServer, hOffmgmtService, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateOfflineService, (hServer, hOffmgmtService, nFlags))
 }
 
 PRL_HANDLE PrlSrv_DeleteOfflineService_Impl(
@@ -238,12 +238,12 @@ PRL_HANDLE PrlSrv_DeleteOfflineService_Impl(
 	PRL_UINT32 nFlags
 	)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) ||
-			PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pServer ||
+			!pOffmgmtService)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_DELETE_OFFLINE_SERVICE));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>(hOffmgmtService);
 	PrlHandleJobPtr pJob = pServer->DeleteOfflineService( pOffmgmtService, nFlags );
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -257,7 +257,7 @@ PRL_ASYNC_METHOD( PrlSrv_DeleteOfflineService ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_DELETE_OFFLINE_SERVICE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_DeleteOfflineService, (hServer, hOffmgmtService, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_DeleteOfflineService, (hServer, hOffmgmtService, nFlags))
 }
 
 PRL_HANDLE PrlSrv_GetOfflineServicesList_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
@@ -271,7 +271,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetOfflineServicesList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_OFFLINE_SERVICES_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetOfflineServicesList, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetOfflineServicesList, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_UpdateNetworkClassesList_Impl(
@@ -280,12 +280,12 @@ PRL_HANDLE PrlSrv_UpdateNetworkClassesList_Impl(
 	PRL_UINT32 nFlags
 	)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) ||
-	    PRL_WRONG_HANDLE(hNetworkClassesList, PHT_HANDLES_LIST))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	PrlHandleHandlesListPtr phList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>( hNetworkClassesList, PHT_HANDLES_LIST );
+	if (!pServer ||
+	    !phList)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_NETWORK_CLASSES_CONFIG));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
-	PrlHandleHandlesListPtr phList = PRL_OBJECT_BY_HANDLE<PrlHandleHandlesList>(hNetworkClassesList);
 	PrlHandleJobPtr pJob = pServer->UpdateNetworkClassesList( phList, nFlags );
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -299,7 +299,7 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateNetworkClassesList) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_NETWORK_CLASSES_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateNetworkClassesList, (hServer, hNetworkClassesList, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateNetworkClassesList, (hServer, hNetworkClassesList, nFlags))
 }
 
 PRL_HANDLE PrlSrv_GetNetworkClassesList_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
@@ -313,7 +313,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetNetworkClassesList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_NETWORK_CLASSES_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetNetworkClassesList, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetNetworkClassesList, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_UpdateNetworkShapingConfig_Impl(
@@ -322,11 +322,11 @@ PRL_HANDLE PrlSrv_UpdateNetworkShapingConfig_Impl(
 	PRL_UINT32 nFlags
 	)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) ||
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	if (!pServer ||
 	    PRL_WRONG_HANDLE(hNetworkShapingConfig, PHT_NETWORK_SHAPING_CONFIG))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_NETWORK_SHAPING_CONFIG));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
 	PrlHandleJobPtr pJob = pServer->UpdateNetworkShapingConfig(hNetworkShapingConfig, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -340,7 +340,7 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateNetworkShapingConfig) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_NETWORK_SHAPING_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateNetworkShapingConfig,
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateNetworkShapingConfig,
 			(hServer, hNetworkShapingConfig, nFlags))
 }
 
@@ -356,15 +356,15 @@ PRL_ASYNC_METHOD( PrlSrv_GetNetworkShapingConfig ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_NETWORK_SHAPING_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetNetworkShapingConfig, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetNetworkShapingConfig, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlSrv_AddIPPrivateNetwork_Impl(PRL_HANDLE hServer, PRL_HANDLE hPrivNet, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_ADD_IPPRIVATE_NETWORK));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
 	PrlHandleJobPtr pJob = pServer->AddIPPrivateNetwork(hPrivNet, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -378,15 +378,15 @@ PRL_ASYNC_METHOD( PrlSrv_AddIPPrivateNetwork ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_ADD_IPPRIVATE_NETWORK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_AddIPPrivateNetwork, (hServer, hPrivNet, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_AddIPPrivateNetwork, (hServer, hPrivNet, nFlags))
 }
 
 PRL_HANDLE PrlSrv_RemoveIPPrivateNetwork_Impl(PRL_HANDLE hServer, PRL_HANDLE hPrivNet, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REMOVE_IPPRIVATE_NETWORK));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
 	PrlHandleJobPtr pJob = pServer->RemoveIPPrivateNetwork(hPrivNet, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -400,16 +400,16 @@ PRL_ASYNC_METHOD( PrlSrv_RemoveIPPrivateNetwork ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REMOVE_IPPRIVATE_NETWORK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_RemoveIPPrivateNetwork, \
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_RemoveIPPrivateNetwork, \
 			(hServer, hPrivNet, nFlags))
 }
 
 PRL_HANDLE PrlSrv_UpdateIPPrivateNetwork_Impl(PRL_HANDLE hServer, PRL_HANDLE hPrivNet, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET))
+	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_UPDATE_IPPRIVATE_NETWORK));
 
-	PrlHandleServerNetPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerNet>( hServer );
 	PrlHandleJobPtr pJob = pServer->UpdateIPPrivateNetwork(hPrivNet, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE);
@@ -423,7 +423,7 @@ PRL_ASYNC_METHOD( PrlSrv_UpdateIPPrivateNetwork ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UPDATE_IPPRIVATE_NETWORK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UpdateIPPrivateNetwork, \
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UpdateIPPrivateNetwork, \
 			(hServer, hPrivNet, nFlags))
 }
 
@@ -439,7 +439,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetIPPrivateNetworksList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_IPPRIVATE_NETWORKS_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetIPPrivateNetworksList, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetIPPrivateNetworksList, (hServer, nFlags))
 }
 
 PRL_METHOD( PrlVirtNet_Create) (
@@ -474,11 +474,11 @@ PRL_METHOD( PrlVirtNet_GetNetworkId ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnNetworkIdBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetNetworkId(sNetworkId, pnNetworkIdBufLength);
 }
@@ -496,11 +496,11 @@ PRL_METHOD( PrlVirtNet_SetNetworkId ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sNetworkId))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetNetworkId(sNetworkId);
 }
@@ -520,11 +520,11 @@ PRL_METHOD( PrlVirtNet_GetDescription ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnDescriptionBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetDescription(sDescription, pnDescriptionBufLength);
 }
@@ -542,11 +542,11 @@ PRL_METHOD( PrlVirtNet_SetDescription ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sDescription))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetDescription(sDescription);
 }
@@ -564,10 +564,10 @@ PRL_METHOD( PrlVirtNet_GetNetworkType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) || PRL_WRONG_PTR(pnNetworkType))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet || PRL_WRONG_PTR(pnNetworkType))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->GetNetworkType(pnNetworkType));
 }
 
@@ -584,10 +584,10 @@ PRL_METHOD( PrlVirtNet_SetNetworkType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetNetworkType(nNetworkType));
 }
 
@@ -606,11 +606,11 @@ PRL_METHOD( PrlVirtNet_GetBoundCardMac ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnBoundCardMacBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetBoundCardMac(sBoundCardMac, pnBoundCardMacBufLength);
 }
@@ -628,11 +628,11 @@ PRL_METHOD( PrlVirtNet_SetBoundCardMac ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sBoundCardMac))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetBoundCardMac(sBoundCardMac);
 }
@@ -652,11 +652,11 @@ PRL_METHOD( PrlVirtNet_GetAdapterName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnAdapterNameBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetAdapterName(sAdapterName, pnAdapterNameBufLength);
 }
@@ -674,11 +674,11 @@ PRL_METHOD( PrlVirtNet_SetAdapterName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sAdapterName))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetAdapterName(sAdapterName);
 }
@@ -696,10 +696,10 @@ PRL_METHOD( PrlVirtNet_GetAdapterIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) || PRL_WRONG_PTR(pnAdapterIndex))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet || PRL_WRONG_PTR(pnAdapterIndex))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->GetAdapterIndex(pnAdapterIndex));
 }
 
@@ -716,10 +716,10 @@ PRL_METHOD( PrlVirtNet_SetAdapterIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetAdapterIndex(nAdapterIndex));
 }
 
@@ -738,11 +738,11 @@ PRL_METHOD( PrlVirtNet_GetHostIPAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnHostIPAddressBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetHostIPAddress(sHostIPAddress, pnHostIPAddressBufLength);
 }
@@ -760,11 +760,11 @@ PRL_METHOD( PrlVirtNet_SetHostIPAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sHostIPAddress))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetHostIPAddress(sHostIPAddress);
 }
@@ -784,11 +784,11 @@ PRL_METHOD( PrlVirtNet_GetHostIP6Address ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnHostIPAddressBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetHostIP6Address(sHostIPAddress, pnHostIPAddressBufLength);
 }
@@ -806,11 +806,11 @@ PRL_METHOD( PrlVirtNet_SetHostIP6Address ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sHostIPAddress))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetHostIP6Address(sHostIPAddress);
 }
@@ -830,11 +830,11 @@ PRL_METHOD( PrlVirtNet_GetDhcpIPAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnDhcpIPAddressBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetDhcpIPAddress(sDhcpIPAddress, pnDhcpIPAddressBufLength);
 }
@@ -852,11 +852,11 @@ PRL_METHOD( PrlVirtNet_SetDhcpIPAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sDhcpIPAddress))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetDhcpIPAddress(sDhcpIPAddress);
 }
@@ -876,11 +876,11 @@ PRL_METHOD( PrlVirtNet_GetDhcpIP6Address ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnDhcpIPAddressBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetDhcpIP6Address(sDhcpIPAddress, pnDhcpIPAddressBufLength);
 }
@@ -898,11 +898,11 @@ PRL_METHOD( PrlVirtNet_SetDhcpIP6Address ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sDhcpIPAddress))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetDhcpIP6Address(sDhcpIPAddress);
 }
@@ -922,11 +922,11 @@ PRL_METHOD( PrlVirtNet_GetIPNetMask ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnIPNetMaskBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetIPNetMask(sIPNetMask, pnIPNetMaskBufLength);
 }
@@ -944,11 +944,11 @@ PRL_METHOD( PrlVirtNet_SetIPNetMask ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sIPNetMask))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetIPNetMask(sIPNetMask);
 }
@@ -968,11 +968,11 @@ PRL_METHOD( PrlVirtNet_GetIP6NetMask ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnIPNetMaskBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetIP6NetMask(sIPNetMask, pnIPNetMaskBufLength);
 }
@@ -990,11 +990,11 @@ PRL_METHOD( PrlVirtNet_SetIP6NetMask ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sIPNetMask))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetIP6NetMask(sIPNetMask);
 }
@@ -1012,11 +1012,11 @@ PRL_METHOD( PrlVirtNet_GetVlanTag ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnVlanTag))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetVlanTag(pnVlanTag);
 }
@@ -1034,10 +1034,10 @@ PRL_METHOD( PrlVirtNet_SetVlanTag ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetVlanTag(nVlanTag);
 }
@@ -1057,11 +1057,11 @@ PRL_METHOD( PrlVirtNet_GetIPScopeStart ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnIPScopeStartBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetIPScopeStart(sIPScopeStart, pnIPScopeStartBufLength);
 }
@@ -1079,11 +1079,11 @@ PRL_METHOD( PrlVirtNet_SetIPScopeStart ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sIPScopeStart))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetIPScopeStart(sIPScopeStart);
 }
@@ -1103,11 +1103,11 @@ PRL_METHOD( PrlVirtNet_GetIPScopeEnd ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnIPScopeEndBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetIPScopeEnd(sIPScopeEnd, pnIPScopeEndBufLength);
 }
@@ -1125,11 +1125,11 @@ PRL_METHOD( PrlVirtNet_SetIPScopeEnd ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sIPScopeEnd))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetIPScopeEnd(sIPScopeEnd);
 }
@@ -1149,11 +1149,11 @@ PRL_METHOD( PrlVirtNet_GetIP6ScopeStart ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnIPScopeStartBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetIP6ScopeStart(sIPScopeStart, pnIPScopeStartBufLength);
 }
@@ -1171,11 +1171,11 @@ PRL_METHOD( PrlVirtNet_SetIP6ScopeStart ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sIPScopeStart))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetIP6ScopeStart(sIPScopeStart);
 }
@@ -1195,11 +1195,11 @@ PRL_METHOD( PrlVirtNet_GetIP6ScopeEnd ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(pnIPScopeEndBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->GetIP6ScopeEnd(sIPScopeEnd, pnIPScopeEndBufLength);
 }
@@ -1217,11 +1217,11 @@ PRL_METHOD( PrlVirtNet_SetIP6ScopeEnd ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) ||
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet ||
 			PRL_WRONG_PTR(sIPScopeEnd))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet );
 
 	return pVirtNet->SetIP6ScopeEnd(sIPScopeEnd);
 }
@@ -1239,10 +1239,10 @@ PRL_METHOD( PrlVirtNet_IsEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) || PRL_WRONG_PTR(pbEnabled))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet || PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->IsEnabled(pbEnabled));
 }
 
@@ -1259,10 +1259,10 @@ PRL_METHOD( PrlVirtNet_SetEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetEnabled(bEnabled));
 }
 
@@ -1279,10 +1279,10 @@ PRL_METHOD( PrlVirtNet_IsAdapterEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) || PRL_WRONG_PTR(pbEnabled))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet || PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->IsAdapterEnabled(pbEnabled));
 }
 
@@ -1299,10 +1299,10 @@ PRL_METHOD( PrlVirtNet_SetAdapterEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetAdapterEnabled(bEnabled));
 }
 
@@ -1319,10 +1319,10 @@ PRL_METHOD( PrlVirtNet_IsDHCPServerEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) || PRL_WRONG_PTR(pbEnabled))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet || PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->IsDHCPServerEnabled(pbEnabled));
 }
 
@@ -1339,10 +1339,10 @@ PRL_METHOD( PrlVirtNet_SetDHCPServerEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetDHCPServerEnabled(bEnabled));
 }
 
@@ -1359,10 +1359,10 @@ PRL_METHOD( PrlVirtNet_IsDHCP6ServerEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) || PRL_WRONG_PTR(pbEnabled))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet || PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->IsDHCP6ServerEnabled(pbEnabled));
 }
 
@@ -1379,10 +1379,10 @@ PRL_METHOD( PrlVirtNet_SetDHCP6ServerEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetDHCP6ServerEnabled(bEnabled));
 }
 
@@ -1399,10 +1399,10 @@ PRL_METHOD( PrlVirtNet_IsNATServerEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK) || PRL_WRONG_PTR(pbEnabled))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet || PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->IsNATServerEnabled(pbEnabled));
 }
 
@@ -1419,10 +1419,10 @@ PRL_METHOD( PrlVirtNet_SetNATServerEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK))
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (!pVirtNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetNATServerEnabled(bEnabled));
 }
 
@@ -1444,13 +1444,13 @@ PRL_METHOD( PrlVirtNet_GetPortForwardList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (   PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK)
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (   !pVirtNet
 		|| PRL_WRONG_PORT_FWD_TYPE(nPortFwdType)
 		|| PRL_WRONG_PTR(phPortFwdList)
 		)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->GetPortForwardList(nPortFwdType, phPortFwdList));
 }
 
@@ -1469,14 +1469,14 @@ PRL_METHOD( PrlVirtNet_SetPortForwardList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (   PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK)
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	if (   !pVirtNet
 		|| PRL_WRONG_PORT_FWD_TYPE(nPortFwdType)
 		|| ( hPortFwdList != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hPortFwdList, PHT_HANDLES_LIST) )
 		|| PRL_WRONG_HANDLES_LIST(hPortFwdList, PHT_PORT_FORWARDING)
 		)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
 	return (pVirtNet->SetPortForwardList(nPortFwdType, hPortFwdList));
 }
 
@@ -1495,14 +1495,14 @@ PRL_METHOD( PrlVirtNet_GetBoundAdapterInfo ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (   PRL_WRONG_HANDLE(hVirtNet, PHT_VIRTUAL_NETWORK)
-		|| PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG)
+	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>( hVirtNet, PHT_VIRTUAL_NETWORK );
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if (   !pVirtNet
+		|| !pSrvConfig
 		|| PRL_WRONG_PTR(phNetAdapter)
 		)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVirtNetPtr pVirtNet = PRL_OBJECT_BY_HANDLE<PrlHandleVirtNet>(hVirtNet);
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>(hSrvConfig);
 	return (pVirtNet->GetBoundAdapterInfo(pSrvConfig, phNetAdapter));
 }
 
@@ -1538,11 +1538,11 @@ PRL_METHOD( PrlPortFwd_GetRuleName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) ||
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd ||
 			PRL_WRONG_PTR(pnRuleNameBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd );
 
 	return pPortFwd->GetRuleName(sRuleName, pnRuleNameBufLength);
 }
@@ -1560,11 +1560,11 @@ PRL_METHOD( PrlPortFwd_SetRuleName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) ||
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd ||
 			PRL_WRONG_PTR(sRuleName))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd );
 
 	return pPortFwd->SetRuleName(sRuleName);
 }
@@ -1582,10 +1582,10 @@ PRL_METHOD( PrlPortFwd_GetIncomingPort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) || PRL_WRONG_PTR(pnIncomingPort))
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd || PRL_WRONG_PTR(pnIncomingPort))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>(hPortFwd);
 	return (pPortFwd->GetIncomingPort(pnIncomingPort));
 }
 
@@ -1602,10 +1602,10 @@ PRL_METHOD( PrlPortFwd_SetIncomingPort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING))
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>(hPortFwd);
 	return (pPortFwd->SetIncomingPort(nIncomingPort));
 }
 
@@ -1624,11 +1624,11 @@ PRL_METHOD( PrlPortFwd_GetRedirectIPAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) ||
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd ||
 			PRL_WRONG_PTR(pnRedirectIPAddressBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd );
 
 	return pPortFwd->GetRedirectIPAddress(sRedirectIPAddress, pnRedirectIPAddressBufLength);
 }
@@ -1646,11 +1646,11 @@ PRL_METHOD( PrlPortFwd_SetRedirectIPAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) ||
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd ||
 			PRL_WRONG_PTR(sRedirectIPAddress))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd );
 
 	return pPortFwd->SetRedirectIPAddress(sRedirectIPAddress);
 }
@@ -1668,10 +1668,10 @@ PRL_METHOD( PrlPortFwd_GetRedirectPort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) || PRL_WRONG_PTR(pnRedirectPort))
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd || PRL_WRONG_PTR(pnRedirectPort))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>(hPortFwd);
 	return (pPortFwd->GetRedirectPort(pnRedirectPort));
 }
 
@@ -1688,10 +1688,10 @@ PRL_METHOD( PrlPortFwd_SetRedirectPort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING))
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>(hPortFwd);
 	return (pPortFwd->SetRedirectPort(nRedirectPort));
 }
 
@@ -1710,11 +1710,11 @@ PRL_METHOD( PrlPortFwd_GetRedirectVm ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) ||
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd ||
 			PRL_WRONG_PTR(pnRedirectVmBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd );
 
 	return pPortFwd->GetRedirectVm(sRedirectVm, pnRedirectVmBufLength);
 }
@@ -1732,11 +1732,11 @@ PRL_METHOD( PrlPortFwd_SetRedirectVm ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPortFwd, PHT_PORT_FORWARDING) ||
+	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd, PHT_PORT_FORWARDING );
+	if (!pPortFwd ||
 			PRL_WRONG_PTR(sRedirectVm))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandlePortFwdPtr pPortFwd = PRL_OBJECT_BY_HANDLE<PrlHandlePortFwd>( hPortFwd );
 
 	return pPortFwd->SetRedirectVm(sRedirectVm);
 }
@@ -1754,9 +1754,9 @@ PRL_METHOD( PrlNetSvc_GetStatus) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_NET_SERVICE_STATUS) || PRL_WRONG_PTR(pnNetStatus) )
+	PrlHandleNetServiceStatusPtr pNetStatus = PRL_OBJECT_BY_HANDLE<PrlHandleNetServiceStatus>( handle, PHT_NET_SERVICE_STATUS );
+	if ( !pNetStatus || PRL_WRONG_PTR(pnNetStatus) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleNetServiceStatusPtr pNetStatus = PRL_OBJECT_BY_HANDLE<PrlHandleNetServiceStatus>( handle );
 	return (pNetStatus->GetStatus(pnNetStatus));
 }
 
@@ -1780,11 +1780,11 @@ PRL_METHOD( PrlOffmgmtService_GetName ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE ) ||
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pOffmgmtService ||
 			PRL_WRONG_PTR(pnNameBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService );
 
 	return pOffmgmtService->GetName(sName, pnNameBufLength);
 }
@@ -1796,11 +1796,11 @@ PRL_METHOD( PrlOffmgmtService_SetName) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE) ||
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pOffmgmtService ||
 			PRL_WRONG_PTR(sName))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService );
 
 	return pOffmgmtService->SetName(sName);
 }
@@ -1812,11 +1812,11 @@ PRL_METHOD( PrlOffmgmtService_GetPort ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE ) ||
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pOffmgmtService ||
 			PRL_WRONG_PTR(pnPort))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService );
 
 	return pOffmgmtService->GetOfflineServicePort(pnPort);
 }
@@ -1828,10 +1828,10 @@ PRL_METHOD( PrlOffmgmtService_SetPort) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE))
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pOffmgmtService)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService );
 
 	return pOffmgmtService->SetOfflineServicePort(nPort);
 }
@@ -1843,11 +1843,11 @@ PRL_METHOD( PrlOffmgmtService_IsUsedByDefault ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE ) ||
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pOffmgmtService ||
 			PRL_WRONG_PTR(pbDefault))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService );
 
 	return pOffmgmtService->IsUsedByDefault(pbDefault);
 }
@@ -1859,10 +1859,10 @@ PRL_METHOD( PrlOffmgmtService_SetUsedByDefault) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hOffmgmtService, PHT_OFFLINE_SERVICE))
+	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService, PHT_OFFLINE_SERVICE );
+	if (!pOffmgmtService)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleOfflineServicePtr pOffmgmtService = PRL_OBJECT_BY_HANDLE<PrlHandleOfflineService>( hOffmgmtService );
 
 	return pOffmgmtService->SetUsedByDefault(bDefault);
 }
@@ -1888,10 +1888,10 @@ PRL_METHOD( PrlNetworkClass_GetClassId ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkClass, PHT_NETWORK_CLASS))
+	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>( hNetworkClass, PHT_NETWORK_CLASS );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>(hNetworkClass);
 
 	return pEntry->GetClassId(pnClassId);
 }
@@ -1903,10 +1903,10 @@ PRL_METHOD( PrlNetworkClass_SetClassId ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkClass, PHT_NETWORK_CLASS))
+	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>( hNetworkClass, PHT_NETWORK_CLASS );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>(hNetworkClass);
 
 	return pEntry->SetClassId(nClassId);
 }
@@ -1918,10 +1918,10 @@ PRL_METHOD( PrlNetworkClass_GetNetworkList ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkClass, PHT_NETWORK_CLASS))
+	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>( hNetworkClass, PHT_NETWORK_CLASS );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>(hNetworkClass);
 
 	return pEntry->GetNetworkList(phNetworkList);
 }
@@ -1933,11 +1933,11 @@ PRL_METHOD( PrlNetworkClass_SetNetworkList ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkClass, PHT_NETWORK_CLASS) ||
+	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>( hNetworkClass, PHT_NETWORK_CLASS );
+	if ( !pEntry ||
 	     PRL_WRONG_HANDLE(hNetworkList, PHT_STRINGS_LIST))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkClassPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkClass>(hNetworkClass);
 
 	return pEntry->SetNetworkList(hNetworkList);
 }
@@ -1964,10 +1964,10 @@ PRL_METHOD( PrlNetworkShapingEntry_GetClassId ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->GetClassId(pnClassId);
 }
@@ -1979,10 +1979,10 @@ PRL_METHOD( PrlNetworkShapingEntry_SetClassId ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->SetClassId(nClassId);
 }
@@ -1994,10 +1994,10 @@ PRL_METHOD( PrlNetworkShapingEntry_GetTotalRate ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->GetTotalRate(pnTotalRate);
 }
@@ -2009,10 +2009,10 @@ PRL_METHOD( PrlNetworkShapingEntry_SetTotalRate ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->SetTotalRate(nTotalRate);
 }
@@ -2024,11 +2024,11 @@ PRL_METHOD( PrlNetworkShapingEntry_SetDevice ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING) ||
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry ||
 		PRL_WRONG_PTR(sDev))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->SetDevice(sDev);
 }
@@ -2041,10 +2041,10 @@ PRL_METHOD( PrlNetworkShapingEntry_GetDevice ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->GetDevice(sDev, pnBufLength);
 }
@@ -2056,10 +2056,10 @@ PRL_METHOD( PrlNetworkShapingEntry_SetRate ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->SetRate(nRate);
 }
@@ -2071,10 +2071,10 @@ PRL_METHOD( PrlNetworkShapingEntry_GetRate ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	return pEntry->GetRate(pnRate);
 }
@@ -2086,10 +2086,10 @@ PRL_METHOD( PrlNetworkShapingEntry_SetRateMPU ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING))
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	pEntry->SetRateMPU(nRateMPU);
 	return PRL_ERR_SUCCESS;
@@ -2102,11 +2102,11 @@ PRL_METHOD( PrlNetworkShapingEntry_GetRateMPU ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hNetworkShapingEntry, PHT_NETWORK_SHAPING) ||
+	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>( hNetworkShapingEntry, PHT_NETWORK_SHAPING );
+	if ( !pEntry ||
 		PRL_WRONG_PTR(pnRateMPU) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShaping>(hNetworkShapingEntry);
 
 	*pnRateMPU = pEntry->GetRateMPU();
 	return PRL_ERR_SUCCESS;
@@ -2125,11 +2125,10 @@ PRL_METHOD( PrlNetworkShapingConfig_IsEnabled ) (
 		pbEnabled
 	);
 
-	if (PRL_WRONG_HANDLE(hConfig, PHT_NETWORK_SHAPING_CONFIG))
-		return PRL_ERR_INVALID_ARG;
-
 	PrlHandleNetworkShapingConfigPtr pNetworkShapingConfig =
-		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig );
+		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig, PHT_NETWORK_SHAPING_CONFIG );
+	if (!pNetworkShapingConfig)
+		return PRL_ERR_INVALID_ARG;
 
 	return pNetworkShapingConfig->IsEnabled(pbEnabled);
 }
@@ -2147,11 +2146,10 @@ PRL_METHOD( PrlNetworkShapingConfig_SetEnabled ) (
 		bEnabled
 	);
 
-	if (PRL_WRONG_HANDLE(hConfig, PHT_NETWORK_SHAPING_CONFIG))
-		return PRL_ERR_INVALID_ARG;
-
 	PrlHandleNetworkShapingConfigPtr pNetworkShapingConfig =
-		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig );
+		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig, PHT_NETWORK_SHAPING_CONFIG );
+	if (!pNetworkShapingConfig)
+		return PRL_ERR_INVALID_ARG;
 
 	return pNetworkShapingConfig->SetEnabled(bEnabled);
 }
@@ -2169,11 +2167,10 @@ PRL_METHOD( PrlNetworkShapingConfig_GetNetworkShapingList ) (
 		phList
 	);
 
-	if (PRL_WRONG_HANDLE(hConfig, PHT_NETWORK_SHAPING_CONFIG))
-		return PRL_ERR_INVALID_ARG;
-
 	PrlHandleNetworkShapingConfigPtr pNetworkShapingConfig =
-		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig );
+		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig, PHT_NETWORK_SHAPING_CONFIG );
+	if (!pNetworkShapingConfig)
+		return PRL_ERR_INVALID_ARG;
 
 	return pNetworkShapingConfig->GetNetworkShapingList(phList);
 }
@@ -2191,11 +2188,10 @@ PRL_METHOD( PrlNetworkShapingConfig_SetNetworkShapingList ) (
 		hList
 	);
 
-	if (PRL_WRONG_HANDLE(hConfig, PHT_NETWORK_SHAPING_CONFIG))
-		return PRL_ERR_INVALID_ARG;
-
 	PrlHandleNetworkShapingConfigPtr pNetworkShapingConfig =
-		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig );
+		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig, PHT_NETWORK_SHAPING_CONFIG );
+	if (!pNetworkShapingConfig)
+		return PRL_ERR_INVALID_ARG;
 
 	return pNetworkShapingConfig->SetNetworkShapingList(hList);
 }
@@ -2213,11 +2209,10 @@ PRL_METHOD( PrlNetworkShapingConfig_GetNetworkDeviceBandwidthList ) (
 		phList
 	);
 
-	if (PRL_WRONG_HANDLE(hConfig, PHT_NETWORK_SHAPING_CONFIG))
-		return PRL_ERR_INVALID_ARG;
-
 	PrlHandleNetworkShapingConfigPtr pNetworkShapingConfig =
-		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig );
+		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig, PHT_NETWORK_SHAPING_CONFIG );
+	if (!pNetworkShapingConfig)
+		return PRL_ERR_INVALID_ARG;
 
 	return pNetworkShapingConfig->GetNetworkDeviceBandwidthList(phList);
 }
@@ -2235,11 +2230,10 @@ PRL_METHOD( PrlNetworkShapingConfig_SetNetworkDeviceBandwidthList ) (
 		hList
 	);
 
-	if (PRL_WRONG_HANDLE(hConfig, PHT_NETWORK_SHAPING_CONFIG))
-		return PRL_ERR_INVALID_ARG;
-
 	PrlHandleNetworkShapingConfigPtr pNetworkShapingConfig =
-		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig );
+		PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingConfig>( hConfig, PHT_NETWORK_SHAPING_CONFIG );
+	if (!pNetworkShapingConfig)
+		return PRL_ERR_INVALID_ARG;
 
 	return pNetworkShapingConfig->SetNetworkDeviceBandwidthList(hList);
 }
@@ -2266,11 +2260,11 @@ PRL_METHOD( PrlNetworkShapingBandwidthEntry_SetDevice ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH) ||
+	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>( hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH );
+	if ( !pEntry ||
 		PRL_WRONG_PTR(sDev))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>(hDeviceEntry);
 
 	return pEntry->SetDevice(sDev);
 }
@@ -2283,10 +2277,10 @@ PRL_METHOD( PrlNetworkShapingBandwidthEntry_GetDevice ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH))
+	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>( hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>(hDeviceEntry);
 
 	return pEntry->GetDevice(sDev, pnBufLength);
 }
@@ -2298,10 +2292,10 @@ PRL_METHOD( PrlNetworkShapingBandwidthEntry_SetBandwidth ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH))
+	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>( hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>(hDeviceEntry);
 
 	return pEntry->SetBandwidth(nBandwidth);
 }
@@ -2313,10 +2307,10 @@ PRL_METHOD( PrlNetworkShapingBandwidthEntry_GetBandwidth ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH))
+	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>( hDeviceEntry, PHT_NETWORK_SHAPING_BANDWIDTH );
+	if ( !pEntry)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkShapingBandwidthPtr pEntry = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkShapingBandwidth>(hDeviceEntry);
 
 	return pEntry->GetBandwidth(pnBandwidth);
 }
@@ -2344,11 +2338,11 @@ PRL_METHOD( PrlNetworkRate_GetClassId ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetworkRate, PHT_NETWORK_RATE) ||
+	PrlHandleNetworkRatePtr pRate = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkRate>( hNetworkRate, PHT_NETWORK_RATE );
+	if (!pRate ||
 	    PRL_WRONG_PTR(pnClass))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkRatePtr pRate = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkRate>(hNetworkRate);
 
 	return pRate->GetClass(pnClass);
 }
@@ -2360,11 +2354,11 @@ PRL_METHOD( PrlNetworkRate_GetRate ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hNetworkRate, PHT_NETWORK_RATE) ||
+	PrlHandleNetworkRatePtr pRate = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkRate>( hNetworkRate, PHT_NETWORK_RATE );
+	if (!pRate ||
 	    PRL_WRONG_PTR(pnRate))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleNetworkRatePtr pRate = PRL_OBJECT_BY_HANDLE<PrlHandleNetworkRate>(hNetworkRate);
 
 	return pRate->GetRate(pnRate);
 }
@@ -2401,11 +2395,11 @@ PRL_METHOD( PrlIPPrivNet_GetName ) (
 		pnNameBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET) ||
+	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet, PHT_IPPRIV_NET );
+	if (!pIPPrivNet ||
 		PRL_WRONG_PTR(pnNameBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet );
 
 	return pIPPrivNet->GetName(sName, pnNameBufLength);
 }
@@ -2423,11 +2417,11 @@ PRL_METHOD( PrlIPPrivNet_SetName ) (
 		sName
 	);
 
-	if (PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET) ||
+	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet, PHT_IPPRIV_NET );
+	if (!pIPPrivNet ||
 		PRL_WRONG_PTR(sName))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet );
 
 	return pIPPrivNet->SetName(sName);
 }
@@ -2445,12 +2439,12 @@ PRL_METHOD( PrlIPPrivNet_SetNetAddresses ) (
 		hNetAddresses
 	);
 
-	if (PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET) ||
-		(PRL_INVALID_HANDLE != hNetAddresses && PRL_WRONG_HANDLE(hNetAddresses, PHT_STRINGS_LIST)))
+	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet, PHT_IPPRIV_NET );
+	PrlHandleStringsListPtr pNetAddressesList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hNetAddresses, PHT_STRINGS_LIST );
+	if (!pIPPrivNet ||
+		(PRL_INVALID_HANDLE != hNetAddresses && !pNetAddressesList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet );
-	PrlHandleStringsListPtr pNetAddressesList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hNetAddresses);
 	return (pIPPrivNet->SetNetAddresses(pNetAddressesList.getHandle() ?
 				pNetAddressesList->GetStringsList() : QStringList()));
 }
@@ -2468,11 +2462,11 @@ PRL_METHOD( PrlIPPrivNet_GetNetAddresses ) (
 		phNetAddresses
 	);
 
-	if (PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET) ||
+	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet, PHT_IPPRIV_NET );
+	if (!pIPPrivNet ||
 		PRL_WRONG_PTR(phNetAddresses))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet );
 
 	return pIPPrivNet->GetNetAddresses(phNetAddresses);
 }
@@ -2490,11 +2484,11 @@ PRL_METHOD( PrlIPPrivNet_IsGlobal ) (
 		pbGlobal
 	);
 
-	if (PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET) ||
+	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet, PHT_IPPRIV_NET );
+	if (!pIPPrivNet ||
 		PRL_WRONG_PTR(pbGlobal))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet );
 
 	return pIPPrivNet->IsGlobal(pbGlobal);
 }
@@ -2512,10 +2506,10 @@ PRL_METHOD( PrlIPPrivNet_SetGlobal ) (
 		bGlobal
 	);
 
-	if (PRL_WRONG_HANDLE(hPrivNet, PHT_IPPRIV_NET))
+	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet, PHT_IPPRIV_NET );
+	if (!pIPPrivNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleIPPrivNetPtr pIPPrivNet = PRL_OBJECT_BY_HANDLE<PrlHandleIPPrivNet>( hPrivNet );
 
 	return pIPPrivNet->SetGlobal(bGlobal);
 }
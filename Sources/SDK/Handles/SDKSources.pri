@@ -80,6 +80,11 @@ HEADERS += $${INSTALL_HEADERS} \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlCommon.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlContextSwitcher.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleBase.h \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlHandlesTable.h \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlJobsWaiter.h \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlUuidKey.h \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlUuidMap.h \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlRequestsPerf.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleJob.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleLocalJob.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleResult.h \
@@ -96,12 +101,18 @@ HEADERS += $${INSTALL_HEADERS} \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlProblemReportAssembler.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlProblemReportSender.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleVmEvent.h \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlLazyVmEvent.h \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlEventsFilter.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlErrStringsStorage.h \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlControlValidity.h \
 	\
 	$$SRC_LEVEL/SDK/Handles/Disp/PveControl.h \
+	$$SRC_LEVEL/SDK/Handles/Disp/PveChannel.h \
+	$$SRC_LEVEL/SDK/Handles/Disp/PveCompression.h \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlCheckServerHelper.h \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlEventsHandler.h \
+	$$SRC_LEVEL/SDK/Handles/Disp/PrlEventBatchThread.h \
+	$$SRC_LEVEL/SDK/Handles/Disp/PrlHandleEventQueue.h \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlQuestionsList.h \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlHandleServer.h \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlHandleServerDisp.h \
@@ -128,6 +139,10 @@ SOURCES += \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlCommon.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlApiCore.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleBase.cpp \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlHandlesTable.cpp \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlJobsWaiter.cpp \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlUuidKey.cpp \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlRequestsPerf.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleJob.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleLocalJob.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleResult.cpp \
@@ -144,14 +159,20 @@ SOURCES += \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlProblemReportAssembler.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlProblemReportSender.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlHandleVmEvent.cpp \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlLazyVmEvent.cpp \
+	$$SRC_LEVEL/SDK/Handles/Core/PrlEventsFilter.cpp \
 	$$SRC_LEVEL/SDK/Handles/Core/PrlErrStringsStorage.cpp\
 	$$SRC_LEVEL/SDK/Handles/Core/PrlErrStringsStorage_PS.cpp\
 	$$SRC_LEVEL/SDK/Handles/Core/PrlControlValidity.cpp\
 	\
 	$$SRC_LEVEL/SDK/Handles/Disp/PveControl.cpp \
+	$$SRC_LEVEL/SDK/Handles/Disp/PveChannel.cpp \
+	$$SRC_LEVEL/SDK/Handles/Disp/PveCompression.cpp \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlApiDisp.cpp \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlCheckServerHelper.cpp \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlEventsHandler.cpp \
+	$$SRC_LEVEL/SDK/Handles/Disp/PrlEventBatchThread.cpp \
+	$$SRC_LEVEL/SDK/Handles/Disp/PrlHandleEventQueue.cpp \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlQuestionsList.cpp \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlHandleServer.cpp \
 	$$SRC_LEVEL/SDK/Handles/Disp/PrlHandleServerDisp.cpp \
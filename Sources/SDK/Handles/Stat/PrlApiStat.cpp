@@ -56,7 +56,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetStatistics ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_STATISTICS)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetStatistics, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetStatistics, (hServer))
 }
 
 PRL_HANDLE PrlSrv_SubscribeToHostStatistics_Impl(PRL_HANDLE hServer)
@@ -69,7 +69,7 @@ PRL_ASYNC_METHOD( PrlSrv_SubscribeToHostStatistics ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_SUBSCRIBE_TO_HOST_STATISTICS)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SubscribeToHostStatistics, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SubscribeToHostStatistics, (hServer))
 }
 
 PRL_HANDLE PrlSrv_UnsubscribeFromHostStatistics_Impl(PRL_HANDLE hServer)
@@ -82,14 +82,14 @@ PRL_ASYNC_METHOD( PrlSrv_UnsubscribeFromHostStatistics ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UNSUBSCRIBE_FROM_HOST_STATISTICS)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UnsubscribeFromHostStatistics, (hServer))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UnsubscribeFromHostStatistics, (hServer))
 }
 
 // Perfomace statistics methods
 PRL_HANDLE PrlSrv_SubscribeToPerfStats_Impl(PRL_HANDLE handle, PRL_CONST_STR sFilter)
 {
-	PRL_CntxSw_CHECK_HANDLE_ASYNC(handle, PHT_SERVER, PJOC_SRV_SUBSCRIBE_PERFSTATS) ;
-	return store_result(PRL_OBJECT_BY_HANDLE<PrlHandleServerStat>(handle)->SubscribePerfStats(sFilter)) ;
+	PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(PrlHandleServerStat, pServer, handle, PHT_SERVER, PJOC_SRV_SUBSCRIBE_PERFSTATS) ;
+	return store_result(pServer->SubscribePerfStats(sFilter)) ;
 }
 
 /*
@@ -98,31 +98,31 @@ PRL_HANDLE PrlSrv_SubscribeToPerfStats_Impl(PRL_HANDLE handle, PRL_CONST_STR sFi
 PRL_ASYNC_METHOD( PrlSrv_SubscribeToPerfStats ) (PRL_HANDLE hServer, PRL_CONST_STR sFilter)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_SUBSCRIBE_PERFSTATS) ;
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_SubscribeToPerfStats, (hServer, sFilter)) ;
+    CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_SubscribeToPerfStats, (hServer, sFilter)) ;
 }
 
 PRL_HANDLE PrlSrv_UnsubscribeFromPerfStats_Impl(PRL_HANDLE handle)
 {
-	PRL_CntxSw_CHECK_HANDLE_ASYNC(handle, PHT_SERVER, PJOC_SRV_UNSUBSCRIBE_PERFSTATS) ;
-	return store_result(PRL_OBJECT_BY_HANDLE<PrlHandleServerStat>(handle)->UnsubscribePerfStats()) ;
+	PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(PrlHandleServerStat, pServer, handle, PHT_SERVER, PJOC_SRV_UNSUBSCRIBE_PERFSTATS) ;
+	return store_result(pServer->UnsubscribePerfStats()) ;
 }
 
 PRL_ASYNC_METHOD( PrlSrv_UnsubscribeFromPerfStats ) (PRL_HANDLE hServer)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_UNSUBSCRIBE_PERFSTATS) ;
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_UnsubscribeFromPerfStats, (hServer)) ;
+    CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_UnsubscribeFromPerfStats, (hServer)) ;
 }
 
 PRL_HANDLE PrlSrv_GetPerfStats_Impl(PRL_HANDLE handle, PRL_CONST_STR sFilter)
 {
-	PRL_CntxSw_CHECK_HANDLE_ASYNC(handle, PHT_SERVER, PJOC_SRV_GET_PERFSTATS) ;
-	return store_result(PRL_OBJECT_BY_HANDLE<PrlHandleServerStat>(handle)->GetPerfStats(sFilter)) ;
+	PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(PrlHandleServerStat, pServer, handle, PHT_SERVER, PJOC_SRV_GET_PERFSTATS) ;
+	return store_result(pServer->GetPerfStats(sFilter)) ;
 }
 
 PRL_ASYNC_METHOD( PrlSrv_GetPerfStats ) (PRL_HANDLE hServer, PRL_CONST_STR sFilter)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_PERFSTATS) ;
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetPerfStats, (hServer, sFilter)) ;
+    CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetPerfStats, (hServer, sFilter)) ;
 }
 
 PRL_METHOD( PrlStat_GetTotalRamSize) (
@@ -138,9 +138,9 @@ PRL_METHOD( PrlStat_GetTotalRamSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetTotalRamSize(pnSize));
 }
 
@@ -157,9 +157,9 @@ PRL_METHOD( PrlStat_GetUsageRamSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetUsageRamSize(pnSize));
 }
 
@@ -176,9 +176,9 @@ PRL_METHOD( PrlStat_GetFreeRamSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetFreeRamSize(pnSize));
 }
 
@@ -195,9 +195,9 @@ PRL_METHOD( PrlStat_GetRealRamSize) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnSize) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnSize) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetRealRamSize(pnSize));
 }
 
@@ -214,9 +214,9 @@ PRL_METHOD( PrlStat_GetOsUptime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnUptime) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnUptime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetOsUptime(pnUptime));
 }
 
@@ -233,9 +233,9 @@ PRL_METHOD( PrlStat_GetCpusStatsCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(pnCount) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(pnCount) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetCpusStatsCount(pnCount));
 }
 
@@ -254,9 +254,9 @@ PRL_METHOD( PrlStat_GetCpuStat) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hStat, PHT_SYSTEM_STATISTICS) || PRL_WRONG_PTR(phCpuStat) )
+	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat, PHT_SYSTEM_STATISTICS );
+	if ( !pSystemStatistics || PRL_WRONG_PTR(phCpuStat) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsPtr pSystemStatistics = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatistics>( hStat );
 	return (pSystemStatistics->GetCpuStat(nIndex, phCpuStat));
 }
 
@@ -273,9 +273,9 @@ PRL_METHOD( PrlStatCpu_GetCpuUsage) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hCpuStat, PHT_SYSTEM_STATISTICS_CPU) || PRL_WRONG_PTR(pnPercents) )
+	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat, PHT_SYSTEM_STATISTICS_CPU );
+	if ( !pSystemStatisticsCpu || PRL_WRONG_PTR(pnPercents) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat );
 	return (pSystemStatisticsCpu->GetCpuUsage(pnPercents));
 }
 
@@ -292,9 +292,9 @@ PRL_METHOD( PrlStatCpu_GetTotalTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hCpuStat, PHT_SYSTEM_STATISTICS_CPU) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat, PHT_SYSTEM_STATISTICS_CPU );
+	if ( !pSystemStatisticsCpu || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat );
 	return (pSystemStatisticsCpu->GetTotalTime(pnTime));
 }
 
@@ -311,9 +311,9 @@ PRL_METHOD( PrlStatCpu_GetUserTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hCpuStat, PHT_SYSTEM_STATISTICS_CPU) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat, PHT_SYSTEM_STATISTICS_CPU );
+	if ( !pSystemStatisticsCpu || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat );
 	return (pSystemStatisticsCpu->GetUserTime(pnTime));
 }
 
@@ -330,9 +330,9 @@ PRL_METHOD( PrlStatCpu_GetSystemTime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hCpuStat, PHT_SYSTEM_STATISTICS_CPU) || PRL_WRONG_PTR(pnTime) )
+	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat, PHT_SYSTEM_STATISTICS_CPU );
+	if ( !pSystemStatisticsCpu || PRL_WRONG_PTR(pnTime) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleSystemStatisticsCpuPtr pSystemStatisticsCpu = PRL_OBJECT_BY_HANDLE<PrlHandleSystemStatisticsCpu>( hCpuStat );
 	return (pSystemStatisticsCpu->GetSystemTime(pnTime));
 }
 
@@ -83,10 +83,10 @@ struct assert_PHT_VM_CONFIGURATION_not_equal_PHT_VIRTUAL_MACHINE
 
 PRL_RESULT PrlSrv_CreateVm_Impl(PRL_HANDLE hServer, PRL_HANDLE_PTR phVm)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(phVm) )
+	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(phVm) )
 		RETURN_RES(PRL_ERR_INVALID_ARG)
 
-	PrlHandleServerPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>(hServer);
 	PrlHandleVm *pVm = new PrlHandleVm(pServer);
 
 	if (!pVm)
@@ -101,7 +101,7 @@ PRL_METHOD( PrlSrv_CreateVm) (
 							  )
 {
 	SYNC_CHECK_API_INITIALIZED
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_CreateVm, (hServer, phVm))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_CreateVm, (hServer, phVm))
 }
 
 PRL_METHOD( PrlVm_RegEventHandler ) (
@@ -123,6 +123,30 @@ PRL_METHOD( PrlVm_UnregEventHandler ) (
 	return PrlHandle_UnregEventHandler(hObj, handler, userData);
 }
 
+PRL_METHOD( PrlVm_SetEventFilter ) (
+		PRL_HANDLE hVm,
+		PRL_HANDLE hEventTypesList,
+		PRL_UINT32 nFlags
+		)
+{
+	LOG_MESSAGE( DBG_DEBUG, "%s (hVm=%.8X, hEventTypesList=%.8X, nFlags=%.8X)",
+		__FUNCTION__,
+		hVm,
+		hEventTypesList,
+		nFlags
+		);
+
+	SYNC_CHECK_API_INITIALIZED
+
+	PrlHandleVmPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVm>( hVm, PHT_VIRTUAL_MACHINE );
+	PrlHandleOpTypeListPtr pEventTypes = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hEventTypesList, PHT_OPAQUE_TYPE_LIST );
+	if ( !pVm
+		|| (PRL_INVALID_HANDLE != hEventTypesList && !pEventTypes) )
+		return (PRL_ERR_INVALID_ARG);
+
+	return (pVm->GetEventsFilter().SetFilter(pEventTypes.getHandle(), NULL));
+}
+
 PRL_ASYNC_METHOD( PrlVm_Connect ) (
 		PRL_HANDLE hObj,
 		PRL_UINT32 nFlags
@@ -222,9 +246,9 @@ PRL_METHOD( PrlApi_GetDefaultOsVersion ) (
 
 PRL_HANDLE PrlSrv_RegisterVm_Impl(PRL_HANDLE hServer, PRL_CONST_STR strVmDirPath, PRL_BOOL bNonInteractiveMode)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(strVmDirPath) )
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(strVmDirPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REGISTER_VM))
-		PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->RegisterVm(strVmDirPath, bNonInteractiveMode);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -238,14 +262,14 @@ PRL_ASYNC_METHOD( PrlSrv_RegisterVm ) (
 									   )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REGISTER_VM)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_RegisterVm, (hServer, strVmDirPath, bNonInteractiveMode ))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_RegisterVm, (hServer, strVmDirPath, bNonInteractiveMode ))
 }
 
 PRL_HANDLE PrlSrv_RegisterVmEx_Impl(PRL_HANDLE hServer, PRL_CONST_STR strVmDirPath, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(strVmDirPath) )
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(strVmDirPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REGISTER_VM_EX))
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->RegisterVmEx(strVmDirPath, NULL, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -266,18 +290,18 @@ PRL_ASYNC_METHOD( PrlSrv_RegisterVmEx ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REGISTER_VM_EX)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_RegisterVmEx, (hServer, strVmDirPath, nFlags ))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_RegisterVmEx, (hServer, strVmDirPath, nFlags ))
 }
 
 PRL_HANDLE PrlSrv_RegisterVmWithUuid_Impl(PRL_HANDLE hServer, PRL_CONST_STR strVmDirPath,
 			PRL_CONST_STR strVmUuid, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(strVmDirPath) )
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(strVmDirPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REGISTER_VM))
 	if (strVmUuid == NULL || !Uuid::isUuid(QString(strVmUuid)))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REGISTER_VM))
 
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->RegisterVmEx(strVmDirPath, strVmUuid, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -293,15 +317,15 @@ PRL_ASYNC_METHOD( PrlSrv_RegisterVmWithUuid ) (
 {
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REGISTER_VM)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_RegisterVmWithUuid, (	hServer, strVmDirPath, strVmUuid, nFlags ))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_RegisterVmWithUuid, (	hServer, strVmDirPath, strVmUuid, nFlags ))
 }
 
 PRL_HANDLE PrlSrv_Register3rdPartyVm_Impl(PRL_HANDLE hServer, PRL_CONST_STR strVmConfigPath, PRL_CONST_STR strVmRootDirPath, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(strVmConfigPath) )
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(strVmConfigPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REGISTER_3RD_PARTY_VM))
 
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->Register3rdPartyVm(strVmConfigPath, strVmRootDirPath, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -324,7 +348,7 @@ PRL_ASYNC_METHOD( PrlSrv_Register3rdPartyVm ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REGISTER_3RD_PARTY_VM)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_Register3rdPartyVm, (hServer, strVmConfigPath, strVmRootDirPath, nFlags ))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_Register3rdPartyVm, (hServer, strVmConfigPath, strVmRootDirPath, nFlags ))
 }
 
 PRL_HANDLE PrlSrv_GetVmList_Impl(PRL_HANDLE hServer, PRL_UINT32 nFlags)
@@ -345,7 +369,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetVmListEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_VM_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetVmList, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetVmList, (hServer, nFlags))
 }
 
 PRL_HANDLE PrlVm_Clone_Impl(PRL_HANDLE hVm,
@@ -354,12 +378,12 @@ PRL_HANDLE PrlVm_Clone_Impl(PRL_HANDLE hVm,
 		PRL_CONST_STR new_vm_config_path,
 		PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm ||
 			PRL_WRONG_PTR(new_vm_name) ||
 			PRL_WRONG_PTR(new_vm_uuid) ||
 			PRL_WRONG_PTR(new_vm_config_path) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_CLONE))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Clone(new_vm_name, new_vm_uuid, new_vm_config_path, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -380,16 +404,15 @@ PRL_ASYNC_METHOD( PrlVm_CloneEx ) (
 PRL_HANDLE PrlVm_Delete_Impl(PRL_HANDLE hVm,PRL_HANDLE hDevicesList)
 {
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE)
-		|| (hDevicesList != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hDevicesList, PHT_STRINGS_LIST)) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hDevicesList, PHT_STRINGS_LIST );
+	if ( !pVm
+		|| (hDevicesList != PRL_INVALID_HANDLE && !pStringsList) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_DELETE))
 
-		PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	if (!pVm->GetServer())
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_DELETE))
 
-		PrlHandleStringsListPtr pStringsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hDevicesList);
-
 	PrlHandleJobPtr pJob = pVm->Delete(
 		hDevicesList != PRL_INVALID_HANDLE ? pStringsList->GetStringsList() : QStringList());
 	if (!pJob)
@@ -404,7 +427,7 @@ PRL_ASYNC_METHOD( PrlVm_Delete ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_DELETE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Delete, (hVm,hDevicesList))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Delete, (hVm,hDevicesList))
 }
 
 PRL_HANDLE PrlVm_GetProblemReport_Impl(PRL_HANDLE hVm)
@@ -417,7 +440,7 @@ PRL_ASYNC_METHOD( PrlVm_GetProblemReport ) (
 								  )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_PROBLEM_REPORT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetProblemReport, (hVm))
+		CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_GetProblemReport, (hVm))
 }
 
 PRL_HANDLE PrlVm_GetPackedProblemReport_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -431,7 +454,7 @@ PRL_ASYNC_METHOD( PrlVm_GetPackedProblemReport ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_PACKED_PROBLEM_REPORT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetPackedProblemReport, (hVm,nFlags))
+		CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_GetPackedProblemReport, (hVm,nFlags))
 }
 
 PRL_ASYNC_METHOD( PrlVm_Clone ) (
@@ -464,9 +487,9 @@ PRL_HANDLE PrlVm_GenerateVmDevFilename_Impl(
 	PRL_CONST_STR sIndexDelimiter
 	)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_GENERATE_VM_DEV_FILENAME))
-		PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->GenerateVmDevFilename(sFilenamePrefix, sFilenameSuffix, sIndexDelimiter);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -482,7 +505,7 @@ PRL_ASYNC_METHOD( PrlVm_GenerateVmDevFilename ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GENERATE_VM_DEV_FILENAME)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GenerateVmDevFilename,\
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_GenerateVmDevFilename,\
 								(hVm, sFilenamePrefix, sFilenameSuffix, sIndexDelimiter))
 }
 
@@ -503,7 +526,7 @@ PRL_ASYNC_METHOD( PrlVm_ChangeSid ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_CHANGE_SID)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_ChangeSid, (hVm, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_ChangeSid, (hVm, nFlags))
 }
 
 PRL_HANDLE PrlVm_ResetUptime_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -523,7 +546,7 @@ PRL_ASYNC_METHOD( PrlVm_ResetUptime) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_RESET_UPTIME)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_ResetUptime, (hVm, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_ResetUptime, (hVm, nFlags))
 }
 
 PRL_HANDLE PrlVm_Start_Impl(PRL_HANDLE hVm)
@@ -536,7 +559,7 @@ PRL_ASYNC_METHOD( PrlVm_Start ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_START)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Start, (hVm))
+	CALL_DIRECT(hVm, PrlVm_Start, (hVm))
 }
 
 PRL_ASYNC_METHOD( PrlVm_Resume ) (
@@ -548,9 +571,9 @@ PRL_ASYNC_METHOD( PrlVm_Resume ) (
 
 PRL_HANDLE PrlVm_StartEx_Impl(PRL_HANDLE hVm, PRL_UINT32 nStartMode, PRL_UINT32 nReserved)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || nStartMode > PSM_VM_START_LAST_ITEM )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || nStartMode > PSM_VM_START_LAST_ITEM )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_START_EX))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->StartEx(nStartMode, nReserved);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -565,7 +588,7 @@ PRL_ASYNC_METHOD( PrlVm_StartEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_START_EX)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_StartEx, (hVm, nStartMode, nReserved))
+	CALL_DIRECT(hVm, PrlVm_StartEx, (hVm, nStartMode, nReserved))
 }
 
 PRL_HANDLE PrlVm_StartVncServer_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -585,7 +608,7 @@ PRL_ASYNC_METHOD( PrlVm_StartVncServer ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_START_VNC_SERVER)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_StartVncServer, (hVm, nReserved))
+	CALL_DIRECT(hVm, PrlVm_StartVncServer, (hVm, nReserved))
 }
 
 PRL_HANDLE PrlVm_StopVncServer_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -605,7 +628,7 @@ PRL_ASYNC_METHOD( PrlVm_StopVncServer ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_STOP_VNC_SERVER)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_StopVncServer, (hVm, nReserved))
+	CALL_DIRECT(hVm, PrlVm_StopVncServer, (hVm, nReserved))
 }
 
 PRL_HANDLE PrlVm_Lock_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -625,7 +648,7 @@ PRL_ASYNC_METHOD( PrlVm_Lock ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_LOCK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Lock, (hVm, nReserved))
+	CALL_DIRECT(hVm, PrlVm_Lock, (hVm, nReserved))
 }
 
 PRL_HANDLE PrlVm_Unlock_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -645,7 +668,7 @@ PRL_ASYNC_METHOD( PrlVm_Unlock ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UNLOCK)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Unlock, (hVm, nReserved))
+	CALL_DIRECT(hVm, PrlVm_Unlock, (hVm, nReserved))
 }
 
 PRL_HANDLE PrlVm_Restart_Impl(PRL_HANDLE hVm)
@@ -658,7 +681,7 @@ PRL_ASYNC_METHOD( PrlVm_Restart ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_RESTART)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Restart, (hVm))
+	CALL_DIRECT(hVm, PrlVm_Restart, (hVm))
 }
 
 PRL_HANDLE PrlVm_Unreg_Impl(PRL_HANDLE hVm)
@@ -671,7 +694,7 @@ PRL_ASYNC_METHOD( PrlVm_Unreg ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UNREG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Unreg, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Unreg, (hVm))
 }
 
 PRL_HANDLE PrlVm_Restore_Impl(PRL_HANDLE hVm)
@@ -684,7 +707,7 @@ PRL_ASYNC_METHOD( PrlVm_Restore ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_RESTORE)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Restore, (hVm))
+		CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Restore, (hVm))
 }
 
 PRL_HANDLE PrlVm_SubscribeToGuestStatistics_Impl(PRL_HANDLE hVm)
@@ -697,7 +720,7 @@ PRL_ASYNC_METHOD( PrlVm_SubscribeToGuestStatistics ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_SUBSCRIBE_TO_GUEST_STATISTICS)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_SubscribeToGuestStatistics, (hVm))
+	CALL_DIRECT(hVm, PrlVm_SubscribeToGuestStatistics, (hVm))
 }
 
 PRL_HANDLE PrlVm_UnsubscribeFromGuestStatistics_Impl(PRL_HANDLE hVm)
@@ -710,14 +733,14 @@ PRL_ASYNC_METHOD( PrlVm_UnsubscribeFromGuestStatistics ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UNSUBSCRIBE_FROM_GUEST_STATISTICS)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_UnsubscribeFromGuestStatistics, (hVm))
+	CALL_DIRECT(hVm, PrlVm_UnsubscribeFromGuestStatistics, (hVm))
 }
 
 PRL_HANDLE PrlVm_Stop_Impl(PRL_HANDLE hVm, PRL_BOOL bAcpi)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_STOP))
-		PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Stop(bAcpi ? PSM_SHUTDOWN : PSM_KILL, 0);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -731,7 +754,7 @@ PRL_ASYNC_METHOD( PrlVm_Stop ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_STOP)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Stop, (hVm, bAcpi))
+	CALL_DIRECT(hVm, PrlVm_Stop, (hVm, bAcpi))
 }
 
 PRL_HANDLE PrlVm_StopEx_Impl(PRL_HANDLE hVm,
@@ -739,10 +762,10 @@ PRL_HANDLE PrlVm_StopEx_Impl(PRL_HANDLE hVm,
 		PRL_UINT32 nFlags
 		)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm ||
 	     nStopMode > PSM_LAST)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_STOP))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Stop(nStopMode, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -757,14 +780,14 @@ PRL_ASYNC_METHOD( PrlVm_StopEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_STOP)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_StopEx, (hVm, nStopMode, nFlags))
+	CALL_DIRECT(hVm, PrlVm_StopEx, (hVm, nStopMode, nFlags))
 }
 
 PRL_HANDLE PrlVm_Pause_Impl(PRL_HANDLE hVm, PRL_BOOL bAcpi)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_PAUSE))
-		PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Pause(bAcpi);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -778,7 +801,7 @@ PRL_ASYNC_METHOD( PrlVm_Pause ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_PAUSE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Pause, (hVm, bAcpi))
+	CALL_DIRECT(hVm, PrlVm_Pause, (hVm, bAcpi))
 }
 
 PRL_HANDLE PrlVm_Suspend_Impl(PRL_HANDLE hVm)
@@ -791,7 +814,7 @@ PRL_ASYNC_METHOD( PrlVm_Suspend ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_SUSPEND)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Suspend, (hVm))
+	CALL_DIRECT(hVm, PrlVm_Suspend, (hVm))
 }
 
 PRL_HANDLE PrlVm_GetSuspendedScreen_Impl(PRL_HANDLE hVm)
@@ -804,15 +827,15 @@ PRL_ASYNC_METHOD( PrlVm_GetSuspendedScreen ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_SUSPENDED_SCREEN)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetSuspendedScreen, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_GetSuspendedScreen, (hVm))
 }
 
 PRL_HANDLE PrlVm_CreateSnapshot_Impl(PRL_HANDLE hVm, PRL_CONST_STR sName,
 		PRL_CONST_STR sDescription, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sName) || PRL_WRONG_PTR(sDescription) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sName) || PRL_WRONG_PTR(sDescription) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_CREATE_SNAPSHOT))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->CreateSnapshot(sName, sDescription, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -829,7 +852,7 @@ PRL_ASYNC_METHOD( PrlVm_CreateSnapshot ) (
 	PRL_UINT32 nFlsgs = 0;
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_CREATE_SNAPSHOT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_CreateSnapshot, (hVm, sName, sDescription, nFlsgs))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_CreateSnapshot, (hVm, sName, sDescription, nFlsgs))
 }
 
 PRL_ASYNC_METHOD( PrlVm_CreateSnapshotEx ) (
@@ -840,16 +863,16 @@ PRL_ASYNC_METHOD( PrlVm_CreateSnapshotEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_CREATE_SNAPSHOT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(hVm,
 		PrlVm_CreateSnapshot, (hVm, sName, sDescription, nFlags))
 }
 
 PRL_HANDLE PrlVm_SwitchToSnapshot_Impl(PRL_HANDLE hVm, PRL_CONST_STR sSnapshotUuid,
 		PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sSnapshotUuid) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sSnapshotUuid) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_SWITCH_TO_SNAPSHOT))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->SwitchToSnapshot(sSnapshotUuid, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -864,7 +887,7 @@ PRL_ASYNC_METHOD( PrlVm_SwitchToSnapshotEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_SWITCH_TO_SNAPSHOT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_SwitchToSnapshot, (hVm,
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_SwitchToSnapshot, (hVm,
 				sSnapshotUuid, nFlags))
 }
 
@@ -878,9 +901,9 @@ PRL_ASYNC_METHOD( PrlVm_SwitchToSnapshot ) (
 
 PRL_HANDLE PrlVm_DeleteSnapshot_Impl(PRL_HANDLE hVm, PRL_CONST_STR sSnapshotUuid, const PRL_BOOL bChild)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sSnapshotUuid) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sSnapshotUuid) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_DELETE_SNAPSHOT))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->DeleteSnapshot(sSnapshotUuid, bChild);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -895,7 +918,7 @@ PRL_ASYNC_METHOD( PrlVm_DeleteSnapshot ) (
 								  )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_DELETE_SNAPSHOT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_DeleteSnapshot, (hVm, sSnapshotUuid, bChild))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_DeleteSnapshot, (hVm, sSnapshotUuid, bChild))
 }
 
 PRL_ASYNC_METHOD( PrlVm_GetSnapshotsTree ) (
@@ -916,7 +939,7 @@ PRL_ASYNC_METHOD( PrlVm_GetSnapshotsTreeEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_SNAPSHOTS_TREE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetSnapshotsTreeEx, (hVm, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_GetSnapshotsTreeEx, (hVm, nFlags))
 }
 
 PRL_HANDLE PrlVm_UpdateSnapshotData_Impl(PRL_HANDLE hVm,
@@ -924,10 +947,10 @@ PRL_HANDLE PrlVm_UpdateSnapshotData_Impl(PRL_HANDLE hVm,
 												  PRL_CONST_STR sNewName,
 												  PRL_CONST_STR sNewDescription)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sSnapshotUuid) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sSnapshotUuid) ||
 		 PRL_WRONG_PTR(sNewName) || PRL_WRONG_PTR(sNewDescription) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_UPDATE_SNAPSHOT_DATA))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->UpdateSnapshotData(sSnapshotUuid, sNewName, sNewDescription);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -944,7 +967,7 @@ PRL_ASYNC_METHOD( PrlVm_UpdateSnapshotData ) (
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UPDATE_SNAPSHOT_DATA)
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(hVm,
 		PrlVm_UpdateSnapshotData,
 		(hVm, sSnapshotUuid, sNewName, sNewDescription)
 		)
@@ -960,7 +983,7 @@ PRL_ASYNC_METHOD( PrlVm_Reset ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_RESET)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Reset, (hVm))
+	CALL_DIRECT(hVm, PrlVm_Reset, (hVm))
 }
 
 PRL_HANDLE PrlVm_InstallTools_Impl(PRL_HANDLE hVm)
@@ -973,7 +996,7 @@ PRL_ASYNC_METHOD( PrlVm_InstallTools ) (
 							   )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_INSTALL_TOOLS)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_InstallTools, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_InstallTools, (hVm))
 }
 
 PRL_HANDLE PrlVm_BeginEdit_Impl(PRL_HANDLE hVm)
@@ -986,7 +1009,7 @@ PRL_ASYNC_METHOD( PrlVm_BeginEdit ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_BEGIN_EDIT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_BeginEdit, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_BeginEdit, (hVm))
 }
 
 PRL_HANDLE PrlVm_Commit_Impl(PRL_HANDLE hVm)
@@ -999,7 +1022,7 @@ PRL_ASYNC_METHOD( PrlVm_Commit ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_COMMIT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Commit, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Commit, (hVm))
 }
 
 PRL_HANDLE PrlVm_CommitEx_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -1013,7 +1036,7 @@ PRL_ASYNC_METHOD( PrlVm_CommitEx ) (
 								  )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_COMMIT)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_CommitEx, (hVm, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_CommitEx, (hVm, nFlags))
 }
 
 PRL_HANDLE PrlVm_GetState_Impl(PRL_HANDLE hVm)
@@ -1026,7 +1049,7 @@ PRL_ASYNC_METHOD( PrlVm_GetState ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_STATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetState, (hVm))
+	CALL_DIRECT(hVm, PrlVm_GetState, (hVm))
 }
 
 PRL_HANDLE PrlVm_GetToolsState_Impl(PRL_HANDLE hVm)
@@ -1039,7 +1062,7 @@ PRL_ASYNC_METHOD( PrlVm_GetToolsState ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_TOOLS_STATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetToolsState, (hVm))
+	CALL_DIRECT(hVm, PrlVm_GetToolsState, (hVm))
 }
 
 PRL_HANDLE PrlVm_RefreshConfig_Impl(PRL_HANDLE hVm)
@@ -1052,7 +1075,7 @@ PRL_ASYNC_METHOD( PrlVm_RefreshConfig ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_REFRESH_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_RefreshConfig, (hVm))
+	CALL_DIRECT(hVm, PrlVm_RefreshConfig, (hVm))
 }
 
 PRL_HANDLE PrlVm_RefreshConfigEx_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -1066,7 +1089,7 @@ PRL_ASYNC_METHOD( PrlVm_RefreshConfigEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_REFRESH_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_RefreshConfigEx, (hVm, nFlags))
+	CALL_DIRECT(hVm, PrlVm_RefreshConfigEx, (hVm, nFlags))
 }
 
 PRL_ASYNC_METHOD( PrlVm_GetStatistics ) (
@@ -1087,7 +1110,7 @@ PRL_ASYNC_METHOD( PrlVm_GetStatisticsEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_STATISTICS)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetStatisticsEx, (hVm, nFlags))
+	CALL_DIRECT(hVm, PrlVm_GetStatisticsEx, (hVm, nFlags))
 }
 
 PRL_HANDLE PrlVm_InitiateDevStateNotifications_Impl(PRL_HANDLE hVm)
@@ -1104,15 +1127,15 @@ PRL_ASYNC_METHOD( PrlVm_InitiateDevStateNotifications ) (
 		__FUNCTION__,
 		hVm
 		);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_InitiateDevStateNotifications, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_InitiateDevStateNotifications, (hVm))
 }
 
 PRL_HANDLE PrlVm_UpdateSecurity_Impl(PRL_HANDLE hVm, PRL_HANDLE hAccessRights)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_HANDLE(hAccessRights, PHT_ACCESS_RIGHTS) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAccessRights, PHT_ACCESS_RIGHTS );
+	if ( !pVm || !pAccessRights )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_UPDATE_SECURITY))
-		PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
-	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>(hAccessRights);
 	PrlHandleJobPtr pJob = pVm->UpdateSecurity(pAccessRights);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1131,7 +1154,7 @@ PRL_ASYNC_METHOD( PrlVm_UpdateSecurity ) (
 		hVm,
 		hAccessRights
 		);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_UpdateSecurity, (hVm, hAccessRights))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_UpdateSecurity, (hVm, hAccessRights))
 }
 
 PRL_HANDLE PrlVm_ValidateConfig_Impl(PRL_HANDLE hVm, PRL_VM_CONFIG_SECTIONS nSection)
@@ -1161,7 +1184,7 @@ PRL_ASYNC_METHOD( PrlVm_ValidateConfig ) (
 		|| !(nSection >= PVC_VALIDATE_CHANGES_ONLY && nSection <= PVC_LAST_SECTION))
 		return GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_VALIDATE_CONFIG);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_ValidateConfig, (hVm, nSection))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_ValidateConfig, (hVm, nSection))
 }
 
 PRL_METHOD( PrlVm_GetQuestions ) (
@@ -1177,10 +1200,10 @@ PRL_METHOD( PrlVm_GetQuestions ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(pQuestionsList) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(pQuestionsList) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 	PrlHandleServerDispPtr pServer = pVm->GetServerDisp();
 	if (!pServer)
 	{
@@ -1217,10 +1240,10 @@ PRL_METHOD( PrlVm_CreateEvent ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(phEvent))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm || PRL_WRONG_PTR(phEvent))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 #ifdef _WIN_
 #ifdef CreateEvent
 #undef CreateEvent
@@ -1242,9 +1265,9 @@ PRL_METHOD( PrlVmInfo_GetState) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_INFO) || PRL_WRONG_PTR(pVmState) )
+	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle, PHT_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pVmState) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle );
 	return (pVmInfo->GetState(pVmState));
 }
 
@@ -1261,9 +1284,9 @@ PRL_METHOD( PrlVmInfo_GetAdditionState) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_INFO) || PRL_WRONG_PTR(pVmState) )
+	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle, PHT_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pVmState) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle );
 	return (pVmInfo->GetAdditionState(pVmState));
 }
 
@@ -1280,9 +1303,9 @@ PRL_METHOD( PrlVmInfo_GetAccessRights ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmInfo, PHT_VM_INFO) || PRL_WRONG_PTR(phVmAcl) )
+	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( hVmInfo, PHT_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(phVmAcl) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( hVmInfo );
 	return (pVmInfo->GetAccessRights(phVmAcl));
 }
 
@@ -1297,9 +1320,9 @@ PRL_METHOD( PrlVmInfo_IsInvalid) (
 		pbIsInvalid
 		);
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_INFO) || PRL_WRONG_PTR(pbIsInvalid) )
+	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle, PHT_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pbIsInvalid) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle );
 
 	PRL_RESULT nRcValid=0;
 	return (pVmInfo->IsInvalid(pbIsInvalid, &nRcValid));
@@ -1318,10 +1341,10 @@ PRL_METHOD( PrlVmInfo_IsInvalidEx) (
 		pnInvalidReason
 		);
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_INFO)
+	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle, PHT_VM_INFO );
+	if ( !pVmInfo
 		|| PRL_WRONG_PTR(pbIsInvalid) || PRL_WRONG_PTR(pnInvalidReason) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle );
 	return (pVmInfo->IsInvalid(pbIsInvalid, pnInvalidReason));
 }
 
@@ -1338,9 +1361,9 @@ PRL_METHOD( PrlVmInfo_IsVmWaitingForAnswer) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_INFO) || PRL_WRONG_PTR(pbIsVmWaitingForAnswer) )
+	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle, PHT_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pbIsVmWaitingForAnswer) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle );
 	return (pVmInfo->IsVmWaitingForAnswer(pbIsVmWaitingForAnswer));
 }
 
@@ -1357,18 +1380,18 @@ PRL_METHOD( PrlVmInfo_IsVncServerStarted ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_INFO) || PRL_WRONG_PTR(pbIsVncServerStarted) )
+	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle, PHT_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pbIsVncServerStarted) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmInfo>( handle );
 	return (pVmInfo->IsVncServerSrtated(pbIsVncServerStarted));
 }
 
 PRL_HANDLE PrlSrv_StartSearchVms_Impl(PRL_HANDLE hServer,	PRL_HANDLE hStringsList)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER)
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer
 		|| (hStringsList != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hStringsList, PHT_STRINGS_LIST)) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_START_SEARCH_VMS))
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->StartSearchVms(hStringsList);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1377,9 +1400,9 @@ PRL_HANDLE PrlSrv_StartSearchVms_Impl(PRL_HANDLE hServer,	PRL_HANDLE hStringsLis
 
 PRL_HANDLE PrlSrv_GetVmConfig_Impl(PRL_HANDLE hServer, PRL_CONST_STR sSearchId, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) )
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_GET_VM_CONFIG));
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->GetVmConfig(sSearchId, nFlags);
 	if ( !pJob )
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -1393,7 +1416,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetVmConfig ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_VM_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetVmConfig, (hServer, sSearchId, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetVmConfig, (hServer, sSearchId, nFlags))
 }
 
 PRL_METHOD( PrlVm_SetConfig ) (
@@ -1403,11 +1426,11 @@ PRL_METHOD( PrlVm_SetConfig ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm
 		 || PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVm);
 	return pVm->SetConfig(hVmCfg);
 }
 
@@ -1424,10 +1447,10 @@ PRL_METHOD( PrlVm_GetConfig ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(phVmCfg) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(phVmCfg) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVm);
 	return pVm->GetConfig(phVmCfg);
 }
 
@@ -1444,11 +1467,11 @@ PRL_METHOD( PrlVmCfg_IsOfflineManagementEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsOfflineManagementEnabled(pbEnabled));
 }
 
@@ -1465,10 +1488,10 @@ PRL_METHOD( PrlVmCfg_SetOfflineManagementEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetOfflineManagementEnabled(bEnabled));
 }
 
@@ -1485,10 +1508,10 @@ PRL_METHOD( PrlVmCfg_SetToolsAutoUpdateEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetToolsAutoUpdateEnabled(bEnabled));
 }
 
@@ -1505,11 +1528,11 @@ PRL_METHOD( PrlVmCfg_IsToolsAutoUpdateEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsToolsAutoUpdateEnabled(pbEnabled));
 }
 
@@ -1526,10 +1549,10 @@ PRL_METHOD( PrlVmCfg_GetConfirmationsList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phConfirmList))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm || PRL_WRONG_PTR(phConfirmList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetConfirmationsList(phConfirmList));
 }
 
@@ -1547,12 +1570,12 @@ PRL_METHOD( PrlVmCfg_SetConfirmationsList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION)
-		|| PRL_WRONG_HANDLE(hConfirmList, PHT_OPAQUE_TYPE_LIST))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	PrlHandleOpTypeListPtr pList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>( hConfirmList, PHT_OPAQUE_TYPE_LIST );
+	if (!pVm
+		|| !pList)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
-	PrlHandleOpTypeListPtr pList = PRL_OBJECT_BY_HANDLE<PrlHandleOpTypeList>(hConfirmList);
 	return (pVm->SetConfirmationsList(pList));
 }
 
@@ -1570,11 +1593,11 @@ PRL_METHOD( PrlVmCfg_IsAutoCompressEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsAutoCompressEnabled(pbEnabled));
 }
 
@@ -1592,10 +1615,10 @@ PRL_METHOD( PrlVmCfg_SetAutoCompressEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetAutoCompressEnabled(bEnabled));
 }
 
@@ -1613,11 +1636,11 @@ PRL_METHOD( PrlVmCfg_GetAutoCompressInterval ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pnInterval) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetAutoCompressInterval(pnInterval));
 }
 
@@ -1635,10 +1658,10 @@ PRL_METHOD( PrlVmCfg_SetAutoCompressInterval ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetAutoCompressInterval(nInterval));
 }
 
@@ -1656,11 +1679,11 @@ PRL_METHOD( PrlVmCfg_GetFreeDiskSpaceRatio ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pdFreeDiskSpaceRatio) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetFreeDiskSpaceRatio(pdFreeDiskSpaceRatio));
 }
 
@@ -1678,10 +1701,10 @@ PRL_METHOD( PrlVmCfg_SetFreeDiskSpaceRatio ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetFreeDiskSpaceRatio(dFreeDiskSpaceRatio));
 }
 
@@ -1719,10 +1742,10 @@ PRL_METHOD( PrlVmCfg_GetConfigValidity ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(pnErrCode) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(pnErrCode) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return pVm->GetConfigValidity( pnErrCode );
 }
@@ -1742,11 +1765,11 @@ PRL_METHOD( PrlVmCfg_GetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetName(sVmName, pnVmNameBufLength));
 }
@@ -1765,11 +1788,11 @@ PRL_METHOD( PrlVmCfg_SetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmName))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetName(sNewVmName));
 }
@@ -1790,11 +1813,11 @@ PRL_METHOD( PrlVmCfg_GetHostname) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmHostnameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetHostname(sVmHostname, pnVmHostnameBufLength));
 }
@@ -1813,11 +1836,11 @@ PRL_METHOD( PrlVmCfg_SetHostname) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmHostname))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetHostname(sNewVmHostname));
 }
@@ -1837,11 +1860,11 @@ PRL_METHOD( PrlVmCfg_GetUuid) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmUuidBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetUuid(sVmUuid, pnVmUuidBufLength));
 }
@@ -1871,11 +1894,11 @@ PRL_METHOD( PrlVmCfg_GetCtId) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnCtIdBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetCtId(sCtId, pnCtIdBufLength);
 }
@@ -1894,11 +1917,11 @@ PRL_METHOD( PrlVmCfg_SetUuid) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmUuid))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetUuid(sNewVmUuid));
 }
@@ -1919,11 +1942,11 @@ PRL_METHOD( PrlVmCfg_GetLinkedVmUuid) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmUuidBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetLinkedVmUuid(sVmUuid, pnVmUuidBufLength));
 }
@@ -1941,11 +1964,11 @@ PRL_METHOD( PrlVmCfg_GetOsType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmOsType))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetOsType(pnVmOsType));
 }
@@ -1963,11 +1986,11 @@ PRL_METHOD( PrlVmCfg_GetOsVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmOsVersion))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetOsVersion(pnVmOsVersion));
 }
@@ -1985,10 +2008,10 @@ PRL_METHOD( PrlVmCfg_SetOsVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetOsVersion(nVmOsVersion));
 }
@@ -2006,11 +2029,11 @@ PRL_METHOD( PrlVmCfg_GetRamSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmRamSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetRamSize(pnVmRamSize));
 }
@@ -2028,11 +2051,11 @@ PRL_METHOD( PrlVmCfg_SetRamSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(nVmRamSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetRamSize(nVmRamSize));
 }
@@ -2050,11 +2073,11 @@ PRL_METHOD( PrlVmCfg_GetVideoRamSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmVideoRamSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetVideoRamSize(pnVmVideoRamSize));
 }
@@ -2072,11 +2095,11 @@ PRL_METHOD( PrlVmCfg_SetVideoRamSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(nVmVideoRamSize))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetVideoRamSize(nVmVideoRamSize));
 }
@@ -2094,11 +2117,11 @@ PRL_METHOD( PrlVmCfg_GetMemGuaranteeSize ) (
 		pMemGuaranteeSize
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pMemGuaranteeSize))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetMemGuaranteeSize(pMemGuaranteeSize);
 }
@@ -2116,11 +2139,11 @@ PRL_METHOD( PrlVmCfg_SetMemGuaranteeSize ) (
 		pMemGuaranteeSize
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pMemGuaranteeSize))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetMemGuaranteeSize(pMemGuaranteeSize);
 }
@@ -2138,11 +2161,11 @@ PRL_METHOD( PrlVmCfg_GetCpuCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmCpuCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCpuCoreCount(pnVmCpuCount));
 }
@@ -2160,10 +2183,10 @@ PRL_METHOD( PrlVmCfg_SetCpuCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCpuCoreCount(nVmCpuCount));
 }
@@ -2181,11 +2204,11 @@ PRL_METHOD( PrlVmCfg_GetCpuSocketsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmCpuSocketsCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCpuSocketCount(pnVmCpuSocketsCount));
 }
@@ -2203,13 +2226,12 @@ PRL_METHOD( PrlVmCfg_SetCpuSocketsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 	if (0 == nVmCpuSocketsCount)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
-
 	return (pVm->SetCpuSocketCount(nVmCpuSocketsCount));
 }
 
@@ -2226,11 +2248,11 @@ PRL_METHOD( PrlVmCfg_GetNumaNodesCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmNumaNodesCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetNumaNodesCount(pnVmNumaNodesCount));
 }
@@ -2248,10 +2270,10 @@ PRL_METHOD( PrlVmCfg_SetNumaNodesCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetNumaNodesCount(nVmNumaNodesCount));
 }
@@ -2269,10 +2291,10 @@ PRL_METHOD( PrlVmCfg_GetChipsetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetChipsetType(nChipsetType));
 }
@@ -2290,13 +2312,12 @@ PRL_METHOD( PrlVmCfg_SetChipsetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 	if (nChipsetType < PRL_CHIPSET_TYPE::CHIP_MIN_NUMBER || nChipsetType > PRL_CHIPSET_TYPE::CHIP_MAX_NUMBER )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
-
 	return (pVm->SetChipsetType(nChipsetType));
 }
 
@@ -2313,10 +2334,10 @@ PRL_METHOD( PrlVmCfg_GetChipsetVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetChipsetVersion(nChipsetVersion));
 }
@@ -2334,10 +2355,10 @@ PRL_METHOD( PrlVmCfg_SetChipsetVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetChipsetVersion(nChipsetVersion));
 }
@@ -2355,11 +2376,11 @@ PRL_METHOD( PrlVmCfg_GetCpuMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmCpuMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCpuMode(pnVmCpuMode));
 }
@@ -2377,10 +2398,10 @@ PRL_METHOD( PrlVmCfg_SetCpuMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCpuMode(nVmCpuMode));
 }
@@ -2398,11 +2419,11 @@ PRL_METHOD( PrlVmCfg_GetCpuAccelLevel ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmCpuAccelLevel))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCpuAccelLevel(pnVmCpuAccelLevel));
 }
@@ -2420,10 +2441,10 @@ PRL_METHOD( PrlVmCfg_SetCpuAccelLevel ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCpuAccelLevel(nVmCpuAccelLevel));
 }
@@ -2441,11 +2462,11 @@ PRL_METHOD( PrlVmCfg_IsCpuVtxEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmCpuVtxEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsCpuVtxEnabled(pbVmCpuVtxEnabled));
 }
@@ -2463,11 +2484,11 @@ PRL_METHOD( PrlVmCfg_IsCpuHotplugEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmCpuHotplugEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsCpuHotplugEnabled(pbVmCpuHotplugEnabled));
 }
@@ -2485,10 +2506,10 @@ PRL_METHOD( PrlVmCfg_SetCpuHotplugEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCpuHotplugEnabled(bVmCpuHotplugEnabled));
 }
@@ -2506,11 +2527,11 @@ PRL_METHOD( PrlVmCfg_Get3DAccelerationMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pn3DAccelerationMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->Get3DAccelerationMode(pn3DAccelerationMode));
 }
@@ -2528,10 +2549,10 @@ PRL_METHOD( PrlVmCfg_Set3DAccelerationMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->Set3DAccelerationMode(n3DAccelerationMode));
 }
@@ -2549,11 +2570,11 @@ PRL_METHOD( PrlVmCfg_IsVerticalSynchronizationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsVerticalSynchronizationEnabled(pbEnabled));
 }
 
@@ -2570,10 +2591,10 @@ PRL_METHOD( PrlVmCfg_SetVerticalSynchronizationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetVerticalSynchronizationEnabled(bEnabled));
 }
 
@@ -2590,11 +2611,11 @@ PRL_METHOD( PrlVmCfg_IsHighResolutionEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsHighResolutionEnabled(pbEnabled));
 }
 
@@ -2611,10 +2632,10 @@ PRL_METHOD( PrlVmCfg_SetHighResolutionEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetHighResolutionEnabled(bEnabled));
 }
 
@@ -2631,11 +2652,11 @@ PRL_METHOD( PrlVmCfg_IsAdaptiveHypervisorEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsAdaptiveHypervisorEnabled(pbEnable);
 }
@@ -2653,10 +2674,10 @@ PRL_METHOD( PrlVmCfg_SetAdaptiveHypervisorEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetAdaptiveHypervisorEnabled(bEnable);
 }
@@ -2674,11 +2695,11 @@ PRL_METHOD( PrlVmCfg_IsSwitchOffWindowsLogoEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsSwitchOffWindowsLogoEnabled(pbEnable);
 }
@@ -2696,10 +2717,10 @@ PRL_METHOD( PrlVmCfg_SetSwitchOffWindowsLogoEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetSwitchOffWindowsLogoEnabled(bEnable);
 }
@@ -2717,11 +2738,11 @@ PRL_METHOD( PrlVmCfg_IsLongerBatteryLifeEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsLongerBatteryLifeEnabled(pbEnable);
 }
@@ -2739,10 +2760,10 @@ PRL_METHOD( PrlVmCfg_SetLongerBatteryLifeEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetLongerBatteryLifeEnabled(bEnable);
 }
@@ -2760,11 +2781,11 @@ PRL_METHOD( PrlVmCfg_IsBatteryStatusEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsBatteryStatusEnabled(pbEnable);
 }
@@ -2782,10 +2803,10 @@ PRL_METHOD( PrlVmCfg_SetBatteryStatusEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetBatteryStatusEnabled(bEnable);
 }
@@ -2803,11 +2824,11 @@ PRL_METHOD( PrlVmCfg_IsNestedVirtualizationEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsNestedVirtualizationEnabled(pbEnable);
 }
@@ -2825,10 +2846,10 @@ PRL_METHOD( PrlVmCfg_SetNestedVirtualizationEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetNestedVirtualizationEnabled(bEnable);
 }
@@ -2846,11 +2867,11 @@ PRL_METHOD( PrlVmCfg_IsPMUVirtualizationEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsPMUVirtualizationEnabled(pbEnable);
 }
@@ -2868,10 +2889,10 @@ PRL_METHOD( PrlVmCfg_SetPMUVirtualizationEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetPMUVirtualizationEnabled(bEnable);
 }
@@ -2889,11 +2910,11 @@ PRL_METHOD( PrlVmCfg_IsLockGuestOnSuspendEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsLockGuestOnSuspendEnabled(pbEnable);
 }
@@ -2911,10 +2932,10 @@ PRL_METHOD( PrlVmCfg_SetLockGuestOnSuspendEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetLockGuestOnSuspendEnabled(bEnable);
 }
@@ -2932,11 +2953,11 @@ PRL_METHOD( PrlVmCfg_IsIsolatedVmEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsIsolatedVmEnabled(pbEnable);
 }
@@ -2954,10 +2975,10 @@ PRL_METHOD( PrlVmCfg_SetIsolatedVmEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetIsolatedVmEnabled(bEnable);
 }
@@ -2977,11 +2998,11 @@ PRL_METHOD( PrlVmCfg_GetServerUuid) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnServerUuidBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetServerUuid(sServerUuid, pnServerUuidBufLength));
 }
@@ -3002,11 +3023,11 @@ PRL_METHOD( PrlVmCfg_GetServerHost) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnServerHostBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetServerHost(sServerHost, pnServerHostBufLength));
 }
@@ -3027,11 +3048,11 @@ PRL_METHOD( PrlVmCfg_GetHomePath) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnHomePathBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetHomePath(sHomePath, pnHomePathBufLength));
 }
@@ -3050,11 +3071,11 @@ PRL_METHOD( PrlVmCfg_GetLocation) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmLocation))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetLocation(pnVmLocation));
 }
@@ -3075,11 +3096,11 @@ PRL_METHOD( PrlVmCfg_GetIcon) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmIconBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetIcon(sVmIcon, pnVmIconBufLength));
 }
@@ -3098,11 +3119,11 @@ PRL_METHOD( PrlVmCfg_SetIcon) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmIcon))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetIcon(sNewVmIcon));
 }
@@ -3123,11 +3144,11 @@ PRL_METHOD( PrlVmCfg_GetDescription) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmDescriptionBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetDescription(sVmDescription, pnVmDescriptionBufLength));
 }
@@ -3146,11 +3167,11 @@ PRL_METHOD( PrlVmCfg_SetDescription) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmDescription))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetDescription(sNewVmDescription));
 }
@@ -3168,11 +3189,11 @@ PRL_METHOD( PrlVmCfg_IsTemplate ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmIsTemplate))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsTemplate(pbVmIsTemplate));
 }
@@ -3190,10 +3211,10 @@ PRL_METHOD( PrlVmCfg_SetTemplateSign ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetTemplateSign(bVmIsTemplate));
 }
@@ -3213,11 +3234,11 @@ PRL_METHOD( PrlVmCfg_GetCustomProperty) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_PTR(pnVmCustomPropertyBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCustomProperty(sVmCustomProperty, pnVmCustomPropertyBufLength));
 }
@@ -3235,11 +3256,11 @@ PRL_METHOD( PrlVmCfg_SetCustomProperty) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_PTR(sNewVmCustomProperty))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCustomProperty(sNewVmCustomProperty));
 }
@@ -3257,11 +3278,11 @@ PRL_METHOD( PrlVmCfg_GetAutoStart ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmAutoStart))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetAutoStart(pnVmAutoStart));
 }
@@ -3279,10 +3300,10 @@ PRL_METHOD( PrlVmCfg_SetAutoStart ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetAutoStart(nVmAutoStart));
 }
@@ -3300,11 +3321,11 @@ PRL_METHOD( PrlVmCfg_GetAutoStartDelay ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmAutoStartDelay))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetAutoStartDelay(pnVmAutoStartDelay));
 }
@@ -3322,10 +3343,10 @@ PRL_METHOD( PrlVmCfg_SetAutoStartDelay ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetAutoStartDelay(nVmAutoStartDelay));
 }
@@ -3343,11 +3364,11 @@ PRL_METHOD( PrlVmCfg_GetStartLoginMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmStartLoginMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetStartLoginMode(pnVmStartLoginMode));
 }
@@ -3365,10 +3386,10 @@ PRL_METHOD( PrlVmCfg_SetStartLoginMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetStartLoginMode(nVmStartLoginMode));
 }
@@ -3388,11 +3409,11 @@ PRL_METHOD( PrlVmCfg_GetStartUserLogin) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnStartUserLoginBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetStartUserLogin(sStartUserLogin, pnStartUserLoginBufLength));
 }
@@ -3413,11 +3434,11 @@ PRL_METHOD( PrlVmCfg_SetStartUserCreds) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sStartUserLogin) || PRL_WRONG_PTR(sPassword))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetStartUserCreds(sStartUserLogin, sPassword));
 }
@@ -3435,11 +3456,11 @@ PRL_METHOD( PrlVmCfg_GetAutoStop ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmAutoStop))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetAutoStop(pnVmAutoStop));
 }
@@ -3457,10 +3478,10 @@ PRL_METHOD( PrlVmCfg_SetAutoStop ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetAutoStop(nVmAutoStop));
 }
@@ -3478,11 +3499,11 @@ PRL_METHOD( PrlVmCfg_GetActionOnWindowClose ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnActionOnWindowClose))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetActionOnWindowClose(pnActionOnWindowClose));
 }
@@ -3500,10 +3521,10 @@ PRL_METHOD( PrlVmCfg_SetActionOnWindowClose ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetActionOnWindowClose(nActionOnWindowClose));
 }
@@ -3521,11 +3542,11 @@ PRL_METHOD( PrlVmCfg_GetActionOnStopMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pnMode) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetActionOnStopMode(pnMode));
 }
 
@@ -3542,10 +3563,10 @@ PRL_METHOD( PrlVmCfg_SetActionOnStopMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetActionOnStopMode(nMode));
 }
 
@@ -3562,11 +3583,11 @@ PRL_METHOD( PrlVmCfg_GetWindowMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmWindowMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetWindowMode(pnVmWindowMode));
 }
@@ -3584,10 +3605,10 @@ PRL_METHOD( PrlVmCfg_SetWindowMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetWindowMode(nVmWindowMode));
 }
@@ -3605,11 +3626,11 @@ PRL_METHOD( PrlVmCfg_IsStartInDetachedWindowEnabled ) (
 		pbEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm
 		|| PRL_WRONG_PTR(pbEnable))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->IsStartInDetachedWindowEnabled(pbEnable);
 }
@@ -3627,10 +3648,10 @@ PRL_METHOD( PrlVmCfg_SetStartInDetachedWindowEnabled ) (
 		bEnable
 	);
 
-	if (PRL_WRONG_HANDLE(hVm, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVm );
 
 	return pVm->SetStartInDetachedWindowEnabled(bEnable);
 }
@@ -3648,10 +3669,10 @@ PRL_METHOD( PrlVmCfg_IsLockInFullScreenMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(pbValue))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm || PRL_WRONG_PTR(pbValue))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsLockInFullScreenMode(pbValue));
 }
@@ -3669,10 +3690,10 @@ PRL_METHOD( PrlVmCfg_SetLockInFullScreenMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetLockInFullScreenMode(bValue));
 }
@@ -3692,11 +3713,11 @@ PRL_METHOD( PrlVmCfg_GetLastModifiedDate) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmLastModifiedDateBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetLastModifiedDate(sVmLastModifiedDate, pnVmLastModifiedDateBufLength));
 }
@@ -3717,11 +3738,11 @@ PRL_METHOD( PrlVmCfg_GetLastModifierName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmLastModifierNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetLastModifierName(sVmLastModifierName, pnVmLastModifierNameBufLength));
 }
@@ -3741,10 +3762,10 @@ PRL_METHOD( PrlVmCfg_GetUptimeStartDate) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetUptimeStartDate(sVmUptimeStartDate, pnVmUptimeStartDateBufLength));
 }
@@ -3763,11 +3784,11 @@ PRL_METHOD( PrlVmCfg_GetUptime) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_PTR(pnVmUptime))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetUptime(pnVmUptime));
 }
@@ -3786,11 +3807,11 @@ PRL_METHOD( PrlVmCfg_GetAccessRights ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(phVmAcl))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetAccessRights(phVmAcl));
 }
@@ -3809,11 +3830,11 @@ PRL_METHOD( PrlVmCfg_IsGuestSharingEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmGuestSharingEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsGuestSharingEnabled(pbVmGuestSharingEnabled));
 }
@@ -3831,10 +3852,10 @@ PRL_METHOD( PrlVmCfg_SetGuestSharingEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetGuestSharingEnabled(bVmGuestSharingEnabled));
 }
@@ -3852,11 +3873,11 @@ PRL_METHOD( PrlVmCfg_IsGuestSharingAutoMount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmGuestSharingAutoMount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsGuestSharingAutoMount(pbVmGuestSharingAutoMount));
 }
@@ -3874,10 +3895,10 @@ PRL_METHOD( PrlVmCfg_SetGuestSharingAutoMount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetGuestSharingAutoMount(bVmGuestSharingAutoMount));
 }
@@ -3895,11 +3916,11 @@ PRL_METHOD( PrlVmCfg_IsGuestSharingEnableSpotlight ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmGuestSharingEnableSpotlight))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsGuestSharingEnableSpotlight(pbVmGuestSharingEnableSpotlight));
 }
@@ -3917,10 +3938,10 @@ PRL_METHOD( PrlVmCfg_SetGuestSharingEnableSpotlight ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetGuestSharingEnableSpotlight(bVmGuestSharingEnableSpotlight));
 }
@@ -3938,11 +3959,11 @@ PRL_METHOD( PrlVmCfg_IsHostSharingEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmHostSharingEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsHostSharingEnabled(pbVmHostSharingEnabled));
 }
@@ -3960,10 +3981,10 @@ PRL_METHOD( PrlVmCfg_SetHostSharingEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetHostSharingEnabled(bVmHostSharingEnabled));
 }
@@ -3981,11 +4002,11 @@ PRL_METHOD( PrlVmCfg_IsShareAllHostDisks ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbShareAllHostDisks))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsShareAllHostDisks(pbShareAllHostDisks));
 }
@@ -4003,10 +4024,10 @@ PRL_METHOD( PrlVmCfg_SetShareAllHostDisks ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetShareAllHostDisks(bShareAllHostDisks));
 }
@@ -4024,11 +4045,11 @@ PRL_METHOD( PrlVmCfg_IsShareUserHomeDir ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbShareUserHomeDir))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsShareUserHomeDir(pbShareUserHomeDir));
 }
@@ -4046,10 +4067,10 @@ PRL_METHOD( PrlVmCfg_SetShareUserHomeDir ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetShareUserHomeDir(bShareUserHomeDir));
 }
@@ -4106,11 +4127,11 @@ PRL_METHOD( PrlVmCfg_GetVNCMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmRemoteDisplayMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetRemoteDisplayMode(pnVmRemoteDisplayMode));
 }
@@ -4128,10 +4149,10 @@ PRL_METHOD( PrlVmCfg_SetVNCMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetRemoteDisplayMode(nVmRemoteDisplayMode));
 }
@@ -4151,11 +4172,11 @@ PRL_METHOD( PrlVmCfg_GetVNCPassword) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmRemoteDisplayPasswordBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetRemoteDisplayPassword(sVmRemoteDisplayPassword, pnVmRemoteDisplayPasswordBufLength));
 }
@@ -4173,11 +4194,11 @@ PRL_METHOD( PrlVmCfg_SetVNCPassword) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmRemoteDisplayPassword))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetRemoteDisplayPassword(sNewVmRemoteDisplayPassword));
 }
@@ -4197,11 +4218,11 @@ PRL_METHOD( PrlVmCfg_GetVNCHostName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmRemoteDisplayHostNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetRemoteDisplayHostName(sVmRemoteDisplayHostName, pnVmRemoteDisplayHostNameBufLength));
 }
@@ -4219,11 +4240,11 @@ PRL_METHOD( PrlVmCfg_SetVNCHostName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmRemoteDisplayHostName))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetRemoteDisplayHostName(sNewVmRemoteDisplayHostName));
 }
@@ -4241,11 +4262,11 @@ PRL_METHOD( PrlVmCfg_GetVNCPort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmRemoteDisplayPortNumber))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetRemoteDisplayPortNumber(pnVmRemoteDisplayPortNumber));
 }
@@ -4263,10 +4284,10 @@ PRL_METHOD( PrlVmCfg_SetVNCPort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetRemoteDisplayPortNumber(nVmRemoteDisplayPortNumber));
 }
@@ -4284,11 +4305,11 @@ PRL_METHOD( PrlVmCfg_GetVNCWebSocketPort ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmRemoteDisplayWebSocketPortNumber))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetRemoteDisplayWebSocketPortNumber(pnVmRemoteDisplayWebSocketPortNumber));
 }
@@ -4306,11 +4327,11 @@ PRL_METHOD( PrlVmCfg_IsVNCEncryptionEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmRemoteDisplayEncryptionEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsRemoteDisplayEncryptionEnabled(pbVmRemoteDisplayEncryptionEnabled));
 }
@@ -4328,11 +4349,11 @@ PRL_METHOD( PrlVmCfg_IsScrResEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmScrResEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsScrResEnabled(pbVmScrResEnabled));
 }
@@ -4350,10 +4371,10 @@ PRL_METHOD( PrlVmCfg_SetScrResEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetScrResEnabled(bVmScrResEnabled));
 }
@@ -4371,11 +4392,11 @@ PRL_METHOD( PrlVmCfg_IsDiskCacheWriteBack ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmDiskCacheWriteBack))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsDiskCacheWriteBack(pbVmDiskCacheWriteBack));
 }
@@ -4393,10 +4414,10 @@ PRL_METHOD( PrlVmCfg_SetDiskCacheWriteBack ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetDiskCacheWriteBack(bVmDiskCacheWriteBack));
 }
@@ -4414,11 +4435,11 @@ PRL_METHOD( PrlVmCfg_IsOsResInFullScrMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmOsResInFullScrMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsOsResInFullScrMode(pbVmOsResInFullScrMode));
 }
@@ -4436,10 +4457,10 @@ PRL_METHOD( PrlVmCfg_SetOsResInFullScrMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetOsResInFullScrMode(bVmOsResInFullScrMode));
 }
@@ -4457,11 +4478,11 @@ PRL_METHOD( PrlVmCfg_IsCloseAppOnShutdown ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbVmCloseAppOnShutdown))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsCloseAppOnShutdown(pbVmCloseAppOnShutdown));
 }
@@ -4479,10 +4500,10 @@ PRL_METHOD( PrlVmCfg_SetCloseAppOnShutdown ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCloseAppOnShutdown(bVmCloseAppOnShutdown));
 }
@@ -4502,11 +4523,11 @@ PRL_METHOD( PrlVmCfg_GetSystemFlags) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmSystemFlagsBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetSystemFlags(sVmSystemFlags, pnVmSystemFlagsBufLength));
 }
@@ -4525,11 +4546,11 @@ PRL_METHOD( PrlVmCfg_SetSystemFlags) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmSystemFlags))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetSystemFlags(sNewVmSystemFlags));
 }
@@ -4547,11 +4568,11 @@ PRL_METHOD( PrlVmCfg_IsDisableAPIC ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbDisableAPIC))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsDisableAPIC(pbDisableAPIC));
 }
@@ -4569,10 +4590,10 @@ PRL_METHOD( PrlVmCfg_SetDisableAPICSign ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetDisableAPICSign(bDisableAPIC));
 }
@@ -4590,11 +4611,11 @@ PRL_METHOD( PrlVmCfg_IsDisableSpeaker ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbDisableSpeaker))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsDisableSpeaker(pbDisableSpeaker));
 }
@@ -4612,10 +4633,10 @@ PRL_METHOD( PrlVmCfg_SetDisableSpeakerSign ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetDisableSpeakerSign(bDisableSpeaker));
 }
@@ -4633,11 +4654,11 @@ PRL_METHOD( PrlVmCfg_GetUndoDisksMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnUndoDisksMode))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetUndoDisksMode(pnUndoDisksMode));
 }
@@ -4655,10 +4676,10 @@ PRL_METHOD( PrlVmCfg_SetUndoDisksMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetUndoDisksMode(nUndoDisksMode));
 }
@@ -4676,11 +4697,11 @@ PRL_METHOD( PrlVmCfg_GetForegroundPriority ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmForegroundPriority))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetForegroundPriority(pnVmForegroundPriority));
 }
@@ -4698,10 +4719,10 @@ PRL_METHOD( PrlVmCfg_SetForegroundPriority ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetForegroundPriority(nVmForegroundPriority));
 }
@@ -4719,11 +4740,11 @@ PRL_METHOD( PrlVmCfg_GetBackgroundPriority ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmBackgroundPriority))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetBackgroundPriority(pnVmBackgroundPriority));
 }
@@ -4741,10 +4762,10 @@ PRL_METHOD( PrlVmCfg_SetBackgroundPriority ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetBackgroundPriority(nVmBackgroundPriority));
 }
@@ -4762,11 +4783,11 @@ PRL_METHOD( PrlVmCfg_IsUseDefaultAnswers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbUseDefaultAnswers) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsUseDefaultAnswers(pbUseDefaultAnswers));
 }
 
@@ -4783,10 +4804,10 @@ PRL_METHOD( PrlVmCfg_SetUseDefaultAnswers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetUseDefaultAnswers(bUseDefaultAnswers));
 }
 
@@ -4803,10 +4824,10 @@ PRL_METHOD( PrlVmCfg_GetSearchDomains ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phSearchDomainsList))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm || PRL_WRONG_PTR(phSearchDomainsList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetSearchDomains(phSearchDomainsList));
 }
 
@@ -4823,12 +4844,12 @@ PRL_METHOD( PrlVmCfg_SetSearchDomains ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
-		(PRL_INVALID_HANDLE != hSearchDomainsList && PRL_WRONG_HANDLE(hSearchDomainsList, PHT_STRINGS_LIST)))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	PrlHandleStringsListPtr pSearchDomainsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hSearchDomainsList, PHT_STRINGS_LIST );
+	if (!pVm ||
+		(PRL_INVALID_HANDLE != hSearchDomainsList && !pSearchDomainsList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
-	PrlHandleStringsListPtr pSearchDomainsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hSearchDomainsList);
 	return (pVm->SetSearchDomains(pSearchDomainsList.getHandle() ? pSearchDomainsList->GetStringsList() : QStringList()));
 }
 
@@ -4845,10 +4866,10 @@ PRL_METHOD( PrlVmCfg_GetDnsServers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phDnsServersList))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm || PRL_WRONG_PTR(phDnsServersList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetDnsServers(phDnsServersList));
 }
 
@@ -4865,12 +4886,12 @@ PRL_METHOD( PrlVmCfg_SetDnsServers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
-		(PRL_INVALID_HANDLE != hDnsServersList && PRL_WRONG_HANDLE(hDnsServersList, PHT_STRINGS_LIST)))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	PrlHandleStringsListPtr pDnsServersList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hDnsServersList, PHT_STRINGS_LIST );
+	if (!pVm ||
+		(PRL_INVALID_HANDLE != hDnsServersList && !pDnsServersList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
-	PrlHandleStringsListPtr pDnsServersList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hDnsServersList);
 	return (pVm->SetDnsServers(pDnsServersList.getHandle() ? pDnsServersList->GetStringsList() : QStringList()));
 }
 
@@ -4881,11 +4902,11 @@ PRL_METHOD( PrlVmCfg_IsAutoApplyIpOnly ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbAutoApplyIpOnly))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsAutoApplyIpOnly(pbAutoApplyIpOnly));
 }
 
@@ -4896,10 +4917,10 @@ PRL_METHOD( PrlVmCfg_SetAutoApplyIpOnly ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetAutoApplyIpOnly(bAutoApplyIpOnly));
 }
 
@@ -4915,10 +4936,10 @@ PRL_METHOD( PrlVmCfg_GetVmInfo ) (
 		phVmInfo
 		);
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phVmInfo) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(phVmInfo) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return (pVm->GetVmInfo(phVmInfo));
 }
@@ -4936,11 +4957,11 @@ PRL_METHOD( PrlVmCfg_GetCapabilitiesMask ) (
 		pnCapMask
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnCapMask))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetCapabilitiesMask(pnCapMask);
 }
@@ -4958,10 +4979,10 @@ PRL_METHOD( PrlVmCfg_SetCapabilitiesMask ) (
 		nCapMask
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetCapabilitiesMask(nCapMask);
 }
@@ -4974,11 +4995,11 @@ PRL_METHOD( PrlVmCfg_GetFeaturesMask ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnOn) || PRL_WRONG_PTR(pnOff))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetFeaturesMask(pnOn, pnOff);
 }
@@ -4991,10 +5012,10 @@ PRL_METHOD( PrlVmCfg_SetFeaturesMask ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetFeaturesMask(nOn, nOff);
 }
@@ -5013,11 +5034,11 @@ PRL_METHOD( PrlVmCfg_GetProfile ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 		 PRL_WRONG_PTR(pnVmProfile) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetProfile(pnVmProfile));
 }
 
@@ -5035,11 +5056,11 @@ PRL_METHOD( PrlVmCfg_IsCustomProfile ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 		 PRL_WRONG_PTR(pbCustom) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsCustomProfile(pbCustom));
 }
 
@@ -5058,13 +5079,12 @@ PRL_METHOD( PrlVmCfg_SetProfile ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION)
-		 || (hSrvConfig != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG)))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if ( !pVm
+		 || (hSrvConfig != PRL_INVALID_HANDLE && !pSrvConfig))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>(hSrvConfig);
-
 	return (pVm->SetProfile(pSrvConfig, nVmProfile));
 }
 
@@ -5082,11 +5102,11 @@ PRL_METHOD( PrlVmCfg_IsHighAvailabilityEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsHighAvailabilityEnabled(pbEnabled));
 }
 
@@ -5103,10 +5123,10 @@ PRL_METHOD( PrlVmCfg_SetHighAvailabilityEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetHighAvailabilityEnabled(bEnabled));
 }
 
@@ -5123,11 +5143,11 @@ PRL_METHOD( PrlVmCfg_GetHighAvailabilityPriority ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pnPriority) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetHighAvailabilityPriority(pnPriority));
 }
 
@@ -5144,10 +5164,10 @@ PRL_METHOD( PrlVmCfg_SetHighAvailabilityPriority ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetHighAvailabilityPriority(nPriority));
 }
 
@@ -5158,10 +5178,10 @@ PRL_METHOD( PrlVmCfg_SetNetworkRateList ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return (pVm->SetNetworkRates(hNetworkRateList));
 }
@@ -5173,10 +5193,10 @@ PRL_METHOD( PrlVmCfg_GetNetworkRateList ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return (pVm->GetNetworkRates(phNetworkRateList));
 }
@@ -5188,11 +5208,11 @@ PRL_METHOD( PrlVmCfg_IsRateBound ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsRateBound(pbEnabled));
 }
 
@@ -5203,10 +5223,10 @@ PRL_METHOD( PrlVmCfg_SetRateBound ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetRateBound(bEnabled));
 }
 
@@ -5226,10 +5246,10 @@ PRL_HANDLE PrlSrv_InstallAppliance_Impl(PRL_HANDLE hServer,
 PRL_HANDLE PrlVm_LoginInGuest_Impl(PRL_HANDLE hVm, PRL_CONST_STR sUserName,
 										PRL_CONST_STR sUserPassword, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sUserName) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sUserName) ||
 		 UTF8_2QSTR(sUserName).isEmpty() )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_LOGIN_IN_GUEST))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->LoginInGuest(sUserName, sUserPassword, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5240,10 +5260,10 @@ PRL_HANDLE PrlVm_LoginInGuest_Impl(PRL_HANDLE hVm, PRL_CONST_STR sUserName,
 PRL_HANDLE PrlVm_AuthWithGuestSecurityDb_Impl(PRL_HANDLE hVm, PRL_CONST_STR sUserName,
 										PRL_CONST_STR sUserPassword, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sUserName) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sUserName) ||
 		 UTF8_2QSTR(sUserName).isEmpty() )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_AUTH_WITH_GUEST_SECURITY_DB))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->AuthWithGuestSecurityDb(sUserName, sUserPassword, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5253,9 +5273,9 @@ PRL_HANDLE PrlVm_AuthWithGuestSecurityDb_Impl(PRL_HANDLE hVm, PRL_CONST_STR sUse
 
 PRL_HANDLE PrlVmGuest_Logout_Impl(PRL_HANDLE hVmGuest, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVmGuest, PHT_VM_GUEST_SESSION) )
+	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>( hVmGuest, PHT_VM_GUEST_SESSION );
+	if ( !pVmGuest )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_GUEST_LOGOUT))
-	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>(hVmGuest);
 	PrlHandleJobPtr pJob = pVmGuest->Logout(nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5265,9 +5285,9 @@ PRL_HANDLE PrlVmGuest_Logout_Impl(PRL_HANDLE hVmGuest, PRL_UINT32 nFlags)
 
 PRL_HANDLE PrlVmGuest_GetNetworkSettings_Impl(PRL_HANDLE hVmGuest, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVmGuest, PHT_VM_GUEST_SESSION) )
+	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>( hVmGuest, PHT_VM_GUEST_SESSION );
+	if ( !pVmGuest )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_GUEST_GET_NETWORK_SETTINGS))
-	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>(hVmGuest);
 	PrlHandleJobPtr pJob = pVmGuest->GetNetworkSettings(nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5279,12 +5299,12 @@ PRL_HANDLE PrlVmGuest_RunProgram_Impl(PRL_HANDLE hVmGuest, PRL_CONST_STR sProgra
 							PRL_HANDLE hArgsList, PRL_HANDLE hEnvsList, PRL_UINT32 nFlags,
 							PRL_FILE_DESC nStdin, PRL_FILE_DESC nStdout, PRL_FILE_DESC nStderr)
 {
-	if ( PRL_WRONG_HANDLE(hVmGuest, PHT_VM_GUEST_SESSION) || PRL_WRONG_PTR(sProgramName) ||
+	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>( hVmGuest, PHT_VM_GUEST_SESSION );
+	if ( !pVmGuest || PRL_WRONG_PTR(sProgramName) ||
 			UTF8_2QSTR(sProgramName).isEmpty() ||
 			(PRL_INVALID_HANDLE != hArgsList && PRL_WRONG_HANDLE(hArgsList, PHT_STRINGS_LIST)) ||
 			(PRL_INVALID_HANDLE != hEnvsList && PRL_WRONG_HANDLE(hEnvsList, PHT_STRINGS_LIST)) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_GUEST_RUN_PROGRAM))
-	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>(hVmGuest);
 	PrlHandleJobPtr pJob = pVmGuest->RunProgram(sProgramName, hArgsList, hEnvsList, nFlags, nStdin, nStdout, nStderr);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5295,9 +5315,9 @@ PRL_HANDLE PrlVmGuest_RunProgram_Impl(PRL_HANDLE hVmGuest, PRL_CONST_STR sProgra
 PRL_HANDLE PrlVmGuest_SetUserPasswd_Impl(PRL_HANDLE hVmGuest, PRL_CONST_STR sUserName,
 							PRL_CONST_STR sUserPasswd, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVmGuest, PHT_VM_GUEST_SESSION) )
+	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>( hVmGuest, PHT_VM_GUEST_SESSION );
+	if ( !pVmGuest )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_GUEST_SET_USER_PASSWD))
-	PrlHandleVmGuestPtr pVmGuest = PRL_OBJECT_BY_HANDLE<PrlHandleVmGuest>(hVmGuest);
 	PrlHandleJobPtr pJob = pVmGuest->SetUserPasswd(sUserName, sUserPasswd, nFlags);
  	if (!pJob)
  		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5308,9 +5328,9 @@ PRL_HANDLE PrlVmGuest_SetUserPasswd_Impl(PRL_HANDLE hVmGuest, PRL_CONST_STR sUse
 PRL_HANDLE PrlVm_SetUserPasswd_Impl(PRL_HANDLE hVm, PRL_CONST_STR sUserName,
 							PRL_CONST_STR sUserPasswd, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE))
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_GUEST_SET_USER_PASSWD))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->VmGuestSetUserPasswd(QString(), sUserName, sUserPasswd, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5330,9 +5350,9 @@ PRL_HANDLE PrlVm_DropSuspendedState_Impl(PRL_HANDLE hVm)
 
 PRL_HANDLE PrlVm_Compact_Impl(PRL_HANDLE hVm, PRL_UINT32 uMask, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_COMPACT))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Compact(uMask, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5343,9 +5363,9 @@ PRL_HANDLE PrlVm_Compact_Impl(PRL_HANDLE hVm, PRL_UINT32 uMask, PRL_UINT32 nFlag
 PRL_HANDLE PrlVm_CancelCompact_Impl(PRL_HANDLE hVm)
 {
 
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_CANCEL_COMPACT))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->CancelCompact();
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5355,9 +5375,9 @@ PRL_HANDLE PrlVm_CancelCompact_Impl(PRL_HANDLE hVm)
 
 PRL_HANDLE PrlVm_ConvertDisks_Impl(PRL_HANDLE hVm, PRL_UINT32 uMask, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_CONVERT_DISKS))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->ConvertDisks(uMask, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -5443,20 +5463,20 @@ PRL_HANDLE PrlVmDev_ResizeImage_Impl(PRL_HANDLE hVmDevice, PRL_UINT32 nNewSize,
 
 PRL_HANDLE PrlVm_SubscribeToPerfStats_Impl(PRL_HANDLE handle, PRL_CONST_STR sFilter)
 {
-	PRL_CntxSw_CHECK_HANDLE_ASYNC(handle, PHT_VIRTUAL_MACHINE, PJOC_VM_SUBSCRIBE_PERFSTATS) ;
-	return store_result(PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(handle)->SubscribePerfStats(sFilter)) ;
+	PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(PrlHandleVmSrv, pVm, handle, PHT_VIRTUAL_MACHINE, PJOC_VM_SUBSCRIBE_PERFSTATS) ;
+	return store_result(pVm->SubscribePerfStats(sFilter)) ;
 }
 
 PRL_HANDLE PrlVm_UnsubscribeFromPerfStats_Impl(PRL_HANDLE handle)
 {
-	PRL_CntxSw_CHECK_HANDLE_ASYNC(handle, PHT_VIRTUAL_MACHINE, PJOC_VM_UNSUBSCRIBE_PERFSTATS) ;
-	return store_result(PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(handle)->UnsubscribePerfStats()) ;
+	PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(PrlHandleVmSrv, pVm, handle, PHT_VIRTUAL_MACHINE, PJOC_VM_UNSUBSCRIBE_PERFSTATS) ;
+	return store_result(pVm->UnsubscribePerfStats()) ;
 }
 
 PRL_HANDLE PrlVm_GetPerfStats_Impl(PRL_HANDLE handle, PRL_CONST_STR sFilter)
 {
-	PRL_CntxSw_CHECK_HANDLE_ASYNC(handle, PHT_VIRTUAL_MACHINE, PJOC_VM_GET_PERFSTATS) ;
-	return store_result(PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(handle)->GetPerfStats(sFilter), handle) ;
+	PRL_CntxSw_OBJECT_BY_HANDLE_ASYNC(PrlHandleVmSrv, pVm, handle, PHT_VIRTUAL_MACHINE, PJOC_VM_GET_PERFSTATS) ;
+	return store_result(pVm->GetPerfStats(sFilter), handle) ;
 }
 
 PRL_METHOD( PrlApi_GetRecommendMinVmMem ) (
@@ -5484,7 +5504,7 @@ PRL_ASYNC_METHOD( PrlSrv_StartSearchVms ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_START_SEARCH_VMS)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_StartSearchVms, (hServer, hStringsList))
+		CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_StartSearchVms, (hServer, hStringsList))
 }
 
 PRL_METHOD( PrlSrv_GetSupportedOses ) (
@@ -5500,10 +5520,10 @@ PRL_METHOD( PrlSrv_GetSupportedOses ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(phOsesMatrix) )
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(phOsesMatrix) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	return (pServer->GetSupportedOses(phOsesMatrix));
 }
 
@@ -5524,7 +5544,7 @@ PRL_ASYNC_METHOD( PrlSrv_InstallAppliance ) (
 	nFlags
 	);
 
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), \
+	CALL_THROUGH_OWNER_CTXT(hServer, \
 								PrlSrv_InstallAppliance, (hServer, hAppCfg, sVmParentPath, nFlags))
 }
 
@@ -5545,7 +5565,7 @@ PRL_ASYNC_METHOD( PrlSrv_CancelInstallAppliance ) (
 
 	PRL_CONST_STR buf = "";
 	nFlags = (nFlags | PIAF_CANCEL);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), \
+	CALL_THROUGH_OWNER_CTXT(hServer, \
 								PrlSrv_InstallAppliance, (hServer, hAppCfg, buf, nFlags))
 }
 
@@ -5566,7 +5586,7 @@ PRL_ASYNC_METHOD( PrlSrv_StopInstallAppliance ) (
 
 	PRL_CONST_STR buf = "";
 	nFlags = (nFlags | PIAF_STOP);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), \
+	CALL_THROUGH_OWNER_CTXT(hServer, \
 								PrlSrv_InstallAppliance, (hServer, hAppCfg, buf, nFlags))
 }
 
@@ -5575,7 +5595,7 @@ PRL_ASYNC_METHOD( PrlVm_DropSuspendedState ) (
 								  )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_DROP_SUSPENDED_STATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_DropSuspendedState, (hVm))
+	CALL_DIRECT(hVm, PrlVm_DropSuspendedState, (hVm))
 }
 
 PRL_HANDLE PrlVm_Migrate_Impl(PRL_HANDLE hVm, PRL_HANDLE hTargetServer,
@@ -5583,11 +5603,11 @@ PRL_HANDLE PrlVm_Migrate_Impl(PRL_HANDLE hVm, PRL_HANDLE hTargetServer,
 									   PRL_UINT32 migration_flags, PRL_UINT32 reserved_flags,
 									   PRL_BOOL force_operation)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_HANDLE(hTargetServer, PHT_SERVER)
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	PrlHandleServerPtr pTargetServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>( hTargetServer, PHT_SERVER );
+	if ( !pVm || !pTargetServer
 		|| PRL_WRONG_PTR(target_name) || PRL_WRONG_PTR(target_home_path)	)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_MIGRATE))
-		PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
-	PrlHandleServerPtr pTargetServer = PRL_OBJECT_BY_HANDLE<PrlHandleServer>(hTargetServer);
 	PrlHandleJobPtr pJob = pVm->Migrate(pTargetServer, target_name, target_home_path, migration_flags, reserved_flags,
 		force_operation);
 	if (!pJob)
@@ -5621,10 +5641,10 @@ PRL_HANDLE PrlVm_MigrateEx_Impl(PRL_HANDLE hVm,
 										 PRL_UINT32 reserved_flags,
 										 PRL_BOOL force_operation)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(target_host) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(target_host) ||
 		PRL_WRONG_PTR(target_session_id) || PRL_WRONG_PTR(target_name) || PRL_WRONG_PTR(target_home_path))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_MIGRATE))
-		PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Migrate(target_host, target_port, target_session_id,
 		target_name, target_home_path,
 		migration_flags, reserved_flags, force_operation);
@@ -5647,7 +5667,7 @@ PRL_ASYNC_METHOD( PrlVm_MigrateEx ) (
 {
 	PRL_CONST_STR target_name = "";
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_MIGRATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_MigrateEx, (hVm, target_host, target_port, target_session_id,
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_MigrateEx, (hVm, target_host, target_port, target_session_id,
 							target_name, target_home_path, migration_flags, reserved_flags, force_operation))
 }
 
@@ -5679,7 +5699,7 @@ PRL_ASYNC_METHOD( PrlVm_MigrateWithRenameEx ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_MIGRATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_MigrateEx, (hVm, target_host, target_port, target_session_id,
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_MigrateEx, (hVm, target_host, target_port, target_session_id,
 							target_name, target_home_path, migration_flags, reserved_flags, force_operation))
 }
 
@@ -5688,7 +5708,7 @@ PRL_ASYNC_METHOD( PrlVm_MigrateCancel) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_MIGRATE_CANCEL)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_MigrateCancel, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_MigrateCancel, (hVm))
 }
 
 PRL_HANDLE PrlSrv_CreateVmBackup_Impl(
@@ -5702,10 +5722,10 @@ PRL_HANDLE PrlSrv_CreateVmBackup_Impl(
 		PRL_UINT32 reserved_flags,
 		PRL_BOOL force_operation)
 {
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sVmUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sVmUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CREATE_VM_BACKUP))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdCreateVmBackup(
 			sVmUuid,
 			sTargetHost,
@@ -5734,8 +5754,8 @@ PRL_ASYNC_METHOD( PrlSrv_CreateVmBackup ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CREATE_VM_BACKUP)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_CreateVmBackup,
 		(hSourceServer, sVmUuid, sTargetHost, nTargetPort, sTargetSessionId, sDescription,
 			backup_flags, reserved_flags, force_operation))
@@ -5755,10 +5775,10 @@ PRL_HANDLE PrlSrv_RestoreVmBackup_Impl(
 		PRL_BOOL force_operation)
 {
 	PRL_UNUSED_PARAM(force_operation);
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_RESTORE_VM_BACKUP))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdRestoreVmBackup(
 			sVmUuid,
 			sBackupUuid,
@@ -5790,8 +5810,8 @@ PRL_ASYNC_METHOD( PrlSrv_RestoreVmBackup ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_RESTORE_VM_BACKUP)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_RestoreVmBackup,
 		(hSourceServer, sVmUuid, sBackupUuid, sTargetHost, nTargetPort, sTargetSessionId,
 			sTargetVmHomePath, sTargetVmName, restore_flags, reserved_flags, force_operation))
@@ -5807,10 +5827,10 @@ PRL_HANDLE PrlSrv_GetBackupTree_Impl(
 		PRL_UINT32 reserved_flags,
 		PRL_BOOL force_operation)
 {
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_GET_BACKUP_TREE))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdGetBackupTree(
 			sUuid,
 			sTargetHost,
@@ -5837,8 +5857,8 @@ PRL_ASYNC_METHOD( PrlSrv_GetBackupTree ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_BACKUP_TREE)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_GetBackupTree,
 		(hSourceServer, sUuid, sTargetHost, nTargetPort, sTargetSessionId,
 			backup_flags, reserved_flags, force_operation))
@@ -5855,10 +5875,10 @@ PRL_HANDLE PrlSrv_RemoveVmBackup_Impl(
 		PRL_UINT32 reserved_flags,
 		PRL_BOOL force_operation)
 {
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REMOVE_VM_BACKUP))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdRemoveVmBackup(
 			sVmUuid,
 			sBackupUuid,
@@ -5887,8 +5907,8 @@ PRL_ASYNC_METHOD( PrlSrv_RemoveVmBackup ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REMOVE_VM_BACKUP)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_RemoveVmBackup,
 		(hSourceServer, sVmUuid, sBackupUuid, sTargetHost, nTargetPort, sTargetSessionId,
 			restore_flags, reserved_flags, force_operation))
@@ -5907,10 +5927,10 @@ PRL_HANDLE PrlSrv_CreateVmBackupEx_Impl(
 		const PRL_BACKUP_PARAM *pExtra)
 
 {
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sVmUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sVmUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CREATE_VM_BACKUP))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdCreateVmBackup(
 			sVmUuid,
 			sTargetHost,
@@ -5940,8 +5960,8 @@ PRL_ASYNC_METHOD( PrlSrv_CreateVmBackupEx ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CREATE_VM_BACKUP)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_CreateVmBackupEx,
 		(hSourceServer, sVmUuid, sTargetHost, nTargetPort, sTargetSessionId, sDescription,
 			backup_flags, reserved_flags, force_operation, pExtra))
@@ -5962,10 +5982,10 @@ PRL_HANDLE PrlSrv_RestoreVmBackupEx_Impl(
 		const PRL_BACKUP_PARAM *pExtra)
 {
 	PRL_UNUSED_PARAM(force_operation);
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_RESTORE_VM_BACKUP))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdRestoreVmBackup(
 			sVmUuid,
 			sBackupUuid,
@@ -5998,8 +6018,8 @@ PRL_ASYNC_METHOD( PrlSrv_RestoreVmBackupEx ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_RESTORE_VM_BACKUP)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_RestoreVmBackupEx,
 		(hSourceServer, sVmUuid, sBackupUuid, sTargetHost, nTargetPort, sTargetSessionId,
 			sTargetVmHomePath, sTargetVmName, restore_flags, reserved_flags, force_operation, pExtra))
@@ -6017,10 +6037,10 @@ PRL_HANDLE PrlSrv_GetBackupTreeEx_Impl(
 		PRL_BOOL force_operation,
 		const PRL_BACKUP_PARAM *pExtra)
 {
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_GET_BACKUP_TREE))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdGetBackupTree(
 			sUuid,
 			sTargetHost,
@@ -6048,8 +6068,8 @@ PRL_ASYNC_METHOD( PrlSrv_GetBackupTreeEx ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_BACKUP_TREE)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_GetBackupTreeEx,
 		(hSourceServer, sUuid, sTargetHost, nTargetPort, sTargetSessionId,
 			backup_flags, reserved_flags, force_operation, pExtra))
@@ -6067,10 +6087,10 @@ PRL_HANDLE PrlSrv_RemoveVmBackupEx_Impl(
 		PRL_BOOL force_operation,
 		const PRL_BACKUP_PARAM *pExtra)
 {
-	if (PRL_WRONG_HANDLE(hSourceServer, PHT_SERVER) || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
+	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSourceServer, PHT_SERVER );
+	if (!pSourceServer || PRL_WRONG_PTR(sVmUuid) || PRL_WRONG_PTR(sBackupUuid) ||
 			PRL_WRONG_PTR(sTargetHost) || PRL_WRONG_PTR(sTargetSessionId))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REMOVE_VM_BACKUP))
-	PrlHandleServerVmPtr pSourceServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSourceServer);
 	PrlHandleJobPtr pJob = pSourceServer->DspCmdRemoveVmBackup(
 			sVmUuid,
 			sBackupUuid,
@@ -6100,8 +6120,8 @@ PRL_ASYNC_METHOD( PrlSrv_RemoveVmBackupEx ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REMOVE_VM_BACKUP)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hSourceServer,
 		PrlSrv_RemoveVmBackupEx,
 		(hSourceServer, sVmUuid, sBackupUuid, sTargetHost, nTargetPort, sTargetSessionId,
 			restore_flags, reserved_flags, force_operation, pExtra))
@@ -6123,7 +6143,7 @@ PRL_ASYNC_METHOD( PrlVm_LoginInGuest ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_LOGIN_IN_GUEST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_LoginInGuest, (hVm, sUserName, sUserPassword, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_LoginInGuest, (hVm, sUserName, sUserPassword, nFlags))
 }
 
 PRL_ASYNC_METHOD( PrlVm_AuthWithGuestSecurityDb ) (
@@ -6142,7 +6162,7 @@ PRL_ASYNC_METHOD( PrlVm_AuthWithGuestSecurityDb ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_AUTH_WITH_GUEST_SECURITY_DB)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_AuthWithGuestSecurityDb, (hVm, sUserName, sUserPassword, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_AuthWithGuestSecurityDb, (hVm, sUserName, sUserPassword, nFlags))
 }
 
 PRL_METHOD( PrlVmCfg_GetOfflineServices ) (
@@ -6158,10 +6178,10 @@ PRL_METHOD( PrlVmCfg_GetOfflineServices ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phOfflineServicesList))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm || PRL_WRONG_PTR(phOfflineServicesList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetOfflineServices(phOfflineServicesList));
 }
 
@@ -6178,12 +6198,12 @@ PRL_METHOD( PrlVmCfg_SetOfflineServices ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
-		(PRL_INVALID_HANDLE != hOfflineServicesList && PRL_WRONG_HANDLE(hOfflineServicesList, PHT_STRINGS_LIST)))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	PrlHandleStringsListPtr pOfflineServicesList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hOfflineServicesList, PHT_STRINGS_LIST );
+	if (!pVm ||
+		(PRL_INVALID_HANDLE != hOfflineServicesList && !pOfflineServicesList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
-	PrlHandleStringsListPtr pOfflineServicesList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hOfflineServicesList);
 	return (pVm->SetOfflineServices(pOfflineServicesList.getHandle() ? pOfflineServicesList->GetStringsList() : QStringList()));
 }
 
@@ -6279,7 +6299,7 @@ PRL_ASYNC_METHOD( PrlVm_SetUserPasswd ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GUEST_SET_USER_PASSWD)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_SetUserPasswd, (hVm, sUserName, sUserPasswd, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_SetUserPasswd, (hVm, sUserName, sUserPasswd, nFlags))
 }
 
 PRL_METHOD( PrlVmCfg_SetDefaultConfig ) (
@@ -6291,10 +6311,10 @@ PRL_METHOD( PrlVmCfg_SetDefaultConfig ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>(hSrvConfig);
 	return (pVm->SetDefaultConfig(pSrvConfig, guestOsVersion, needCreateDevices));
 }
@@ -6307,12 +6327,12 @@ PRL_METHOD( PrlVmCfg_AddDefaultDevice ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION)
-		|| (hSrvConfig != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG)))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if ( !pVm
+		|| (hSrvConfig != PRL_INVALID_HANDLE && !pSrvConfig))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>(hSrvConfig);
 	return (pVm->AddDefaultDevice(pSrvConfig, deviceType));
 }
 
@@ -6326,13 +6346,13 @@ PRL_METHOD( PrlVmCfg_AddDefaultDeviceEx ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION)
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
+	if ( !pVm
 		|| PRL_WRONG_PTR(phVmDevice)
-		|| (hSrvConfig != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hSrvConfig, PHT_SERVER_CONFIG)))
+		|| (hSrvConfig != PRL_INVALID_HANDLE && !pSrvConfig))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>(hSrvConfig);
 	return (pVm->AddDefaultDeviceEx(pSrvConfig, deviceType, phVmDevice));
 }
 
@@ -6398,12 +6418,11 @@ PRL_METHOD( PrlVmCfg_GetDefaultVideoRamSize ) (
 		);
 
 	SYNC_CHECK_API_INITIALIZED
+	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>( hSrvConfig, PHT_SERVER_CONFIG );
 	if ( PRL_WRONG_PTR( pnVideoRamSize ) ||
-			( PRL_INVALID_HANDLE != hSrvConfig && PRL_WRONG_HANDLE( hSrvConfig, PHT_SERVER_CONFIG ) ) )
+			( PRL_INVALID_HANDLE != hSrvConfig && !pSrvConfig ) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleSrvConfigPtr pSrvConfig = PRL_OBJECT_BY_HANDLE<PrlHandleSrvConfig>(hSrvConfig);
-
 	*pnVideoRamSize = PrlHandleVmDefaultConfig::GetDefaultVideoRamSize( guestOsVersion, pSrvConfig, bIs3DSupportEnabled );
 	return PRL_ERR_SUCCESS;
 }
@@ -6411,10 +6430,10 @@ PRL_METHOD( PrlVmCfg_GetDefaultVideoRamSize ) (
 PRL_HANDLE PrlVm_RegEx_Impl(PRL_HANDLE hVm, PRL_CONST_STR sVmParentPath, PRL_UINT32 nFlags)
 {
 	// We always have to ensure input parameters validity
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sVmParentPath) )
+	PrlHandleVmPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVm>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sVmParentPath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_REG))
 
-		PrlHandleVmPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVm>(hVm);
 	if (!pVm->GetServer())
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_REG))
 
@@ -6432,7 +6451,7 @@ PRL_ASYNC_METHOD( PrlVm_RegEx) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_REG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_RegEx, (hVm, sVmParentPath, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_RegEx, (hVm, sVmParentPath, nFlags))
 }
 
 
@@ -6460,10 +6479,10 @@ PRL_METHOD( PrlVmCfg_CreateVmDev) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_VM_DEVICE_TYPE(device_type) || PRL_WRONG_PTR(phVmDevice) )
+	PrlHandleVmPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVm>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_VM_DEVICE_TYPE(device_type) || PRL_WRONG_PTR(phVmDevice) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVm>(hVmCfg);
 	return (PrlHandleVmDevice::CreateVmDevice(pVm, device_type, phVmDevice));
 }
 
@@ -6480,10 +6499,10 @@ PRL_METHOD( PrlVmCfg_GetDevsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(vmdev_handles_count) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(vmdev_handles_count) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return (pVm->GetDevicesCount(vmdev_handles_count));
 }
@@ -6502,10 +6521,10 @@ PRL_METHOD( PrlVmCfg_GetAllDevices ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phDevsList) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(phDevsList) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return (pVm->GetAllDevices(phDevsList));
 }
@@ -6522,10 +6541,10 @@ PRL_METHOD( PrlVmCfg_GetDevsCountByType ) (
 	if (vmDeviceType >= PDE_MAX)
 	   return PRL_ERR_INVALID_ARG ;
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(pnDevicesCount))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm || PRL_WRONG_PTR(pnDevicesCount))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetDevsCountByType(vmDeviceType, pnDevicesCount) ;
 }
@@ -6540,13 +6559,13 @@ PRL_METHOD( PrlVmCfg_GetDevByType ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phDevice))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm || PRL_WRONG_PTR(phDevice))
 		return (PRL_ERR_INVALID_ARG);
 
 	if (vmDeviceType >= PDE_MAX)
 	   return PRL_ERR_INVALID_ARG ;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 	return pVm->GetDevByType(vmDeviceType, nIndex, phDevice) ;
 }
 
@@ -6751,10 +6770,10 @@ PRL_METHOD( PrlVmCfg_CreateShare) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phVmShare) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(phVmShare) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->CreateShare(phVmShare));
 }
 
@@ -6771,10 +6790,10 @@ PRL_METHOD( PrlVmCfg_GetSharesCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(pnSharesCount) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(pnSharesCount) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetSharesCount(pnSharesCount));
 }
 
@@ -6794,10 +6813,10 @@ PRL_METHOD( PrlVmCfg_GetShare) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phVmShare) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(phVmShare) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetShare(nShareIndex, phVmShare));
 }
 
@@ -6853,11 +6872,11 @@ PRL_METHOD( PrlVmCfg_IsSmartMountEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsSmartMountEnabled(pbEnabled));
 }
 
@@ -6874,10 +6893,10 @@ PRL_METHOD( PrlVmCfg_SetSmartMountEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartMountEnabled(bEnabled));
 }
 
@@ -6894,11 +6913,11 @@ PRL_METHOD( PrlVmCfg_IsSmartMountRemovableDrivesEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsSmartMountRemovableDrivesEnabled(pbEnabled));
 }
 
@@ -6915,10 +6934,10 @@ PRL_METHOD( PrlVmCfg_SetSmartMountRemovableDrivesEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartMountRemovableDrivesEnabled(bEnabled));
 }
 
@@ -6935,11 +6954,11 @@ PRL_METHOD( PrlVmCfg_IsSmartMountDVDsEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsSmartMountDVDsEnabled(pbEnabled));
 }
 
@@ -6956,10 +6975,10 @@ PRL_METHOD( PrlVmCfg_SetSmartMountDVDsEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartMountDVDsEnabled(bEnabled));
 }
 
@@ -6976,11 +6995,11 @@ PRL_METHOD( PrlVmCfg_IsSmartMountNetworkSharesEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsSmartMountNetworkSharesEnabled(pbEnabled));
 }
 
@@ -6997,10 +7016,10 @@ PRL_METHOD( PrlVmCfg_SetSmartMountNetworkSharesEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartMountNetworkSharesEnabled(bEnabled));
 }
 
@@ -7017,11 +7036,11 @@ PRL_METHOD( PrlVmCfg_IsSmartGuardEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsSmartGuardEnabled(pbEnabled));
 }
 
@@ -7038,10 +7057,10 @@ PRL_METHOD( PrlVmCfg_SetSmartGuardEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartGuardEnabled(bEnabled));
 }
 
@@ -7058,11 +7077,11 @@ PRL_METHOD( PrlVmCfg_IsSmartGuardNotifyBeforeCreation ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbNotifyBeforeCreation) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsSmartGuardNotifyBeforeCreation(pbNotifyBeforeCreation));
 }
 
@@ -7079,10 +7098,10 @@ PRL_METHOD( PrlVmCfg_SetSmartGuardNotifyBeforeCreation ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartGuardNotifyBeforeCreation(bNotifyBeforeCreation));
 }
 
@@ -7099,11 +7118,11 @@ PRL_METHOD( PrlVmCfg_GetSmartGuardInterval ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pnInterval) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetSmartGuardInterval(pnInterval));
 }
 
@@ -7120,10 +7139,10 @@ PRL_METHOD( PrlVmCfg_SetSmartGuardInterval ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartGuardInterval(nInterval));
 }
 
@@ -7140,11 +7159,11 @@ PRL_METHOD( PrlVmCfg_GetSmartGuardMaxSnapshotsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pnMaxSnapshotsCount) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetSmartGuardMaxSnapshotsCount(pnMaxSnapshotsCount));
 }
 
@@ -7161,10 +7180,10 @@ PRL_METHOD( PrlVmCfg_SetSmartGuardMaxSnapshotsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSmartGuardMaxSnapshotsCount(nMaxSnapshotsCount));
 }
 
@@ -7181,11 +7200,11 @@ PRL_METHOD( PrlVmCfg_IsAllowSelectBootDevice ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbAllowed) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsAllowSelectBootDevice(pbAllowed));
 }
 
@@ -7202,10 +7221,10 @@ PRL_METHOD( PrlVmCfg_SetAllowSelectBootDevice ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetAllowSelectBootDevice(bAllowed));
 }
 
@@ -7222,11 +7241,11 @@ PRL_METHOD( PrlVmCfg_IsEfiEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pbEfiEnabled))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->IsEfiEnabled(pbEfiEnabled));
 }
@@ -7244,10 +7263,10 @@ PRL_METHOD( PrlVmCfg_SetEfiEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetEfiEnabled(bEfiEnabled));
 }
@@ -7267,11 +7286,11 @@ PRL_METHOD( PrlVmCfg_GetExternalBootDevice) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnSysNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetExternalBootDevice(sSysName, pnSysNameBufLength));
 }
@@ -7289,11 +7308,11 @@ PRL_METHOD( PrlVmCfg_SetExternalBootDevice) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewSysName))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetExternalBootDevice(sNewSysName));
 }
@@ -7311,11 +7330,11 @@ PRL_METHOD( PrlVmCfg_IsSharedProfileEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsSharedProfileEnabled(pbEnabled));
 }
 
@@ -7332,10 +7351,10 @@ PRL_METHOD( PrlVmCfg_SetSharedProfileEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetSharedProfileEnabled(bEnabled));
 }
 
@@ -7352,11 +7371,11 @@ PRL_METHOD( PrlVmCfg_IsUseDesktop ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsUseDesktop(pbEnabled));
 }
 
@@ -7373,10 +7392,10 @@ PRL_METHOD( PrlVmCfg_SetUseDesktop ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetUseDesktop(bEnabled));
 }
 
@@ -7393,11 +7412,11 @@ PRL_METHOD( PrlVmCfg_IsUseDocuments ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsUseDocuments(pbEnabled));
 }
 
@@ -7414,10 +7433,10 @@ PRL_METHOD( PrlVmCfg_SetUseDocuments ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetUseDocuments(bEnabled));
 }
 
@@ -7434,11 +7453,11 @@ PRL_METHOD( PrlVmCfg_IsUsePictures ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsUsePictures(pbEnabled));
 }
 
@@ -7455,10 +7474,10 @@ PRL_METHOD( PrlVmCfg_SetUsePictures ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetUsePictures(bEnabled));
 }
 
@@ -7475,11 +7494,11 @@ PRL_METHOD( PrlVmCfg_IsUseMusic ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsUseMusic(pbEnabled));
 }
 
@@ -7496,10 +7515,10 @@ PRL_METHOD( PrlVmCfg_SetUseMusic ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetUseMusic(bEnabled));
 }
 
@@ -7516,11 +7535,11 @@ PRL_METHOD( PrlVmCfg_IsUseDownloads ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsUseDownloads(pbEnabled));
 }
 
@@ -7537,10 +7556,10 @@ PRL_METHOD( PrlVmCfg_SetUseDownloads ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetUseDownloads(bEnabled));
 }
 
@@ -7557,11 +7576,11 @@ PRL_METHOD( PrlVmCfg_IsUseMovies ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsUseMovies(pbEnabled));
 }
 
@@ -7578,10 +7597,10 @@ PRL_METHOD( PrlVmCfg_SetUseMovies ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetUseMovies(bEnabled));
 }
 
@@ -7598,11 +7617,11 @@ PRL_METHOD( PrlVmCfg_GetOptimizeModifiersMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pnMode) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetOptimizeModifiersMode(pnMode));
 }
 
@@ -7619,10 +7638,10 @@ PRL_METHOD( PrlVmCfg_SetOptimizeModifiersMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetOptimizeModifiersMode(nMode));
 }
 
@@ -7639,11 +7658,11 @@ PRL_METHOD( PrlVmCfg_IsShareClipboard ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsShareClipboard(pbEnabled));
 }
 
@@ -7660,10 +7679,10 @@ PRL_METHOD( PrlVmCfg_SetShareClipboard ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetShareClipboard(bEnabled));
 }
 
@@ -7680,11 +7699,11 @@ PRL_METHOD( PrlVmCfg_IsTimeSynchronizationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsTimeSynchronizationEnabled(pbEnabled));
 }
 
@@ -7701,10 +7720,10 @@ PRL_METHOD( PrlVmCfg_SetTimeSynchronizationEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetTimeSynchronizationEnabled(bEnabled));
 }
 
@@ -7721,11 +7740,11 @@ PRL_METHOD( PrlVmCfg_IsTimeSyncSmartModeEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pbEnabled) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->IsTimeSyncSmartModeEnabled(pbEnabled));
 }
 
@@ -7742,10 +7761,10 @@ PRL_METHOD( PrlVmCfg_SetTimeSyncSmartModeEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetTimeSyncSmartModeEnabled(bEnabled));
 }
 
@@ -7762,11 +7781,11 @@ PRL_METHOD( PrlVmCfg_GetTimeSyncInterval ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 			PRL_WRONG_PTR(pnTimeSyncInterval) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetTimeSyncInterval(pnTimeSyncInterval));
 }
 
@@ -7783,10 +7802,10 @@ PRL_METHOD( PrlVmCfg_SetTimeSyncInterval ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetTimeSyncInterval(nTimeSyncInterval));
 }
 
@@ -7803,10 +7822,10 @@ PRL_METHOD( PrlVmCfg_CreateBootDev) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phVmBootDev) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(phVmBootDev) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->CreateBootDev(phVmBootDev));
 }
 
@@ -7823,10 +7842,10 @@ PRL_METHOD( PrlVmCfg_GetBootDevCount) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(pnBootDevCount) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(pnBootDevCount) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetBootDevCount(pnBootDevCount));
 }
 
@@ -7846,10 +7865,10 @@ PRL_METHOD( PrlVmCfg_GetBootDev) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(phVmBootDev) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(phVmBootDev) )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetBootDev(nBootDevIndex, phVmBootDev));
 }
 
@@ -7866,10 +7885,10 @@ PRL_METHOD( PrlVmCfg_SetCpuUnits ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCpuUnits(nVmCpuUnits));
 }
@@ -7887,11 +7906,11 @@ PRL_METHOD( PrlVmCfg_GetCpuUnits ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pnVmCpuUnits))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCpuUnits(pnVmCpuUnits));
 }
@@ -7909,10 +7928,10 @@ PRL_METHOD( PrlVmCfg_SetCpuLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCpuLimit(nVmCpuLimit));
 }
@@ -7930,11 +7949,11 @@ PRL_METHOD( PrlVmCfg_GetCpuLimit ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pnVmCpuLimit))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCpuLimit(pnVmCpuLimit));
 }
@@ -7950,7 +7969,8 @@ PRL_METHOD( PrlVmCfg_SetCpuLimitEx ) (
 			pVmCpuLimit
 		   );
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pVmCpuLimit))
 		return (PRL_ERR_INVALID_ARG);
 
@@ -7960,8 +7980,6 @@ PRL_METHOD( PrlVmCfg_SetCpuLimitEx ) (
 	    pVmCpuLimit->type != PRL_CPULIMIT_PERCENTS_TO_MHZ)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
-
 	return (pVm->SetCpuLimitEx(pVmCpuLimit));
 }
 
@@ -7976,7 +7994,8 @@ PRL_METHOD( PrlVmCfg_GetCpuLimitEx ) (
 			pVmCpuLimit
 		   );
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pVmCpuLimit))
 		return (PRL_ERR_INVALID_ARG);
 
@@ -7985,8 +8004,6 @@ PRL_METHOD( PrlVmCfg_GetCpuLimitEx ) (
 	    pVmCpuLimit->type != PRL_CPULIMIT_MHZ)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
-
 	return (pVm->GetCpuLimitEx(pVmCpuLimit));
 }
 
@@ -8003,11 +8020,11 @@ PRL_METHOD( PrlVmCfg_GetGuestCpuLimitType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pnVmGuestCpuLimitType))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetGuestCpuLimitType(pnVmGuestCpuLimitType));
 }
@@ -8017,10 +8034,10 @@ PRL_METHOD( PrlVmCfg_SetCpuMask) (
 		PRL_CONST_STR sMask
 		)
 {
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetCpuMask(sMask));
 }
@@ -8031,11 +8048,11 @@ PRL_RESULT PrlVmCfg_GetCpuMask(
 		PRL_UINT32_PTR pnMaskBufLength
 		)
 {
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pnMaskBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetCpuMask(sMask, pnMaskBufLength));
 }
@@ -8045,11 +8062,11 @@ PRL_METHOD( PrlVmCfg_SetNodeMask) (
 		PRL_CONST_STR sMask
 		)
 {
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_PTR(sMask))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetNodeMask(sMask));
 }
@@ -8060,12 +8077,12 @@ PRL_RESULT PrlVmCfg_GetNodeMask(
 		PRL_UINT32_PTR pnMaskBufLength
 		)
 {
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_PTR(sMask) ||
 	    PRL_WRONG_PTR(pnMaskBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetNodeMask(sMask, pnMaskBufLength));
 }
@@ -8077,11 +8094,11 @@ PRL_METHOD( PrlVmCfg_SetIoPriority ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    nVmIoPriority > PRL_IOPRIO_MAX)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetIoPriority(nVmIoPriority));
 }
@@ -8093,11 +8110,11 @@ PRL_METHOD( PrlVmCfg_GetIoPriority ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pnVmIoPriority))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetIoPriority(pnVmIoPriority));
 }
@@ -8119,10 +8136,10 @@ PRL_METHOD( PrlVmCfg_SetIopsLimit ) (
 	return PRL_ERR_UNIMPLEMENTED;
 #endif
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetIopsLimit(nVmIopsLimit));
 }
@@ -8138,11 +8155,11 @@ PRL_METHOD( PrlVmCfg_GetIopsLimit ) (
 	return PRL_ERR_UNIMPLEMENTED;
 #endif
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pnVmIopsLimit))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetIopsLimit(pnVmIopsLimit));
 }
@@ -8160,15 +8177,14 @@ PRL_METHOD( PrlVmCfg_SetIoLimit ) (
 			pVmIoLimit
 		   );
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pVmIoLimit))
 		return (PRL_ERR_INVALID_ARG);
 
 	if (pVmIoLimit->type != PRL_IOLIMIT_BS)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
-
 	return (pVm->SetIoLimit(pVmIoLimit));
 }
 
@@ -8185,15 +8201,14 @@ PRL_METHOD( PrlVmCfg_GetIoLimit ) (
 			pVmIoLimit
 		   );
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 	    PRL_WRONG_PTR(pVmIoLimit))
 		return (PRL_ERR_INVALID_ARG);
 
 	if (pVmIoLimit->type != PRL_IOLIMIT_BS)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
-
 	return (pVm->GetIoLimit(pVmIoLimit));
 }
 
@@ -8233,7 +8248,7 @@ PRL_ASYNC_METHOD( PrlVm_CreateUnattendedFloppy ) (
 	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sUsername) || PRL_WRONG_PTR(sCompanyName) ||
 				PRL_WRONG_PTR(sSerialKey) )
 		return GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_CREATE_UNATTENDED_FLOPPY);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_CreateUnattendedFloppy, (hVm, nGuestDistroType, sUsername, sCompanyName, sSerialKey))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_CreateUnattendedFloppy, (hVm, nGuestDistroType, sUsername, sCompanyName, sSerialKey))
 }
 
 PRL_HANDLE PrlSrv_CreateUnattendedCd_Impl(
@@ -8247,11 +8262,11 @@ PRL_HANDLE PrlSrv_CreateUnattendedCd_Impl(
 		)
 
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(sUserName) || PRL_WRONG_PTR(sPasswd) ||
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(sUserName) || PRL_WRONG_PTR(sPasswd) ||
 		PRL_WRONG_PTR(sFullUserName) || PRL_WRONG_PTR(sOsDistroPath) || PRL_WRONG_PTR(sOutImagePath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_CREATE_UNATTENDED_CD))
 
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdCreateUnattendedCd(nGuestType, sUserName,
 		sPasswd, sFullUserName, sOsDistroPath, sOutImagePath);
 	if (!pJob)
@@ -8270,8 +8285,8 @@ PRL_ASYNC_METHOD( PrlSrv_CreateUnattendedCd ) (
 )
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_CREATE_UNATTENDED_CD)
-	CALL_THROUGH_CTXT_SWITCHER(
-		PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(
+		hServer,
 		PrlSrv_CreateUnattendedCd,
 		(hServer, nGuestType, sUserName, sPasswd, sFullUserName, sOsDistroPath, sOutImagePath))
 }
@@ -8281,11 +8296,11 @@ PRL_HANDLE PrlSrv_GetDefaultVmConfig_Impl(
 		PRL_CONST_GET_VM_CONFIG_PARAM_DATA_PTR pParam,
 		PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(pParam) ||
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if ( !pServer || PRL_WRONG_PTR(pParam) ||
 	     (pParam->nVmType != PVT_VM && pParam->nVmType != PVT_CT))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_GET_DEFAULT_VM_CONFIG))
 
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer );
 	PrlHandleJobPtr pJob = pServer->DspCmdGetDefaultVmConfig(pParam, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -8299,7 +8314,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetDefaultVmConfig ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_DEFAULT_VM_CONFIG)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetDefaultVmConfig, (hServer, pParam, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetDefaultVmConfig, (hServer, pParam, nFlags))
 }
 
 PRL_METHOD( PrlVmDev_Create) (
@@ -9009,11 +9024,11 @@ PRL_METHOD( PrlVmDevHd_GetDiskType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnDiskType))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->GetDiskType(pnDiskType));
 }
 
@@ -9030,10 +9045,10 @@ PRL_METHOD( PrlVmDevHd_SetDiskType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK))
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->SetDiskType(nDiskType));
 }
 
@@ -9050,11 +9065,11 @@ PRL_METHOD( PrlVmDevHd_IsSplitted ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pbSplitted))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->IsSplitted(pbSplitted));
 }
 
@@ -9071,10 +9086,10 @@ PRL_METHOD( PrlVmDevHd_SetSplitted ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK))
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->SetSplitted(bSplitted));
 }
 
@@ -9091,11 +9106,11 @@ PRL_METHOD( PrlVmDevHd_GetDiskSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnDiskSize))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->GetDiskSize(pnDiskSize));
 }
 
@@ -9112,10 +9127,10 @@ PRL_METHOD( PrlVmDevHd_SetDiskSize ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK))
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->SetDiskSize(nDiskSize));
 }
 
@@ -9132,11 +9147,11 @@ PRL_METHOD( PrlVmDevHd_GetSizeOnDisk ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnOnDiskSize))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->GetSizeOnDisk(pnOnDiskSize));
 }
 
@@ -9153,11 +9168,11 @@ PRL_METHOD( PrlVmDevHd_AddPartition ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(phPartition))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return pDevice->AddPartition(phPartition);
 }
 
@@ -9174,11 +9189,11 @@ PRL_METHOD( PrlVmDevHd_GetPartitionsCount ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnPartitionsCount))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return pDevice->GetPartitionsCount(pnPartitionsCount);
 }
 
@@ -9197,11 +9212,11 @@ PRL_METHOD( PrlVmDevHd_GetPartition ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(phPartition))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return pDevice->GetPartition(nIndex, phPartition);
 }
 
@@ -9212,11 +9227,11 @@ PRL_METHOD( PrlVmDevHd_SetMountPoint ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(sMountPoint))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return pDevice->SetMountPoint(sMountPoint);
 }
 
@@ -9228,11 +9243,11 @@ PRL_METHOD( PrlVmDevHd_GetMountPoint ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnMountPointBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return pDevice->GetMountPoint(sMountPoint, pnMountPointBufLength);
 }
 
@@ -9249,10 +9264,10 @@ PRL_METHOD( PrlVmDevHd_SetStorageURL ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK))
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->SetStorageURL(sURL));
 }
 
@@ -9271,11 +9286,11 @@ PRL_METHOD( PrlVmDevHd_GetStorageURL ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnURLBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->GetStorageURL(sURL, pnURLBufLength));
 }
 
@@ -9286,10 +9301,10 @@ PRL_METHOD( PrlVmDevHd_SetAutoCompressEnabled ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK))
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return pDevice->SetAutoCompressEnabled(bEnabled);
 }
 
@@ -9300,11 +9315,11 @@ PRL_METHOD( PrlVmDevHd_IsAutoCompressEnabled ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return pDevice->IsAutoCompressEnabled(pbEnabled);
 }
 
@@ -9323,11 +9338,11 @@ PRL_METHOD( PrlVmDevHd_GetSerialNumber ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK) ||
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnSerialNumberBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->GetSerialNumber(sSerialNumber, pnSerialNumberBufLength));
 }
 
@@ -9344,10 +9359,10 @@ PRL_METHOD( PrlVmDevHd_SetSerialNumber ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK))
+	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHardDrivePtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
 	return (pDevice->SetSerialNumber(sSerialNumber));
 }
 
@@ -9358,15 +9373,13 @@ PRL_METHOD(PrlVmDevHd_GetEncryption) (PRL_HANDLE hVmDev, PRL_HANDLE_PTR phEncryp
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK)
+	PrlHandleVmDeviceHardDrivePtr pDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	if (!pDev
 		|| PRL_WRONG_PTR(phEncryption))
 	{
 		return PRL_ERR_INVALID_ARG;
 	}
 
-	PrlHandleVmDeviceHardDrivePtr pDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
-	if (!pDev.isValid())
-		return PRL_ERR_INVALID_ARG;
 	return pDev->GetEncryption(phEncryption);
 }
 
@@ -9377,15 +9390,9 @@ PRL_METHOD(PrlVmDevHd_SetEncryption) (PRL_HANDLE hVmDev, PRL_HANDLE hEncryption)
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_HARD_DISK)
-		|| PRL_WRONG_HANDLE(hEncryption, PHT_VIRTUAL_DISK_ENCRYPTION))
-	{
-		return PRL_ERR_INVALID_ARG;
-	}
-
-	PrlHandleVmDeviceHardDrivePtr pDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>(hVmDev);
-	PrlHandleVirtualDiskEncryptionPtr pEnc = PRL_OBJECT_BY_HANDLE<PrlHandleVirtualDiskEncryption>(hEncryption);
-	if (!pDev.isValid() || !pEnc.isValid())
+	PrlHandleVmDeviceHardDrivePtr pDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHardDrive>( hVmDev, PHT_VIRTUAL_DEV_HARD_DISK );
+	PrlHandleVirtualDiskEncryptionPtr pEnc = PRL_OBJECT_BY_HANDLE<PrlHandleVirtualDiskEncryption>( hEncryption, PHT_VIRTUAL_DISK_ENCRYPTION );
+	if (!pDev || !pEnc)
 		return PRL_ERR_INVALID_ARG;
 
 	return (pDev->SetEncryption(pEnc));
@@ -9402,10 +9409,10 @@ PRL_METHOD( PrlVmDevHdPart_Remove ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPartition, PHT_VIRTUAL_DEV_HD_PARTITION))
+	PrlHandleVmDeviceHdPartPtr pPartition = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHdPart>( hPartition, PHT_VIRTUAL_DEV_HD_PARTITION );
+	if (!pPartition)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHdPartPtr pPartition = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHdPart>(hPartition);
 	return pPartition->Remove();
 }
 
@@ -9424,11 +9431,11 @@ PRL_METHOD( PrlVmDevHdPart_GetSysName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPartition, PHT_VIRTUAL_DEV_HD_PARTITION) ||
+	PrlHandleVmDeviceHdPartPtr pPartition = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHdPart>( hPartition, PHT_VIRTUAL_DEV_HD_PARTITION );
+	if (!pPartition ||
 			PRL_WRONG_PTR(pnSysNameBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHdPartPtr pPartition = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHdPart>(hPartition);
 	return pPartition->GetSysName(sSysName, pnSysNameBufLength);
 }
 
@@ -9445,11 +9452,11 @@ PRL_METHOD( PrlVmDevHdPart_SetSysName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hPartition, PHT_VIRTUAL_DEV_HD_PARTITION) ||
+	PrlHandleVmDeviceHdPartPtr pPartition = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHdPart>( hPartition, PHT_VIRTUAL_DEV_HD_PARTITION );
+	if (!pPartition ||
 			PRL_WRONG_PTR(sSysName))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceHdPartPtr pPartition = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceHdPart>(hPartition);
 	return pPartition->SetSysName(sSysName);
 }
 
@@ -9464,16 +9471,13 @@ PRL_METHOD(PrlVmDevHdEncryption_GetKeyId) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hEncryption, PHT_VIRTUAL_DISK_ENCRYPTION) ||
+	PrlHandleVirtualDiskEncryptionPtr pEnc = PRL_OBJECT_BY_HANDLE<PrlHandleVirtualDiskEncryption>( hEncryption, PHT_VIRTUAL_DISK_ENCRYPTION );
+	if (!pEnc ||
 		PRL_WRONG_PTR(pnKeyIdBufLength))
 	{
 		return PRL_ERR_INVALID_ARG;
 	}
 
-	PrlHandleVirtualDiskEncryptionPtr pEnc = PRL_OBJECT_BY_HANDLE<PrlHandleVirtualDiskEncryption>(hEncryption);
-	if (!pEnc.isValid())
-		return PRL_ERR_INVALID_ARG;
-
 	return pEnc->getKeyId(sKeyId, pnKeyIdBufLength);
 }
 
@@ -9487,16 +9491,13 @@ PRL_METHOD(PrlVmDevHdEncryption_SetKeyId) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hEncryption, PHT_VIRTUAL_DISK_ENCRYPTION) ||
+	PrlHandleVirtualDiskEncryptionPtr pEnc = PRL_OBJECT_BY_HANDLE<PrlHandleVirtualDiskEncryption>( hEncryption, PHT_VIRTUAL_DISK_ENCRYPTION );
+	if (!pEnc ||
 		PRL_WRONG_PTR(sKeyId))
 	{
 		return PRL_ERR_INVALID_ARG;
 	}
 
-	PrlHandleVirtualDiskEncryptionPtr pEnc = PRL_OBJECT_BY_HANDLE<PrlHandleVirtualDiskEncryption>(hEncryption);
-	if (!pEnc.isValid())
-		return PRL_ERR_INVALID_ARG;
-
 	return pEnc->setKeyId(sKeyId);
 }
 
@@ -9553,11 +9554,11 @@ PRL_METHOD( PrlVmDevNet_GetBoundAdapterIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnIndex))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetBoundAdapterIndex(pnIndex));
 }
 
@@ -9574,10 +9575,10 @@ PRL_METHOD( PrlVmDevNet_SetBoundAdapterIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetBoundAdapterIndex(nIndex));
 }
 
@@ -9596,11 +9597,11 @@ PRL_METHOD( PrlVmDevNet_GetBoundAdapterName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnBoundAdapterNameBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetBoundAdapterName(sBoundAdapterName, pnBoundAdapterNameBufLength));
 }
 
@@ -9617,10 +9618,10 @@ PRL_METHOD( PrlVmDevNet_SetBoundAdapterName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(sNewBoundAdapterName))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(sNewBoundAdapterName))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetBoundAdapterName(sNewBoundAdapterName));
 }
 
@@ -9632,11 +9633,11 @@ PRL_METHOD( PrlVmDevNet_GetHostInterfaceName ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnHostInterfaceNameBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetHostInterfaceName(sHostInterfaceName, pnHostInterfaceNameBufLength));
 }
 
@@ -9647,10 +9648,10 @@ PRL_METHOD( PrlVmDevNet_SetHostInterfaceName ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(sNewHostInterfaceName))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(sNewHostInterfaceName))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetHostInterfaceName(sNewHostInterfaceName));
 }
 
@@ -9669,11 +9670,11 @@ PRL_METHOD( PrlVmDevNet_GetMacAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnMacAddressBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetMacAddress(sMacAddress, pnMacAddressBufLength));
 }
 
@@ -9685,11 +9686,11 @@ PRL_METHOD( PrlVmDevNet_GetMacAddressCanonical ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnMacAddressBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetMacAddress(sMacAddress, pnMacAddressBufLength, true));
 }
 
@@ -9706,10 +9707,10 @@ PRL_METHOD( PrlVmDevNet_SetMacAddress ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(sNewMacAddress))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(sNewMacAddress))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetMacAddress(sNewMacAddress));
 }
 
@@ -9724,10 +9725,10 @@ PRL_METHOD( PrlVmDevNet_GenerateMacAddr ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GenerateMacAddress());
 }
 
@@ -9744,10 +9745,10 @@ PRL_METHOD( PrlVmDevNet_IsAutoApply ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(pbAutoApply))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter || PRL_WRONG_PTR(pbAutoApply))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->IsAutoApply(pbAutoApply));
 }
 
@@ -9765,10 +9766,10 @@ PRL_METHOD( PrlVmDevNet_SetAutoApply ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->SetAutoApply(bAutoApply));
 }
 
@@ -9787,11 +9788,11 @@ PRL_METHOD( PrlVmDevNet_GetDefaultGateway ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnDefaultGatewayBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetDefaultGateway(sDefaultGateway, pnDefaultGatewayBufLength));
 }
 
@@ -9808,10 +9809,10 @@ PRL_METHOD( PrlVmDevNet_SetDefaultGateway ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(sNewDefaultGateway))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(sNewDefaultGateway))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetDefaultGateway(sNewDefaultGateway));
 }
 
@@ -9830,11 +9831,11 @@ PRL_METHOD( PrlVmDevNet_GetDefaultGatewayIPv6 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnDefaultGatewayBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetDefaultGatewayIPv6(sDefaultGateway, pnDefaultGatewayBufLength));
 }
 
@@ -9851,10 +9852,10 @@ PRL_METHOD( PrlVmDevNet_SetDefaultGatewayIPv6 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(sNewDefaultGateway))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(sNewDefaultGateway))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetDefaultGatewayIPv6(sNewDefaultGateway));
 }
 
@@ -9873,11 +9874,11 @@ PRL_METHOD( PrlVmDevNet_GetVirtualNetworkId ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnVirtualNetworkIdBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetVirtualNetworkId(sVirtualNetworkId, pnVirtualNetworkIdBufLength));
 }
 
@@ -9894,10 +9895,10 @@ PRL_METHOD( PrlVmDevNet_SetVirtualNetworkId ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetVirtualNetworkId(sNewVirtualNetworkId));
 }
 
@@ -9914,10 +9915,10 @@ PRL_METHOD( PrlVmDevNet_GetNetAddresses ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(phNetAddressesList))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(phNetAddressesList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetNetAddresses(phNetAddressesList));
 }
 
@@ -9934,10 +9935,10 @@ PRL_METHOD( PrlVmDevNet_SetNetAddresses ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	PrlHandleStringsListPtr pNetAddressesList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hNetAddressesList);
 	return (pDevice->SetNetAddresses(pNetAddressesList.getHandle() ? pNetAddressesList->GetStringsList() : QStringList()));
 }
@@ -9955,10 +9956,10 @@ PRL_METHOD( PrlVmDevNet_GetDnsServers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(phDnsServersList))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(phDnsServersList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetDnsServers(phDnsServersList));
 }
 
@@ -9975,10 +9976,10 @@ PRL_METHOD( PrlVmDevNet_SetDnsServers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	PrlHandleStringsListPtr pDnsServersList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hDnsServersList);
 	return (pDevice->SetDnsServers(pDnsServersList.getHandle() ? pDnsServersList->GetStringsList() : QStringList()));
 }
@@ -9996,10 +9997,10 @@ PRL_METHOD( PrlVmDevNet_GetSearchDomains ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(phSearchDomainsList))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice || PRL_WRONG_PTR(phSearchDomainsList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetSearchDomains(phSearchDomainsList));
 }
 
@@ -10016,12 +10017,12 @@ PRL_METHOD( PrlVmDevNet_SetSearchDomains ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
-		(PRL_INVALID_HANDLE != hSearchDomainsList && PRL_WRONG_HANDLE(hSearchDomainsList, PHT_STRINGS_LIST)))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	PrlHandleStringsListPtr pSearchDomainsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>( hSearchDomainsList, PHT_STRINGS_LIST );
+	if (!pDevice ||
+		(PRL_INVALID_HANDLE != hSearchDomainsList && !pSearchDomainsList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
-	PrlHandleStringsListPtr pSearchDomainsList = PRL_OBJECT_BY_HANDLE<PrlHandleStringsList>(hSearchDomainsList);
 	return (pDevice->SetSearchDomains(pSearchDomainsList.getHandle() ? pSearchDomainsList->GetStringsList() : QStringList()));
 }
 
@@ -10038,10 +10039,10 @@ PRL_METHOD( PrlVmDevNet_IsConfigureWithDhcp ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(pbConfigureWithDhcp))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter || PRL_WRONG_PTR(pbConfigureWithDhcp))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->IsConfigureWithDhcp(pbConfigureWithDhcp));
 }
 
@@ -10059,10 +10060,10 @@ PRL_METHOD( PrlVmDevNet_SetConfigureWithDhcp ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->SetConfigureWithDhcp(bConfigureWithDhcp));
 }
 
@@ -10080,10 +10081,10 @@ PRL_METHOD( PrlVmDevNet_IsConfigureWithDhcpIPv6 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(pbConfigureWithDhcp))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter || PRL_WRONG_PTR(pbConfigureWithDhcp))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->IsConfigureWithDhcpIPv6(pbConfigureWithDhcp));
 }
 
@@ -10101,10 +10102,10 @@ PRL_METHOD( PrlVmDevNet_SetConfigureWithDhcpIPv6 ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->SetConfigureWithDhcpIPv6(bConfigureWithDhcp));
 }
 
@@ -10122,10 +10123,10 @@ PRL_METHOD( PrlVmDevNet_IsPktFilterPreventMacSpoof ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(pbPktFilterPreventMacSpoof))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter || PRL_WRONG_PTR(pbPktFilterPreventMacSpoof))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->IsPktFilterPreventMacSpoof(pbPktFilterPreventMacSpoof));
 }
 
@@ -10143,10 +10144,10 @@ PRL_METHOD( PrlVmDevNet_SetPktFilterPreventMacSpoof ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->SetPktFilterPreventMacSpoof(bPktFilterPreventMacSpoof));
 }
 
@@ -10163,10 +10164,10 @@ PRL_METHOD( PrlVmDevNet_IsPktFilterPreventPromisc ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(pbPktFilterPreventPromisc))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter || PRL_WRONG_PTR(pbPktFilterPreventPromisc))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->IsPktFilterPreventPromisc(pbPktFilterPreventPromisc));
 }
 
@@ -10184,10 +10185,10 @@ PRL_METHOD( PrlVmDevNet_SetPktFilterPreventPromisc ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->SetPktFilterPreventPromisc(bPktFilterPreventPromisc));
 }
 
@@ -10204,10 +10205,10 @@ PRL_METHOD( PrlVmDevNet_IsPktFilterPreventIpSpoof ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) || PRL_WRONG_PTR(pbPktFilterPreventIpSpoof))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter || PRL_WRONG_PTR(pbPktFilterPreventIpSpoof))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->IsPktFilterPreventIpSpoof(pbPktFilterPreventIpSpoof));
 }
 
@@ -10225,10 +10226,10 @@ PRL_METHOD( PrlVmDevNet_SetPktFilterPreventIpSpoof ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pNetAdapter)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pNetAdapter = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pNetAdapter->SetPktFilterPreventIpSpoof(bPktFilterPreventIpSpoof));
 }
 
@@ -10239,11 +10240,11 @@ PRL_METHOD( PrlVmDevNet_GetAdapterType) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER) ||
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnAdapterType))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->GetAdapterType(pnAdapterType));
 }
 
@@ -10254,10 +10255,10 @@ PRL_METHOD( PrlVmDevNet_SetAdapterType ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pDevice->SetAdapterType(nAdapterType));
 }
 
@@ -10274,11 +10275,11 @@ PRL_METHOD( PrlVmDevNet_IsFirewallEnabled ) (
 		pbEnabled
 	);
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER)
+	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pVmDevNet
 		|| PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev );
 
 	return pVmDevNet->IsFirewallEnabled(pbEnabled);
 }
@@ -10296,10 +10297,10 @@ PRL_METHOD( PrlVmDevNet_SetFirewallEnabled ) (
 		bEnabled
 	);
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pVmDevNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev );
 
 	return pVmDevNet->SetFirewallEnabled(bEnabled);
 }
@@ -10318,11 +10319,11 @@ PRL_METHOD( PrlVmDevNet_GetFirewallDefaultPolicy ) (
 		pnPolicy
 	);
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER)
+	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pVmDevNet
 		|| PRL_WRONG_PTR(pnPolicy))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev );
 
 	return pVmDevNet->GetFirewallDefaultPolicy(nDirection, pnPolicy);
 }
@@ -10341,10 +10342,10 @@ PRL_METHOD( PrlVmDevNet_SetFirewallDefaultPolicy ) (
 		nPolicy
 	);
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER))
+	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (!pVmDevNet)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev );
 
 	return pVmDevNet->SetFirewallDefaultPolicy(nDirection, nPolicy);
 }
@@ -10363,12 +10364,12 @@ PRL_METHOD( PrlVmDevNet_GetFirewallRuleList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (   PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER)
+	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (   !pVmDevNet
 		|| PRL_WRONG_PTR(phRuleList)
 		)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pVmDevNet->GetFirewallRuleList(nDirection, phRuleList));
 }
 
@@ -10387,13 +10388,13 @@ PRL_METHOD( PrlVmDevNet_SetFirewallRuleList ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (   PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER)
+	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>( hVmDev, PHT_VIRTUAL_DEV_NET_ADAPTER );
+	if (   !pVmDevNet
 		|| ( hRuleList != PRL_INVALID_HANDLE && PRL_WRONG_HANDLE(hRuleList, PHT_HANDLES_LIST) )
 		|| PRL_WRONG_HANDLES_LIST(hRuleList, PHT_FIREWALL_RULE)
 		)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceNetAdapterPtr pVmDevNet = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceNetAdapter>(hVmDev);
 	return (pVmDevNet->SetFirewallRuleList(nDirection, hRuleList));
 }
 
@@ -10428,11 +10429,11 @@ PRL_METHOD( PrlFirewallRule_GetLocalPort ) (
 		pnPort
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(pnPort))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->GetLocalPort(pnPort);
 }
@@ -10450,10 +10451,10 @@ PRL_METHOD( PrlFirewallRule_SetLocalPort ) (
 		nPort
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE))
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->SetLocalPort(nPort);
 }
@@ -10471,11 +10472,11 @@ PRL_METHOD( PrlFirewallRule_GetRemotePort ) (
 		pnPort
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(pnPort))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->GetRemotePort(pnPort);
 }
@@ -10493,10 +10494,10 @@ PRL_METHOD( PrlFirewallRule_SetRemotePort ) (
 		nPort
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE))
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->SetRemotePort(nPort);
 }
@@ -10516,11 +10517,11 @@ PRL_METHOD( PrlFirewallRule_GetProtocol ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->GetProtocol(sProtocol, pnBufLength);
 }
@@ -10538,11 +10539,11 @@ PRL_METHOD( PrlFirewallRule_SetProtocol ) (
 		sProtocol
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(sProtocol))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->SetProtocol(sProtocol);
 }
@@ -10562,11 +10563,11 @@ PRL_METHOD( PrlFirewallRule_GetLocalNetAddress ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->GetLocalNetAddress(sAddr, pnBufLength);
 }
@@ -10584,11 +10585,11 @@ PRL_METHOD( PrlFirewallRule_SetLocalNetAddress ) (
 		sAddr
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(sAddr))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->SetLocalNetAddress(sAddr);
 }
@@ -10608,11 +10609,11 @@ PRL_METHOD( PrlFirewallRule_GetRemoteNetAddress ) (
 		pnBufLength
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(pnBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->GetRemoteNetAddress(sAddr, pnBufLength);
 }
@@ -10630,11 +10631,11 @@ PRL_METHOD( PrlFirewallRule_SetRemoteNetAddress ) (
 		sAddr
 	);
 
-	if (PRL_WRONG_HANDLE(hRule, PHT_FIREWALL_RULE)
+	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule, PHT_FIREWALL_RULE );
+	if (!pFirewallRule
 		|| PRL_WRONG_PTR(sAddr))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleFirewallRulePtr pFirewallRule = PRL_OBJECT_BY_HANDLE<PrlHandleFirewallRule>( hRule );
 
 	return pFirewallRule->SetRemoteNetAddress(sAddr);
 }
@@ -10653,11 +10654,11 @@ PRL_METHOD( PrlVmDevUsb_GetAutoconnectOption ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_USB_DEVICE) ||
+	PrlHandleVmDeviceUsbPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceUsbPort>( hVmDev, PHT_VIRTUAL_DEV_USB_DEVICE );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnAutoconnectOption))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceUsbPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceUsbPort>(hVmDev);
 	return (pDevice->GetAutoconnectOption(pnAutoconnectOption));
 }
 
@@ -10674,10 +10675,10 @@ PRL_METHOD( PrlVmDevUsb_SetAutoconnectOption ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_USB_DEVICE))
+	PrlHandleVmDeviceUsbPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceUsbPort>( hVmDev, PHT_VIRTUAL_DEV_USB_DEVICE );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceUsbPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceUsbPort>(hVmDev);
 	return (pDevice->SetAutoconnectOption(nAutoconnectOption));
 }
 
@@ -10696,11 +10697,11 @@ PRL_METHOD( PrlVmDevSound_GetOutputDev ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_SOUND) ||
+	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>( hVmDev, PHT_VIRTUAL_DEV_SOUND );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnOutputDevBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>(hVmDev);
 	return (pDevice->GetOutputDev(sOutputDev, pnOutputDevBufLength));
 }
 
@@ -10717,10 +10718,10 @@ PRL_METHOD( PrlVmDevSound_SetOutputDev ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_SOUND) || PRL_WRONG_PTR(sNewOutputDev))
+	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>( hVmDev, PHT_VIRTUAL_DEV_SOUND );
+	if (!pDevice || PRL_WRONG_PTR(sNewOutputDev))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>(hVmDev);
 	return (pDevice->SetOutputDev(sNewOutputDev));
 }
 
@@ -10740,11 +10741,11 @@ PRL_METHOD( PrlVmDevSound_GetMixerDev ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_SOUND) ||
+	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>( hVmDev, PHT_VIRTUAL_DEV_SOUND );
+	if (!pDevice ||
 			PRL_WRONG_PTR(pnMixerDevBufLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>(hVmDev);
 	return (pDevice->GetMixerDev(sMixerDev, pnMixerDevBufLength));
 }
 
@@ -10761,10 +10762,10 @@ PRL_METHOD( PrlVmDevSound_SetMixerDev ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_SOUND) || PRL_WRONG_PTR(sNewMixerDev))
+	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>( hVmDev, PHT_VIRTUAL_DEV_SOUND );
+	if (!pDevice || PRL_WRONG_PTR(sNewMixerDev))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceSoundPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSound>(hVmDev);
 	return (pDevice->SetMixerDev(sNewMixerDev));
 }
 
@@ -10782,10 +10783,10 @@ PRL_METHOD( PrlVmDevSerial_GetSocketMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_SERIAL_PORT) || PRL_WRONG_PTR(pnSocketMode))
+	PrlHandleVmDeviceSerialPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSerialPort>( hVmDev, PHT_VIRTUAL_DEV_SERIAL_PORT );
+	if (!pDevice || PRL_WRONG_PTR(pnSocketMode))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceSerialPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSerialPort>(hVmDev);
 	return (pDevice->GetSocketMode(pnSocketMode));
 }
 
@@ -10802,10 +10803,10 @@ PRL_METHOD( PrlVmDevSerial_SetSocketMode ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmDev, PHT_VIRTUAL_DEV_SERIAL_PORT))
+	PrlHandleVmDeviceSerialPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSerialPort>( hVmDev, PHT_VIRTUAL_DEV_SERIAL_PORT );
+	if (!pDevice)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmDeviceSerialPortPtr pDevice = PRL_OBJECT_BY_HANDLE<PrlHandleVmDeviceSerialPort>(hVmDev);
 	return (pDevice->SetSocketMode(nSocketMode));
 }
 
@@ -10820,10 +10821,10 @@ PRL_METHOD( PrlShare_Remove ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE))
+	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pShare)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>(hVmShare);
 	return (pShare->Remove());
 }
 
@@ -10843,11 +10844,11 @@ PRL_METHOD( PrlShare_GetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) ||
+	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pVmShare ||
 			PRL_WRONG_PTR(pnShareNameBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare );
 
 	return (pVmShare->GetName(sShareName, pnShareNameBufLength));
 }
@@ -10866,11 +10867,11 @@ PRL_METHOD( PrlShare_SetName) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) ||
+	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pVmShare ||
 			PRL_WRONG_PTR(sNewShareName))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare );
 
 	return (pVmShare->SetName(sNewShareName));
 }
@@ -10891,11 +10892,11 @@ PRL_METHOD( PrlShare_GetPath) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) ||
+	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pVmShare ||
 			PRL_WRONG_PTR(pnSharePathBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare );
 
 	return (pVmShare->GetPath(sSharePath, pnSharePathBufLength));
 }
@@ -10914,11 +10915,11 @@ PRL_METHOD( PrlShare_SetPath) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) ||
+	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pVmShare ||
 			PRL_WRONG_PTR(sNewSharePath))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare );
 
 	return (pVmShare->SetPath(sNewSharePath));
 }
@@ -10939,11 +10940,11 @@ PRL_METHOD( PrlShare_GetDescription) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) ||
+	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pVmShare ||
 			PRL_WRONG_PTR(pnShareDescriptionBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare );
 
 	return (pVmShare->GetDescription(sShareDescription, pnShareDescriptionBufLength));
 }
@@ -10962,11 +10963,11 @@ PRL_METHOD( PrlShare_SetDescription) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) ||
+	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pVmShare ||
 			PRL_WRONG_PTR(sNewShareDescription))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmSharePtr pVmShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare );
 
 	return (pVmShare->SetDescription(sNewShareDescription));
 }
@@ -10985,10 +10986,10 @@ PRL_METHOD( PrlShare_IsEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) || PRL_WRONG_PTR(pbEnabled))
+	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pShare || PRL_WRONG_PTR(pbEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>(hVmShare);
 	return (pShare->IsEnabled(pbEnabled));
 }
 
@@ -11006,10 +11007,10 @@ PRL_METHOD( PrlShare_SetEnabled ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE))
+	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pShare)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>(hVmShare);
 	return (pShare->SetEnabled(bEnabled));
 }
 
@@ -11026,10 +11027,10 @@ PRL_METHOD( PrlShare_IsReadOnly ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE) || PRL_WRONG_PTR(pbReadOnly))
+	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pShare || PRL_WRONG_PTR(pbReadOnly))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>(hVmShare);
 	return (pShare->IsReadOnly(pbReadOnly));
 }
 
@@ -11047,10 +11048,10 @@ PRL_METHOD( PrlShare_SetReadOnly ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmShare, PHT_SHARE))
+	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>( hVmShare, PHT_SHARE );
+	if (!pShare)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmSharePtr pShare = PRL_OBJECT_BY_HANDLE<PrlHandleVmShare>(hVmShare);
 	return (pShare->SetReadOnly(bReadOnly));
 }
 
@@ -11065,10 +11066,10 @@ PRL_METHOD( PrlBootDev_Remove ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->Remove());
 }
 
@@ -11085,10 +11086,10 @@ PRL_METHOD( PrlBootDev_GetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE) || PRL_WRONG_PTR(pnDevType))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev || PRL_WRONG_PTR(pnDevType))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->GetBootDevType(pnDevType));
 }
 
@@ -11105,10 +11106,10 @@ PRL_METHOD( PrlBootDev_SetType ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->SetType(nDevType));
 }
 
@@ -11125,10 +11126,10 @@ PRL_METHOD( PrlBootDev_GetIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE) || PRL_WRONG_PTR(pnDevIndex))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev || PRL_WRONG_PTR(pnDevIndex))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->GetIndex(pnDevIndex));
 }
 
@@ -11145,10 +11146,10 @@ PRL_METHOD( PrlBootDev_SetIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->SetIndex(nDevIndex));
 }
 
@@ -11165,10 +11166,10 @@ PRL_METHOD( PrlBootDev_GetSequenceIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE) || PRL_WRONG_PTR(pnSequenceIndex))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev || PRL_WRONG_PTR(pnSequenceIndex))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->GetSequenceIndex(pnSequenceIndex));
 }
 
@@ -11185,10 +11186,10 @@ PRL_METHOD( PrlBootDev_SetSequenceIndex ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->SetSequenceIndex(nSequenceIndex));
 }
 
@@ -11205,10 +11206,10 @@ PRL_METHOD( PrlBootDev_IsInUse ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE) || PRL_WRONG_PTR(pbInUse))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev || PRL_WRONG_PTR(pbInUse))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->IsInUse(pbInUse));
 }
 
@@ -11225,10 +11226,10 @@ PRL_METHOD( PrlBootDev_SetInUse ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmBootDev, PHT_BOOT_DEVICE))
+	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>( hVmBootDev, PHT_BOOT_DEVICE );
+	if (!pBootDev)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmBootDevPtr pBootDev = PRL_OBJECT_BY_HANDLE<PrlHandleVmBootDev>(hVmBootDev);
 	return (pBootDev->SetInUse(bInUse));
 }
 
@@ -11247,9 +11248,9 @@ PRL_METHOD( PrlFoundVmInfo_GetName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_FOUND_VM_INFO) || PRL_WRONG_PTR(pnNameBufLength) )
+	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle, PHT_FOUND_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pnNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle );
 	return (pVmInfo->GetName(sName, pnNameBufLength));
 }
 
@@ -11266,9 +11267,9 @@ PRL_METHOD( PrlFoundVmInfo_IsOldConfig ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_FOUND_VM_INFO) || PRL_WRONG_PTR(pbOldVersion) )
+	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle, PHT_FOUND_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pbOldVersion) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle );
 	return (pVmInfo->IsOldConfig(pbOldVersion));
 }
 
@@ -11285,9 +11286,9 @@ PRL_METHOD( PrlFoundVmInfo_GetOSVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_FOUND_VM_INFO) || PRL_WRONG_PTR(pnOSVersion) )
+	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle, PHT_FOUND_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pnOSVersion) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle );
 	return (pVmInfo->GetOSVersion(pnOSVersion));
 }
 
@@ -11306,9 +11307,9 @@ PRL_METHOD( PrlFoundVmInfo_GetConfigPath ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_FOUND_VM_INFO) || PRL_WRONG_PTR(pnPathBufLength) )
+	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle, PHT_FOUND_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pnPathBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle );
 	return (pVmInfo->GetConfigPath(sPath, pnPathBufLength));
 }
 
@@ -11325,9 +11326,9 @@ PRL_METHOD( PrlFoundVmInfo_IsTemplate ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_FOUND_VM_INFO) || PRL_WRONG_PTR(pbIsTemplate) )
+	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle, PHT_FOUND_VM_INFO );
+	if ( !pVmInfo || PRL_WRONG_PTR(pbIsTemplate) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleFoundVmInfoPtr pVmInfo = PRL_OBJECT_BY_HANDLE<PrlHandleFoundVmInfo>( handle );
 	return (pVmInfo->IsTemplate(pbIsTemplate));
 }
 
@@ -11344,9 +11345,9 @@ PRL_METHOD( PrlVmToolsInfo_GetState) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_TOOLS_INFO) || PRL_WRONG_PTR(pVmToolsState) )
+	PrlHandleVmToolsInfoPtr pVmToolsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmToolsInfo>( handle, PHT_VM_TOOLS_INFO );
+	if ( !pVmToolsInfo || PRL_WRONG_PTR(pVmToolsState) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmToolsInfoPtr pVmToolsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmToolsInfo>( handle );
 	return (pVmToolsInfo->GetState(pVmToolsState));
 }
 
@@ -11365,9 +11366,9 @@ PRL_METHOD( PrlVmToolsInfo_GetVersion ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(handle, PHT_VM_TOOLS_INFO) || PRL_WRONG_PTR(pnNameBufLength) )
+	PrlHandleVmToolsInfoPtr pVmToolsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmToolsInfo>( handle, PHT_VM_TOOLS_INFO );
+	if ( !pVmToolsInfo || PRL_WRONG_PTR(pnNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleVmToolsInfoPtr pVmToolsInfo = PRL_OBJECT_BY_HANDLE<PrlHandleVmToolsInfo>( handle );
 	return (pVmToolsInfo->GetVersion(sName, pnNameBufLength));
 }
 
@@ -11386,9 +11387,9 @@ PRL_METHOD( PrlAcl_IsAllowed ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hAcl, PHT_ACCESS_RIGHTS) || PRL_WRONG_PTR(pbAllowed) )
+	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl, PHT_ACCESS_RIGHTS );
+	if ( !pAccessRights || PRL_WRONG_PTR(pbAllowed) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl );
 	return (pAccessRights->IsAllowed(nPermission, pbAllowed));
 }
 
@@ -11405,9 +11406,9 @@ PRL_METHOD( PrlAcl_GetAccessForOthers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hAcl, PHT_ACCESS_RIGHTS) || PRL_WRONG_PTR(pnAccessForOthers) )
+	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl, PHT_ACCESS_RIGHTS );
+	if ( !pAccessRights || PRL_WRONG_PTR(pnAccessForOthers) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl );
 	return (pAccessRights->GetAccessForOthers(pnAccessForOthers));
 }
 
@@ -11424,9 +11425,9 @@ PRL_METHOD( PrlAcl_SetAccessForOthers ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hAcl, PHT_ACCESS_RIGHTS) )
+	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl, PHT_ACCESS_RIGHTS );
+	if ( !pAccessRights )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl );
 	return (pAccessRights->SetAccessForOthers(nAccessForOthers));
 }
 
@@ -11445,9 +11446,9 @@ PRL_METHOD( PrlAcl_GetOwnerName ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hAcl, PHT_ACCESS_RIGHTS) || PRL_WRONG_PTR(pnOwnerNameBufLength) )
+	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl, PHT_ACCESS_RIGHTS );
+	if ( !pAccessRights || PRL_WRONG_PTR(pnOwnerNameBufLength) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl );
 	return (pAccessRights->GetOwnerName(sOwnerNameBuf, pnOwnerNameBufLength));
 }
 
@@ -11464,9 +11465,9 @@ PRL_METHOD( PrlAcl_IsCurrentSessionOwner ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hAcl, PHT_ACCESS_RIGHTS) || PRL_WRONG_PTR(pbIsOwner) )
+	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl, PHT_ACCESS_RIGHTS );
+	if ( !pAccessRights || PRL_WRONG_PTR(pbIsOwner) )
 		return (PRL_ERR_INVALID_ARG);
-	PrlHandleAccessRightsPtr pAccessRights = PRL_OBJECT_BY_HANDLE<PrlHandleAccessRights>( hAcl );
 	return (pAccessRights->IsCurrentSessionOwner(pbIsOwner));
 }
 
@@ -11477,7 +11478,7 @@ PRL_ASYNC_METHOD( PrlVm_Compact ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_COMPACT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Compact, (hVm, uMask, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Compact, (hVm, uMask, nFlags))
 }
 
 PRL_ASYNC_METHOD( PrlVm_CancelCompact ) (
@@ -11485,7 +11486,7 @@ PRL_ASYNC_METHOD( PrlVm_CancelCompact ) (
        )
 {
     ASYNC_CHECK_API_INITIALIZED(PJOC_UNKNOWN)
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_CancelCompact, (hVm))
+    CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_CancelCompact, (hVm))
 }
 
 
@@ -11496,7 +11497,7 @@ PRL_ASYNC_METHOD( PrlVm_ConvertDisks ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_CONVERT_DISKS)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_ConvertDisks, (hVm, uMask, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_ConvertDisks, (hVm, uMask, nFlags))
 }
 
 PRL_ASYNC_METHOD( PrlVm_CancelConvertDisks ) (
@@ -11507,25 +11508,25 @@ PRL_ASYNC_METHOD( PrlVm_CancelConvertDisks ) (
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_CONVERT_DISKS)
 	PRL_UINT32 nMask = 0;
 	nFlags = (nFlags & PCVD_CANCEL);
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_ConvertDisks, (hVm, nMask, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_ConvertDisks, (hVm, nMask, nFlags))
 }
 
 PRL_ASYNC_METHOD( PrlVm_SubscribeToPerfStats ) (PRL_HANDLE hVm, PRL_CONST_STR sFilter)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_SUBSCRIBE_PERFSTATS) ;
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_SubscribeToPerfStats, (hVm, sFilter)) ;
+    CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_SubscribeToPerfStats, (hVm, sFilter)) ;
 }
 
 PRL_ASYNC_METHOD( PrlVm_UnsubscribeFromPerfStats ) (PRL_HANDLE hVm)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UNSUBSCRIBE_PERFSTATS) ;
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_UnsubscribeFromPerfStats, (hVm)) ;
+    CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_UnsubscribeFromPerfStats, (hVm)) ;
 }
 
 PRL_ASYNC_METHOD( PrlVm_GetPerfStats ) (PRL_HANDLE hVm, PRL_CONST_STR sFilter)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_GET_PERFSTATS) ;
-    CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_GetPerfStats, (hVm, sFilter)) ;
+    CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_GetPerfStats, (hVm, sFilter)) ;
 }
 
 PRL_METHOD( PrlOsesMatrix_GetSupportedOsesTypes ) (
@@ -11542,10 +11543,10 @@ PRL_METHOD( PrlOsesMatrix_GetSupportedOsesTypes ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// check input parameters validity
-	if ( PRL_WRONG_HANDLE(hOsesMatrix, PHT_GUEST_OSES_MATRIX) || PRL_WRONG_PTR(phOsesTypesList) )
+	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix, PHT_GUEST_OSES_MATRIX );
+	if ( !pOsesMatrix || PRL_WRONG_PTR(phOsesTypesList) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix );
 
 	return (pOsesMatrix->GetSupportedOsesTypes(phOsesTypesList));
 }
@@ -11566,10 +11567,10 @@ PRL_METHOD( PrlOsesMatrix_GetSupportedOsesVersions ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// check input parameters validity
-	if ( PRL_WRONG_HANDLE(hOsesMatrix, PHT_GUEST_OSES_MATRIX) || PRL_WRONG_PTR(phGuestsList) )
+	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix, PHT_GUEST_OSES_MATRIX );
+	if ( !pOsesMatrix || PRL_WRONG_PTR(phGuestsList) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix );
 
 	return (pOsesMatrix->GetSupportedOsesVersions(nGuestOsType, phGuestsList));
 }
@@ -11590,10 +11591,10 @@ PRL_METHOD( PrlOsesMatrix_GetDefaultOsVersion ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// check input parameters validity
-	if ( PRL_WRONG_HANDLE(hOsesMatrix, PHT_GUEST_OSES_MATRIX) || PRL_WRONG_PTR(pnOsVersion) )
+	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix, PHT_GUEST_OSES_MATRIX );
+	if ( !pOsesMatrix || PRL_WRONG_PTR(pnOsVersion) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix );
 
 	return (pOsesMatrix->GetDefaultOsVersion(nGuestOsType, pnOsVersion));
 }
@@ -11616,10 +11617,10 @@ PRL_METHOD( PrlOsesMatrix_GetSupportType ) (
 	SYNC_CHECK_API_INITIALIZED
 
 	// check input parameters validity
-	if ( PRL_WRONG_HANDLE(hOsesMatrix, PHT_GUEST_OSES_MATRIX) || PRL_WRONG_PTR(pnGuestSupportType) )
+	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix, PHT_GUEST_OSES_MATRIX );
+	if ( !pOsesMatrix || PRL_WRONG_PTR(pnGuestSupportType) )
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleGuestOsesMatrixPtr pOsesMatrix = PRL_OBJECT_BY_HANDLE<PrlHandleGuestOsesMatrix>( hOsesMatrix );
 
 	return (pOsesMatrix->GetSupportType(nGuestOsType, nGuestOSVersion, pnGuestSupportType));
 }
@@ -11648,10 +11649,10 @@ PRL_METHOD( PrlVmCfg_SetVmType ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetVmType(nType));
 }
 
@@ -11662,10 +11663,10 @@ PRL_METHOD( PrlVmCfg_GetVmType ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetVmType(pnType));
 }
 
@@ -11676,10 +11677,10 @@ PRL_METHOD( PrlVmCfg_SetOsTemplate ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetOstemplate(sOsTemplate));
 }
 
@@ -11690,10 +11691,10 @@ PRL_METHOD( PrlVmCfg_GetOsTemplate ) (
 		)
 {
 	SYNC_CHECK_API_INITIALIZED
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) || PRL_WRONG_PTR(pnBufLength))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm || PRL_WRONG_PTR(pnBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 
 	return (pVm->GetOstemplate(sOsTemplate, pnBufLength));
 }
@@ -11705,11 +11706,11 @@ PRL_METHOD( PrlVmCfg_ApplyConfigSample ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm ||
 	     PRL_WRONG_PTR(sConfigSample))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetApplyConfigSample(sConfigSample));
 }
 
@@ -11722,10 +11723,10 @@ PRL_METHOD( PrlVmCfg_SetResource ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->SetResourceById(nResourceId, nBarrirer, nLimit));
 }
 
@@ -11738,10 +11739,10 @@ PRL_METHOD( PrlVmCfg_GetResource ) (
 {
 	SYNC_CHECK_API_INITIALIZED
 
-	if ( PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) )
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if ( !pVm )
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>(hVmCfg);
 	return (pVm->GetResourceById(nResourceId, pnBarrirer, pnLimit));
 }
 
@@ -11760,11 +11761,11 @@ PRL_METHOD( PrlCtTemplate_GetName ) (
 		pnNameLength
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pnNameLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetName(sName, pnNameLength);
 }
@@ -11782,11 +11783,11 @@ PRL_METHOD( PrlCtTemplate_GetType ) (
 		pType
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pType))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetTemplType(pType);
 }
@@ -11806,11 +11807,11 @@ PRL_METHOD( PrlCtTemplate_GetDescription ) (
 		pnDescriptionLength
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pnDescriptionLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetDescription(sDescription, pnDescriptionLength);
 }
@@ -11830,11 +11831,11 @@ PRL_METHOD( PrlCtTemplate_GetVersion ) (
 		pnVersionLength
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pnVersionLength))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetVersion(sVersion, pnVersionLength);
 }
@@ -11852,11 +11853,11 @@ PRL_METHOD( PrlCtTemplate_GetOsType ) (
 		pnOsType
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pnOsType))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetOsType(pnOsType);
 }
@@ -11874,11 +11875,11 @@ PRL_METHOD( PrlCtTemplate_GetOsVersion ) (
 		pnOsVersion
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pnOsVersion))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetOsVersion(pnOsVersion);
 }
@@ -11896,11 +11897,11 @@ PRL_METHOD( PrlCtTemplate_GetCpuMode ) (
 		pnCpuMode
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pnCpuMode))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetCpuMode(pnCpuMode);
 }
@@ -11918,11 +11919,11 @@ PRL_METHOD( PrlCtTemplate_IsCached ) (
 		pbCached
 		);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE) ||
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate ||
 			PRL_WRONG_PTR(pbCached))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->IsCached(pbCached);
 }
@@ -11939,7 +11940,7 @@ PRL_ASYNC_METHOD( PrlSrv_GetCtTemplateList ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_GET_CT_TEMPLATE_LIST)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_GetCtTemplateList, (hServer, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hServer, PrlSrv_GetCtTemplateList, (hServer, nFlags))
 }
 
 PRL_METHOD( PrlVmCfg_GetAppTemplateList ) (
@@ -11955,11 +11956,11 @@ PRL_METHOD( PrlVmCfg_GetAppTemplateList ) (
 		phAppList
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_PTR(phAppList))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetAppTemplateList(phAppList);
 }
@@ -11977,11 +11978,11 @@ PRL_METHOD( PrlVmCfg_SetAppTemplateList ) (
 		hAppList
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_HANDLE(hAppList, PHT_STRINGS_LIST))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetAppTemplateList(hAppList);
 }
@@ -11989,10 +11990,10 @@ PRL_METHOD( PrlVmCfg_SetAppTemplateList ) (
 PRL_HANDLE PrlSrv_RemoveCtTemplate_Impl(PRL_HANDLE hServer,
 	PRL_CONST_STR sName, PRL_CONST_STR sOsTmplName, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hServer, PHT_SERVER) || PRL_WRONG_PTR(sName))
+	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hServer, PHT_SERVER );
+	if (!pServer || PRL_WRONG_PTR(sName))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_REMOVE_CT_TEMPLATE))
 
-	PrlHandleServerVmPtr pServer = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hServer);
 	PrlHandleJobPtr pJob = pServer->RemoveCtTemplate(sName, sOsTmplName, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -12007,7 +12008,7 @@ PRL_ASYNC_METHOD( PrlSrv_RemoveCtTemplate ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_REMOVE_CT_TEMPLATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(hServer,
 		PrlSrv_RemoveCtTemplate, (hServer, sName, sOsTmplName, nFlags))
 }
 
@@ -12026,10 +12027,10 @@ PRL_METHOD( PrlCtTemplate_GetOsTemplate ) (
 		pnOsTemplateLength
 	);
 
-	if (PRL_WRONG_HANDLE(hTemplate, PHT_CT_TEMPLATE))
+	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate, PHT_CT_TEMPLATE );
+	if (!pCtTemplate)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleCtTemplatePtr pCtTemplate = PRL_OBJECT_BY_HANDLE<PrlHandleCtTemplate>( hTemplate );
 
 	return pCtTemplate->GetOsTemplate(sOsTemplate, pnOsTemplateLength);
 }
@@ -12044,13 +12045,13 @@ PRL_HANDLE PrlSrv_CopyCtTemplate_Impl(
 			PRL_UINT32 nFlags,
 			PRL_UINT32 nReservedFlags)
 {
-	if (	PRL_WRONG_HANDLE(hSrv, PHT_SERVER) ||
+	PrlHandleServerVmPtr pSrv = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>( hSrv, PHT_SERVER );
+	if (	!pSrv ||
 		PRL_WRONG_PTR(sName) ||
 		PRL_WRONG_PTR(sTargetServerHostname) ||
 		PRL_WRONG_PTR(sTargetServerSessionUuid))
 			RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_SRV_COPY_CT_TEMPLATE))
 
-	PrlHandleServerVmPtr pSrv = PRL_OBJECT_BY_HANDLE<PrlHandleServerVm>(hSrv);
 	PrlHandleJobPtr pJob = pSrv->CopyCtTemplate(
 			sName,
 			sOsTmplName,
@@ -12076,7 +12077,7 @@ PRL_ASYNC_METHOD( PrlSrv_CopyCtTemplate ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_SRV_COPY_CT_TEMPLATE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlSrv_CopyCtTemplate, (
+	CALL_THROUGH_OWNER_CTXT(hSrv, PrlSrv_CopyCtTemplate, (
 			hSrv,
 			sName,
 			sOsTmplName,
@@ -12100,11 +12101,11 @@ PRL_METHOD( PrlVmCfg_IsRamHotplugEnabled ) (
 		pbVmRamHotplugEnabled
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 		PRL_WRONG_PTR(pbVmRamHotplugEnabled))
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->IsRamHotplugEnabled(pbVmRamHotplugEnabled);
 }
@@ -12122,20 +12123,20 @@ PRL_METHOD( PrlVmCfg_SetRamHotplugEnabled ) (
 		bVmRamHotplugEnabled
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetRamHotplugEnabled(bVmRamHotplugEnabled);
 }
 
 PRL_HANDLE PrlVm_Mount_Impl(PRL_HANDLE hVm, PRL_CONST_STR sMntPath, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE))
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_MOUNT))
 
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Mount(sMntPath, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -12150,7 +12151,7 @@ PRL_ASYNC_METHOD( PrlVm_Mount ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_MOUNT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Mount, (hVm, sMntPath, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Mount, (hVm, sMntPath, nFlags))
 }
 
 PRL_HANDLE PrlVm_Umount_Impl(PRL_HANDLE hVm, PRL_UINT32 nFlags)
@@ -12164,14 +12165,14 @@ PRL_ASYNC_METHOD( PrlVm_Umount ) (
 		)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UMOUNT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Umount, (hVm, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Umount, (hVm, nFlags))
 }
 
 PRL_HANDLE PrlVm_Move_Impl(PRL_HANDLE hVm, PRL_CONST_STR sNewHomePath, PRL_UINT32 nFlags)
 {
-	if ( PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) || PRL_WRONG_PTR(sNewHomePath) )
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if ( !pVm || PRL_WRONG_PTR(sNewHomePath) )
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_MOVE))
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Move(sNewHomePath, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -12186,15 +12187,15 @@ PRL_ASYNC_METHOD( PrlVm_Move ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_MOVE)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_Move, (hVm, sNewHomePath, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_Move, (hVm, sNewHomePath, nFlags))
 }
 
 PRL_HANDLE PrlVm_CaptureScreen_Impl(PRL_HANDLE hVm, PRL_UINT32 nWidth, PRL_UINT32 nHeight, PRL_UINT32 nFlags)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE))
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_DEV_DISPLAY_CAPTURE_SCREEN))
 
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->CaptureScreen(nWidth, nHeight, nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -12210,7 +12211,7 @@ PRL_ASYNC_METHOD( PrlVm_CaptureScreen ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_DEV_DISPLAY_CAPTURE_SCREEN)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_CaptureScreen, (hVm, nWidth, nHeight, nFlags))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_CaptureScreen, (hVm, nWidth, nHeight, nFlags))
 }
 
 PRL_HANDLE PrlVm_CommitEncryption_Impl(
@@ -12218,10 +12219,10 @@ PRL_HANDLE PrlVm_CommitEncryption_Impl(
 		PRL_UINT32 nFlags
 	)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE))
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm)
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_VM_COMMIT_ENCRYPTION))
 
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->CommitEncryption(nFlags);
 	if (!pJob)
 		RETURN_RES(PRL_INVALID_HANDLE)
@@ -12240,7 +12241,7 @@ PRL_ASYNC_METHOD(PrlVm_CommitEncryption) (
 	PRL_UNUSED_PARAM(hReserved);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_COMMIT_ENCRYPTION)
-		CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_CommitEncryption, (hVm, nFlags))
+		CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_CommitEncryption, (hVm, nFlags))
 }
 
 PRL_METHOD( PrlVmCfg_SetActionOnGuestCrash ) (
@@ -12256,10 +12257,10 @@ PRL_METHOD( PrlVmCfg_SetActionOnGuestCrash ) (
 		nAction
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetOnCrashAction(nAction);
 }
@@ -12277,10 +12278,10 @@ PRL_METHOD( PrlVmCfg_GetActionOnGuestCrash ) (
 		pnAction
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetOnCrashAction(pnAction);
 }
@@ -12298,10 +12299,10 @@ PRL_METHOD( PrlVmCfg_SetOptionsOnGuestCrash ) (
 		nOptions
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->SetOnCrashOptions(nOptions);
 }
@@ -12319,10 +12320,10 @@ PRL_METHOD( PrlVmCfg_GetOptionsOnGuestCrash ) (
 		pnOptions
 	);
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return PRL_ERR_INVALID_ARG;
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return pVm->GetOnCrashOptions(pnOptions);
 }
@@ -12342,11 +12343,11 @@ PRL_METHOD( PrlVmCfg_GetDefaultBackupDirectory) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(pnVmBackupDirectoryBufLength))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->GetDefaultBackupDirectory(sVmBackupDirectory, pnVmBackupDirectoryBufLength));
 }
@@ -12365,11 +12366,11 @@ PRL_METHOD( PrlVmCfg_SetDefaultBackupDirectory) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION) ||
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm ||
 			PRL_WRONG_PTR(sNewVmBackupDirectory))
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->SetDefaultBackupDirectory(sNewVmBackupDirectory));
 }
@@ -12380,11 +12381,11 @@ PRL_HANDLE PrlCt_Reinstall_Impl(
 		PRL_UINT32 nFlags
 	)
 {
-	if (PRL_WRONG_HANDLE(hVm, PHT_VIRTUAL_MACHINE) ||
+	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>( hVm, PHT_VIRTUAL_MACHINE );
+	if (!pVm ||
 			PRL_WRONG_PTR(sOsTemplate))
 		RETURN_RES(GENERATE_ERROR_HANDLE(PRL_ERR_INVALID_ARG, PJOC_CT_REINSTALL))
 
-	PrlHandleVmSrvPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmSrv>(hVm);
 	PrlHandleJobPtr pJob = pVm->Reinstall(sOsTemplate, nFlags);
 	if (!pJob)
 		return PRL_INVALID_HANDLE;
@@ -12400,7 +12401,7 @@ PRL_ASYNC_METHOD( PrlCt_Reinstall ) (
 	)
 {
 	ASYNC_CHECK_API_INITIALIZED(PJOC_CT_REINSTALL)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(),
+	CALL_THROUGH_OWNER_CTXT(hVm,
 			PrlCt_Reinstall, (hVm, sOsTemplate, nFlags))
 }
 
@@ -12420,7 +12421,7 @@ PRL_ASYNC_METHOD( PrlVm_UpdateNvram ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_VM_UPDATE_NVRAM)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlVm_UpdateNvram, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlVm_UpdateNvram, (hVm))
 }
 
 PRL_METHOD( PrlVmCfg_UpdateNvram ) (
@@ -12434,10 +12435,10 @@ PRL_METHOD( PrlVmCfg_UpdateNvram ) (
 
 	SYNC_CHECK_API_INITIALIZED
 
-	if (PRL_WRONG_HANDLE(hVmCfg, PHT_VM_CONFIGURATION))
+	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg, PHT_VM_CONFIGURATION );
+	if (!pVm)
 		return (PRL_ERR_INVALID_ARG);
 
-	PrlHandleVmCfgPtr pVm = PRL_OBJECT_BY_HANDLE<PrlHandleVmCfg>( hVmCfg );
 
 	return (pVm->UpdateNvram());
 }
@@ -12457,5 +12458,5 @@ PRL_ASYNC_METHOD( PrlCt_Convert ) (
 		);
 
 	ASYNC_CHECK_API_INITIALIZED(PJOC_CT_CONVERT)
-	CALL_THROUGH_CTXT_SWITCHER(PrlContextSwitcher::Instance(), PrlCt_Convert, (hVm))
+	CALL_THROUGH_OWNER_CTXT(hVm, PrlCt_Convert, (hVm))
 }
@@ -717,10 +717,9 @@ void PrlHandleVm::ProcessVmEvent( PrlHandleBasePtr pEvent )
 	if( pEvent->GetType() != PHT_EVENT )
 		return;
 
-	PrlHandleVmEvent *pVmEventHandle = static_cast<PrlHandleVmEvent *>( pEvent.getHandle() );
-	CVmEvent &vmEvent = pVmEventHandle->GetEventObject();
-
-	PRL_EVENT_TYPE vmEventType = vmEvent.getEventType();
+	// Event type is known without parsing of event parameters
+	PRL_EVENT_TYPE vmEventType = PET_VM_INF_UNINITIALIZED_EVENT_CODE;
+	static_cast<PrlHandleVmEvent *>( pEvent.getHandle() )->GetEventType(&vmEventType);
 	switch (vmEventType)
 	{
 	default:
@@ -39,6 +39,7 @@
 #include <prlxmlmodel/VmConfig/CVmConfiguration.h>
 
 #include "BuiltinEventSource.h"
+#include "PrlEventsFilter.h"
 #include "PrlHandleBase.h"
 #include "PrlHandleHandlesList.h"
 #include "PrlHandleIOJob.h"
@@ -113,6 +114,11 @@ public:
 	 */
 	BuiltinEventSource *eventSource() { return &m_eventSource; }
 
+	/**
+	 * Returns client side filter of the VM events
+	 */
+	PrlEventsFilter &GetEventsFilter() { return m_EventsFilter; }
+
 	/**
 	 * Connects to Vm desktop.
 	 */
@@ -188,6 +194,8 @@ private:
 
 	BuiltinEventSource m_eventSource;
 
+	PrlEventsFilter m_EventsFilter;
+
 	QReadWriteLock m_ioJobsListRWLock;
 	QList< PrlHandleSmartPtr<PrlHandleIOJob> > m_ioJobsList;
 
@@ -572,6 +572,7 @@ PrlHandleJobPtr PrlHandleVmSrv::GetState()
 
 PrlHandleJobPtr PrlHandleVmSrv::GetToolsState()
 {
+	SYNCHRO_INTERNAL_DATA_ACCESS
 	CHECK_SERVER
 	CHECK_IDENTIFICATION
 	return (m_pServerVm->DspCmdGetVmToolsInfo(GET_VM_UUID));
@@ -167,6 +167,41 @@ PRL_METHOD_DECL( VIRTUOZZO_API_VER_2,
 		PRL_APPLICATION_MODE_PTR app_mode
 		) );
 
+/* Returns the client side latency counters of the requests
+   sent by the process. The counters are gathered per protocol
+   command for each stage of the request processing (see
+   PRL_REQUEST_STAGE): waiting in the requests queue or batch,
+   sending until the response is received, parsing of the
+   response, waiting for its delivery to the job and waiting of
+   the API call which sent the request for the event loop it
+   is switched to. Each
+   counter holds the number of the measured requests, total and
+   maximum time and percentiles of the time of its stage. The
+   counters are always collected and are never reset.
+   Parameters
+   pCounters :  [out] A pointer to a buffer that receives the
+                counters. Pass a null pointer to determine the
+                required number of counters.
+   pnCount :    [in] The number of counters the buffer can hold.
+                [out] The number of the available counters.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - null pointer was passed.
+
+   PRL_ERR_BUFFER_OVERRUN - the buffer is not large enough. The
+   pnCount parameter will contain the required number of
+   counters.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_GetInFlightJobs                                        */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlApi_GetPerfCounters, (
+		PRL_REQUEST_PERF_COUNTER_PTR pCounters,
+		PRL_UINT32_PTR pnCount
+		) );
+
 
 ///////////////////////////////////////////////////////////////////////////////
 /// @section Result code description functionality.
@@ -895,6 +930,139 @@ PRL_METHOD_DECL( VIRTUOZZO_API_VER_1,
 		PRL_UINT32 msecs
 		) );
 
+/* Waits for completion of any job from the specified list. The
+   calling thread is woken up only once the first job completes
+   so waiting on a big number of jobs does not rescan them. On
+   function return the jobs objects are not destroyed and could
+   be queried until their destruction with the call to
+   PrlHandle_Free.
+   Parameters
+   hJobsList :  A handle of type PHT_HANDLES_LIST containing
+                handles of type PHT_JOB to wait for.
+   msecs :      Timeout in milliseconds. For an infinite timeout,
+                use the UINT_MAX value.
+   pnIndex :    [out] A pointer to a variable that receives the
+                index in the list of the first completed job.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - an invalid or empty handles list was
+   passed, the list contains not PHT_JOB handles or jobs of the
+   virtual machine IO channel, or invalid pointer was passed.
+
+   PRL_ERR_OUT_OF_MEMORY - not enough memory to allocate waiter.
+
+   PRL_ERR_TIMEOUT - the specified timeout limit was reached.
+
+   PRL_ERR_SUCCESS - operation completed successfully.
+   See Also
+   PrlJob_Wait
+   PrlJob_WaitAll                                                */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlJob_WaitAny, (
+		PRL_HANDLE hJobsList,
+		PRL_UINT32 msecs,
+		PRL_UINT32_PTR pnIndex
+		) );
+
+/* Waits for completion of all jobs from the specified list. The
+   calling thread is woken up only once the last job completes.
+   On function return the jobs objects are not destroyed and
+   could be queried until their destruction with the call to
+   PrlHandle_Free.
+   Parameters
+   hJobsList :  A handle of type PHT_HANDLES_LIST containing
+                handles of type PHT_JOB to wait for.
+   msecs :      Timeout in milliseconds. For an infinite timeout,
+                use the UINT_MAX value.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - an invalid or empty handles list was
+   passed or the list contains not PHT_JOB handles or jobs of
+   the virtual machine IO channel.
+
+   PRL_ERR_OUT_OF_MEMORY - not enough memory to allocate waiter.
+
+   PRL_ERR_TIMEOUT - the specified timeout limit was reached.
+
+   PRL_ERR_SUCCESS - operation completed successfully.
+   See Also
+   PrlJob_Wait
+   PrlJob_WaitAny                                                */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlJob_WaitAll, (
+		PRL_HANDLE hJobsList,
+		PRL_UINT32 msecs
+		) );
+
+/* Returns a file descriptor which becomes readable once the job
+   completes. The descriptor can be watched with poll, epoll or
+   select in the client event loop. It is owned by the job: the
+   client must neither read it nor close it. The descriptor is
+   valid until the job handle is freed.
+   Parameters
+   hJob :  A handle of type PHT_JOB identifying the job.
+   pnFd :  [out] A pointer to a variable that receives the file
+           descriptor.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - an invalid PHT_JOB handle or null
+   pointer was passed.
+
+   PRL_ERR_OUT_OF_MEMORY - failed to create the descriptor.
+
+   PRL_ERR_UNIMPLEMENTED - the job or the platform does not
+   support completion descriptors.
+
+   PRL_ERR_SUCCESS - operation completed successfully.
+   See Also
+   PrlJob_Wait
+   PrlSrv_GetJobsCompletionFd                                     */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlJob_GetCompletionFd, (
+		PRL_HANDLE hJob,
+		PRL_INT32_PTR pnFd
+		) );
+
+/* Sets a callback function which is called once when the job
+   completes. The job is not passed to the event handlers
+   registered for the server or virtual machine in this case, so
+   the callback receives only completion of its own job. Event
+   queues opened with PrlSrv_OpenEventQueue still receive the
+   job. If the job is already completed, the callback is called
+   immediately from the calling thread. Otherwise it is called
+   from the execution context thread of the server connection,
+   which processes all responses and events of the server, so
+   the callback must not block.
+   Parameters
+   hJob :      A handle of type PHT_JOB identifying the job.
+   handler :   A pointer to the callback function. The function
+               receives the job handle which must be freed with
+               PrlHandle_Free. Pass NULL to reset the previously
+               set callback.
+   userData :  A pointer to a user data passed to the callback
+               function.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - an invalid PHT_JOB handle was passed.
+
+   PRL_ERR_UNIMPLEMENTED - the job does not support completion
+   callbacks.
+
+   PRL_ERR_SUCCESS - operation completed successfully.
+   See Also
+   PrlJob_Wait
+   PrlSrv_RegEventHandler                                         */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlJob_SetCompletionCallback, (
+		PRL_HANDLE hJob,
+		PRL_EVENT_HANDLER_PTR handler,
+		PRL_VOID_PTR userData
+		) );
+
 
 /* Cancel the specified job. If an asynchronous operation takes
    a long time to complete, you may cancel it by calling this
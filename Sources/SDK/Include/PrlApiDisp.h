@@ -144,6 +144,12 @@ PRL_METHOD_DECL( VIRTUOZZO_API_VER_1,
 					 continue. In non\-interactive mode, the
 					 Dispatcher Service will make decisions
 					 on its own.
+                       PLLF_ALLOW_COMPRESSION - to let the
+					 Dispatcher Service compress large
+					 packages (VM lists, configurations,
+					 host information). Large requests are
+					 compressed too if the Dispatcher
+					 Service confirms it accepts them.
    Returns
    A handle of type PHT_JOB containing the results of this
    asynchronous operation, including the return code and a
@@ -351,6 +357,618 @@ PRL_METHOD_DECL( VIRTUOZZO_API_VER_1,
 		PRL_VOID_PTR userData
 		) );
 
+/* Sets client side filter of the server events. Events which
+   do not pass the filter are dropped by the SDK right after
+   receiving: no event handles are created for them and
+   registered event handlers are not called. Questions
+   (PET_DSP_EVT_VM_QUESTION) are never filtered.
+   Parameters
+   hServer :          A handle of type PHT_SERVER.
+   hEventTypesList :  A handle of type PHT_OPAQUE_TYPE_LIST
+                      containing accepted event types
+                      (PRL_EVENT_TYPE values) or PRL_INVALID_HANDLE
+                      to accept events of any type.
+   hVmUuidsList :     A handle of type PHT_STRINGS_LIST containing
+                      UUIDs of VMs which events are accepted or
+                      PRL_INVALID_HANDLE to accept events of any VM.
+                      Events not related to any VM are not filtered
+                      by this list.
+   nFlags :           Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlVm_SetEventFilter
+   PrlSrv_GetEventFilterStat                                      */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_SetEventFilter, (
+		PRL_HANDLE hServer,
+		PRL_HANDLE hEventTypesList,
+		PRL_HANDLE hVmUuidsList,
+		PRL_UINT32 nFlags
+		) );
+
+/* Returns numbers of server events which were delivered to
+   the client and which were dropped by the client side events
+   filter since the server handle was created.
+   Parameters
+   hServer :      A handle of type PHT_SERVER.
+   pnDelivered :  [out] A pointer to a variable that receives
+                  the number of delivered events.
+   pnFiltered :   [out] A pointer to a variable that receives
+                  the number of filtered events.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_SetEventFilter                                          */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_GetEventFilterStat, (
+		PRL_HANDLE hServer,
+		PRL_UINT64_PTR pnDelivered,
+		PRL_UINT64_PTR pnFiltered
+		) );
+
+/* Sets the number of threads which deliver events of the
+   server to the registered callbacks. By default all events
+   are delivered by a single thread, so one slow callback delays
+   events of every VM. With several threads events of the same
+   VM are always delivered by the same thread in the order they
+   were received, events of different VMs may be delivered
+   concurrently. Events not related to any VM are delivered by
+   the first thread.
+
+   The function must be called before login: once the first
+   event or job result of the server is delivered the number of
+   threads can't be changed.
+   Parameters
+   hServer :       A handle of type PHT_SERVER.
+   nShardsCount :  The number of notification threads, from 1
+                   (default single thread delivery) to 64.
+   nFlags :        Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or threads number was
+   passed.
+
+   PRL_ERR_UNEXPECTED - events delivery was already stopped.
+
+   PRL_ERR_ALREADY_CONNECTED_TO_DISPATCHER - events delivery was
+   already started.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_GetNotificationShardStat                                */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_SetNotificationShards, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nShardsCount,
+		PRL_UINT32 nFlags
+		) );
+
+/* Returns statistics of the server events notification thread.
+   Latency of an event notification is measured from the moment
+   the event was queued to the thread up to return from the
+   registered callbacks.
+   Parameters
+   hServer :       A handle of type PHT_SERVER.
+   nShard :        Index of the notification thread, from 0 to
+                   the number set by PrlSrv_SetNotificationShards
+                   minus one.
+   pnQueueDepth :  [out] A pointer to a variable that receives
+                   the number of queued notifications.
+   pnDelivered :   [out] A pointer to a variable that receives
+                   the number of delivered notifications.
+   pnAvgLatency :  [out] A pointer to a variable that receives
+                   the average notification latency in
+                   microseconds.
+   pnMaxLatency :  [out] A pointer to a variable that receives
+                   the maximum notification latency in
+                   microseconds.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle, thread index or null
+   pointer was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_SetNotificationShards                                   */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_GetNotificationShardStat, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nShard,
+		PRL_UINT32_PTR pnQueueDepth,
+		PRL_UINT64_PTR pnDelivered,
+		PRL_UINT64_PTR pnAvgLatency,
+		PRL_UINT64_PTR pnMaxLatency
+		) );
+
+/* Enables or disables coalescing of progress events of the
+   server. Long running operations (migration, backup, clone,
+   disk operations, etc.) report progress by a stream of
+   *_PROGRESS_CHANGED events. With coalescing enabled a progress
+   event which is not delivered to the callbacks yet is dropped
+   when a newer progress event of the same type, issuer and
+   operation is received, so callbacks get only the latest
+   progress value. Coalescing is disabled by default.
+   Parameters
+   hServer :  A handle of type PHT_SERVER.
+   bEnable :  PRL_TRUE to enable coalescing, PRL_FALSE to
+              disable it.
+   nFlags :   Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_GetCoalescedEventsCount                                 */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_SetProgressEventsCoalescing, (
+		PRL_HANDLE hServer,
+		PRL_BOOL bEnable,
+		PRL_UINT32 nFlags
+		) );
+
+/* Returns the number of progress events of the server which
+   were dropped by coalescing since the server handle was
+   created.
+   Parameters
+   hServer :      A handle of type PHT_SERVER.
+   pnCoalesced :  [out] A pointer to a variable that receives
+                  the number of dropped progress events.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_SetProgressEventsCoalescing                             */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_GetCoalescedEventsCount, (
+		PRL_HANDLE hServer,
+		PRL_UINT64_PTR pnCoalesced
+		) );
+
+/* Registers an event handler which receives events of the
+   Dispatcher Service in batches. Events are accumulated and
+   passed to the handler as a handle of type PHT_HANDLES_LIST
+   when the number of accumulated events reaches nMaxBatch or
+   when the first accumulated event has waited for nMaxDelayMs
+   milliseconds, whichever comes first. The handler is called
+   once per batch, events in the list are in the order they
+   were received. The handler is called by a separate thread, so
+   it does not delay handlers registered with
+   PrlSrv_RegEventHandler. The list handle must be freed by the
+   handler with PrlHandle_Free.
+   Parameters
+   hServer :      A handle of type PHT_SERVER identifying the
+                  Dispatcher Service.
+   handler :      A pointer to a user callback function which
+                  receives a handle of type PHT_HANDLES_LIST.
+   nMaxBatch :    The maximum number of events in the list.
+   nMaxDelayMs :  The maximum time in milliseconds an event
+                  waits for the batch to be delivered.
+   userData :     Optional. A pointer to a user data that will be
+                  passed to the callback function.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle, null handler or zero
+   batch size was passed.
+
+   PRL_ERR_OUT_OF_MEMORY - not enough memory to complete the
+   operation.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_UnregEventHandlerBatch                                  */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_RegEventHandlerBatch, (
+		PRL_HANDLE hServer,
+		PRL_EVENT_HANDLER_PTR handler,
+		PRL_UINT32 nMaxBatch,
+		PRL_UINT32 nMaxDelayMs,
+		PRL_VOID_PTR userData
+		) );
+
+/* Unregisters the event handler that was previously
+   registered with the PrlSrv_RegEventHandlerBatch function.
+   Events accumulated for the handler and not delivered yet are
+   dropped. The values of the handler and userData parameters
+   identify the event handler that will be unregistered.
+   Parameters
+   hServer :   A handle of type PHT_SERVER identifying the
+               Dispatcher Service.
+   handler :   A pointer to the user callback function.
+   userData :  A pointer to the user data used for the
+               handler registration.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_RegEventHandlerBatch                                    */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_UnregEventHandlerBatch, (
+		PRL_HANDLE hServer,
+		PRL_EVENT_HANDLER_PTR handler,
+		PRL_VOID_PTR userData
+		) );
+
+/* Opens a queue which accumulates events and jobs completions
+   of the Dispatcher Service so the client can read them on its
+   own with PrlEventQueue_Poll instead of receiving them in
+   callbacks. Events are put into the queue as soon as they are
+   received from the Dispatcher Service, independently of the
+   registered event handlers. When the queue is full the oldest
+   event is dropped and the overflow counter is incremented.
+   The queue is closed with PrlHandle_Free.
+   Parameters
+   hServer :    A handle of type PHT_SERVER identifying the
+                Dispatcher Service.
+   nCapacity :  The maximum number of events in the queue.
+   phQueue :    [out] A pointer to a variable that receives the
+                handle of type PHT_EVENT_QUEUE.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle, zero capacity or null
+   pointer was passed.
+
+   PRL_ERR_OUT_OF_MEMORY - not enough memory to complete the
+   operation.
+
+   PRL_ERR_FAILURE - failed to create notification descriptor.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlEventQueue_Poll
+   PrlEventQueue_GetFd                                            */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_OpenEventQueue, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nCapacity,
+		PRL_HANDLE_PTR phQueue
+		) );
+
+/* Takes events from the queue in the order they were received.
+   If the queue is empty the function waits for an event up to
+   the specified timeout.
+   Parameters
+   hQueue :        A handle of type PHT_EVENT_QUEUE.
+   nTimeoutMs :    Timeout in milliseconds. Use 0 to return
+                   immediately, for an infinite timeout use the
+                   UINT_MAX value.
+   nMaxEvents :    The maximum number of events to take.
+   phEventsList :  [out] A pointer to a variable that receives
+                   the handle of type PHT_HANDLES_LIST containing
+                   taken events (PHT_EVENT or PHT_JOB handles).
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle, zero events number or
+   null pointer was passed.
+
+   PRL_ERR_TIMEOUT - no events were received during the timeout.
+
+   PRL_ERR_OUT_OF_MEMORY - not enough memory to complete the
+   operation.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_OpenEventQueue                                          */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlEventQueue_Poll, (
+		PRL_HANDLE hQueue,
+		PRL_UINT32 nTimeoutMs,
+		PRL_UINT32 nMaxEvents,
+		PRL_HANDLE_PTR phEventsList
+		) );
+
+/* Returns a file descriptor which is readable while the queue
+   is not empty. The descriptor can be watched with poll, epoll
+   or select in the client event loop. It is owned by the queue:
+   the client must neither read it nor close it. The descriptor
+   is valid until the queue handle is freed.
+   Parameters
+   hQueue :  A handle of type PHT_EVENT_QUEUE.
+   pnFd :    [out] A pointer to a variable that receives the
+             file descriptor.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_UNIMPLEMENTED - the platform does not support
+   notification descriptors.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlEventQueue_Poll                                             */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlEventQueue_GetFd, (
+		PRL_HANDLE hQueue,
+		PRL_INT32_PTR pnFd
+		) );
+
+/* Returns the number of events which were dropped because the
+   queue was full.
+   Parameters
+   hQueue :           A handle of type PHT_EVENT_QUEUE.
+   pnOverflowCount :  [out] A pointer to a variable that receives
+                      the number of dropped events.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_OpenEventQueue                                          */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlEventQueue_GetOverflowCount, (
+		PRL_HANDLE hQueue,
+		PRL_UINT64_PTR pnOverflowCount
+		) );
+
+/* Returns a file descriptor which is readable while there are
+   completed jobs of the server to reap with
+   PrlSrv_ReapCompletedJobs. Jobs completions are collected since
+   the first call of this function, so it should be called before
+   the jobs are started. The descriptor can be watched with poll,
+   epoll or select in the client event loop. It is owned by the
+   server handle: the client must neither read it nor close it.
+   Parameters
+   hServer :  A handle of type PHT_SERVER identifying the
+              Virtuozzo Service.
+   pnFd :     [out] A pointer to a variable that receives the
+              file descriptor.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_OUT_OF_MEMORY - failed to create the descriptor.
+
+   PRL_ERR_UNIMPLEMENTED - the platform does not support
+   notification descriptors.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_ReapCompletedJobs
+   PrlJob_GetCompletionFd                                         */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_GetJobsCompletionFd, (
+		PRL_HANDLE hServer,
+		PRL_INT32_PTR pnFd
+		) );
+
+/* Takes jobs of the server which were completed since the
+   previous call in order of their completion. The function never
+   blocks. Jobs which handles were already freed by the client
+   are skipped.
+   Parameters
+   hServer :      A handle of type PHT_SERVER identifying the
+                  Virtuozzo Service.
+   nMaxJobs :     Maximum number of jobs to take. Zero means all
+                  completed jobs.
+   phJobsList :   [out] A pointer to a variable that receives the
+                  handle of type PHT_HANDLES_LIST with handles of
+                  type PHT_JOB. The list may be empty.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_OUT_OF_MEMORY - not enough memory to allocate the
+   list.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_GetJobsCompletionFd                                     */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_ReapCompletedJobs, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nMaxJobs,
+		PRL_HANDLE_PTR phJobsList
+		) );
+
+/* Configures the requests queue of the server connection. By
+   default a request fails with PRL_ERR_TRY_AGAIN when the
+   transport send queue is full. With the requests queue enabled
+   such a request is held by the SDK and the job is returned as
+   pending; queued requests are sent in submission order as the
+   transport frees up. When the requests queue is full too, the
+   submitting call blocks up to the specified timeout waiting for
+   free space and the job fails with PRL_ERR_TRY_AGAIN only after
+   that. The settings are kept across reconnections.
+   Parameters
+   hServer :    A handle of type PHT_SERVER identifying the
+                Virtuozzo Service.
+   nCapacity :  Maximum number of queued requests. Zero disables
+                the queue.
+   nTimeout :   Time in milliseconds to wait for free space in the
+                full queue. For an infinite timeout, use the
+                UINT_MAX value.
+   nFlags :     Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_GetRequestsQueueStat                                    */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_SetRequestsQueue, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nCapacity,
+		PRL_UINT32 nTimeout,
+		PRL_UINT32 nFlags
+		) );
+
+/* Returns metrics of the requests queue of the current server
+   connection.
+   Parameters
+   hServer :     A handle of type PHT_SERVER identifying the
+                 Virtuozzo Service.
+   pnDepth :     [out] A pointer to a variable that receives the
+                 number of currently queued requests.
+   pnMaxDepth :  [out] A pointer to a variable that receives the
+                 maximum number of simultaneously queued requests.
+   pnQueued :    [out] A pointer to a variable that receives the
+                 total number of queued requests.
+   pnRejected :  [out] A pointer to a variable that receives the
+                 number of requests failed as the queue was full.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_SetRequestsQueue                                        */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_GetRequestsQueueStat, (
+		PRL_HANDLE hServer,
+		PRL_UINT32_PTR pnDepth,
+		PRL_UINT32_PTR pnMaxDepth,
+		PRL_UINT64_PTR pnQueued,
+		PRL_UINT64_PTR pnRejected
+		) );
+
+/* Configures the connection pool of the server connection. With
+   the pool enabled, after a successful remote login the SDK opens
+   additional connections to the same Virtuozzo Service and logs
+   them in with the same credentials. Requests with bulk responses
+   (VM configurations, VM lists, host information, problem reports
+   and so on) are spread over the pool connections so that small
+   latency-sensitive requests such as PrlVm_GetState sent with the
+   primary connection are not delayed behind them. Events are
+   received with the primary connection only. When no pool
+   connection is ready, requests are sent with the primary one.
+   Pool connections are opened for logins with user name and
+   password only; local logins and logins with RSA keys do not use
+   the pool. The setting is kept across reconnections and applies
+   to the current session immediately.
+   Parameters
+   hServer :       A handle of type PHT_SERVER identifying the
+                   Virtuozzo Service.
+   nConnections :  Number of additional connections, up to 16.
+                   Zero disables the pool.
+   nFlags :        Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or too many connections
+   were passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_Login                                                   */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_SetConnectionPool, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nConnections,
+		PRL_UINT32 nFlags
+		) );
+
+/* Opens a requests batch of the server connection. Requests
+   made after this call are not sent but held by the SDK. Each
+   of them still returns its own job which is pending until the
+   batch is submitted with PrlSrv_SubmitBatch. Then the held
+   requests are passed to the transport back to back in
+   submission order, and their jobs complete independently. The
+   batch collects requests made from any thread. Login, logoff
+   and cancel requests are never held. Do not wait for a held
+   job before the batch is submitted. If the connection is closed
+   before that, held jobs fail with
+   PRL_ERR_NOT_CONNECTED_TO_DISPATCHER.
+   Parameters
+   hServer :  A handle of type PHT_SERVER identifying the
+              Virtuozzo Service.
+   nFlags :   Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_SubmitBatch                                             */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_BeginBatch, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nFlags
+		) );
+
+/* Closes the requests batch of the server connection opened
+   with PrlSrv_BeginBatch. Sends the held requests in
+   submission order. Calling this function without an open
+   batch has no effect.
+   Parameters
+   hServer :  A handle of type PHT_SERVER identifying the
+              Virtuozzo Service.
+   nFlags :   Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_BeginBatch                                              */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_SubmitBatch, (
+		PRL_HANDLE hServer,
+		PRL_UINT32 nFlags
+		) );
+
+/* Returns the number of in-flight jobs of the server
+   connection.
+   Parameters
+   hServer :     A handle of type PHT_SERVER identifying the
+                 Virtuozzo Service.
+   pnJobs :      [out] A pointer to a variable that receives the
+                 number of jobs awaiting their completion.
+   pnRequests :  [out] A pointer to a variable that receives the
+                 number of requests sent and awaiting response.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle or null pointer was
+   passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlApi_GetPerfCounters                                         */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlSrv_GetInFlightJobs, (
+		PRL_HANDLE hServer,
+		PRL_UINT32_PTR pnJobs,
+		PRL_UINT32_PTR pnRequests
+		) );
+
 /**
 The PrlSrv_GetQuestions function allows to synchronously receive questions from
 a Dispatcher Service. It can be used as an alternative to asynchronous question
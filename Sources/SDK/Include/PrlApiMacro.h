@@ -1151,5 +1151,31 @@ PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_GetCpuMaskSupport ) \
 PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlVm_UpdateNvram ) \
 PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlVmCfg_UpdateNvram ) \
 PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlCt_Convert ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_SetEventFilter ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_GetEventFilterStat ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlVm_SetEventFilter ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_SetNotificationShards ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_GetNotificationShardStat ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_SetProgressEventsCoalescing ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_GetCoalescedEventsCount ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_RegEventHandlerBatch ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_UnregEventHandlerBatch ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_OpenEventQueue ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlEventQueue_Poll ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlEventQueue_GetFd ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlEventQueue_GetOverflowCount ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlJob_WaitAny ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlJob_WaitAll ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlJob_GetCompletionFd ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_GetJobsCompletionFd ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_ReapCompletedJobs ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlJob_SetCompletionCallback ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_SetRequestsQueue ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_GetRequestsQueueStat ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_SetConnectionPool ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_BeginBatch ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_SubmitBatch ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlApi_GetPerfCounters ) \
+PRL_SDK_WRAP_FOR_EACH_ITERATOR( PrlSrv_GetInFlightJobs ) \
 
 #endif // PRL_SDK_WRAP_FOR_EACH
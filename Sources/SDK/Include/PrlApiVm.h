@@ -3274,6 +3274,32 @@ PRL_METHOD_DECL( VIRTUOZZO_API_VER_1,
 		PRL_VOID_PTR userData
 		) );
 
+/* Sets client side filter of the virtual machine events. Events
+   of the virtual machine which do not pass the filter are dropped
+   by the SDK right after receiving in addition to the server
+   events filter (see PrlSrv_SetEventFilter).
+   Parameters
+   hVm :              A handle of type PHT_VIRTUAL_MACHINE.
+   hEventTypesList :  A handle of type PHT_OPAQUE_TYPE_LIST
+                      containing accepted event types
+                      (PRL_EVENT_TYPE values) or PRL_INVALID_HANDLE
+                      to accept events of any type.
+   nFlags :           Reserved parameter.
+   Returns
+   PRL_RESULT. Possible values:
+
+   PRL_ERR_INVALID_ARG - invalid handle was passed.
+
+   PRL_ERR_SUCCESS - function completed successfully.
+   See Also
+   PrlSrv_SetEventFilter                                          */
+PRL_METHOD_DECL( VIRTUOZZO_API_VER_7,
+				 PrlVm_SetEventFilter, (
+		PRL_HANDLE hVm,
+		PRL_HANDLE hEventTypesList,
+		PRL_UINT32 nFlags
+		) );
+
 /**
 The PrlVm_GetQuestions function allows to synchronously receive questions from
 a Dispatcher Service. It can be used as an alternative to asynchronous question
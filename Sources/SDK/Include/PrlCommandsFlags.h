@@ -592,6 +592,8 @@ typedef enum _PRL_LOGIN_FLAGS
 {
 	// Start from 4, cause client identifier is also used during login
 	PLLF_LOGIN_WITH_RSA_KEYS		         = 1 << (PACF_MAX+4),
+	// Client accepts compressed packages bodies
+	PLLF_ALLOW_COMPRESSION			         = 1 << (PACF_MAX+5),
 } PRL_LOGIN_FLAGS;
 typedef PRL_LOGIN_FLAGS* PRL_LOGIN_FLAGS_PTR;
 
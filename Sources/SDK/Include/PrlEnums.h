@@ -127,8 +127,9 @@ typedef enum _PRL_HANDLE_TYPE
 	PHT_VIRTUAL_DISK_ENCRYPTION				= 0x10000061,
 	PHT_VCMMD_CONFIG					= 0x10000062,
 	PHT_BACKUP						= 0x10000063,
+	PHT_EVENT_QUEUE					= 0x10000064,
 
-	PHT_LAST = PHT_BACKUP // should be set to last
+	PHT_LAST = PHT_EVENT_QUEUE // should be set to last
 } PRL_HANDLE_TYPE;
 typedef PRL_HANDLE_TYPE* PRL_HANDLE_TYPE_PTR;
 
@@ -2322,6 +2323,20 @@ typedef enum PRL_Q35_VERSION
 	Q35_DEFAULT = 0,
 } PRL_Q35_VERSION;
 
+/**
+ * Stages of the request processing measured by the SDK performance counters
+ */
+typedef enum _PRL_REQUEST_STAGE
+{
+	PRQS_QUEUE		= 0,	// held by the SDK in the requests queue or batch
+	PRQS_WIRE		= 1,	// sent until its response is received
+	PRQS_PARSE		= 2,	// response is parsed and ordered after the previous packages
+	PRQS_DELIVER	= 3,	// response awaits delivery to the job in the events loop
+	PRQS_SWITCH		= 4,	// API call awaits the context switcher queue of its event loop
+	PRQS_MAX		= PRQS_SWITCH,
+} PRL_REQUEST_STAGE;
+typedef PRL_REQUEST_STAGE* PRL_REQUEST_STAGE_PTR;
+
 #include "PrlCommandsFlags.h"
 
 #endif // __VIRTUOZZO_API_ENUMS_H__
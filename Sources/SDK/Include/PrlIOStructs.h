@@ -660,6 +660,29 @@ typedef struct _PRL_BACKUP_PARAM
 } PRL_STRUCT( PRL_BACKUP_PARAM );
 typedef PRL_BACKUP_PARAM* PRL_BACKUP_PARAM_PTR;
 
+typedef struct _PRL_REQUEST_PERF_COUNTER
+{
+	// @brief Protocol command code of the requests
+	PRL_UINT32 nOpCode;
+	// @brief Measured stage (one of PRL_REQUEST_STAGE values)
+	PRL_UINT32 nStage;
+	// @brief Number of requests passed the stage
+	PRL_UINT64 nCount;
+	// @brief Total time spent at the stage, in microseconds
+	PRL_UINT64 nTotalTime;
+	// @brief Maximum time spent at the stage, in microseconds
+	PRL_UINT64 nMaxTime;
+	// @brief Median, 90th and 99th percentiles of the time spent at the
+	// stage, in microseconds (with up to 12.5% relative error)
+	PRL_UINT64 nP50Time;
+	PRL_UINT64 nP90Time;
+	PRL_UINT64 nP99Time;
+	// @brief Number of requests of the command sent and awaiting response
+	PRL_UINT32 nInFlight;
+	PRL_UINT32 nReserved;
+} PRL_STRUCT( PRL_REQUEST_PERF_COUNTER );
+typedef PRL_REQUEST_PERF_COUNTER* PRL_REQUEST_PERF_COUNTER_PTR;
+
 #ifdef _WIN_
 #pragma pack(pop, save_pack)
 #endif
@@ -63,6 +63,60 @@ static PRL_RESULT PrlHandle_EventCallbackHandler(PRL_HANDLE hEvent, PRL_VOID_PTR
 	return PRL_ERR_SUCCESS;
 }
 
+static std::vector<PyObject *> batch_args_vector;
+
+static PRL_RESULT PrlSrv_BatchEventCallbackHandler(PRL_HANDLE hEventsList, PRL_VOID_PTR user_data)
+{
+	// Whole batch of events is passed to Python under single GIL acquisition
+	PyGILState_STATE gstate = PyGILState_Ensure();
+	do {
+		PRL_HANDLE handle = (PRL_HANDLE)0;
+		PyObject *py_callback_function;
+		PRL_UINT32 nMaxBatch;
+		PRL_UINT32 nMaxDelayMs;
+		PyObject *py_user_data;
+
+		if (!PyArg_ParseTuple((PyObject *)user_data, "kOIIO", &handle, &py_callback_function,
+				&nMaxBatch, &nMaxDelayMs, &py_user_data))
+			break;
+		PyObject *arglist;
+		arglist = Py_BuildValue("(I,O)", hEventsList, py_user_data);
+		PyObject *call_obj_result;
+		call_obj_result = PyObject_CallObject(py_callback_function, arglist);
+		if (PyErr_Occurred())
+			PyErr_Print();
+		Py_XDECREF(call_obj_result);
+		Py_DECREF(arglist);
+	} while(0);
+	PyGILState_Release(gstate);
+	return PRL_ERR_SUCCESS;
+}
+
+static PRL_RESULT PrlJob_CompletionCallbackHandler(PRL_HANDLE hJob, PRL_VOID_PTR user_data)
+{
+	// Callback is called once, so its arguments are released here
+	PyGILState_STATE gstate = PyGILState_Ensure();
+	do {
+		PRL_HANDLE handle = (PRL_HANDLE)0;
+		PyObject *py_callback_function;
+		PyObject *py_user_data;
+
+		if (!PyArg_ParseTuple((PyObject *)user_data, "kOO", &handle, &py_callback_function, &py_user_data))
+			break;
+		PyObject *arglist;
+		arglist = Py_BuildValue("(I,O)", hJob, py_user_data);
+		PyObject *call_obj_result;
+		call_obj_result = PyObject_CallObject(py_callback_function, arglist);
+		if (PyErr_Occurred())
+			PyErr_Print();
+		Py_XDECREF(call_obj_result);
+		Py_DECREF(arglist);
+	} while(0);
+	Py_XDECREF((PyObject *)user_data);
+	PyGILState_Release(gstate);
+	return PRL_ERR_SUCCESS;
+}
+
 static PyObject* sdk_PrlApi_SendProblemReport(PyObject* /*self*/, PyObject* args)
 {
 	PRL_SDK_CHECK;
@@ -707,6 +761,129 @@ static PyObject *sdk_PrlSrv_UnregEventHandler(PyObject* self, PyObject *args)
 	return sdk_PrlHandle_UnregEventHandler(self, args);
 }
 
+static PyObject *sdk_PrlSrv_RegEventHandlerBatch(PyObject* /*self*/, PyObject *args)
+{
+	PRL_SDK_CHECK;
+	do {
+		PyObject *py_callback_function;
+		PyObject *py_user_data;
+		PRL_HANDLE handle = (PRL_HANDLE)0;
+		PRL_UINT32 nMaxBatch = 0;
+		PRL_UINT32 nMaxDelayMs = 0;
+		if ( ! PyArg_ParseTuple(args, "kOIIO:PrlSrv_RegEventHandlerBatch", &handle, &py_callback_function,
+				&nMaxBatch, &nMaxDelayMs, &py_user_data))
+			break;
+		if ( ! PyCallable_Check(py_callback_function)) {
+			PyErr_SetString(PyExc_TypeError, "parameter must be callable");
+			break;
+		}
+		PRL_RESULT prlResult;
+		Py_BEGIN_ALLOW_THREADS
+		prlResult = PrlSrv_RegEventHandlerBatch(handle, PrlSrv_BatchEventCallbackHandler,
+				nMaxBatch, nMaxDelayMs, (PRL_VOID_PTR) args);
+		Py_END_ALLOW_THREADS
+		if (PRL_SUCCEEDED(prlResult)) {
+			Py_XINCREF(args);
+			batch_args_vector.push_back(args);
+		}
+		PyObject* ret_list = PyList_New(0);
+		if ( ! ret_list )
+			break;
+
+		PyObject *pResult = Py_BuildValue( "k", prlResult );
+		if ( PyList_Append(ret_list, pResult) ) {
+			Py_DECREF(pResult);
+			Py_DECREF(ret_list);
+			break;
+		}
+		Py_DECREF(pResult);
+
+		return ret_list;
+	} while(0);
+	return NULL;
+}
+
+static PyObject *sdk_PrlSrv_UnregEventHandlerBatch(PyObject* /*self*/, PyObject *args)
+{
+	PRL_SDK_CHECK;
+	do {
+		PRL_HANDLE handle = (PRL_HANDLE)0;
+		PyObject *py_callback_function;
+		PyObject *py_user_data;
+		PRL_RESULT prlResult = PRL_ERR_FAILURE;
+		if ( ! PyArg_ParseTuple(args, "kOO:PrlSrv_UnregEventHandlerBatch", &handle, &py_callback_function, &py_user_data))
+			break;
+		// Registration arguments are (handle, callback, max batch, max delay, user data)
+		for (std::vector<PyObject *>::size_type i = 0; i != batch_args_vector.size(); i++) {
+			PyObject *reg_args = batch_args_vector[i];
+			if (PyObject_RichCompareBool(PyTuple_GetItem(args, 0), PyTuple_GetItem(reg_args, 0), Py_EQ) == 1
+				&& PyObject_RichCompareBool(py_callback_function, PyTuple_GetItem(reg_args, 1), Py_EQ) == 1
+				&& PyObject_RichCompareBool(py_user_data, PyTuple_GetItem(reg_args, 4), Py_EQ) == 1) {
+				Py_BEGIN_ALLOW_THREADS
+				prlResult = PrlSrv_UnregEventHandlerBatch(handle, PrlSrv_BatchEventCallbackHandler, (PRL_VOID_PTR) reg_args);
+				Py_END_ALLOW_THREADS
+				if (PRL_SUCCEEDED(prlResult)) {
+					Py_XDECREF(reg_args);
+					batch_args_vector.erase(batch_args_vector.begin() + i);
+				}
+				break;
+			}
+		}
+		PyObject* ret_list = PyList_New(0);
+		if ( ! ret_list )
+			break;
+
+		PyObject *pResult = Py_BuildValue( "k", prlResult );
+		if ( PyList_Append(ret_list, pResult) ) {
+			Py_DECREF(pResult);
+			Py_DECREF(ret_list);
+			break;
+		}
+		Py_DECREF(pResult);
+
+		return ret_list;
+	} while(0);
+	return NULL;
+}
+
+static PyObject *sdk_PrlJob_SetCompletionCallback(PyObject* /*self*/, PyObject *args)
+{
+	PRL_SDK_CHECK;
+	do {
+		PyObject *py_callback_function;
+		PyObject *py_user_data;
+		PRL_HANDLE handle = (PRL_HANDLE)0;
+		if ( ! PyArg_ParseTuple(args, "kOO:PrlJob_SetCompletionCallback", &handle, &py_callback_function, &py_user_data))
+			break;
+		if ( ! PyCallable_Check(py_callback_function)) {
+			PyErr_SetString(PyExc_TypeError, "parameter must be callable");
+			break;
+		}
+		// Arguments are released by the callback handler after the call
+		Py_XINCREF(args);
+		PRL_RESULT prlResult;
+		Py_BEGIN_ALLOW_THREADS
+		prlResult = PrlJob_SetCompletionCallback(handle, PrlJob_CompletionCallbackHandler, (PRL_VOID_PTR) args);
+		Py_END_ALLOW_THREADS
+		if (PRL_FAILED(prlResult))
+			Py_XDECREF(args);
+		PyObject* ret_list = PyList_New(0);
+		if ( ! ret_list )
+			break;
+
+		PyObject *pResult = Py_BuildValue( "k", prlResult );
+		if ( PyList_Append(ret_list, pResult) ) {
+			Py_DECREF(pResult);
+			Py_DECREF(ret_list);
+			break;
+		}
+		Py_DECREF(pResult);
+
+		return ret_list;
+	} while(0);
+	return NULL;
+}
+
 static PyObject *sdk_PrlVm_RegEventHandler(PyObject* self, PyObject *args)
 {
 	PRL_SDK_CHECK;
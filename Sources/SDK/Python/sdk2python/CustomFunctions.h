@@ -45,6 +45,9 @@ inline QStringList getCustomFunctions() {
 	nonStdFuncs.append("PrlSrv_UnregEventHandler");
 	nonStdFuncs.append("PrlVm_RegEventHandler");
 	nonStdFuncs.append("PrlVm_UnregEventHandler");
+	nonStdFuncs.append("PrlSrv_RegEventHandlerBatch");
+	nonStdFuncs.append("PrlSrv_UnregEventHandlerBatch");
+	nonStdFuncs.append("PrlJob_SetCompletionCallback");
 	nonStdFuncs.append("PrlOpTypeList_GetItem");
 	nonStdFuncs.append("PrlApi_Init");
 	nonStdFuncs.append("PrlApi_InitEx");
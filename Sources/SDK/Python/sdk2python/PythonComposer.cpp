@@ -121,6 +121,7 @@ PythonComposer::CustomClassInfo PythonComposer::s_CustomClassInfo[] =
 {"Disk",	     "",             "_Handle",    "",       "PHT_VIRTUAL_DISK",   "",0,0,0,0},
 {"DiskMap",      "",             "_Handle",    "",       "PHT_VIRTUAL_DISK_MAP",   "",0,0,0,0},
 {"VcmmdConfig",      "",             "_Handle",    "",       "PHT_VCMMD_CONFIG",   "",0,0,0,0},
+{"EventQueue",   "",             "_Handle",    "",       "PHT_EVENT_QUEUE",   "",0,0,0,0},
 };
 
 
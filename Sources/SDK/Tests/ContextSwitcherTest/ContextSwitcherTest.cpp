@@ -0,0 +1,168 @@
+/*
+ * ContextSwitcherTest.cpp: Context switcher tests and benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "ContextSwitcherTest.h"
+
+#include <thread>
+#include <vector>
+
+#include "Libraries/ContextSwitcher/ContextSwitcher.h"
+
+namespace {
+
+/** Thread the calls are expected to be executed on */
+QThread *g_pSwitcherThread = NULL;
+/** Accessed by the switched calls only */
+int g_nSum = 0;
+int g_nWrongThreadCalls = 0;
+
+int Add(int nValue)
+{
+	if (QThread::currentThread() != g_pSwitcherThread)
+		++g_nWrongThreadCalls;
+	g_nSum += nValue;
+	return g_nSum;
+}
+
+qint64 GetQueueTime()
+{
+	return ContextSwitcher::GetCurrentCallQueueTime();
+}
+
+void RunInThreads(int nThreads, int nCalls, ContextSwitcher *pSwitcher)
+{
+	std::vector<std::thread> vThreads;
+	vThreads.reserve(nThreads);
+	for (int i = 0; i < nThreads; ++i)
+		vThreads.emplace_back([nCalls, pSwitcher]()
+		{
+			for (int nValue = 1; nValue <= nCalls; ++nValue)
+				pSwitcher->Invoke(Add, nValue);
+		});
+	for (std::thread &t : vThreads)
+		t.join();
+}
+
+} // namespace
+
+CContextSwitcherTest::CContextSwitcherTest()
+: m_pThread(NULL), m_pSwitcher(NULL)
+{
+}
+
+void CContextSwitcherTest::initTestCase()
+{
+	m_pThread = new QThread;
+	m_pThread->start();
+	m_pSwitcher = new ContextSwitcher;
+	m_pSwitcher->moveToThread(m_pThread);
+	g_pSwitcherThread = m_pThread;
+}
+
+void CContextSwitcherTest::cleanupTestCase()
+{
+	m_pThread->quit();
+	QVERIFY(m_pThread->wait());
+	delete m_pSwitcher;
+	delete m_pThread;
+}
+
+void CContextSwitcherTest::init()
+{
+	g_nSum = 0;
+	g_nWrongThreadCalls = 0;
+}
+
+void CContextSwitcherTest::testCallResult()
+{
+	int nValue = 42;
+	QCOMPARE(m_pSwitcher->Invoke(Add, nValue), 42);
+	nValue = 8;
+	QCOMPARE(m_pSwitcher->Invoke(Add, nValue), 50);
+	QCOMPARE(g_nWrongThreadCalls, 0);
+}
+
+void CContextSwitcherTest::testCallOnOwnThread()
+{
+	// Switcher calls made from its own thread must not wait for themselves
+	ContextSwitcher _switcher;
+	g_pSwitcherThread = QThread::currentThread();
+	int nValue = 1;
+	QCOMPARE(_switcher.Invoke(Add, nValue), 1);
+	g_pSwitcherThread = m_pThread;
+	QCOMPARE(g_nWrongThreadCalls, 0);
+}
+
+void CContextSwitcherTest::testQueueTime()
+{
+	QCOMPARE(ContextSwitcher::GetCurrentCallQueueTime(), qint64(-1));
+	QVERIFY(m_pSwitcher->Invoke(GetQueueTime) >= 0);
+	QCOMPARE(ContextSwitcher::GetCurrentCallQueueTime(), qint64(-1));
+}
+
+void CContextSwitcherTest::testManyProducers_data()
+{
+	QTest::addColumn<int>("threads");
+	QTest::addColumn<int>("calls");
+
+	QTest::newRow("16 producers") << 16 << 10000;
+	// More blocked producers than queue cells, so some calls fall back to queued connection
+	QTest::newRow("queue overflow") << 300 << 100;
+}
+
+void CContextSwitcherTest::testManyProducers()
+{
+	QFETCH(int, threads);
+	QFETCH(int, calls);
+
+	RunInThreads(threads, calls, m_pSwitcher);
+
+	// Each call is executed exactly once and calls are never executed concurrently
+	QCOMPARE(g_nSum, threads * calls * (calls + 1) / 2);
+	QCOMPARE(g_nWrongThreadCalls, 0);
+}
+
+void CContextSwitcherTest::benchHandoff_data()
+{
+	QTest::addColumn<int>("threads");
+
+	QTest::newRow("1 thread") << 1;
+	QTest::newRow("4 threads") << 4;
+	QTest::newRow("16 threads") << 16;
+}
+
+void CContextSwitcherTest::benchHandoff()
+{
+	QFETCH(int, threads);
+
+	QBENCHMARK
+	{
+		RunInThreads(threads, 1000, m_pSwitcher);
+	}
+}
+
+QTEST_GUILESS_MAIN(CContextSwitcherTest)
@@ -0,0 +1,66 @@
+/*
+ * ContextSwitcherTest.h: Context switcher tests and benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_CONTEXT_SWITCHER_TEST_H__
+#define __VIRTUOZZO_CONTEXT_SWITCHER_TEST_H__
+
+#include <QtTest/QtTest>
+
+class ContextSwitcher;
+
+/**
+ * Context switcher tests: calls are executed on the switcher thread exactly
+ * once from any number of producers, including queue overflow, and the
+ * benchmark of the call handoff latency.
+ */
+class CContextSwitcherTest : public QObject
+{
+	Q_OBJECT
+
+public:
+	CContextSwitcherTest();
+
+private slots:
+	void initTestCase();
+	void cleanupTestCase();
+	void init();
+
+	void testCallResult();
+	void testCallOnOwnThread();
+	void testQueueTime();
+	void testManyProducers_data();
+	void testManyProducers();
+
+	void benchHandoff_data();
+	void benchHandoff();
+
+private:
+	QThread *m_pThread;
+	ContextSwitcher *m_pSwitcher;
+};
+
+#endif // __VIRTUOZZO_CONTEXT_SWITCHER_TEST_H__
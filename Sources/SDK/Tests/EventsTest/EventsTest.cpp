@@ -0,0 +1,307 @@
+/*
+ * EventsTest.cpp: Server events delivery tests and benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "EventsTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <QUuid>
+
+namespace {
+
+/** Registration state of the handler checked by the handler itself */
+struct HandlerState
+{
+	HandlerState() : bRegistered(false) {}
+
+	std::atomic<bool> bRegistered;
+	QAtomicInt nCalls;
+	QAtomicInt nUnexpectedCalls;
+};
+
+PRL_RESULT CheckRegistered(PRL_HANDLE hEvent, PRL_VOID_PTR pData)
+{
+	SdkHandleWrap h(hEvent);
+	HandlerState *pState = static_cast<HandlerState *>(pData);
+	pState->nCalls.ref();
+	if (!pState->bRegistered.load())
+		pState->nUnexpectedCalls.ref();
+	return PRL_ERR_SUCCESS;
+}
+
+/** Registers and unregisters handler until stopped */
+void ChurnHandler(PRL_HANDLE hServer, HandlerState *pState, const std::atomic<bool> &bStop)
+{
+	while (!bStop.load())
+	{
+		pState->bRegistered.store(true);
+		PrlSrv_RegEventHandler(hServer, CheckRegistered, pState);
+		PrlSrv_UnregEventHandler(hServer, CheckRegistered, pState);
+		// Handler must not be called anymore once unregistration returned
+		pState->bRegistered.store(false);
+	}
+}
+
+/** Length of the string buffers UUIDs are read to */
+enum { UUID_BUF_LENGTH = 64 };
+
+/** Events delivery of the VMs one of which has the slow callback */
+struct VmsEventsState
+{
+	VmsEventsState() : bBlocked(false), nHandlerUsecs(0) {}
+
+	/** Events of this VM are held by the callback while it is blocked */
+	QUuid blockedVmUuid;
+	std::atomic<bool> bBlocked;
+	/** Time the callback spends on every event */
+	int nHandlerUsecs;
+	QAtomicInt nBlockedVmEvents;
+	QAtomicInt nOtherVmsEvents;
+};
+
+PRL_RESULT CountVmsEvents(PRL_HANDLE hEvent, PRL_VOID_PTR pData)
+{
+	SdkHandleWrap h(hEvent);
+	VmsEventsState *pState = static_cast<VmsEventsState *>(pData);
+	PRL_EVENT_TYPE nEventType = PET_VM_INF_UNINITIALIZED_EVENT_CODE;
+	if (PRL_FAILED(PrlEvent_GetType(h, &nEventType)) || PET_DSP_EVT_VM_STATE_CHANGED != nEventType)
+		return PRL_ERR_SUCCESS;
+
+	char sUuid[UUID_BUF_LENGTH];
+	PRL_UINT32 nLength = sizeof(sUuid);
+	if (PRL_FAILED(PrlEvent_GetIssuerId(h, sUuid, &nLength)))
+		return PRL_ERR_SUCCESS;
+
+	if (pState->blockedVmUuid == QUuid(QString::fromUtf8(sUuid)))
+	{
+		while (pState->bBlocked.load())
+			QThread::msleep(1);
+		pState->nBlockedVmEvents.ref();
+		return PRL_ERR_SUCCESS;
+	}
+
+	if (pState->nHandlerUsecs > 0)
+		std::this_thread::sleep_for(std::chrono::microseconds(pState->nHandlerUsecs));
+	pState->nOtherVmsEvents.ref();
+	return PRL_ERR_SUCCESS;
+}
+
+} // namespace
+
+void CEventsTest::initTestCase()
+{
+	QVERIFY(m_Dispatcher.Start());
+}
+
+void CEventsTest::cleanupTestCase()
+{
+	m_Dispatcher.Stop();
+}
+
+void CEventsTest::init()
+{
+	m_Dispatcher.SetVmsCount(0);
+	m_nEvents.storeRelease(0);
+}
+
+void CEventsTest::testConcurrentRegistration()
+{
+	enum { EVENTS = 20000, CHURNING_THREADS = 8 };
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	const PRL_HANDLE hServer = _session.GetServer();
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_RegEventHandler(hServer, CountStateEvents, &m_nEvents)));
+
+	HandlerState aStates[CHURNING_THREADS];
+	std::atomic<bool> bStop(false);
+	std::thread _sender([this]() { m_Dispatcher.SendEvents(EVENTS); });
+	RunInThreads(CHURNING_THREADS, [this, hServer, &aStates, &bStop](int nThread)
+	{
+		if (nThread == 0)
+		{
+			// The first thread stops churning once all events were delivered
+			WaitCounter(m_nEvents, EVENTS);
+			bStop.store(true);
+		}
+		ChurnHandler(hServer, &aStates[nThread], bStop);
+	});
+	_sender.join();
+
+	// Handler registered all the time got every event despite of the snapshots replacement
+	QCOMPARE(m_nEvents.loadAcquire(), int(EVENTS));
+	int nChurnedCalls = 0;
+	for (int i = 0; i < CHURNING_THREADS; ++i)
+	{
+		QCOMPARE(aStates[i].nUnexpectedCalls.loadAcquire(), 0);
+		nChurnedCalls += aStates[i].nCalls.loadAcquire();
+	}
+	qDebug("Handlers registered on the fly were called %d times", nChurnedCalls);
+
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_UnregEventHandler(hServer, CountStateEvents, &m_nEvents)));
+}
+
+void CEventsTest::testShardedDelivery()
+{
+	enum { VMS = 2000, EVENTS = 20000, SHARDS = 8 };
+
+	m_Dispatcher.SetVmsCount(VMS);
+	CSdkTestSession _session(m_Dispatcher);
+	const PRL_HANDLE hServer = _session.GetServer();
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_SetNotificationShards(hServer, SHARDS, 0)));
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	QCOMPARE(PrlSrv_SetNotificationShards(hServer, 1, 0),
+		PRL_ERR_ALREADY_CONNECTED_TO_DISPATCHER);
+
+	// Callback of the first VM is stuck, so with the single notification thread
+	// no event would be delivered at all as the first event is issued by that VM
+	VmsEventsState _state;
+	_state.blockedVmUuid = QUuid(m_Dispatcher.GetVmsUuids().first());
+	_state.bBlocked.store(true);
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_RegEventHandler(hServer, CountVmsEvents, &_state)));
+
+	std::thread _sender([this]() { m_Dispatcher.SendEvents(EVENTS); });
+	// Only VMs sharing the thread with the stuck one are delayed
+	const bool bOthersDelivered = WaitCounter(_state.nOtherVmsEvents, EVENTS / 2);
+	const int nBlockedVmEvents = _state.nBlockedVmEvents.loadAcquire();
+	_state.bBlocked.store(false);
+	_sender.join();
+
+	QVERIFY(bOthersDelivered);
+	QCOMPARE(nBlockedVmEvents, 0);
+	QVERIFY(WaitCounter(_state.nBlockedVmEvents, EVENTS / VMS));
+	QVERIFY(WaitCounter(_state.nOtherVmsEvents, EVENTS - EVENTS / VMS));
+
+	PRL_UINT32 nQueueDepth = 0;
+	PRL_UINT64 nDelivered = 0, nShardDelivered = 0, nAvgLatency = 0, nMaxLatency = 0;
+	for (PRL_UINT32 i = 0; i < SHARDS; ++i)
+	{
+		QVERIFY(PRL_SUCCEEDED(PrlSrv_GetNotificationShardStat(hServer, i, &nQueueDepth,
+			&nShardDelivered, &nAvgLatency, &nMaxLatency)));
+		nDelivered += nShardDelivered;
+	}
+	QVERIFY(nDelivered >= PRL_UINT64(EVENTS));
+	QCOMPARE(PrlSrv_GetNotificationShardStat(hServer, SHARDS, &nQueueDepth,
+		&nShardDelivered, &nAvgLatency, &nMaxLatency), PRL_ERR_INVALID_ARG);
+
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_UnregEventHandler(hServer, CountVmsEvents, &_state)));
+}
+
+void CEventsTest::benchDispatch_data()
+{
+	QTest::addColumn<int>("handlers");
+	QTest::addColumn<bool>("churn");
+
+	QTest::newRow("1 handler") << 1 << false;
+	QTest::newRow("16 handlers") << 16 << false;
+	QTest::newRow("16 handlers, concurrent registration") << 16 << true;
+}
+
+void CEventsTest::benchDispatch()
+{
+	enum { EVENTS = 10000 };
+
+	QFETCH(int, handlers);
+	QFETCH(bool, churn);
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	const PRL_HANDLE hServer = _session.GetServer();
+
+	// The first handler counts events, others are distinguished by their user data
+	std::vector<HandlerState> vStates(handlers - 1);
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_RegEventHandler(hServer, CountStateEvents, &m_nEvents)));
+	for (size_t i = 0; i < vStates.size(); ++i)
+	{
+		vStates[i].bRegistered.store(true);
+		QVERIFY(PRL_SUCCEEDED(PrlSrv_RegEventHandler(hServer, CheckRegistered, &vStates[i])));
+	}
+
+	HandlerState _churned;
+	std::atomic<bool> bStop(false);
+	std::thread _churner;
+	if (churn)
+		_churner = std::thread(ChurnHandler, hServer, &_churned, std::cref(bStop));
+
+	QBENCHMARK
+	{
+		m_nEvents.storeRelease(0);
+		m_Dispatcher.SendEvents(EVENTS);
+		QVERIFY(WaitCounter(m_nEvents, EVENTS));
+	}
+
+	bStop.store(true);
+	if (_churner.joinable())
+		_churner.join();
+	for (size_t i = 0; i < vStates.size(); ++i)
+		QVERIFY(PRL_SUCCEEDED(PrlSrv_UnregEventHandler(hServer, CheckRegistered, &vStates[i])));
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_UnregEventHandler(hServer, CountStateEvents, &m_nEvents)));
+	QCOMPARE(_churned.nUnexpectedCalls.loadAcquire(), 0);
+}
+
+void CEventsTest::benchShardedDelivery_data()
+{
+	QTest::addColumn<int>("shards");
+	QTest::addColumn<int>("usecs");
+
+	QTest::newRow("1 thread, fast callback") << 1 << 0;
+	QTest::newRow("8 threads, fast callback") << 8 << 0;
+	QTest::newRow("1 thread, 20 us callback") << 1 << 20;
+	QTest::newRow("8 threads, 20 us callback") << 8 << 20;
+}
+
+void CEventsTest::benchShardedDelivery()
+{
+	enum { VMS = 2000, EVENTS = 20000 };
+
+	QFETCH(int, shards);
+	QFETCH(int, usecs);
+
+	m_Dispatcher.SetVmsCount(VMS);
+	CSdkTestSession _session(m_Dispatcher);
+	const PRL_HANDLE hServer = _session.GetServer();
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_SetNotificationShards(hServer, shards, 0)));
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	VmsEventsState _state;
+	_state.nHandlerUsecs = usecs;
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_RegEventHandler(hServer, CountVmsEvents, &_state)));
+
+	QBENCHMARK
+	{
+		_state.nOtherVmsEvents.storeRelease(0);
+		m_Dispatcher.SendEvents(EVENTS);
+		QVERIFY(WaitCounter(_state.nOtherVmsEvents, EVENTS));
+	}
+
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_UnregEventHandler(hServer, CountVmsEvents, &_state)));
+}
+
+PRL_SDK_TEST_MAIN(CEventsTest)
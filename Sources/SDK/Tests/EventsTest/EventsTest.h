@@ -0,0 +1,61 @@
+/*
+ * EventsTest.h: Server events delivery tests and benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_EVENTS_TEST_H__
+#define __VIRTUOZZO_EVENTS_TEST_H__
+
+#include "SdkTest.h"
+
+/**
+ * Server events delivery tests: handlers registration concurrent with
+ * events dispatching, delivery of thousands of VMs events by sharded
+ * notification threads and events delivery rate benchmarks.
+ */
+class CEventsTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void cleanupTestCase();
+	void init();
+
+	void testConcurrentRegistration();
+	void testShardedDelivery();
+
+	void benchDispatch_data();
+	void benchDispatch();
+	void benchShardedDelivery_data();
+	void benchShardedDelivery();
+
+private:
+	CFakeDispatcher m_Dispatcher;
+	/** Events counted by the handler, outlives the sessions it is registered with */
+	QAtomicInt m_nEvents;
+};
+
+#endif // __VIRTUOZZO_EVENTS_TEST_H__
@@ -0,0 +1,385 @@
+/*
+ * FakeDispatcher.cpp: Dispatcher Service stub for SDK tests
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "FakeDispatcher.h"
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QHostAddress>
+#include <QMutexLocker>
+#include <QTcpServer>
+#include <QThread>
+
+#include <algorithm>
+#include <random>
+
+#include <prlcommon/Interfaces/VirtuozzoNamespace.h>
+#include <prlcommon/Interfaces/VirtuozzoQt.h>
+#include <prlcommon/IOService/IOCommunication/IORoutingTableHelper.h>
+#include <prlcommon/Logging/Logging.h>
+#include <prlcommon/Messaging/CVmEvent.h>
+#include <prlcommon/Messaging/CVmEventParameter.h>
+#include <prlcommon/ProtoSerializer/CProtoSerializer.h>
+#include <prlcommon/PrlUuid/Uuid.h>
+#include <prlxmlmodel/VmConfig/CVmConfiguration.h>
+
+#include "SDK/Handles/Disp/PveCompression.h"
+
+using namespace Virtuozzo;
+
+CFakeDispatcher::CFakeDispatcher()
+: m_pServer(NULL), m_nPort(0), m_sServerUuid(Uuid::createUuid().toString()),
+  m_nResponseDelay(0), m_nRequestsCount(0), m_nBinaryResponses(0),
+  m_nCompression(0), m_nCompressedRequests(0), m_nCompressedPackages(0), m_bHoldResponses(false), m_nNextEventIssuer(0)
+{
+}
+
+CFakeDispatcher::~CFakeDispatcher()
+{
+	Stop();
+}
+
+bool CFakeDispatcher::Start()
+{
+	if (m_pServer)
+		return true;
+
+	// Transport can't listen on the ephemeral port, so the free one is found first
+	{
+		QTcpServer _probe;
+		if (!_probe.listen(QHostAddress(GetHost()), 0))
+		{
+			WRITE_TRACE(DBG_FATAL, "Failed to find free port: %s", QSTR2UTF8(_probe.errorString()));
+			return false;
+		}
+		m_nPort = _probe.serverPort();
+	}
+
+	m_pServer = new IOServer(IORoutingTableHelper::GetServerRoutingTable(PSL_LOW_SECURITY),
+							 IOSender::Dispatcher, GetHost(), m_nPort);
+	bool bRes = true;
+	bRes &= bool(connect(m_pServer, SIGNAL(onClientConnected(IOSender::Handle)),
+						 SLOT(onClientConnected(IOSender::Handle)), Qt::DirectConnection));
+	bRes &= bool(connect(m_pServer, SIGNAL(onClientDisconnected(IOSender::Handle)),
+						 SLOT(onClientDisconnected(IOSender::Handle)), Qt::DirectConnection));
+	bRes &= bool(connect(m_pServer, SIGNAL(onPackageReceived(IOSender::Handle, const SmartPtr<IOPackage>)),
+						 SLOT(onPackageReceived(IOSender::Handle, const SmartPtr<IOPackage>)),
+						 Qt::DirectConnection));
+	Q_ASSERT(bRes);
+
+	if (!bRes || IOSender::Connected != m_pServer->listen())
+	{
+		WRITE_TRACE(DBG_FATAL, "Failed to listen on port %u", m_nPort);
+		Stop();
+		return false;
+	}
+	return true;
+}
+
+void CFakeDispatcher::Stop()
+{
+	if (!m_pServer)
+		return;
+
+	m_pServer->disconnectServer();
+	delete m_pServer;
+	m_pServer = NULL;
+
+	QMutexLocker _lock(&m_Mutex);
+	m_lstClients.clear();
+	m_setCompressionClients.clear();
+	m_lstHeldRequests.clear();
+}
+
+void CFakeDispatcher::SetResponseDelay(int nMsecs)
+{
+	m_nResponseDelay.storeRelease(nMsecs);
+}
+
+void CFakeDispatcher::SetVmsCount(int nCount)
+{
+	QStringList lstUuids, lstConfigs;
+	for (int i = 0; i < nCount; ++i)
+	{
+		CVmConfiguration _config;
+		QString sUuid = Uuid::createUuid().toString();
+		_config.getVmIdentification()->setVmUuid(sUuid);
+		_config.getVmIdentification()->setVmName(QString("vm-%1").arg(i));
+		_config.getVmSettings()->getVmCommonOptions()->setOsType(PVS_GUEST_TYPE_LINUX);
+		lstUuids.append(sUuid);
+		lstConfigs.append(_config.toString());
+	}
+
+	QMutexLocker _lock(&m_Mutex);
+	m_lstVmsUuids = lstUuids;
+	m_lstVmsConfigs = lstConfigs;
+	m_nNextEventIssuer = 0;
+}
+
+QStringList CFakeDispatcher::GetVmsUuids() const
+{
+	QMutexLocker _lock(&m_Mutex);
+	return m_lstVmsUuids;
+}
+
+void CFakeDispatcher::SetBinaryResponses(bool bBinary)
+{
+	m_nBinaryResponses.storeRelease(bBinary ? 1 : 0);
+}
+
+void CFakeDispatcher::SetCompression(bool bEnabled)
+{
+	m_nCompression.storeRelease(bEnabled ? 1 : 0);
+}
+
+void CFakeDispatcher::SetHoldResponses(bool bHold)
+{
+	QMutexLocker _lock(&m_Mutex);
+	m_bHoldResponses = bHold;
+}
+
+int CFakeDispatcher::GetHeldResponsesCount() const
+{
+	QMutexLocker _lock(&m_Mutex);
+	return m_lstHeldRequests.size();
+}
+
+int CFakeDispatcher::ReleaseHeldResponses(int nMaxCount, bool bShuffle)
+{
+	QList<HeldRequest> lstRequests;
+	{
+		QMutexLocker _lock(&m_Mutex);
+		if (nMaxCount < 0 || nMaxCount >= m_lstHeldRequests.size())
+			lstRequests.swap(m_lstHeldRequests);
+		else
+		{
+			lstRequests = m_lstHeldRequests.mid(0, nMaxCount);
+			m_lstHeldRequests.erase(m_lstHeldRequests.begin(), m_lstHeldRequests.begin() + nMaxCount);
+		}
+	}
+
+	if (bShuffle)
+		std::shuffle(lstRequests.begin(), lstRequests.end(), std::mt19937(std::random_device()()));
+	foreach(const HeldRequest &r, lstRequests)
+		AnswerRequest(r.h, r.p);
+	return lstRequests.size();
+}
+
+void CFakeDispatcher::SendEvents(int nCount)
+{
+	QList<IOSender::Handle> lstClients;
+	QStringList lstIssuers;
+	int nNextIssuer;
+	{
+		QMutexLocker _lock(&m_Mutex);
+		lstClients = m_lstClients;
+		lstIssuers = m_lstVmsUuids;
+		nNextIssuer = m_nNextEventIssuer;
+		if (!lstIssuers.isEmpty())
+			m_nNextEventIssuer = (m_nNextEventIssuer + nCount) % lstIssuers.size();
+	}
+
+	for (int i = 0; i < nCount; ++i)
+	{
+		CVmEvent _event(PET_DSP_EVT_VM_STATE_CHANGED, m_sServerUuid, PIE_DISPATCHER);
+		if (!lstIssuers.isEmpty())
+		{
+			_event.setEventIssuerType(PIE_VIRTUAL_MACHINE);
+			_event.setEventIssuerId(lstIssuers.at((nNextIssuer + i) % lstIssuers.size()));
+		}
+		_event.addEventParameter(new CVmEventParameter(PVE::Integer,
+			QString::number(VMS_RUNNING), EVT_PARAM_VMINFO_VM_STATE));
+
+		SmartPtr<IOPackage> p = DispatcherPackage::createInstance(PVE::DspVmEvent, _event.toString());
+		foreach(const IOSender::Handle &h, lstClients)
+			SendPackage(h, p);
+	}
+}
+
+void CFakeDispatcher::onClientConnected(IOSender::Handle h)
+{
+	QMutexLocker _lock(&m_Mutex);
+	m_lstClients.append(h);
+}
+
+void CFakeDispatcher::onClientDisconnected(IOSender::Handle h)
+{
+	QMutexLocker _lock(&m_Mutex);
+	m_lstClients.removeAll(h);
+	m_setCompressionClients.remove(h);
+}
+
+void CFakeDispatcher::onPackageReceived(IOSender::Handle h, const SmartPtr<IOPackage> p)
+{
+	m_nRequestsCount.ref();
+
+	if (CPveCompression::IsCompressed(p))
+	{
+		bool bOk = false;
+		CPveCompression::GetBody(p, true, bOk);
+		if (bOk)
+			m_nCompressedRequests.ref();
+		else
+			WRITE_TRACE(DBG_FATAL, "Failed to inflate request %d body", p->header.type);
+	}
+
+	int nDelay = m_nResponseDelay.loadAcquire();
+	if (nDelay > 0)
+		QThread::msleep(nDelay);
+
+	// Session management requests are not held to let sessions come and go
+	if (PVE::DspCmdUserLogin != p->header.type && PVE::DspCmdUserLogoff != p->header.type)
+	{
+		QMutexLocker _lock(&m_Mutex);
+		if (m_bHoldResponses)
+		{
+			HeldRequest r = { h, p };
+			m_lstHeldRequests.append(r);
+			return;
+		}
+	}
+
+	AnswerRequest(h, p);
+}
+
+void CFakeDispatcher::AnswerRequest(IOSender::Handle h, const SmartPtr<IOPackage> &p)
+{
+	switch (p->header.type)
+	{
+	case PVE::DspCmdUserLogin:
+		SendLoginResponse(h, p);
+		break;
+	case PVE::DspCmdDirGetVmList:
+		SendVmListResponse(h, p);
+		break;
+	default:
+		SendEmptyResponse(h, p);
+		break;
+	}
+}
+
+void CFakeDispatcher::SendLoginResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p)
+{
+	CVmEvent _login_info;
+	_login_info.addEventParameter(new CVmEventParameter(PVE::String,
+		Uuid::createUuid().toString(), EVT_PARAM_RESPONSE_LOGIN_CMD_SESSION));
+	_login_info.addEventParameter(new CVmEventParameter(PVE::String,
+		m_sServerUuid, EVT_PARAM_PRL_SERVER_INFO_SERVER_UUID));
+
+	if (m_nCompression.loadAcquire())
+	{
+		bool bOk = false;
+		const QByteArray body = CPveCompression::GetBody(p, false, bOk);
+		CProtoCommandPtr pLogin = CProtoSerializer::ParseCommand(PVE::DspCmdUserLogin,
+			UTF8_2QSTR(body.constData()));
+		if (pLogin->IsValid() && (pLogin->GetCommandFlags() & PLLF_ALLOW_COMPRESSION))
+		{
+			_login_info.addEventParameter(new CVmEventParameter(PVE::UnsignedInt,
+				"1", EVT_PARAM_PRL_SERVER_INFO_COMPRESSION));
+			QMutexLocker _lock(&m_Mutex);
+			m_setCompressionClients.insert(h);
+		}
+	}
+
+	// Login info is sent as binary content of the response like the dispatcher does
+	SendResponse(h, p, CProtoSerializer::CreateDspWsResponseCommand(p, PRL_ERR_SUCCESS), true, &_login_info);
+}
+
+void CFakeDispatcher::SendVmListResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p)
+{
+	QStringList lstConfigs;
+	{
+		QMutexLocker _lock(&m_Mutex);
+		lstConfigs = m_lstVmsConfigs;
+	}
+
+	CProtoCommandPtr pResponse = CProtoSerializer::CreateDspWsResponseCommand(p, PRL_ERR_SUCCESS);
+	CProtoSerializer::CastToProtoCommand<CProtoCommandDspWsResponse>(pResponse)->SetParamsList(lstConfigs);
+	SendResponse(h, p, pResponse, m_nBinaryResponses.loadAcquire());
+}
+
+void CFakeDispatcher::SendEmptyResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p)
+{
+	SendResponse(h, p, CProtoSerializer::CreateDspWsResponseCommand(p, PRL_ERR_SUCCESS),
+				 m_nBinaryResponses.loadAcquire());
+}
+
+void CFakeDispatcher::SendResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p,
+								   const CProtoCommandPtr &pResponse, bool bBinary,
+								   CVmEvent *pBinaryContent)
+{
+	if (!bBinary)
+	{
+		SendPackage(h, DispatcherPackage::createInstance(PVE::DspWsResponse,
+			pResponse->GetCommand()->toString(), p));
+		return;
+	}
+
+	// Binary response is the serialized response command followed by the binary content
+	QBuffer _buffer;
+	bool bRes = _buffer.open(QIODevice::WriteOnly);
+	Q_ASSERT(bRes); Q_UNUSED(bRes);
+	QDataStream _data_stream(&_buffer);
+	_data_stream.setVersion(QDataStream::Qt_4_0);
+	pResponse->GetCommand()->Serialize(_data_stream);
+	CVmEvent _empty_content;
+	(pBinaryContent ? pBinaryContent : &_empty_content)->Serialize(_data_stream);
+
+	SmartPtr<IOPackage> pPackage = IOPackage::createInstance(PVE::DspWsBinaryResponse, 1, p);
+	pPackage->fillBuffer(0, IOPackage::RawEncoding, _buffer.data().constData(), _buffer.data().size());
+	SendPackage(h, pPackage);
+}
+
+void CFakeDispatcher::SendPackage(IOSender::Handle h, const SmartPtr<IOPackage> &p)
+{
+	if (!m_pServer)
+		return;
+
+	SmartPtr<IOPackage> pPackage = p;
+	{
+		QMutexLocker _lock(&m_Mutex);
+		if (m_setCompressionClients.contains(h))
+			pPackage = CPveCompression::Deflate(p);
+	}
+	if (pPackage.getImpl() != p.getImpl())
+		m_nCompressedPackages.ref();
+
+	// Events storms overflow the send queue, so sending is retried until
+	// the client takes the packages queued before
+	for (;;)
+	{
+		IOSendJob::Handle hJob = m_pServer->sendPackage(h, pPackage);
+		if (hJob == IOSendJob::InvalidHandle)
+		{
+			WRITE_TRACE(DBG_FATAL, "Failed to send package %d to client %s", p->header.type, QSTR2UTF8(h));
+			return;
+		}
+		if (IOSendJob::SendQueueIsFull != m_pServer->getSendResult(hJob))
+			return;
+		QThread::yieldCurrentThread();
+	}
+}
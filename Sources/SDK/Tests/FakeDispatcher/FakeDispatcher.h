@@ -0,0 +1,186 @@
+/*
+ * FakeDispatcher.h: Dispatcher Service stub for SDK tests
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_FAKE_DISPATCHER_H__
+#define __VIRTUOZZO_FAKE_DISPATCHER_H__
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QSet>
+#include <QStringList>
+
+#include "SDK/Include/Virtuozzo.h"
+
+#include <prlcommon/IOService/IOCommunication/IOServer.h>
+#include <prlcommon/ProtoSerializer/CProtoCommands.h>
+
+using namespace IOService;
+
+class CVmEvent;
+
+/**
+ * Dispatcher Service stub listening on the loopback interface. It speaks
+ * enough of the dispatcher protocol to let SDK log in, send requests and
+ * receive events without a real host:
+ *  - login is answered with the session and server UUIDs;
+ *  - VMs list request is answered with canned VMs configurations;
+ *  - any other request is answered with the empty successful response.
+ * Responses are sent as XML commands or, on demand, in the binary form.
+ * Compression of large packages bodies is confirmed on demand.
+ * Packages are answered right on the transport thread they are received
+ * on, so the response delay models the dispatcher processing time.
+ */
+class CFakeDispatcher : public QObject
+{
+	Q_OBJECT
+
+public:
+	/** Class constructor */
+	CFakeDispatcher();
+	/** Class destructor */
+	~CFakeDispatcher();
+
+	/**
+	 * Starts listening on the free port of the loopback interface
+	 * @return false if listening could not be started
+	 */
+	bool Start();
+	/** Stops listening and disconnects all clients */
+	void Stop();
+
+	/** Returns host to log in to */
+	static const char *GetHost() { return "127.0.0.1"; }
+	/** Returns port to log in to */
+	quint16 GetPort() const { return m_nPort; }
+	/** Returns server UUID reported at login */
+	QString GetServerUuid() const { return m_sServerUuid; }
+
+	/**
+	 * Sets time each request is processed for
+	 * @param delay in milliseconds
+	 */
+	void SetResponseDelay(int nMsecs);
+	/**
+	 * Sets number of VMs registered on the dispatcher
+	 * @param number of VMs
+	 */
+	void SetVmsCount(int nCount);
+	/** Returns UUIDs of the VMs registered on the dispatcher */
+	QStringList GetVmsUuids() const;
+	/**
+	 * Sets whether requests are answered with binary responses instead of
+	 * XML ones. Login is always answered with the binary response.
+	 * @param sign of binary responses
+	 */
+	void SetBinaryResponses(bool bBinary);
+
+	/**
+	 * Sets whether dispatcher confirms compression offered by client at
+	 * login. Large packages sent to such clients are compressed.
+	 * @param sign of compression support
+	 */
+	void SetCompression(bool bEnabled);
+	/** Returns number of compressed requests received and inflated */
+	int GetCompressedRequestsCount() const { return m_nCompressedRequests.loadAcquire(); }
+	/** Returns number of packages sent compressed */
+	int GetCompressedPackagesCount() const { return m_nCompressedPackages.loadAcquire(); }
+
+	/**
+	 * Sets whether responses to the requests are held until released. Login
+	 * and logoff are always answered at once.
+	 * @param sign of holding responses
+	 */
+	void SetHoldResponses(bool bHold);
+	/** Returns number of requests whose responses are held */
+	int GetHeldResponsesCount() const;
+	/**
+	 * Answers held requests
+	 * @param maximum number of requests to answer, -1 to answer all of them
+	 * @param sign whether requests are answered in random order instead of
+	 * the order they were received in
+	 * @return number of answered requests
+	 */
+	int ReleaseHeldResponses(int nMaxCount = -1, bool bShuffle = false);
+
+	/**
+	 * Sends state change events to all connected clients. Events are issued
+	 * by the registered VMs in turn, or by the dispatcher if there are no VMs.
+	 * @param number of events
+	 */
+	void SendEvents(int nCount);
+
+	/** Returns number of requests received since start */
+	int GetRequestsCount() const { return m_nRequestsCount.loadAcquire(); }
+
+private slots:
+	void onClientConnected(IOSender::Handle h);
+	void onClientDisconnected(IOSender::Handle h);
+	void onPackageReceived(IOSender::Handle h, const SmartPtr<IOPackage> p);
+
+private:
+	Q_DISABLE_COPY(CFakeDispatcher)
+
+	/** Request whose response is held */
+	struct HeldRequest
+	{
+		IOSender::Handle h;
+		SmartPtr<IOPackage> p;
+	};
+
+	void AnswerRequest(IOSender::Handle h, const SmartPtr<IOPackage> &p);
+	void SendLoginResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p);
+	void SendVmListResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p);
+	void SendEmptyResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p);
+	void SendResponse(IOSender::Handle h, const SmartPtr<IOPackage> &p,
+					  const CProtoCommandPtr &pResponse, bool bBinary,
+					  CVmEvent *pBinaryContent = NULL);
+	void SendPackage(IOSender::Handle h, const SmartPtr<IOPackage> &p);
+
+private:
+	IOServer *m_pServer;
+	quint16 m_nPort;
+	QString m_sServerUuid;
+	QAtomicInt m_nResponseDelay;
+	QAtomicInt m_nRequestsCount;
+	QAtomicInt m_nBinaryResponses;
+	QAtomicInt m_nCompression;
+	QAtomicInt m_nCompressedRequests;
+	QAtomicInt m_nCompressedPackages;
+	/** Protects clients, VMs and held requests lists */
+	mutable QMutex m_Mutex;
+	QList<IOSender::Handle> m_lstClients;
+	/** Clients whose compression offer was confirmed */
+	QSet<IOSender::Handle> m_setCompressionClients;
+	bool m_bHoldResponses;
+	QList<HeldRequest> m_lstHeldRequests;
+	QStringList m_lstVmsUuids;
+	QStringList m_lstVmsConfigs;
+	int m_nNextEventIssuer;
+};
+
+#endif // __VIRTUOZZO_FAKE_DISPATCHER_H__
@@ -0,0 +1,112 @@
+/*
+ * SdkTest.cpp: Common helpers of SDK tests
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "SdkTest.h"
+
+#include <QDeadlineTimer>
+#include <QThread>
+#include <thread>
+#include <vector>
+
+PRL_RESULT WaitJob(PRL_HANDLE hJob, PRL_UINT32 nTimeout)
+{
+	if (PRL_INVALID_HANDLE == hJob)
+		return PRL_ERR_INVALID_HANDLE;
+
+	PRL_RESULT nRes = PrlJob_Wait(hJob, nTimeout);
+	if (PRL_FAILED(nRes))
+		return nRes;
+
+	PRL_RESULT nRetCode = PRL_ERR_UNINITIALIZED;
+	nRes = PrlJob_GetRetCode(hJob, &nRetCode);
+	return PRL_FAILED(nRes) ? nRes : nRetCode;
+}
+
+bool WaitCounter(const QAtomicInt &nCounter, int nValue, int nTimeout)
+{
+	QDeadlineTimer _deadline(nTimeout);
+	while (nCounter.loadAcquire() < nValue)
+	{
+		if (_deadline.hasExpired())
+			return false;
+		QThread::yieldCurrentThread();
+	}
+	return true;
+}
+
+PRL_RESULT CountStateEvents(PRL_HANDLE hEvent, PRL_VOID_PTR pCounter)
+{
+	SdkHandleWrap h(hEvent);
+	PRL_HANDLE_TYPE nType = PHT_ERROR;
+	PRL_EVENT_TYPE nEventType = PET_VM_INF_UNINITIALIZED_EVENT_CODE;
+	if (PRL_SUCCEEDED(PrlHandle_GetType(h, &nType)) && PHT_EVENT == nType
+		&& PRL_SUCCEEDED(PrlEvent_GetType(h, &nEventType))
+		&& PET_DSP_EVT_VM_STATE_CHANGED == nEventType)
+		static_cast<QAtomicInt *>(pCounter)->ref();
+	return PRL_ERR_SUCCESS;
+}
+
+void RunInThreads(int nThreads, const std::function<void (int)> &fn)
+{
+	std::vector<std::thread> vThreads;
+	vThreads.reserve(nThreads);
+	for (int i = 0; i < nThreads; ++i)
+		vThreads.emplace_back(fn, i);
+	for (std::thread &t : vThreads)
+		t.join();
+}
+
+CSdkTestSession::CSdkTestSession(const CFakeDispatcher &dispatcher)
+: m_Dispatcher(dispatcher), m_bLoggedIn(false)
+{
+	PrlSrv_Create(m_hServer.GetHandlePtr());
+}
+
+CSdkTestSession::~CSdkTestSession()
+{
+	Logoff();
+}
+
+PRL_RESULT CSdkTestSession::Login(PRL_UINT32 nFlags)
+{
+	SdkHandleWrap hJob(PrlSrv_LoginEx(m_hServer, CFakeDispatcher::GetHost(), "user", "password",
+		NULL, m_Dispatcher.GetPort(), 0, PSL_LOW_SECURITY, nFlags));
+	PRL_RESULT nRes = WaitJob(hJob);
+	m_bLoggedIn = PRL_SUCCEEDED(nRes);
+	return nRes;
+}
+
+void CSdkTestSession::Logoff()
+{
+	if (m_bLoggedIn)
+	{
+		SdkHandleWrap hJob(PrlSrv_Logoff(m_hServer));
+		WaitJob(hJob);
+		m_bLoggedIn = false;
+	}
+	m_hServer.reset();
+}
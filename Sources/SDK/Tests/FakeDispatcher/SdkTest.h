@@ -0,0 +1,118 @@
+/*
+ * SdkTest.h: Common helpers of SDK tests
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_SDK_TEST_H__
+#define __VIRTUOZZO_SDK_TEST_H__
+
+#include <QtTest/QtTest>
+#include <functional>
+
+#include "SDK/Wrappers/SdkWrap/SdkHandleWrap.h"
+#include "FakeDispatcher.h"
+
+/** Timeout of the jobs waited by tests, in milliseconds */
+#define PRL_TEST_JOB_TIMEOUT 30000
+
+/**
+ * Waits for job completion
+ * @param job handle
+ * @return job wait error or job return code
+ */
+PRL_RESULT WaitJob(PRL_HANDLE hJob, PRL_UINT32 nTimeout = PRL_TEST_JOB_TIMEOUT);
+
+/**
+ * Waits until counter reaches specified value
+ * @return false on timeout
+ */
+bool WaitCounter(const QAtomicInt &nCounter, int nValue, int nTimeout = PRL_TEST_JOB_TIMEOUT);
+
+/**
+ * Events handler counting VM state change events sent by the fake dispatcher
+ * @param event handle
+ * @param pointer to QAtomicInt counter
+ */
+PRL_RESULT CountStateEvents(PRL_HANDLE hEvent, PRL_VOID_PTR pCounter);
+
+/**
+ * Runs function on several threads at once and waits for all of them
+ * @param number of threads
+ * @param function called with the thread index
+ */
+void RunInThreads(int nThreads, const std::function<void (int)> &fn);
+
+/**
+ * Server handle logged in to the fake dispatcher. Logs off on destruction.
+ */
+class CSdkTestSession
+{
+public:
+	/**
+	 * Class constructor
+	 * @param dispatcher to log in to
+	 */
+	explicit CSdkTestSession(const CFakeDispatcher &dispatcher);
+	/** Class destructor */
+	~CSdkTestSession();
+
+	/**
+	 * Logs in to the dispatcher
+	 * @param login flags (PLLF_*)
+	 */
+	PRL_RESULT Login(PRL_UINT32 nFlags = 0);
+	/** Logs off and frees server handle */
+	void Logoff();
+
+	/** Returns server handle */
+	PRL_HANDLE GetServer() const { return m_hServer; }
+
+private:
+	Q_DISABLE_COPY(CSdkTestSession)
+
+	const CFakeDispatcher &m_Dispatcher;
+	SdkHandleWrap m_hServer;
+	bool m_bLoggedIn;
+};
+
+/**
+ * Test executable entry point. SDK runs its own event loop thread, so the
+ * test object is executed on the main thread without Qt application.
+ */
+#define PRL_SDK_TEST_MAIN(TestObject)										\
+int main(int argc, char *argv[])											\
+{																			\
+	if (PRL_FAILED(PrlApi_InitEx(VIRTUOZZO_API_VER, PAM_SERVER, 0, 0)))		\
+		return 1;															\
+	int nRet;																\
+	{																		\
+		TestObject _test;													\
+		nRet = QTest::qExec(&_test, argc, argv);							\
+	}																		\
+	PrlApi_Deinit();														\
+	return nRet;															\
+}
+
+#endif // __VIRTUOZZO_SDK_TEST_H__
@@ -0,0 +1,227 @@
+/*
+ * HandlesTest.cpp: Handles table tests and benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "HandlesTest.h"
+#include "SDK/Handles/Core/PrlHandlesTable.h"
+
+namespace {
+
+/** Number of handle operations each thread makes per test iteration */
+enum { OPERATIONS_PER_THREAD = 10000 };
+
+/** Limit of create/free iterations waiting for the slot generations to be used up */
+enum { MAX_WRAP_ITERATIONS = 10000000 };
+
+/** Handle value bits of the shard and slot indexes (see PrlHandlesTable) */
+const ULONG_PTR SLOT_ID_MASK = (ULONG_PTR(1) << (PrlHandlesTable::SlotBits + PrlHandlesTable::ShardBits)) - 1;
+
+PRL_UINT32 GetGeneration(PRL_HANDLE h)
+{
+	return PRL_UINT32(ULONG_PTR(h) >> (PrlHandlesTable::SlotBits + PrlHandlesTable::ShardBits))
+		& PrlHandlesTable::GenerationMask;
+}
+
+PRL_UINT32 GetHandlesNum()
+{
+	PRL_UINT32 nCount = 0;
+	PrlDbg_GetHandlesNum(&nCount, PHT_ERROR);
+	return nCount;
+}
+
+void AddThreadsRows()
+{
+	QTest::addColumn<int>("threads");
+
+	QTest::newRow("1 thread") << 1;
+	QTest::newRow("4 threads") << 4;
+	QTest::newRow("16 threads") << 16;
+}
+
+} // namespace
+
+void CHandlesTest::testGenerationWrap()
+{
+	// Runs first, while the table has few free slots which are reused in turn
+	PRL_HANDLE hOld = PRL_INVALID_HANDLE;
+	QVERIFY(PRL_SUCCEEDED(PrlApi_CreateStringsList(&hOld)));
+	const ULONG_PTR nSlotId = ULONG_PTR(hOld) & SLOT_ID_MASK;
+	QVERIFY(PRL_SUCCEEDED(PrlHandle_Free(hOld)));
+
+	// Slot is reused till its last generation, then it must stay retired
+	// for at least two more periods of its reuse
+	qint64 nIteration = 0, nLastReuse = 0, nReusePeriod = 0;
+	bool bLastGeneration = (GetGeneration(hOld) == PRL_UINT32(PrlHandlesTable::GenerationMask));
+	while (!bLastGeneration || nIteration - nLastReuse <= 2 * nReusePeriod)
+	{
+		QVERIFY2(nIteration < MAX_WRAP_ITERATIONS, "Slot of the freed handle is not reused");
+
+		PRL_HANDLE h = PRL_INVALID_HANDLE;
+		QVERIFY(PRL_SUCCEEDED(PrlApi_CreateStringsList(&h)));
+		QVERIFY(h != hOld);
+		if ((ULONG_PTR(h) & SLOT_ID_MASK) == nSlotId)
+		{
+			QVERIFY2(!bLastGeneration, "Slot generation has wrapped");
+			nReusePeriod = nIteration - nLastReuse;
+			nLastReuse = nIteration;
+			bLastGeneration = (GetGeneration(h) == PRL_UINT32(PrlHandlesTable::GenerationMask));
+		}
+		QVERIFY(PRL_SUCCEEDED(PrlHandle_Free(h)));
+		++nIteration;
+	}
+
+	PRL_HANDLE_TYPE nType = PHT_ERROR;
+	QCOMPARE(PrlHandle_GetType(hOld, &nType), PRL_ERR_INVALID_ARG);
+}
+
+void CHandlesTest::testStaleHandle()
+{
+	PRL_HANDLE hOld = PRL_INVALID_HANDLE;
+	QVERIFY(PRL_SUCCEEDED(PrlApi_CreateStringsList(&hOld)));
+	QVERIFY(PRL_SUCCEEDED(PrlHandle_Free(hOld)));
+
+	// Slot of the freed handle is reused sooner or later, old handle value must not resolve to new object
+	QList<PRL_HANDLE> lstHandles;
+	for (int i = 0; i < OPERATIONS_PER_THREAD; ++i)
+	{
+		PRL_HANDLE h = PRL_INVALID_HANDLE;
+		QVERIFY(PRL_SUCCEEDED(PrlApi_CreateStringsList(&h)));
+		QVERIFY(h != hOld);
+		lstHandles.append(h);
+	}
+
+	PRL_HANDLE_TYPE nType = PHT_ERROR;
+	QCOMPARE(PrlHandle_GetType(hOld, &nType), PRL_ERR_INVALID_ARG);
+	QCOMPARE(PrlHandle_Free(hOld), PRL_ERR_INVALID_ARG);
+
+	foreach (PRL_HANDLE h, lstHandles)
+		QVERIFY(PRL_SUCCEEDED(PrlHandle_Free(h)));
+}
+
+void CHandlesTest::testConcurrentCreateFree()
+{
+	const PRL_UINT32 nHandlesBefore = GetHandlesNum();
+	QAtomicInt nFailures;
+
+	RunInThreads(16, [&nFailures](int)
+	{
+		for (int i = 0; i < OPERATIONS_PER_THREAD; ++i)
+		{
+			SdkHandleWrap hList;
+			PRL_HANDLE_TYPE nType = PHT_ERROR;
+			if (PRL_FAILED(PrlApi_CreateStringsList(hList.GetHandlePtr()))
+				|| PRL_FAILED(PrlHandle_GetType(hList, &nType))
+				|| PHT_STRINGS_LIST != nType)
+				nFailures.ref();
+		}
+	});
+
+	QCOMPARE(nFailures.loadAcquire(), 0);
+	QCOMPARE(GetHandlesNum(), nHandlesBefore);
+}
+
+void CHandlesTest::testConcurrentAddRefFree()
+{
+	SdkHandleWrap hList;
+	QVERIFY(PRL_SUCCEEDED(PrlApi_CreateStringsList(hList.GetHandlePtr())));
+	QVERIFY(PRL_SUCCEEDED(PrlStrList_AddItem(hList, "item")));
+	QAtomicInt nFailures;
+
+	RunInThreads(16, [&hList, &nFailures](int)
+	{
+		for (int i = 0; i < OPERATIONS_PER_THREAD; ++i)
+		{
+			PRL_UINT32 nCount = 0;
+			if (PRL_FAILED(PrlHandle_AddRef(hList))
+				|| PRL_FAILED(PrlStrList_GetItemsCount(hList, &nCount))
+				|| 1 != nCount
+				|| PRL_FAILED(PrlHandle_Free(hList)))
+				nFailures.ref();
+		}
+	});
+
+	QCOMPARE(nFailures.loadAcquire(), 0);
+	// Only the reference of the wrapper is left, so the handle dies with it
+	const PRL_HANDLE h = hList;
+	hList.reset();
+	PRL_HANDLE_TYPE nType = PHT_ERROR;
+	QCOMPARE(PrlHandle_GetType(h, &nType), PRL_ERR_INVALID_ARG);
+}
+
+void CHandlesTest::benchLookup_data()
+{
+	AddThreadsRows();
+}
+
+void CHandlesTest::benchLookup()
+{
+	QFETCH(int, threads);
+
+	// Each thread looks up its own handle, handles are spread over the table shards
+	QList<SdkHandleWrap> lstHandles;
+	for (int i = 0; i < threads; ++i)
+	{
+		SdkHandleWrap hList;
+		QVERIFY(PRL_SUCCEEDED(PrlApi_CreateStringsList(hList.GetHandlePtr())));
+		lstHandles.append(hList);
+	}
+
+	QBENCHMARK
+	{
+		RunInThreads(threads, [&lstHandles](int nThread)
+		{
+			PRL_HANDLE hList = lstHandles.at(nThread);
+			PRL_UINT32 nCount = 0;
+			for (int i = 0; i < OPERATIONS_PER_THREAD; ++i)
+				PrlStrList_GetItemsCount(hList, &nCount);
+		});
+	}
+}
+
+void CHandlesTest::benchCreateFree_data()
+{
+	AddThreadsRows();
+}
+
+void CHandlesTest::benchCreateFree()
+{
+	QFETCH(int, threads);
+
+	QBENCHMARK
+	{
+		RunInThreads(threads, [](int)
+		{
+			for (int i = 0; i < OPERATIONS_PER_THREAD; ++i)
+			{
+				PRL_HANDLE hList = PRL_INVALID_HANDLE;
+				PrlApi_CreateStringsList(&hList);
+				PrlHandle_Free(hList);
+			}
+		});
+	}
+}
+
+PRL_SDK_TEST_MAIN(CHandlesTest)
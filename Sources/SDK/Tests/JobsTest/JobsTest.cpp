@@ -0,0 +1,262 @@
+/*
+ * JobsTest.cpp: Jobs completion tests and benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "JobsTest.h"
+
+namespace {
+
+/** Jobs sent at once and the list to wait for them */
+struct Jobs
+{
+	enum { SEND_WINDOW = 128 };
+
+	Jobs()
+	{
+		PrlApi_CreateHandlesList(hList.GetHandlePtr());
+	}
+
+	/** Sends requests whose jobs are added to the list */
+	void Send(const CFakeDispatcher &dispatcher, PRL_HANDLE hServer, int nCount)
+	{
+		// Keeps burst of requests below the transport send queue limit
+		const int nReceived = dispatcher.GetRequestsCount();
+		for (int i = 0; i < nCount; ++i)
+		{
+			while (i - (dispatcher.GetRequestsCount() - nReceived) >= SEND_WINDOW)
+				QThread::yieldCurrentThread();
+
+			SdkHandleWrap hJob(PrlSrv_GetCommonPrefs(hServer));
+			PrlHndlList_AddItem(hList, hJob);
+			lstJobs.append(hJob);
+		}
+	}
+
+	/** Returns number of finished jobs */
+	int GetFinishedCount() const
+	{
+		int nFinished = 0;
+		foreach(const SdkHandleWrap &hJob, lstJobs)
+		{
+			PRL_JOB_STATUS nStatus = PJS_UNKNOWN;
+			if (PRL_SUCCEEDED(PrlJob_GetStatus(hJob, &nStatus)) && PJS_FINISHED == nStatus)
+				++nFinished;
+		}
+		return nFinished;
+	}
+
+	SdkHandleWrap hList;
+	QList<SdkHandleWrap> lstJobs;
+};
+
+} // namespace
+
+bool CJobsTest::WaitHeldResponses(int nCount)
+{
+	QElapsedTimer _timer;
+	_timer.start();
+	while (m_Dispatcher.GetHeldResponsesCount() < nCount)
+	{
+		if (_timer.hasExpired(PRL_TEST_JOB_TIMEOUT))
+			return false;
+		QThread::yieldCurrentThread();
+	}
+	return true;
+}
+
+void CJobsTest::initTestCase()
+{
+	QVERIFY(m_Dispatcher.Start());
+}
+
+void CJobsTest::cleanupTestCase()
+{
+	m_Dispatcher.Stop();
+}
+
+void CJobsTest::init()
+{
+	m_Dispatcher.SetHoldResponses(false);
+}
+
+void CJobsTest::cleanup()
+{
+	// Jobs of the failed test must not stay waiting for their responses
+	m_Dispatcher.SetHoldResponses(false);
+	m_Dispatcher.ReleaseHeldResponses();
+}
+
+void CJobsTest::testWaitAny()
+{
+	enum { JOBS = 100 };
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	m_Dispatcher.SetHoldResponses(true);
+	Jobs _jobs;
+	_jobs.Send(m_Dispatcher, _session.GetServer(), JOBS);
+	QVERIFY(WaitHeldResponses(JOBS));
+
+	PRL_UINT32 nIndex = PRL_UINT32(-1);
+	QCOMPARE(PrlJob_WaitAny(_jobs.hList, 100, &nIndex), PRL_ERR_TIMEOUT);
+
+	QCOMPARE(m_Dispatcher.ReleaseHeldResponses(1), 1);
+	QCOMPARE(PrlJob_WaitAny(_jobs.hList, PRL_TEST_JOB_TIMEOUT, &nIndex), PRL_ERR_SUCCESS);
+	QVERIFY(nIndex < PRL_UINT32(JOBS));
+	PRL_JOB_STATUS nStatus = PJS_UNKNOWN;
+	QVERIFY(PRL_SUCCEEDED(PrlJob_GetStatus(_jobs.lstJobs.at(nIndex), &nStatus)));
+	QCOMPARE(nStatus, PJS_FINISHED);
+	QCOMPARE(_jobs.GetFinishedCount(), 1);
+
+	QCOMPARE(m_Dispatcher.ReleaseHeldResponses(), JOBS - 1);
+	QCOMPARE(PrlJob_WaitAll(_jobs.hList, PRL_TEST_JOB_TIMEOUT), PRL_ERR_SUCCESS);
+}
+
+void CJobsTest::testWaitAll()
+{
+	enum { JOBS = 1000 };
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	m_Dispatcher.SetHoldResponses(true);
+	Jobs _jobs;
+	_jobs.Send(m_Dispatcher, _session.GetServer(), JOBS);
+	QVERIFY(WaitHeldResponses(JOBS));
+
+	// All but one job is not enough
+	QCOMPARE(m_Dispatcher.ReleaseHeldResponses(JOBS - 1, true), JOBS - 1);
+	QCOMPARE(PrlJob_WaitAll(_jobs.hList, 100), PRL_ERR_TIMEOUT);
+
+	QCOMPARE(m_Dispatcher.ReleaseHeldResponses(), 1);
+	QCOMPARE(PrlJob_WaitAll(_jobs.hList, PRL_TEST_JOB_TIMEOUT), PRL_ERR_SUCCESS);
+	QCOMPARE(_jobs.GetFinishedCount(), int(JOBS));
+	foreach(const SdkHandleWrap &hJob, _jobs.lstJobs)
+		QCOMPARE(WaitJob(hJob, 0), PRL_ERR_SUCCESS);
+}
+
+void CJobsTest::testWaitInvalidList()
+{
+	PRL_UINT32 nIndex = 0;
+	SdkHandleWrap hList;
+	QVERIFY(PRL_SUCCEEDED(PrlApi_CreateHandlesList(hList.GetHandlePtr())));
+	QCOMPARE(PrlJob_WaitAny(hList, 0, &nIndex), PRL_ERR_INVALID_ARG);
+	QCOMPARE(PrlJob_WaitAll(hList, 0), PRL_ERR_INVALID_ARG);
+
+	SdkHandleWrap hNotJob;
+	QVERIFY(PRL_SUCCEEDED(PrlApi_CreateStringsList(hNotJob.GetHandlePtr())));
+	QVERIFY(PRL_SUCCEEDED(PrlHndlList_AddItem(hList, hNotJob)));
+	QCOMPARE(PrlJob_WaitAny(hList, 0, &nIndex), PRL_ERR_INVALID_ARG);
+	QCOMPARE(PrlJob_WaitAll(hList, 0), PRL_ERR_INVALID_ARG);
+	QCOMPARE(PrlJob_WaitAny(hList, 0, NULL), PRL_ERR_INVALID_ARG);
+}
+
+void CJobsTest::testOutOfOrderCompletion()
+{
+	enum { JOBS = 50000 };
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	m_Dispatcher.SetHoldResponses(true);
+	Jobs _jobs;
+	_jobs.Send(m_Dispatcher, _session.GetServer(), JOBS);
+	QVERIFY(WaitHeldResponses(JOBS));
+	QCOMPARE(_jobs.GetFinishedCount(), 0);
+
+	// Every response has to find its own job among all outstanding ones
+	QCOMPARE(m_Dispatcher.ReleaseHeldResponses(-1, true), int(JOBS));
+	QCOMPARE(PrlJob_WaitAll(_jobs.hList, PRL_TEST_JOB_TIMEOUT), PRL_ERR_SUCCESS);
+	foreach(const SdkHandleWrap &hJob, _jobs.lstJobs)
+		QCOMPARE(WaitJob(hJob, 0), PRL_ERR_SUCCESS);
+}
+
+void CJobsTest::benchWaitJobs_data()
+{
+	QTest::addColumn<int>("jobs");
+	QTest::addColumn<bool>("waitAll");
+
+	QTest::newRow("1000 jobs, one by one") << 1000 << false;
+	QTest::newRow("1000 jobs, all at once") << 1000 << true;
+	QTest::newRow("10000 jobs, one by one") << 10000 << false;
+	QTest::newRow("10000 jobs, all at once") << 10000 << true;
+}
+
+void CJobsTest::benchWaitJobs()
+{
+	QFETCH(int, jobs);
+	QFETCH(bool, waitAll);
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	QBENCHMARK
+	{
+		Jobs _jobs;
+		_jobs.Send(m_Dispatcher, _session.GetServer(), jobs);
+		if (waitAll)
+			QCOMPARE(PrlJob_WaitAll(_jobs.hList, PRL_TEST_JOB_TIMEOUT), PRL_ERR_SUCCESS);
+		else
+		{
+			foreach(const SdkHandleWrap &hJob, _jobs.lstJobs)
+				QCOMPARE(PrlJob_Wait(hJob, PRL_TEST_JOB_TIMEOUT), PRL_ERR_SUCCESS);
+		}
+	}
+}
+
+void CJobsTest::benchOutstandingJobs_data()
+{
+	QTest::addColumn<int>("jobs");
+	QTest::addColumn<bool>("shuffle");
+
+	QTest::newRow("10000 jobs, in order") << 10000 << false;
+	QTest::newRow("10000 jobs, out of order") << 10000 << true;
+	QTest::newRow("50000 jobs, in order") << 50000 << false;
+	QTest::newRow("50000 jobs, out of order") << 50000 << true;
+}
+
+void CJobsTest::benchOutstandingJobs()
+{
+	QFETCH(int, jobs);
+	QFETCH(bool, shuffle);
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	m_Dispatcher.SetHoldResponses(true);
+
+	// Completion of all jobs is measured once all of them are outstanding
+	QBENCHMARK
+	{
+		Jobs _jobs;
+		_jobs.Send(m_Dispatcher, _session.GetServer(), jobs);
+		QVERIFY(WaitHeldResponses(jobs));
+		QCOMPARE(m_Dispatcher.ReleaseHeldResponses(-1, shuffle), jobs);
+		QCOMPARE(PrlJob_WaitAll(_jobs.hList, PRL_TEST_JOB_TIMEOUT), PRL_ERR_SUCCESS);
+	}
+}
+
+PRL_SDK_TEST_MAIN(CJobsTest)
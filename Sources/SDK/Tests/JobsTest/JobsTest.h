@@ -0,0 +1,65 @@
+/*
+ * JobsTest.h: Jobs completion tests and benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_JOBS_TEST_H__
+#define __VIRTUOZZO_JOBS_TEST_H__
+
+#include "SdkTest.h"
+
+/**
+ * Jobs completion tests: waiting for any or all of many jobs, tens of
+ * thousands of outstanding jobs completed out of order and the benchmarks
+ * of waiting for thousands of outstanding jobs.
+ */
+class CJobsTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void cleanupTestCase();
+	void init();
+	void cleanup();
+
+	void testWaitAny();
+	void testWaitAll();
+	void testWaitInvalidList();
+	void testOutOfOrderCompletion();
+
+	void benchWaitJobs_data();
+	void benchWaitJobs();
+	void benchOutstandingJobs_data();
+	void benchOutstandingJobs();
+
+private:
+	bool WaitHeldResponses(int nCount);
+
+private:
+	CFakeDispatcher m_Dispatcher;
+};
+
+#endif // __VIRTUOZZO_JOBS_TEST_H__
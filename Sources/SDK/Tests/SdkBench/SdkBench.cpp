@@ -0,0 +1,366 @@
+/*
+ * SdkBench.cpp: End to end SDK benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#include "SdkBench.h"
+
+#include <QSet>
+
+namespace {
+
+/** Length of the string buffers UUIDs are read to */
+enum { UUID_BUF_LENGTH = 64 };
+
+QString GetVmUuid(PRL_HANDLE hVm)
+{
+	char sUuid[UUID_BUF_LENGTH];
+	PRL_UINT32 nLength = sizeof(sUuid);
+	if (PRL_FAILED(PrlVmCfg_GetUuid(hVm, sUuid, &nLength)))
+		return QString();
+	return QString::fromUtf8(sUuid);
+}
+
+/** Returns first VM of the server VMs list */
+PRL_RESULT GetFirstVm(PRL_HANDLE hServer, SdkHandleWrap &hVm)
+{
+	SdkHandleWrap hJob(PrlSrv_GetVmList(hServer));
+	PRL_RESULT nRes = WaitJob(hJob);
+	if (PRL_FAILED(nRes))
+		return nRes;
+	SdkHandleWrap hResult;
+	nRes = PrlJob_GetResult(hJob, hResult.GetHandlePtr());
+	if (PRL_FAILED(nRes))
+		return nRes;
+	return PrlResult_GetParamByIndex(hResult, 0, hVm.GetHandlePtr());
+}
+
+/**
+ * Sends VM request and waits for its completion. VM start is sent directly
+ * from the caller thread, uptime reset is switched to the server context.
+ */
+PRL_RESULT CallVm(PRL_HANDLE hVm, bool bDirect)
+{
+	SdkHandleWrap hJob(bDirect ? PrlVm_Start(hVm) : PrlVm_ResetUptime(hVm, 0));
+	return WaitJob(hJob);
+}
+
+} // namespace
+
+void CSdkBench::initTestCase()
+{
+	QVERIFY(m_Dispatcher.Start());
+}
+
+void CSdkBench::cleanupTestCase()
+{
+	m_Dispatcher.Stop();
+}
+
+void CSdkBench::init()
+{
+	m_Dispatcher.SetResponseDelay(0);
+	m_Dispatcher.SetVmsCount(0);
+	m_Dispatcher.SetBinaryResponses(false);
+	m_Dispatcher.SetCompression(false);
+	m_nEvents.storeRelease(0);
+}
+
+void CSdkBench::testLogin()
+{
+	SdkHandleWrap hServer;
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_Create(hServer.GetHandlePtr())));
+	SdkHandleWrap hJob(PrlSrv_LoginEx(hServer, CFakeDispatcher::GetHost(), "user", "password",
+		NULL, m_Dispatcher.GetPort(), 0, PSL_LOW_SECURITY, 0));
+	QCOMPARE(WaitJob(hJob), PRL_ERR_SUCCESS);
+
+	SdkHandleWrap hResult, hLoginResponse;
+	QVERIFY(PRL_SUCCEEDED(PrlJob_GetResult(hJob, hResult.GetHandlePtr())));
+	QVERIFY(PRL_SUCCEEDED(PrlResult_GetParam(hResult, hLoginResponse.GetHandlePtr())));
+	char sUuid[UUID_BUF_LENGTH];
+	PRL_UINT32 nLength = sizeof(sUuid);
+	QVERIFY(PRL_SUCCEEDED(PrlLoginResponse_GetServerUuid(hLoginResponse, sUuid, &nLength)));
+	QCOMPARE(QString::fromUtf8(sUuid), m_Dispatcher.GetServerUuid());
+
+	hJob.reset(PrlSrv_Logoff(hServer));
+	QCOMPARE(WaitJob(hJob), PRL_ERR_SUCCESS);
+}
+
+void CSdkBench::testVmList_data()
+{
+	QTest::addColumn<bool>("binary");
+
+	QTest::newRow("xml response") << false;
+	QTest::newRow("binary response") << true;
+}
+
+void CSdkBench::testVmList()
+{
+	QFETCH(bool, binary);
+
+	m_Dispatcher.SetBinaryResponses(binary);
+	m_Dispatcher.SetVmsCount(10);
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	SdkHandleWrap hJob(PrlSrv_GetVmList(_session.GetServer()));
+	QCOMPARE(WaitJob(hJob), PRL_ERR_SUCCESS);
+	SdkHandleWrap hResult;
+	QVERIFY(PRL_SUCCEEDED(PrlJob_GetResult(hJob, hResult.GetHandlePtr())));
+	PRL_UINT32 nCount = 0;
+	QVERIFY(PRL_SUCCEEDED(PrlResult_GetParamsCount(hResult, &nCount)));
+	QCOMPARE(nCount, PRL_UINT32(10));
+
+	QSet<QString> setUuids;
+	for (PRL_UINT32 i = 0; i < nCount; ++i)
+	{
+		SdkHandleWrap hVm;
+		QVERIFY(PRL_SUCCEEDED(PrlResult_GetParamByIndex(hResult, i, hVm.GetHandlePtr())));
+		setUuids.insert(GetVmUuid(hVm));
+	}
+	QStringList lstUuids = m_Dispatcher.GetVmsUuids();
+	QCOMPARE(setUuids, QSet<QString>(lstUuids.begin(), lstUuids.end()));
+}
+
+void CSdkBench::testEvents()
+{
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_RegEventHandler(_session.GetServer(), CountStateEvents, &m_nEvents)));
+	m_Dispatcher.SendEvents(100);
+	QVERIFY(WaitCounter(m_nEvents, 100));
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_UnregEventHandler(_session.GetServer(), CountStateEvents, &m_nEvents)));
+}
+
+void CSdkBench::testConcurrentVmCalls()
+{
+	m_Dispatcher.SetVmsCount(1);
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	SdkHandleWrap hVm;
+	QVERIFY(PRL_SUCCEEDED(GetFirstVm(_session.GetServer(), hVm)));
+
+	// Responses of direct requests race with their sending, each job still has to get its own response
+	const int nRequestsBefore = m_Dispatcher.GetRequestsCount();
+	QAtomicInt nFailures;
+	RunInThreads(8, [&hVm, &nFailures](int nThread)
+	{
+		for (int i = 0; i < 1000; ++i)
+			if (PRL_FAILED(CallVm(hVm, nThread % 2 == 0)))
+				nFailures.ref();
+	});
+
+	QCOMPARE(nFailures.loadAcquire(), 0);
+	QCOMPARE(m_Dispatcher.GetRequestsCount() - nRequestsBefore, 8 * 1000);
+}
+
+void CSdkBench::testCompression_data()
+{
+	QTest::addColumn<bool>("offered");
+	QTest::addColumn<bool>("supported");
+
+	QTest::newRow("negotiated") << true << true;
+	QTest::newRow("not supported by dispatcher") << true << false;
+	QTest::newRow("not offered by client") << false << true;
+}
+
+void CSdkBench::testCompression()
+{
+	QFETCH(bool, offered);
+	QFETCH(bool, supported);
+
+	// VMs list of 1000 VMs and the stored value are larger than compression threshold
+	m_Dispatcher.SetCompression(supported);
+	m_Dispatcher.SetVmsCount(1000);
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(offered ? PLLF_ALLOW_COMPRESSION : 0), PRL_ERR_SUCCESS);
+	const int nCompressedPackages = m_Dispatcher.GetCompressedPackagesCount();
+	const int nCompressedRequests = m_Dispatcher.GetCompressedRequestsCount();
+
+	SdkHandleWrap hJob(PrlSrv_GetVmList(_session.GetServer()));
+	QCOMPARE(WaitJob(hJob), PRL_ERR_SUCCESS);
+	SdkHandleWrap hResult;
+	QVERIFY(PRL_SUCCEEDED(PrlJob_GetResult(hJob, hResult.GetHandlePtr())));
+	PRL_UINT32 nCount = 0;
+	QVERIFY(PRL_SUCCEEDED(PrlResult_GetParamsCount(hResult, &nCount)));
+	QCOMPARE(nCount, PRL_UINT32(1000));
+	QSet<QString> setUuids;
+	for (PRL_UINT32 i = 0; i < nCount; ++i)
+	{
+		SdkHandleWrap hVm;
+		QVERIFY(PRL_SUCCEEDED(PrlResult_GetParamByIndex(hResult, i, hVm.GetHandlePtr())));
+		setUuids.insert(GetVmUuid(hVm));
+	}
+	QStringList lstUuids = m_Dispatcher.GetVmsUuids();
+	QCOMPARE(setUuids, QSet<QString>(lstUuids.begin(), lstUuids.end()));
+
+	const QByteArray sValue(128 * 1024, 'v');
+	hJob.reset(PrlSrv_StoreValueByKey(_session.GetServer(), "key", sValue.constData(), 0));
+	QCOMPARE(WaitJob(hJob), PRL_ERR_SUCCESS);
+
+	const bool bNegotiated = offered && supported;
+	QCOMPARE(m_Dispatcher.GetCompressedPackagesCount() > nCompressedPackages, bNegotiated);
+	QCOMPARE(m_Dispatcher.GetCompressedRequestsCount() > nCompressedRequests, bNegotiated);
+}
+
+void CSdkBench::benchLogin()
+{
+	QBENCHMARK
+	{
+		CSdkTestSession _session(m_Dispatcher);
+		QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	}
+}
+
+void CSdkBench::benchRoundTripLatency_data()
+{
+	QTest::addColumn<int>("delay");
+
+	QTest::newRow("no delay") << 0;
+	QTest::newRow("1 ms delay") << 1;
+}
+
+void CSdkBench::benchRoundTripLatency()
+{
+	QFETCH(int, delay);
+
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	m_Dispatcher.SetResponseDelay(delay);
+
+	QBENCHMARK
+	{
+		SdkHandleWrap hJob(PrlSrv_GetCommonPrefs(_session.GetServer()));
+		QCOMPARE(WaitJob(hJob), PRL_ERR_SUCCESS);
+	}
+}
+
+void CSdkBench::benchVmListThroughput_data()
+{
+	QTest::addColumn<int>("vms");
+	QTest::addColumn<bool>("binary");
+	QTest::addColumn<bool>("compression");
+
+	QTest::newRow("100 vms, xml response") << 100 << false << false;
+	QTest::newRow("100 vms, binary response") << 100 << true << false;
+	QTest::newRow("1000 vms, xml response") << 1000 << false << false;
+	QTest::newRow("1000 vms, binary response") << 1000 << true << false;
+	QTest::newRow("1000 vms, compressed xml response") << 1000 << false << true;
+}
+
+void CSdkBench::benchVmListThroughput()
+{
+	QFETCH(int, vms);
+	QFETCH(bool, binary);
+	QFETCH(bool, compression);
+
+	m_Dispatcher.SetBinaryResponses(binary);
+	m_Dispatcher.SetCompression(compression);
+	m_Dispatcher.SetVmsCount(vms);
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(compression ? PLLF_ALLOW_COMPRESSION : 0), PRL_ERR_SUCCESS);
+
+	// VMs are taken from the result as applications do, so configs parsing is measured too
+	QBENCHMARK
+	{
+		SdkHandleWrap hJob(PrlSrv_GetVmList(_session.GetServer()));
+		QCOMPARE(WaitJob(hJob), PRL_ERR_SUCCESS);
+		SdkHandleWrap hResult;
+		QVERIFY(PRL_SUCCEEDED(PrlJob_GetResult(hJob, hResult.GetHandlePtr())));
+		PRL_UINT32 nCount = 0;
+		QVERIFY(PRL_SUCCEEDED(PrlResult_GetParamsCount(hResult, &nCount)));
+		QCOMPARE(nCount, PRL_UINT32(vms));
+		for (PRL_UINT32 i = 0; i < nCount; ++i)
+		{
+			SdkHandleWrap hVm;
+			QVERIFY(PRL_SUCCEEDED(PrlResult_GetParamByIndex(hResult, i, hVm.GetHandlePtr())));
+		}
+	}
+}
+
+void CSdkBench::benchEventsThroughput_data()
+{
+	QTest::addColumn<int>("vms");
+	QTest::addColumn<int>("events");
+
+	QTest::newRow("server events") << 0 << 10000;
+	QTest::newRow("events of 100 vms") << 100 << 10000;
+}
+
+void CSdkBench::benchEventsThroughput()
+{
+	QFETCH(int, vms);
+	QFETCH(int, events);
+
+	m_Dispatcher.SetVmsCount(vms);
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_RegEventHandler(_session.GetServer(), CountStateEvents, &m_nEvents)));
+
+	QBENCHMARK
+	{
+		m_nEvents.storeRelease(0);
+		m_Dispatcher.SendEvents(events);
+		QVERIFY(WaitCounter(m_nEvents, events));
+	}
+
+	QVERIFY(PRL_SUCCEEDED(PrlSrv_UnregEventHandler(_session.GetServer(), CountStateEvents, &m_nEvents)));
+}
+
+void CSdkBench::benchVmCalls_data()
+{
+	QTest::addColumn<bool>("direct");
+	QTest::addColumn<int>("threads");
+
+	QTest::newRow("switched, 1 thread") << false << 1;
+	QTest::newRow("direct, 1 thread") << true << 1;
+	QTest::newRow("switched, 8 threads") << false << 8;
+	QTest::newRow("direct, 8 threads") << true << 8;
+}
+
+void CSdkBench::benchVmCalls()
+{
+	QFETCH(bool, direct);
+	QFETCH(int, threads);
+
+	m_Dispatcher.SetVmsCount(1);
+	CSdkTestSession _session(m_Dispatcher);
+	QCOMPARE(_session.Login(), PRL_ERR_SUCCESS);
+	SdkHandleWrap hVm;
+	QVERIFY(PRL_SUCCEEDED(GetFirstVm(_session.GetServer(), hVm)));
+
+	QBENCHMARK
+	{
+		RunInThreads(threads, [&hVm, direct](int)
+		{
+			for (int i = 0; i < 100; ++i)
+				CallVm(hVm, direct);
+		});
+	}
+}
+
+PRL_SDK_TEST_MAIN(CSdkBench)
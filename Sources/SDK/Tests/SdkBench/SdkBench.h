@@ -0,0 +1,71 @@
+/*
+ * SdkBench.h: End to end SDK benchmarks
+ *
+ * Copyright (c) 1999-2017, Parallels International GmbH
+ * Copyright (c) 2017-2019 Virtuozzo International GmbH. All rights reserved.
+ *
+ * This file is part of Virtuozzo SDK. Virtuozzo SDK is free
+ * software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License,
+ * or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/> or write to Free Software Foundation,
+ * 51 Franklin Street, Fifth Floor Boston, MA 02110, USA.
+ *
+ * Our contact details: Virtuozzo International GmbH, Vordergasse 59, 8200
+ * Schaffhausen, Switzerland; http://www.virtuozzo.com/.
+ */
+
+
+#ifndef __VIRTUOZZO_SDK_BENCH_H__
+#define __VIRTUOZZO_SDK_BENCH_H__
+
+#include "SdkTest.h"
+
+/**
+ * End to end SDK benchmarks against the fake dispatcher: login time,
+ * request round trip latency, VMs list throughput, events delivery rate and
+ * VM requests sent directly from the caller thread versus switched ones.
+ */
+class CSdkBench : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void cleanupTestCase();
+	void init();
+
+	void testLogin();
+	void testVmList_data();
+	void testVmList();
+	void testEvents();
+	void testConcurrentVmCalls();
+	void testCompression_data();
+	void testCompression();
+
+	void benchLogin();
+	void benchRoundTripLatency_data();
+	void benchRoundTripLatency();
+	void benchVmListThroughput_data();
+	void benchVmListThroughput();
+	void benchEventsThroughput_data();
+	void benchEventsThroughput();
+	void benchVmCalls_data();
+	void benchVmCalls();
+
+private:
+	CFakeDispatcher m_Dispatcher;
+	/** Events counted by the handler, outlives the sessions it is registered with */
+	QAtomicInt m_nEvents;
+};
+
+#endif // __VIRTUOZZO_SDK_BENCH_H__